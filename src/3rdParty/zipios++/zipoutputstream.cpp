@@ -64,6 +64,13 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
 }
 
 
+std::streamoff ZipOutputStream::putRawEntry( const ZipCDirEntry &entry,
+                                             const char *data,
+                                             std::streamsize size ) {
+  return ozf->putRawEntry( entry, data, size ) ;
+}
+
+
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
 }
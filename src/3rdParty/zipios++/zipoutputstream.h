@@ -54,6 +54,12 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes an entry whose data has already been compressed, see
+      ZipOutputStreambuf::putRawEntry().
+      @return the offset of the entry data in the archive. */
+  std::streamoff putRawEntry( const ZipCDirEntry &entry, const char *data,
+                              std::streamsize size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
@@ -49,6 +49,14 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes an entry whose data has already been compressed. The
+      compression method, crc32 and the sizes must be set in entry, data
+      is written to the archive as it is. Closes the current entry if one
+      is open.
+      @return the offset of the entry data in the archive. */
+  std::streamoff putRawEntry( const ZipCDirEntry &entry, const char *data,
+                              std::streamsize size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
@@ -68,6 +76,7 @@ protected:
 
   void setEntryClosedState() ;
   void updateEntryHeaderInfo() ;
+  static int currentDosTime() ;
 
   // Should/could be moved to zipheadio.h ?!
   static void writeCentralDirectory( const vector< ZipCDirEntry > &entries, 
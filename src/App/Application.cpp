@@ -836,6 +836,21 @@ bool Application::isFineGrainedRecomputeEnabled()
     return enableFineGrainedRecompute;
 }
 
+int Application::getParallelRecomputeThreads()
+{
+    static const ParameterGrp::handle hGrp = GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document"
+    );
+    if (!hGrp->GetBool("EnableParallelRecompute", false)) {
+        return 0;
+    }
+    long threads = hGrp->GetInt("ParallelRecomputeThreads", 0);
+    if (threads <= 0) {
+        threads = static_cast<long>(std::thread::hardware_concurrency());
+    }
+    return threads > 1 ? static_cast<int>(threads) : 0;
+}
+
 bool Application::canRecomputeRequestOnWorker(const RecomputeRequest& req) const
 {
     if (DocumentObject* documentObject = req.resolveDocumentObject()) {
@@ -2322,6 +2337,7 @@ void Application::initTypes()
     App::FeatureTestPlacement      ::init();
     App::FeatureTestAttribute      ::init();
     App::FeatureTestAsyncBlocker   ::init();
+    App::FeatureTestConcurrent     ::init();
 
     // Feature class
     App::FeaturePython             ::init();
@@ -394,6 +394,9 @@ public:
     // Returns if document and object recomputes should be done async.
     bool isAsyncRecomputeEnabled();
     bool isFineGrainedRecomputeEnabled();
+    // Returns the number of threads used to recompute independent objects
+    // concurrently, or 0 if parallel recompute is disabled.
+    int getParallelRecomputeThreads();
     bool canRecomputeRequestOnWorker(const RecomputeRequest& req) const;
 
     // Adds a recompute request to the processing queue.
@@ -31,6 +31,7 @@
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
+#include <Base/MemoryStatistics.h>
 #include <Base/Parameter.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 #include <Base/Sequencer.h>
@@ -145,6 +146,14 @@ PyMethodDef ApplicationPy::Methods[] = {
      (PyCFunction)ApplicationPy::sGetHomePath,
      METH_VARARGS,
      "Get the home path, i.e. the parent directory of the executable"},
+    {"getMemoryStatistics",
+     (PyCFunction)ApplicationPy::sGetMemoryStatistics,
+     METH_VARARGS,
+     "getMemoryStatistics(resetPeak=False) -> dict\n\n"
+     "Get the resident set size, its peak and the number of heap allocations of\n"
+     "the process. The allocation count is None unless the executable was built\n"
+     "with FREECAD_COUNT_ALLOCATIONS. If resetPeak is True the peak is restarted\n"
+     "from the current size after reading it, where the platform supports this."},
 
     {"loadFile",
      (PyCFunction)ApplicationPy::sLoadFile,
@@ -1007,6 +1016,28 @@ PyObject* ApplicationPy::sGetHomePath(PyObject* /*self*/, PyObject* args)
     return Py::new_reference_to(homedir);
 }
 
+PyObject* ApplicationPy::sGetMemoryStatistics(PyObject* /*self*/, PyObject* args)
+{
+    PyObject* resetPeak = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &resetPeak)) {
+        return nullptr;
+    }
+
+    using ULongLong = unsigned long long;
+    Py::Dict dict;
+    dict.setItem("ResidentSize", Py::Long(ULongLong(MemoryStatistics::residentSize())));
+    dict.setItem("PeakResidentSize", Py::Long(ULongLong(MemoryStatistics::peakResidentSize())));
+    if (MemoryStatistics::isCountingAllocations()) {
+        dict.setItem("Allocations", Py::Long(ULongLong(MemoryStatistics::allocationCount())));
+    }
+    else {
+        dict.setItem("Allocations", Py::None());
+    }
+    bool reset = Base::asBoolean(resetPeak) && MemoryStatistics::resetPeakResidentSize();
+    dict.setItem("PeakReset", Py::Boolean(reset));
+    return Py::new_reference_to(dict);
+}
+
 PyObject* ApplicationPy::sListDocuments(PyObject* /*self*/, PyObject* args)
 {
     PyObject* sort = Py_False;
@@ -59,6 +59,7 @@ public:
     static PyObject* sGetUserMacroPath       (PyObject *self, PyObject *args);
     static PyObject* sGetHelpPath            (PyObject *self, PyObject *args);
     static PyObject* sGetHomePath            (PyObject *self, PyObject *args);
+    static PyObject* sGetMemoryStatistics    (PyObject *self, PyObject *args);
 
     static PyObject* sLoadFile               (PyObject *self,PyObject *args);
     static PyObject* sOpenDocument           (PyObject *self,PyObject *args, PyObject *kwd);
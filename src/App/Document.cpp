@@ -31,6 +31,7 @@
 #include <memory>
 #include <new>
 #include <string>
+#include <cstring>
 #include <map>
 #include <vector>
 #include <list>
@@ -38,6 +39,11 @@
 #include <filesystem>
 #include <format>
 #include <optional>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/bimap.hpp>
@@ -75,6 +81,7 @@
 #include "Application.h"
 #include "AutoTransaction.h"
 #include "BackupPolicy.h"
+#include "DocumentObjectExtension.h"
 #include "ExpressionParser.h"
 #include "GeoFeature.h"
 #include "License.h"
@@ -902,8 +909,142 @@ void Document::onChanged(const Property* prop)
     }
 }
 
+namespace
+{
+// true on the pool threads of a parallel recompute
+thread_local bool inConcurrentRecompute = false;
+
+// Serializes property change notifications coming from objects that are
+// recomputed concurrently. Only the pool threads take it, so that the emits
+// they hand to the recomputing thread cannot deadlock. The lock order is this
+// mutex before the GIL, a pool thread holding the GIL releases it while waiting.
+class ConcurrentChangeLock
+{
+public:
+    explicit ConcurrentChangeLock(std::recursive_mutex& mutex)
+    {
+        if (!inConcurrentRecompute) {
+            return;
+        }
+        if (PyGILState_Check()) {
+            Base::PyGILStateRelease release;
+            lock = std::unique_lock<std::recursive_mutex>(mutex);
+        }
+        else {
+            lock = std::unique_lock<std::recursive_mutex>(mutex);
+        }
+    }
+
+private:
+    std::unique_lock<std::recursive_mutex> lock;
+};
+
+bool canRecomputeConcurrently(DocumentObject* obj)
+{
+    if (!obj->canRecomputeConcurrently()) {
+        return false;
+    }
+    auto exts = obj->getExtensionsDerivedFromType<DocumentObjectExtension>();
+    return std::none_of(exts.begin(), exts.end(), [](DocumentObjectExtension* ext) {
+        return ext->isPythonExtension();
+    });
+}
+
+/*!
+  Tracks the objects of a topologically sorted recompute list that can be
+  recomputed ahead of the serial recompute loop. An object is ready once the
+  loop has passed all of its dependencies, and it qualifies if it supports
+  concurrent recompute and has to be recomputed. The state is built once per
+  recompute pass and updated as the loop advances, so that every object and
+  dependency is visited a constant number of times per pass.
+ */
+class ConcurrentReadyObjects
+{
+public:
+    /// \a deps holds the indices of the direct dependencies of each object in \a objs
+    ConcurrentReadyObjects(const std::vector<DocumentObject*>& objs,
+                           const std::vector<std::vector<size_t>>& deps)
+        : objs(objs)
+        , deps(deps)
+        , dependents(objs.size())
+        , waiting(objs.size(), 0)
+    {
+        for (size_t i = 0; i < deps.size(); ++i) {
+            for (auto dep : deps[i]) {
+                dependents[dep].push_back(i);
+            }
+        }
+    }
+
+    /// Starts a recompute pass at \a start
+    void reset(size_t start)
+    {
+        current = start;
+        ready.clear();
+        for (size_t i = start; i < objs.size(); ++i) {
+            waiting[i] = std::count_if(deps[i].begin(), deps[i].end(), [start](size_t dep) {
+                return dep >= start;
+            });
+            if (waiting[i] == 0) {
+                add(i);
+            }
+        }
+    }
+
+    /// The serial loop has reached \a idx, the objects before it are done
+    void moveTo(size_t idx)
+    {
+        for (; current < idx; ++current) {
+            ready.erase(current);
+            for (auto dependent : dependents[current]) {
+                if (--waiting[dependent] == 0) {
+                    add(dependent);
+                }
+            }
+        }
+    }
+
+    /// Returns the ready objects that are neither filtered nor recomputed yet
+    std::vector<DocumentObject*> collect(const std::set<DocumentObject*>& filter,
+                                         const std::map<DocumentObject*, int>& results)
+    {
+        std::vector<DocumentObject*> batch;
+        for (auto it = ready.begin(); it != ready.end();) {
+            auto obj = objs[*it];
+            // the dependencies of a ready object are done, so it cannot get
+            // touched by them anymore
+            if (!obj->isAttachedToDocument() || filter.contains(obj) || results.contains(obj)
+                || !obj->mustRecompute()) {
+                it = ready.erase(it);
+                continue;
+            }
+            batch.push_back(obj);
+            ++it;
+        }
+        return batch;
+    }
+
+private:
+    void add(size_t idx)
+    {
+        if (canRecomputeConcurrently(objs[idx])) {
+            ready.insert(idx);
+        }
+    }
+
+    const std::vector<DocumentObject*>& objs;
+    const std::vector<std::vector<size_t>>& deps;
+    std::vector<std::vector<size_t>> dependents;
+    // the number of dependencies of each object the serial loop has not passed yet
+    std::vector<size_t> waiting;
+    std::set<size_t> ready;
+    size_t current = 0;
+};
+}  // namespace
+
 void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Property* What)
 {
+    ConcurrentChangeLock lock(d->concurrentChangeMutex);
     if (Who->isDerivedFrom<DocumentObject>()) {
         signalBeforeChangeObject(*static_cast<const DocumentObject*>(Who), *What);
     }
@@ -917,6 +1058,7 @@ void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject* Who, const Property* What)
 {
+    ConcurrentChangeLock lock(d->concurrentChangeMutex);
     signalChangedObject(*Who, *What);
 }
 
@@ -1937,6 +2079,9 @@ bool Document::save()
 
 bool Document::saveToFile(const char* filename) const
 {
+    ZoneScoped;
+    ZoneText(filename, std::strlen(filename));
+
     signalStartSave(*this, filename);
 
     auto hGrp = GetApplication().GetParameterGroupByPath(
@@ -1996,6 +2141,8 @@ bool Document::saveToFile(const char* filename) const
         fn += uuid;
     }
 
+    bool parallelSave = hGrp->GetBool("EnableParallelSave", false);
+    Base::ZipWriter::EntryIndex savedEntries;
 
     // open extra scope to close ZipWriter properly
     {
@@ -2009,6 +2156,20 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        if (parallelSave) {
+            writer.setParallelCompression(
+                static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U)));
+
+            // The file is only overwritten by a renamed temporary file, so the last
+            // saved archive can be read while writing if nobody touched it since.
+            const auto& last = d->lastSave;
+            if (policy && last.fileName == nativePath && originalFileInfo.exists()
+                && originalFileInfo.size() == last.fileSize
+                && std::chrono::system_clock::time_point(originalFileInfo.lastModified())
+                    == last.modified) {
+                writer.setPreviousArchive(nativePath, last.entries);
+            }
+        }
         writer.putNextEntry("Document.xml");
 
         if (hGrp->GetBool("SaveBinaryBrep", false)) {
@@ -2036,8 +2197,10 @@ bool Document::saveToFile(const char* filename) const
         }
 
         GetApplication().signalSaveDocument(*this);
+        savedEntries = writer.getEntryIndex();
     }
 
+    d->lastSave = {};
     if (policy) {
         // if saving the project data succeeded rename to the actual file name
         int count_bak = static_cast<int>(GetApplication()
@@ -2071,6 +2234,16 @@ bool Document::saveToFile(const char* filename) const
         backupPolicy.apply(fn, nativePath);
     }
 
+    FC_PROFILE_COUNT("Bytes written", Base::FileInfo(nativePath).size());
+
+    if (parallelSave) {
+        Base::FileInfo savedFileInfo(nativePath);
+        d->lastSave.fileName = nativePath;
+        d->lastSave.fileSize = savedFileInfo.size();
+        d->lastSave.modified = savedFileInfo.lastModified();
+        d->lastSave.entries = std::move(savedEntries);
+    }
+
     signalFinishSave(*this, filename);
 
     return true;
@@ -2906,6 +3079,60 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
 
+    // Independent objects that support it are executed ahead of time on a
+    // thread pool. Their results are picked up by the serial loop below so
+    // that signals, touch propagation and error handling keep their order.
+    // Fine grained recompute touches objects per property and is not supported.
+    int threads = fineGrained ? 0 : GetApplication().getParallelRecomputeThreads();
+    std::map<DocumentObject*, int> precomputed;
+    std::vector<std::vector<size_t>> deps;
+    std::optional<ConcurrentReadyObjects> readyObjects;
+    if (threads > 0) {
+        std::unordered_map<DocumentObject*, size_t> indices;
+        for (size_t i = 0; i < topoSortedObjects.size(); ++i) {
+            indices[topoSortedObjects[i]] = i;
+        }
+        deps.resize(topoSortedObjects.size());
+        for (size_t i = 0; i < topoSortedObjects.size(); ++i) {
+            for (auto dep : topoSortedObjects[i]->getOutList()) {
+                auto it = indices.find(dep);
+                if (it != indices.end() && it->second < i) {
+                    deps[i].push_back(it->second);
+                }
+            }
+        }
+        readyObjects.emplace(topoSortedObjects, deps);
+    }
+
+    // The objects that were executed ahead of an aborted recompute are finished
+    // like the serial loop does it, so that they do not stay touched with an
+    // up-to-date result while their dependents are not marked for recompute.
+    auto finishPrecomputed = [&]() {
+        for (auto obj : topoSortedObjects) {
+            auto result = precomputed.find(obj);
+            if (result == precomputed.end()) {
+                continue;
+            }
+            int res = result->second;
+            precomputed.erase(result);
+            if (!obj->isAttachedToDocument() || res < 0) {
+                continue;
+            }
+            ++objectCount;
+            if (res > 0) {
+                if (hasError) {
+                    *hasError = true;
+                }
+                continue;
+            }
+            signalRecomputedObject(*obj);
+            obj->purgeTouched();
+            for (auto inObjIt : obj->getInList()) {
+                inObjIt->enforceRecompute();
+            }
+        }
+    };
+
     tracker.checkpoint("pre-recompute & topo sort");
 
     try {
@@ -2919,22 +3146,41 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                                                                 topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
+            if (readyObjects) {
+                readyObjects->reset(idx);
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
                     continue;
                 }
+                if (readyObjects && !precomputed.contains(obj) && canRecomputeConcurrently(obj)) {
+                    readyObjects->moveTo(idx);
+                    auto batch = readyObjects->collect(filter, precomputed);
+                    if (batch.size() > 1) {
+                        _recomputeConcurrently(batch, precomputed, threads);
+                    }
+                }
+                auto result = precomputed.find(obj);
                 // ask the object if it should be recomputed
                 bool doRecompute = false;
-                if (obj->mustRecompute()) {
+                if (result != precomputed.end() || obj->mustRecompute()) {
                     doRecompute = true;
                     ++objectCount;
-                    int res = _recomputeFeature(obj);
+                    int res = 0;
+                    if (result != precomputed.end()) {
+                        res = result->second;
+                        precomputed.erase(result);
+                    }
+                    else {
+                        res = _recomputeFeature(obj);
+                    }
                     if (res != 0) {
                         if (hasError) {
                             *hasError = true;
                         }
                         if (res < 0) {
+                            finishPrecomputed();
                             passes = 2;
                             break;
                         }
@@ -2993,6 +3239,8 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
         e.reportException();
     }
 
+    finishPrecomputed();
+
     tracker.checkpoint("Recompute");
 
     for (auto obj : topoSortedObjects) {
@@ -3015,7 +3263,7 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
 
     tracker.checkpoint("Recompute total");
 
-    if (!d->_RecomputeLog.empty()) {
+    if (d->hasRecomputeLog()) {
         if (!testStatus(Status::IgnoreErrorOnRecompute)) {
             for (auto it : topoSortedObjects) {
                 if (it->isError()) {
@@ -3231,15 +3479,27 @@ const char* Document::getErrorDescription(const DocumentObject* Obj) const
 }
 
 // call the recompute of the Feature and handle the exceptions and errors.
-int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
+int Document::_recomputeFeature(DocumentObject* Feat, bool releaseGIL) // NOLINT
 {
+    ZoneScoped;
+    ZoneText(Feat->getNameInDocument(), std::strlen(Feat->getNameInDocument()));
+    ZoneText(Feat->getTypeId().getName(), std::strlen(Feat->getTypeId().getName()));
+    FC_PROFILE_COUNT("Objects recomputed", 1);
+
     FC_LOG("Recomputing " << Feat->getFullName());
 
     DocumentObjectExecReturn* returnCode = nullptr;
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
-            returnCode = Feat->recompute();
+            if (releaseGIL) {
+                // expressions may need Python but the object itself does not
+                Base::PyGILStateRelease release;
+                returnCode = Feat->recompute();
+            }
+            else {
+                returnCode = Feat->recompute();
+            }
             if (returnCode == DocumentObject::StdReturn) {
                 returnCode =
                     Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
@@ -3288,6 +3548,91 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     return 0;
 }
 
+void Document::_recomputeConcurrently(const std::vector<DocumentObject*>& batch,
+                                      std::map<DocumentObject*, int>& results,
+                                      int threads)
+{
+    ZoneScoped;
+
+    std::vector<int> codes(batch.size(), 0);
+    std::atomic<size_t> next {0};
+    size_t count = std::min(batch.size(), static_cast<size_t>(threads));
+
+    // The signals emitted by the pool threads are run by this thread while it
+    // waits for them. Joining the pool right away would deadlock, because the
+    // emits wait for the main thread, which may be this one.
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::packaged_task<void()>> emits;
+    size_t running = count;
+    const MainThreadSignalConfig::RedirectFn redirect = [&](std::function<void()>&& emit) {
+        std::packaged_task<void()> task(std::move(emit));
+        auto done = task.get_future();
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            emits.push_back(std::move(task));
+        }
+        changed.notify_all();
+        done.get();
+    };
+
+    auto worker = [&]() {
+        inConcurrentRecompute = true;
+        MainThreadSignalConfig::setThreadRedirect(&redirect);
+        {
+            // each pool thread holds the GIL except while an object is executed
+            Base::PyGILStateLocker lock;
+            for (size_t i = next++; i < batch.size(); i = next++) {
+                codes[i] = _recomputeFeature(batch[i], true);
+            }
+        }
+        MainThreadSignalConfig::setThreadRedirect(nullptr);
+        inConcurrentRecompute = false;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            --running;
+        }
+        changed.notify_all();
+    };
+
+    FC_LOG("Recomputing " << batch.size() << " objects concurrently");
+    {
+        std::optional<Base::PyGILStateRelease> release;
+        if (PyGILState_Check()) {
+            release.emplace();
+        }
+        std::vector<std::thread> pool;
+        pool.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            pool.emplace_back(worker);
+        }
+
+        std::unique_lock<std::mutex> guard(mutex);
+        while (true) {
+            changed.wait(guard, [&]() {
+                return !emits.empty() || running == 0;
+            });
+            if (emits.empty()) {
+                break;
+            }
+            auto task = std::move(emits.front());
+            emits.pop_front();
+            guard.unlock();
+            task();
+            guard.lock();
+        }
+        guard.unlock();
+
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        results[batch[i]] = codes[i];
+    }
+}
+
 bool Document::recomputeFeature(DocumentObject* feature, bool recursive)
 {
     // delete recompute log
@@ -1406,9 +1406,23 @@ protected:
     /**
      * @brief Recompute a single object.
      * @param[in] Feat The object to recompute.
+     * @param[in] releaseGIL If true, the GIL is released while the object
+     * itself is executed. Its expressions are still evaluated with the GIL.
      * @return 0 if succeeded, 1 if failed, -1 if aborted by user.
      */
-    int _recomputeFeature(DocumentObject* Feat);
+    int _recomputeFeature(DocumentObject* Feat, bool releaseGIL = false);
+
+    /**
+     * @brief Recompute independent objects concurrently on a thread pool.
+     *
+     * @param[in] batch The objects to recompute. None of them may depend on
+     * another one of the batch.
+     * @param[out] results The return code of _recomputeFeature() per object.
+     * @param[in] threads The maximum number of threads to use.
+     */
+    void _recomputeConcurrently(const std::vector<DocumentObject*>& batch,
+                                std::map<DocumentObject*, int>& results,
+                                int threads);
 
     /// Clear the redos.
     void _clearRedos();
@@ -1309,6 +1309,21 @@ public:
         return true;
     }
 
+    /**
+     * @brief Whether this object may be recomputed concurrently with other
+     * independent objects of the same document.
+     *
+     * This is used by the parallel recompute scheduler. Returning true means
+     * that execute() is pure C++, does not call into Python and only modifies
+     * the object's own properties. Such objects are executed on a thread pool
+     * with the GIL released, while all other objects are recomputed serially.
+     * The default is false, i.e. object classes have to opt in explicitly.
+     */
+    virtual bool canRecomputeConcurrently() const
+    {
+        return false;
+    }
+
     /**
      * @brief Called when an element reference is updated.
      *
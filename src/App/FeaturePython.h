@@ -355,6 +355,12 @@ public:
         return imp->supportsAsyncRecompute() == FeaturePythonImp::Accepted;
     }
 
+    bool canRecomputeConcurrently() const override
+    {
+        // execute() is forwarded to Python and therefore needs the GIL
+        return false;
+    }
+
     /**
      * @brief Called when a property is edited by the user.
      *
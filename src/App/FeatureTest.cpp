@@ -23,6 +23,7 @@
  ***************************************************************************/
 
 
+#include <algorithm>
 #include <boost/core/ignore_unused.hpp>
 #include <condition_variable>
 #include <mutex>
@@ -62,6 +63,21 @@ AsyncBlockerState& getAsyncBlockerState()
     return state;
 }
 
+struct ConcurrencyState
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    int running = 0;
+    int maxRunning = 0;
+    int waitFor = 0;
+};
+
+ConcurrencyState& getConcurrencyState()
+{
+    static ConcurrencyState state;
+    return state;
+}
+
 }  // namespace
 
 
@@ -435,3 +451,56 @@ DocumentObjectExecReturn* FeatureTestAsyncBlocker::execute()
     state.changed.wait(lock, [&state] { return state.proceed; });
     return StdReturn;
 }
+
+// ----------------------------------------------------------------------------
+
+PROPERTY_SOURCE(App::FeatureTestConcurrent, App::DocumentObject)
+
+
+FeatureTestConcurrent::FeatureTestConcurrent()
+{
+    ADD_PROPERTY(Source, (nullptr));
+    ADD_PROPERTY_TYPE(Value, (0), "Test", Prop_Output, "Source value plus one");
+    ADD_PROPERTY(Abort, (false));
+}
+
+FeatureTestConcurrent::~FeatureTestConcurrent() = default;
+
+void FeatureTestConcurrent::resetConcurrency(int count)
+{
+    auto& state = getConcurrencyState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.running = 0;
+    state.maxRunning = 0;
+    state.waitFor = count;
+}
+
+int FeatureTestConcurrent::maxConcurrency()
+{
+    auto& state = getConcurrencyState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.maxRunning;
+}
+
+DocumentObjectExecReturn* FeatureTestConcurrent::execute()
+{
+    {
+        auto& state = getConcurrencyState();
+        std::unique_lock<std::mutex> lock(state.mutex);
+        ++state.running;
+        state.maxRunning = std::max(state.maxRunning, state.running);
+        state.changed.notify_all();
+        state.changed.wait_for(lock, std::chrono::seconds(2), [&state] {
+            return state.running >= state.waitFor;
+        });
+        --state.running;
+    }
+
+    if (Abort.getValue()) {
+        throw Base::AbortException("Recompute aborted");
+    }
+
+    auto source = dynamic_cast<FeatureTestConcurrent*>(Source.getValue());
+    Value.setValue(source ? source->Value.getValue() + 1 : 1);
+    return StdReturn;
+}
@@ -237,5 +237,26 @@ public:
     static void releaseBlocker();
 };
 
+class AppExport FeatureTestConcurrent: public DocumentObject
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(App::FeatureTestConcurrent);
+
+public:
+    FeatureTestConcurrent();
+    ~FeatureTestConcurrent() override;
+    DocumentObjectExecReturn* execute() override;
+    bool canRecomputeConcurrently() const override { return true; }
+
+    App::PropertyLink Source;
+    App::PropertyInteger Value;
+    /// Let execute() throw an abort exception
+    App::PropertyBool Abort;
+
+    /// Let execute() wait until \a count objects are executed at the same time.
+    static void resetConcurrency(int count);
+    /// The maximum number of objects that were executed at the same time.
+    static int maxConcurrency();
+};
+
 
 }  // namespace App
@@ -130,6 +130,10 @@ def getHomePath() -> str:
     """Return the current FreeCAD home directory."""
     ...
 
+def getMemoryStatistics(resetPeak: bool = False, /) -> dict[str, int | bool | None]:
+    """Return the resident set size, its peak and the heap allocation count of the process."""
+    ...
+
 # Document lifecycle
 def loadFile(path: str, doc: str = "", module: str = "", /) -> None:
     """Load one file into an existing or inferred document context."""
@@ -76,6 +76,22 @@ public:
         }
     }
 
+    // Runs the given emit on another thread and returns when it is done.
+    using RedirectFn = std::function<void(std::function<void()>&&)>;
+
+    // Hands all emits of the calling thread to fn instead of the main thread,
+    // or restores the default for nullptr. Document::recompute() uses this for
+    // its pool threads, so that their emits run on the thread waiting for them.
+    static void setThreadRedirect(const RedirectFn* fn)
+    {
+        redirectSlot() = fn;
+    }
+
+    static inline const RedirectFn* threadRedirect()
+    {
+        return redirectSlot();
+    }
+
 private:
     static IsMainThreadFn& isMainThreadSlot()
     {
@@ -87,6 +103,11 @@ private:
         static InvokeFn fn = nullptr;
         return fn;
     }
+    static const RedirectFn*& redirectSlot()
+    {
+        static thread_local const RedirectFn* fn = nullptr;
+        return fn;
+    }
 };
 
 namespace detail
@@ -230,34 +251,44 @@ private:
         typename ::fastsignals::signal_arg_t<Arguments>... args
     )
     {
-        if (MainThreadSignalConfig::isMainThread()) {
+        const auto* redirect = MainThreadSignalConfig::threadRedirect();
+        if (!redirect && MainThreadSignalConfig::isMainThread()) {
             return self->sig_(std::forward<typename ::fastsignals::signal_arg_t<Arguments>>(args)...);
         }
 
-        Base::PyGILStateRelease release;
+        // Objects recomputed concurrently emit without holding the GIL
+        std::optional<Base::PyGILStateRelease> release;
+        if (PyGILState_Check()) {
+            release.emplace();
+        }
 
         auto caps = std::make_tuple(
             detail::captureSignalArg<typename ::fastsignals::signal_arg_t<Arguments>>(args)...
         );
 
+        // A redirected emit is emitted again by the receiving thread, which
+        // forwards it to the main thread unless it is the main thread itself.
+        auto invoke = [redirect](std::function<void()>&& fn) {
+            if (redirect) {
+                (*redirect)(std::move(fn));
+            }
+            else {
+                MainThreadSignalConfig::invoke(std::move(fn), /*blocking=*/true);
+            }
+        };
+
         if constexpr (std::is_void_v<result_type>) {
-            MainThreadSignalConfig::invoke(
-                [self, caps = std::move(caps)]() mutable {
-                    std::apply([self](auto&... c) { self->sig_(c.get()...); }, caps);
-                },
-                /*blocking=*/true
-            );
+            invoke([self, caps = std::move(caps)]() mutable {
+                std::apply([self](auto&... c) { emitImpl(self, c.get()...); }, caps);
+            });
         }
         else {
             std::optional<detail::non_void_t<result_type>> result;
-            MainThreadSignalConfig::invoke(
-                [self, caps = std::move(caps), &result]() mutable {
-                    result.emplace(
-                        std::apply([self](auto&... c) { return self->sig_(c.get()...); }, caps)
-                    );
-                },
-                /*blocking=*/true
-            );
+            invoke([self, caps = std::move(caps), &result]() mutable {
+                result.emplace(
+                    std::apply([self](auto&... c) { return emitImpl(self, c.get()...); }, caps)
+                );
+            });
             return std::move(*result);
         }
     }
@@ -28,9 +28,12 @@
 #pragma warning(disable : 4834)
 #endif
 
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -46,6 +49,7 @@
 #include <App/StringHasher.h>
 #include <App/ExportInfo.h>
 #include <Base/UniqueNameManager.h>
+#include <Base/Writer.h>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
 using DependencyList = boost::adjacency_list<
@@ -102,8 +106,22 @@ struct DocumentP
     mutable HasherMap hashers;
     std::multimap<const App::DocumentObject*, std::unique_ptr<App::DocumentObjectExecReturn>>
         _RecomputeLog;
+    std::mutex recomputeLogMutex;
+    // serializes transaction bookkeeping of concurrently recomputed objects
+    std::recursive_mutex concurrentChangeMutex;
     ExportInfo exportInfo;
 
+    // The files written by the last parallel save. Unchanged files are
+    // copied from that archive as long as it was not modified since.
+    struct SaveIndex
+    {
+        std::string fileName;
+        std::uint64_t fileSize {0};
+        std::chrono::system_clock::time_point modified;
+        Base::ZipWriter::EntryIndex entries;
+    };
+    SaveIndex lastSave;
+
     StringHasherRef Hasher {new StringHasher};
 
     DocumentP();
@@ -124,6 +142,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
@@ -131,6 +150,7 @@ struct DocumentP
 
     void clearRecomputeLog(const App::DocumentObject* obj = nullptr)
     {
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
         if (!obj) {
             _RecomputeLog.clear();
         }
@@ -153,8 +173,15 @@ struct DocumentP
         objectIdMap.clear();
     }
 
+    bool hasRecomputeLog()
+    {
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
+        return !_RecomputeLog.empty();
+    }
+
     const char* findRecomputeLog(const App::DocumentObject* obj)
     {
+        std::lock_guard<std::mutex> lock(recomputeLogMutex);
         auto range = _RecomputeLog.equal_range(obj);
         if (range.first == range.second) {
             return nullptr;
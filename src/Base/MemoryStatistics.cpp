@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include "MemoryStatistics.h"
+
+#if defined(_WIN32)
+# ifndef NOMINMAX
+#  define NOMINMAX
+# endif
+# include <windows.h>
+# include <psapi.h>
+#elif defined(__APPLE__)
+# include <mach/mach.h>
+# include <sys/resource.h>
+#elif defined(__linux__)
+# include <fstream>
+# include <limits>
+# include <string>
+#endif
+
+using namespace Base;
+
+std::atomic<std::uint64_t> MemoryStatistics::allocations {0};
+std::atomic<bool> MemoryStatistics::countingAllocations {false};
+
+#if defined(__linux__)
+namespace
+{
+// Reads a field such as "VmRSS:    1234 kB" of /proc/self/status
+std::size_t readProcStatus(const char* field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == field) {
+            std::size_t kiloBytes = 0;
+            status >> kiloBytes;
+            return kiloBytes * 1024;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return 0;
+}
+}  // namespace
+#endif
+
+std::size_t MemoryStatistics::residentSize()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count)
+        == KERN_SUCCESS) {
+        return info.resident_size;
+    }
+    return 0;
+#elif defined(__linux__)
+    return readProcStatus("VmRSS:");
+#else
+    return 0;
+#endif
+}
+
+std::size_t MemoryStatistics::peakResidentSize()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters {};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;  // bytes on macOS
+    }
+    return 0;
+#elif defined(__linux__)
+    return readProcStatus("VmHWM:");
+#else
+    return 0;
+#endif
+}
+
+bool MemoryStatistics::resetPeakResidentSize()
+{
+#if defined(__linux__)
+    // Since Linux 4.0 writing 5 resets the peak resident set size to the current value
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return clearRefs.good();
+#else
+    return false;
+#endif
+}
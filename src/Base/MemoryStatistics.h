@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef BASE_MEMORYSTATISTICS_H
+#define BASE_MEMORYSTATISTICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FC_GLOBAL_H
+# include <FCGlobal.h>
+#endif
+
+namespace Base
+{
+
+/**
+ * Memory usage of the running process.
+ *
+ * The resident set sizes are queried from the operating system and are 0 where this is not
+ * supported. Allocations are only counted if the executable replaces the global operator new and
+ * reports each call with countAllocation(), see FREECAD_COUNT_ALLOCATIONS.
+ */
+class BaseExport MemoryStatistics
+{
+public:
+    /// Current resident set size in bytes.
+    static std::size_t residentSize();
+    /// Peak resident set size in bytes since start or the last resetPeakResidentSize().
+    static std::size_t peakResidentSize();
+    /// Restarts tracking the peak resident set size. Returns false if this is not supported.
+    static bool resetPeakResidentSize();
+
+    static bool isCountingAllocations()
+    {
+        return countingAllocations.load(std::memory_order_relaxed);
+    }
+    static std::uint64_t allocationCount()
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+    static void countAllocation() noexcept
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    static void setCountingAllocations(bool on)
+    {
+        countingAllocations.store(on, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<std::uint64_t> allocations;
+    static std::atomic<bool> countingAllocations;
+};
+
+}  // namespace Base
+
+#endif  // BASE_MEMORYSTATISTICS_H
@@ -132,3 +132,18 @@
 # define TracyFiberEnterHint(x, y)
 # define TracyFiberLeave
 #endif
+
+// FC_PROFILE_COUNT(name, value) adds value to the running total plotted as name. The name must be
+// a string literal and value is not evaluated if the profiler is disabled.
+#ifdef TRACY_ENABLE
+# include <atomic>
+# include <cstdint>
+# define FC_PROFILE_COUNT(name, value)                                            \
+    do {                                                                          \
+        static std::atomic<int64_t> fcProfileCounter {0};                         \
+        int64_t fcProfileTotal = fcProfileCounter += static_cast<int64_t>(value); \
+        TracyPlot(name, fcProfileTotal);                                          \
+    } while (false)
+#else
+# define FC_PROFILE_COUNT(name, value)
+#endif
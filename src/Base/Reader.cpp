@@ -39,6 +39,7 @@
 #include "Exception.h"
 #include "InputSource.h"
 #include "Persistence.h"
+#include "Profiler.h"
 #include "Sequencer.h"
 #include "Stream.h"
 #include "XMLTools.h"
@@ -446,6 +447,8 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
     // up. In this case the associated GUI document asks for its file which is not part of the ZIP
     // file, then.
     // In either case it's guaranteed that the order of the files is kept.
+    ZoneScoped;
+
     zipios::ConstEntryPointer entry;
     try {
         entry = zipstream.getNextEntry();
@@ -468,6 +471,10 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // no file name for the current entry in the zip was registered.
         if (jt != FileList.end()) {
             try {
+                ZoneScopedN("RestoreDocFile");
+                ZoneText(jt->FileName.c_str(), jt->FileName.size());
+                FC_PROFILE_COUNT("Bytes read", entry->getSize());
+
                 Base::Reader reader(zipstream, jt->FileName, FileVersion);
                 jt->Object->RestoreDocFile(reader);
                 if (reader.getLocalReader()) {
@@ -23,8 +23,12 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <memory>
 #include <set>
+#include <string_view>
 #include <vector>
 #include <string>
 
@@ -38,11 +42,13 @@
 #include "Exception.h"
 #include "FileInfo.h"
 #include "Persistence.h"
+#include "Profiler.h"
 #include "Stream.h"
 #include "Tools.h"
 
 #include <boost/iostreams/filtering_stream.hpp>
 #include <zipios++/zipinputstream.h>
+#include <zlib.h>
 
 using namespace Base;
 
@@ -366,8 +372,246 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
     Writer::checkErrNo();
 }
 
+void ZipWriter::setParallelCompression(int threads)
+{
+    Threads = std::max(threads, 0);
+}
+
+void ZipWriter::setPreviousArchive(const std::string& fileName, const EntryIndex& index)
+{
+    PreviousArchive = fileName;
+    PreviousIndex = index;
+}
+
+namespace
+{
+
+struct CompressedEntry
+{
+    ZipWriter::EntryInfo info;
+    std::string data;
+};
+
+std::uint32_t computeCrc(const std::string& data)
+{
+    uLong crc = crc32(0, Z_NULL, 0);
+    const char* ptr = data.data();
+    std::size_t remaining = data.size();
+    while (remaining > 0) {
+        auto len = static_cast<uInt>(std::min<std::size_t>(remaining, 1 << 30));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(ptr), len);  // NOLINT
+        ptr += len;
+        remaining -= len;
+    }
+    return static_cast<std::uint32_t>(crc);
+}
+
+bool copyCompressed(const std::string& archive,
+                    const std::string& name,
+                    const ZipWriter::EntryInfo& info,
+                    std::string& out)
+{
+    // make sure the local header in front of the data is still the one that was written
+    const std::streamoff headerSize = 30;
+    std::streamoff headerOffset =
+        info.dataOffset - headerSize - static_cast<std::streamoff>(name.size());
+    if (headerOffset < 0) {
+        return false;
+    }
+
+    Base::ifstream file(Base::FileInfo(archive), std::ios::in | std::ios::binary);
+    std::string header(static_cast<std::size_t>(headerSize) + name.size(), '\0');
+    if (!file.seekg(headerOffset)
+        || !file.read(header.data(), static_cast<std::streamsize>(header.size()))) {
+        return false;
+    }
+
+    auto readUInt32 = [&header](std::size_t pos) {
+        auto byte = [&header](std::size_t index) {
+            return static_cast<std::uint32_t>(static_cast<unsigned char>(header[index]));
+        };
+        return byte(pos) | byte(pos + 1) << 8 | byte(pos + 2) << 16 | byte(pos + 3) << 24;
+    };
+    if (readUInt32(0) != 0x04034b50 || readUInt32(14) != info.crc
+        || readUInt32(18) != info.compressedSize
+        || header.compare(headerSize, name.size(), name) != 0) {
+        return false;
+    }
+
+    out.resize(info.compressedSize);
+    return static_cast<bool>(file.read(out.data(), info.compressedSize));
+}
+
+// zipios neither writes zip64 extra fields nor data descriptors, so the sizes of
+// an entry must fit into the 32 bit fields of the headers, 0xffffffff marks zip64
+constexpr std::size_t maxEntrySize = std::numeric_limits<std::uint32_t>::max() - 1;
+
+std::string deflateData(const std::string& data, int level)
+{
+    // raw deflate stream as written by zipios' DeflateOutputStreambuf
+    z_stream zs {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw Base::RuntimeError("Failed to initialize compression");
+    }
+
+    // avail_in and avail_out are only 32 bit wide, feed the data in chunks
+    constexpr std::size_t maxChunk = std::numeric_limits<uInt>::max();
+    std::string out;
+    out.resize(deflateBound(&zs, static_cast<uLong>(std::min(data.size(), maxChunk))));
+    std::size_t inPos = 0;
+    std::size_t outPos = 0;
+    int err = Z_OK;
+    while (err == Z_OK) {
+        if (zs.avail_in == 0 && inPos < data.size()) {
+            std::size_t len = std::min(data.size() - inPos, maxChunk);
+            zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data() + inPos));  // NOLINT
+            zs.avail_in = static_cast<uInt>(len);
+            inPos += len;
+        }
+        if (outPos == out.size()) {
+            out.resize(out.size() * 2);
+        }
+        std::size_t avail = std::min(out.size() - outPos, maxChunk);
+        zs.next_out = reinterpret_cast<Bytef*>(out.data() + outPos);  // NOLINT
+        zs.avail_out = static_cast<uInt>(avail);
+        err = deflate(&zs, inPos == data.size() ? Z_FINISH : Z_NO_FLUSH);
+        outPos += avail - zs.avail_out;
+    }
+    deflateEnd(&zs);
+    if (err != Z_STREAM_END) {
+        throw Base::RuntimeError("Failed to compress data");
+    }
+
+    out.resize(outPos);
+    return out;
+}
+
+CompressedEntry compressEntry(const std::string& name,
+                              const std::string& data,
+                              int level,
+                              const ZipWriter::EntryInfo* previous,
+                              const std::string& archive)
+{
+    ZoneScoped;
+    ZoneText(name.c_str(), name.size());
+
+    if (data.size() > maxEntrySize) {
+        throw Base::FileException("File too large for the project file", name);
+    }
+
+    CompressedEntry entry;
+    entry.info.hash = std::hash<std::string_view>()(data);
+    entry.info.crc = computeCrc(data);
+    entry.info.size = static_cast<std::uint32_t>(data.size());
+    entry.info.level = level;
+
+    // the content is unchanged since the last save, take its compressed data from there
+    if (previous && previous->hash == entry.info.hash && previous->crc == entry.info.crc
+        && previous->size == entry.info.size && previous->level == level
+        && copyCompressed(archive, name, *previous, entry.data)) {
+        entry.info.compressedSize = previous->compressedSize;
+        return entry;
+    }
+
+    entry.data = deflateData(data, level);
+    if (entry.data.size() > maxEntrySize) {
+        throw Base::FileException("Compressed file too large for the project file", name);
+    }
+    entry.info.compressedSize = static_cast<std::uint32_t>(entry.data.size());
+    return entry;
+}
+
+}  // namespace
+
+void ZipWriter::writeFilesParallel()
+{
+    ZoneScoped;
+
+    std::deque<std::pair<std::string, std::future<CompressedEntry>>> pending;
+    auto writeNext = [this, &pending]() {
+        auto& [name, result] = pending.front();
+        CompressedEntry entry = result.get();
+
+        zipios::ZipCDirEntry cdir(name);
+        cdir.setMethod(zipios::DEFLATED);
+        cdir.setCrc(entry.info.crc);
+        cdir.setSize(entry.info.size);
+        cdir.setCompressedSize(entry.info.compressedSize);
+        entry.info.dataOffset = ZipStream.putRawEntry(
+            cdir,
+            entry.data.data(),
+            static_cast<std::streamsize>(entry.data.size())
+        );
+        Writer::checkErrNo();
+
+        Index[name] = entry.info;
+        pending.pop_front();
+    };
+
+    // the files are serialized one after the other because SaveDocFile() may add
+    // new files, only the compression runs concurrently
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList[index];
+        auto data = std::make_shared<std::string>();
+        {
+            StringOStreambuf buf(*data);
+            std::ostream str(&buf);
+            str.imbue(ZipStream.getloc());
+            str.precision(ZipStream.precision());
+            str.flags(ZipStream.flags());
+
+            Writer::putNextEntry(entry.FileName.c_str());
+            indent = 0;
+            indBuf[0] = 0;
+            EntryStream = &str;
+            try {
+                ZoneScopedN("SaveDocFile");
+                ZoneText(entry.FileName.c_str(), entry.FileName.size());
+                entry.Object->SaveDocFile(*this);
+            }
+            catch (...) {
+                EntryStream = nullptr;
+                throw;
+            }
+            EntryStream = nullptr;
+        }
+
+        const EntryInfo* previous = nullptr;
+        auto it = PreviousIndex.find(entry.FileName);
+        if (!PreviousArchive.empty() && it != PreviousIndex.end()) {
+            previous = &it->second;
+        }
+        pending.emplace_back(
+            entry.FileName,
+            std::async(
+                std::launch::async,
+                [name = entry.FileName, data, level = Level, previous, this]() {
+                    return compressEntry(name, *data, level, previous, PreviousArchive);
+                }
+            )
+        );
+
+        if (pending.size() >= static_cast<size_t>(Threads)) {
+            writeNext();
+        }
+        index++;
+    }
+
+    while (!pending.empty()) {
+        writeNext();
+    }
+}
+
 void ZipWriter::writeFiles()
 {
+    if (Threads > 0) {
+        writeFilesParallel();
+        return;
+    }
+
+    ZoneScoped;
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
@@ -376,7 +620,11 @@ void ZipWriter::writeFiles()
         putNextEntry(entry.FileName.c_str());
         indent = 0;
         indBuf[0] = 0;
-        entry.Object->SaveDocFile(*this);
+        {
+            ZoneScopedN("SaveDocFile");
+            ZoneText(entry.FileName.c_str(), entry.FileName.size());
+            entry.Object->SaveDocFile(*this);
+        }
         index++;
     }
 }
@@ -25,6 +25,8 @@
 #pragma once
 
 
+#include <cstdint>
+#include <map>
 #include <set>
 #include <string>
 #include <sstream>
@@ -218,6 +220,20 @@ private:
 class BaseExport ZipWriter: public Writer
 {
 public:
+    /// Describes a file written by writeFiles() in parallel mode
+    struct EntryInfo
+    {
+        /// hash of the uncompressed content
+        std::size_t hash {0};
+        std::uint32_t crc {0};
+        std::uint32_t size {0};
+        std::uint32_t compressedSize {0};
+        /// offset of the compressed data in the archive
+        std::streamoff dataOffset {0};
+        int level {0};
+    };
+    using EntryIndex = std::map<std::string, EntryInfo>;
+
     explicit ZipWriter(const char* FileName);
     explicit ZipWriter(std::ostream&);
     ~ZipWriter() override;
@@ -226,11 +242,17 @@ public:
 
     std::ostream& Stream() override
     {
+        if (EntryStream) {
+            return *EntryStream;
+        }
         return ZipStream;
     }
 
     const std::ostream& Stream() const override
     {
+        if (EntryStream) {
+            return *EntryStream;
+        }
         return ZipStream;
     }
 
@@ -240,17 +262,44 @@ public:
     }
     void setLevel(int level)
     {
+        Level = level;
         ZipStream.setLevel(level);
     }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
+    /** Lets writeFiles() compress the files with up to \a threads threads.
+     * The files are still serialized one after the other, but into memory, and
+     * written to the archive in the order they were added. 0 switches back to
+     * compressing while serializing.
+     */
+    void setParallelCompression(int threads);
+    /** Sets an archive written before in parallel mode together with the
+     * index of its files. The compressed data of files whose content did not
+     * change is copied from there instead of being compressed again.
+     */
+    void setPreviousArchive(const std::string& fileName, const EntryIndex& index);
+    /// The index of the files written by writeFiles() in parallel mode
+    const EntryIndex& getEntryIndex() const
+    {
+        return Index;
+    }
+
     ZipWriter(const ZipWriter&) = delete;
     ZipWriter(ZipWriter&&) = delete;
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
+private:
+    void writeFilesParallel();
+
 private:
     zipios::ZipOutputStream ZipStream;
+    std::ostream* EntryStream {nullptr};
+    int Level {zipios::ZipOutputStreambuf::DEFAULT_COMPRESSION};
+    int Threads {0};
+    std::string PreviousArchive;
+    EntryIndex PreviousIndex;
+    EntryIndex Index;
 };
 
 /** The StringWriter class
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+// Replaces the global allocation functions to count the allocations made by the process. This
+// file is only built with FREECAD_COUNT_ALLOCATIONS because it adds an atomic increment to every
+// allocation. The counter is read with FreeCAD.getMemoryStatistics().
+//
+// On Windows each DLL keeps the allocation functions of its runtime, so only the allocations of
+// the executable itself are counted there.
+
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+# include <malloc.h>
+#endif
+
+#include <Base/MemoryStatistics.h>
+
+namespace
+{
+struct EnableCounting
+{
+    EnableCounting()
+    {
+        Base::MemoryStatistics::setCountingAllocations(true);
+    }
+} enableCounting;
+
+void* allocate(std::size_t size)
+{
+    Base::MemoryStatistics::countAllocation();
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t align)
+{
+    Base::MemoryStatistics::countAllocation();
+    auto alignment = static_cast<std::size_t>(align);
+    // aligned_alloc() requires the size to be a multiple of the alignment
+    size = size == 0 ? alignment : (size + alignment - 1) / alignment * alignment;
+    while (true) {
+#if defined(_WIN32)
+        void* ptr = _aligned_malloc(size, alignment);
+#else
+        void* ptr = std::aligned_alloc(alignment, size);
+#endif
+        if (ptr) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void freeAligned(void* ptr) noexcept
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept
+{
+    try {
+        return allocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*unused*/) noexcept
+{
+    try {
+        return allocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*unused*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*unused*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t& /*unused*/) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t& /*unused*/) noexcept
+{
+    std::free(ptr);
+}
+
+// The aligned overloads are used for types with an alignment above __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+// e.g. Eigen or SIMD types. Their memory must be released with the matching aligned delete.
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    return allocateAligned(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+    return allocateAligned(size, align);
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t& /*unused*/) noexcept
+{
+    try {
+        return allocateAligned(size, align);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t& /*unused*/) noexcept
+{
+    try {
+        return allocateAligned(size, align);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr, std::align_val_t /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*unused*/, std::align_val_t /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t /*unused*/, const std::nothrow_t& /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t /*unused*/, const std::nothrow_t& /*unused*/) noexcept
+{
+    freeAligned(ptr);
+}
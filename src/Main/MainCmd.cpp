@@ -30,14 +30,18 @@
 
 #include <Build/Version.h>  // For FCCopyrightYear
 
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <ostream>
+#include <thread>
 #include <QString>
 
 // FreeCAD Base header
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Interpreter.h>
+#include <Base/Profiler.h>
 
 // FreeCAD doc header
 #include <App/Application.h>
@@ -130,6 +134,19 @@ int main(int argc, char** argv)
         exit(101);
     }
 
+#ifdef TRACY_ENABLE
+    // In command line mode the work is usually done before a profiler has a chance to connect.
+    // FREECAD_TRACY_WAIT gives the number of seconds to wait for e.g. tracy-capture. Combine it
+    // with TRACY_NO_EXIT=1 so that the collected data is sent before the process exits.
+    if (const char* wait = getenv("FREECAD_TRACY_WAIT")) {
+        TracySetProgramName("FreeCADCmd");
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(std::atoi(wait));
+        while (!TracyIsConnected && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+#endif
+
     // Run phase ===========================================================
     try {
         Application::runApplication();
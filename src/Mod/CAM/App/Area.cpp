@@ -25,8 +25,10 @@
 // From Boost 1.75 on the geometry component requires C++14
 #define BOOST_GEOMETRY_DISABLE_DEPRECATED_03_WARNING
 
+#include <future>
 #include <limits>
 #include <optional>
+#include <thread>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/point.hpp>
@@ -39,6 +41,7 @@
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_Surface.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
@@ -1495,6 +1498,39 @@ static void showShapes(const T& shapes, const char* name, const char* fmt = null
     }
 }
 
+// Number of threads to build count sections with. The debug shapes shown in
+// trace mode are added to the document, so they force a single thread.
+static int countSectionThreads(long threads, std::size_t count)
+{
+    if (FC_LOG_INSTANCE.level() > FC_LOGLEVEL_TRACE) {
+        return 1;
+    }
+    long num = threads > 0 ? threads : long(std::thread::hardware_concurrency());
+    return int(std::max<long>(std::min<long>(num, long(count)), 1));
+}
+
+// calls func(i, thread) for i in [0, count), spread over the given number of
+// threads, which are numbered from 0 (the calling thread) to threads - 1
+template<class Func>
+static void forEachSection(std::size_t count, int threads, Func func)
+{
+    auto run = [&func, count, step = std::size_t(threads)](std::size_t first) {
+        // interleaved, because the cost of the sections changes with height
+        for (std::size_t i = first; i < count; i += step) {
+            func(i, int(first));
+        }
+    };
+    std::vector<std::future<void>> futures;
+    futures.reserve(threads);
+    for (int t = 1; t < threads; ++t) {
+        futures.push_back(std::async(std::launch::async, run, t));
+    }
+    run(0);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 template<class Func>
 static int foreachSubshape(
     const TopoDS_Shape& shape,
@@ -1896,7 +1932,36 @@ std::vector<shared_ptr<Area>> Area::makeSections(
     bool can_retry = fabs(tolerance) > Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for (size_t i = 0; i < heights.size(); ++i) {
+    const int numThreads = countSectionThreads(threads, heights.size());
+
+    // The solids are the same at all heights. Fix their tolerance once here,
+    // instead of at every height.
+    std::vector<std::vector<std::vector<TopoDS_Shape>>> solids(numThreads);
+    if (!project) {
+        solids[0].reserve(myShapes.size());
+        for (const Shape& s : myShapes) {
+            auto& shapes = solids[0].emplace_back();
+            for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
+                TopoDS_Shape shape(xp.Current());
+                ShapeFix_ShapeTolerance sTol;
+                sTol.SetTolerance(shape, Precision::Confusion());
+                shapes.push_back(shape);
+            }
+        }
+        // OCC algorithms may update the shapes they read, e.g. their pcurves,
+        // so each further thread slices its own deep copy of the solids
+        for (int t = 1; t < numThreads; ++t) {
+            for (const auto& shapes : solids[0]) {
+                auto& copies = solids[t].emplace_back();
+                for (const TopoDS_Shape& shape : shapes) {
+                    copies.push_back(BRepBuilderAPI_Copy(shape, Standard_True).Shape());
+                }
+            }
+        }
+    }
+
+    // returns the section at heights[i] made by the given thread, or null if it is empty
+    auto makeSection = [&](size_t i, int thread) -> shared_ptr<Area> {
         double z = heights[i];
         bool retried = !can_retry;
         while (true) {
@@ -1915,23 +1980,27 @@ std::vector<shared_ptr<Area>> Area::makeSections(
                     gp_Trsf t;
                     t.SetTranslation(gp_Vec(0, 0, -d));
                     TopLoc_Location wloc(t);
-                    area->add(s.shape.Moved(wloc).Moved(locInverse), s.op);
+                    const TopoDS_Shape& shape = s.shape.Moved(wloc).Moved(locInverse);
+                    if (numThreads > 1) {
+                        // the sections may be built on any thread later, so
+                        // they must not share the projected shapes
+                        area->add(BRepBuilderAPI_Copy(shape, Standard_True).Shape(), s.op);
+                    }
+                    else {
+                        area->add(shape, s.op);
+                    }
                 }
-                sections.push_back(area);
-                break;
+                return area;
             }
 
-            for (auto it = myShapes.begin(); it != myShapes.end(); ++it) {
+            size_t index = 0;
+            for (auto it = myShapes.begin(); it != myShapes.end(); ++it, ++index) {
                 const auto& s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
                 builder.MakeCompound(comp);
 
-                for (TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
-                    TopoDS_Shape shape(xp.Current());
-                    ShapeFix_ShapeTolerance sTol;
-                    sTol.SetTolerance(shape, Precision::Confusion());
-
+                for (const TopoDS_Shape& shape : solids[thread][index]) {
                     showShape(shape, nullptr, "section_%zu_shape", i);
                     std::list<TopoDS_Wire> wires;
                     Part::CrossSection section(a, b, c, shape);
@@ -2004,19 +2073,29 @@ std::vector<shared_ptr<Area>> Area::makeSections(
                 }
             }
             if (!area->myShapes.empty()) {
-                sections.push_back(area);
-                showShape(area->getShape(), nullptr, "section_%zu_final", i);
-                break;
+                // build the section here, so that its offset or pocket runs
+                // on the same thread as the slicing
+                const TopoDS_Shape& shape = area->getShape();
+                showShape(shape, nullptr, "section_%zu_final", i);
+                return area;
             }
             if (retried) {
                 AREA_WARN("Discard empty section");
-                break;
-            }
-            else {
-                AREA_TRACE("retry section " << z << "->" << z + tolerance);
-                z += tolerance;
-                retried = true;
+                return nullptr;
             }
+            AREA_TRACE("retry section " << z << "->" << z + tolerance);
+            z += tolerance;
+            retried = true;
+        }
+    };
+
+    std::vector<shared_ptr<Area>> results(heights.size());
+    forEachSection(heights.size(), numThreads, [&](size_t i, int thread) {
+        results[i] = makeSection(i, thread);
+    });
+    for (auto& area : results) {
+        if (area) {
+            sections.push_back(std::move(area));
         }
     }
     return sections;
@@ -2228,11 +2307,16 @@ TopoDS_Shape Area::toShape(CArea& area, short fill, int reorient)
             if (_index >= (int)mySections.size()) \
                 return TopoDS_Shape(); \
             if (_index < 0) { \
+                std::vector<TopoDS_Shape> shapes(mySections.size()); \
+                forEachSection( \
+                    mySections.size(), \
+                    countSectionThreads(myParams.SectionThreads, mySections.size()), \
+                    [&](size_t i, int) { shapes[i] = mySections[i]->_op(_index, ##__VA_ARGS__); } \
+                ); \
                 BRep_Builder builder; \
                 TopoDS_Compound compound; \
                 builder.MakeCompound(compound); \
-                for (shared_ptr<Area> area : mySections) { \
-                    const TopoDS_Shape& s = area->_op(_index, ##__VA_ARGS__); \
+                for (const TopoDS_Shape& s : shapes) { \
                     if (s.IsNull()) \
                         continue; \
                     builder.Add(compound, s); \
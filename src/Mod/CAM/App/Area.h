@@ -264,8 +264,10 @@ public:
      * \arg \c plane: the section plane if the section mode is
      * SectionModeWorkplane, otherwise ignored
      *
-     * See #AREA_PARAMS_EXTRA for description of the arguments. Currently, there
-     * is only one argument, namely \c mode for section mode.
+     * See #AREA_PARAMS_SECTION_EXTRA for description of the arguments, namely
+     * \c mode for section mode, \c project and \c threads. With more than one
+     * thread, the sections are sliced and built concurrently, and returned in
+     * the same order as serially.
      */
     std::vector<std::shared_ptr<Area>> makeSections(
         PARAM_ARGS_DEF(PARAM_FARG, AREA_PARAMS_SECTION_EXTRA),
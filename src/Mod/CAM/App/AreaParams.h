@@ -231,7 +231,13 @@
          Project, \
          false, \
          "The section is produced by normal projecting the outline\n" \
-         "of all added shapes to the section plane, instead of slicing.") \
+         "of all added shapes to the section plane, instead of slicing."))( \
+        (long, \
+         threads, \
+         SectionThreads, \
+         1, \
+         "Number of threads used to slice the sections and to build their offset or pocket.\n" \
+         "0 means one thread per available core, 1 builds the sections one after another.") \
     )
 
 /** Section parameters */
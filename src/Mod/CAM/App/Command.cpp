@@ -21,7 +21,6 @@
  *                                                                         *
  ***************************************************************************/
 
-#include <cinttypes>
 #include <iomanip>
 #include <boost/algorithm/string.hpp>
 
@@ -32,6 +31,7 @@
 #include <Base/Writer.h>
 
 #include "Command.h"
+#include "GCode.h"
 
 
 using namespace Base;
@@ -106,167 +106,14 @@ bool Command::has(const std::string& attr) const
 
 std::string Command::toGCode(int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
-    if (precision < 0) {
-        precision = 0;
-    }
-    double scale = std::pow(10.0, precision + 1);
-    std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin(); i != Parameters.end();
-         ++i) {
-        if (i->first == "N") {
-            continue;
-        }
-
-        str << " " << i->first;
-
-        std::int64_t v = static_cast<std::int64_t>(i->second * scale);
-        if (v < 0) {
-            v = -v;
-            str << '-';  // shall we allow -0 ?
-        }
-        v += 5;
-        v /= 10;
-        str << (v / iscale);
-        if (!precision) {
-            continue;
-        }
-
-        int width = precision;
-        std::int64_t digits = v % iscale;
-        if (!padzero) {
-            if (!digits) {
-                continue;
-            }
-            while (digits % 10 == 0) {
-                digits /= 10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
-    }
-
-    // Add annotations as a comment if they exist
-    if (!Annotations.empty()) {
-        str << "; ";
-        bool first = true;
-        for (const auto& pair : Annotations) {
-            if (!first) {
-                str << " ";
-            }
-            first = false;
-            str << pair.first << ":";
-            if (std::holds_alternative<std::string>(pair.second)) {
-                str << "'" << std::get<std::string>(pair.second) << "'";
-            }
-            else if (std::holds_alternative<double>(pair.second)) {
-                std::ostringstream oss;
-                oss << std::fixed << std::setprecision(6) << std::get<double>(pair.second);
-                str << oss.str();
-            }
-        }
-    }
-
-    return str.str();
+    std::string result;
+    GCode::appendCommand(result, *this, precision, padzero);
+    return result;
 }
 
 void Command::setFromGCode(const std::string& str)
 {
-    Parameters.clear();
-    Annotations.clear();
-
-    // Check for annotation comment and split the string
-    std::string gcode_part = str;
-    std::string annotation_part;
-
-    auto comment_pos = str.find("; ");
-    if (comment_pos != std::string::npos) {
-        gcode_part = str.substr(0, comment_pos);
-        annotation_part = str.substr(comment_pos + 1);  // length of "; "
-    }
-
-    std::string mode = "none";
-    std::string key;
-    std::string value;
-    for (unsigned int i = 0; i < gcode_part.size(); i++) {
-        if ((isdigit(gcode_part[i])) || (gcode_part[i] == '-') || (gcode_part[i] == '.')
-            || ((gcode_part[i] == 'e') && (i > 0) && (isdigit(gcode_part[i - 1])))) {
-            value += gcode_part[i];
-        }
-        else if (isalpha(gcode_part[i])) {
-            if (mode == "command") {
-                if (!key.empty() && !value.empty()) {
-                    std::string cmd = key + value;
-                    boost::to_upper(cmd);
-                    Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
-                }
-                else {
-                    throw Base::BadFormatError("Badly formatted GCode command");
-                }
-                mode = "argument";
-            }
-            else if (mode == "none") {
-                mode = "command";
-            }
-            else if (mode == "argument") {
-                if (!key.empty() && !value.empty()) {
-                    double val = std::atof(value.c_str());
-                    boost::to_upper(key);
-                    Parameters[key] = val;
-                    key = "";
-                    value = "";
-                }
-                else {
-                    throw Base::BadFormatError("Badly formatted GCode argument");
-                }
-            }
-            else if (mode == "comment") {
-                value += gcode_part[i];
-            }
-            key = gcode_part[i];
-        }
-        else if (gcode_part[i] == '(') {
-            mode = "comment";
-        }
-        else if (gcode_part[i] == ')') {
-            key = "(";
-            value += ")";
-        }
-        else {
-            // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += gcode_part[i];
-            }
-        }
-    }
-
-    // Parse annotations if found
-    if (!annotation_part.empty()) {
-        setAnnotations(annotation_part);
-    }
-
-    if (!key.empty() && !value.empty()) {
-        if ((mode == "command") || (mode == "comment")) {
-            std::string cmd = key + value;
-            if (mode == "command") {
-                boost::to_upper(cmd);
-            }
-            Name = cmd;
-        }
-        else {
-            double val = std::atof(value.c_str());
-            boost::to_upper(key);
-            Parameters[key] = val;
-        }
-    }
-    else {
-        throw Base::BadFormatError("Badly formatted GCode argument");
-    }
+    GCode::parseCommand(str, *this);
 }
 
 void Command::setFromPlacement(const Base::Placement& plac)
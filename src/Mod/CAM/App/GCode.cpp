@@ -0,0 +1,565 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <memory>
+#include <thread>
+
+#include <Base/Exception.h>
+
+#include "GCode.h"
+
+
+using namespace Path;
+
+namespace
+{
+// below these sizes per thread starting the threads costs more than it saves
+constexpr std::size_t MinBytesPerThread = 1 << 20;
+constexpr std::size_t MinCommandsPerThread = 1 << 15;
+
+int countThreads(int threads, std::size_t size, std::size_t minPerThread)
+{
+    int num = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    auto limit = static_cast<int>(std::min<std::size_t>(size / minPerThread, 256));
+    return std::max(std::min(num, limit), 1);
+}
+
+// calls func(chunk) for every chunk, each chunk in its own thread
+template<class Func>
+void forEachChunk(std::size_t chunks, Func func)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks);
+    for (std::size_t i = 1; i < chunks; i++) {
+        futures.push_back(std::async(std::launch::async, [&func, i]() { func(i); }));
+    }
+    func(0);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+// the parser only accepts ASCII, independent of the locale
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isAlpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+char toUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// digits, signs, decimal points and exponents after a digit
+bool isNumber(std::string_view text, std::size_t pos)
+{
+    char c = text[pos];
+    return isDigit(c) || c == '-' || c == '.' || (c == 'e' && pos > 0 && isDigit(text[pos - 1]));
+}
+
+bool isCommandStart(char c)
+{
+    return c == 'G' || c == 'g' || c == 'M' || c == 'm';
+}
+
+// like std::atof() the longest valid prefix is converted and no valid prefix gives 0
+double toDouble(const std::string& value)
+{
+    double result = 0.0;
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec == std::errc::result_out_of_range) {
+        result = std::strtod(value.c_str(), nullptr);
+    }
+    return result;
+}
+
+void setName(Command& cmd, char key, const std::string& value, bool upper)
+{
+    cmd.Name.assign(1, key);
+    cmd.Name += value;
+    if (upper) {
+        std::transform(cmd.Name.begin(), cmd.Name.end(), cmd.Name.begin(), toUpper);
+    }
+}
+
+void appendNumber(std::string& out, std::int64_t value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+struct Chunk
+{
+    std::vector<Command*> commands;
+    std::exception_ptr error;
+    // the chunk ends inside a comment
+    bool openComment = false;
+};
+
+void deleteCommands(std::vector<Chunk>& chunks)
+{
+    for (auto& chunk : chunks) {
+        for (auto* cmd : chunk.commands) {
+            delete cmd;
+        }
+        chunk.commands.clear();
+    }
+}
+
+/*
+ * Splits the text at every G or M word and every comment. Text in front of the first command and
+ * between a comment and the next command is skipped. An annotation after a command or a comment
+ * belongs to it up to the end of the line, so that any output of appendCommand() is read back.
+ */
+void splitProgram(std::string_view text, Chunk& chunk)
+{
+    constexpr std::size_t none = std::string_view::npos;
+    auto add = [&](std::size_t first, std::size_t last) {
+        auto cmd = std::make_unique<Command>();
+        GCode::parseCommand(text.substr(first, last - first), *cmd);
+        chunk.commands.push_back(cmd.release());
+    };
+    auto endOfLine = [&](std::size_t pos) {
+        return std::min(text.find('\n', pos), text.size());
+    };
+    auto isAnnotation = [&](std::size_t pos) {
+        return pos + 1 < text.size() && text[pos] == ';' && text[pos + 1] == ' ';
+    };
+
+    std::size_t last = none;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '(') {
+            if (last != none) {
+                add(last, pos);
+                last = none;
+            }
+            std::size_t close = text.find(')', pos + 1);
+            if (close == none) {
+                chunk.openComment = true;
+                return;
+            }
+            std::size_t end = isAnnotation(close + 1) ? endOfLine(close + 1) : close + 1;
+            add(pos, end);
+            pos = end;
+        }
+        else if (isCommandStart(c)) {
+            if (last != none) {
+                add(last, pos);
+            }
+            last = pos++;
+        }
+        else if (last != none && isAnnotation(pos)) {
+            pos = endOfLine(pos);
+        }
+        else {
+            pos++;
+        }
+    }
+    if (last != none) {
+        add(last, text.size());
+    }
+}
+
+/*
+ * Returns the first G or M word at the start of a line after pos, apart from leading text that
+ * cannot open a comment or an annotation. All text before it belongs to the commands in front of
+ * it unless a comment is still open, which the caller has to check.
+ */
+std::size_t findChunkStart(std::string_view text, std::size_t pos)
+{
+    bool lineStart = false;
+    for (pos = text.find('\n', pos); pos < text.size(); pos++) {
+        char c = text[pos];
+        if (c == '\n') {
+            lineStart = true;
+        }
+        else if (lineStart && isCommandStart(c)) {
+            return pos;
+        }
+        else if (c == '(' || c == ';') {
+            lineStart = false;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// removes G20 and G21 and scales the commands given in inches
+void applyUnits(std::vector<Command*>& commands, bool inches)
+{
+    auto out = commands.begin();
+    for (auto* cmd : commands) {
+        if (cmd->Name == "G20") {
+            inches = true;
+            delete cmd;
+        }
+        else if (cmd->Name == "G21") {
+            inches = false;
+            delete cmd;
+        }
+        else {
+            if (inches) {
+                cmd->scaleBy(25.4);
+            }
+            *out++ = cmd;
+        }
+    }
+    commands.erase(out, commands.end());
+}
+
+std::vector<Command*> joinChunks(std::vector<Chunk>& chunks)
+{
+    std::size_t size = 0;
+    for (const auto& chunk : chunks) {
+        size += chunk.commands.size();
+    }
+    std::vector<Command*> commands;
+    commands.reserve(size);
+    for (auto& chunk : chunks) {
+        commands.insert(commands.end(), chunk.commands.begin(), chunk.commands.end());
+        chunk.commands.clear();
+    }
+    return commands;
+}
+}  // namespace
+
+void GCode::parseCommand(std::string_view gcode, Command& cmd)
+{
+    cmd.Parameters.clear();
+    cmd.Annotations.clear();
+
+    std::string_view annotations;
+    auto pos = gcode.find("; ");
+    if (pos != std::string_view::npos) {
+        annotations = gcode.substr(pos + 1);
+        gcode = gcode.substr(0, pos);
+    }
+
+    enum class Mode
+    {
+        None,
+        Command,
+        Argument,
+        Comment
+    };
+
+    Mode mode = Mode::None;
+    char key = 0;
+    // numbers are short enough not to allocate memory
+    std::string value;
+    for (std::size_t i = 0; i < gcode.size(); i++) {
+        char c = gcode[i];
+        if (isNumber(gcode, i)) {
+            // append the whole number at once
+            std::size_t first = i;
+            while (i + 1 < gcode.size() && isNumber(gcode, i + 1)) {
+                i++;
+            }
+            value.append(gcode.substr(first, i + 1 - first));
+        }
+        else if (isAlpha(c)) {
+            switch (mode) {
+                case Mode::None:
+                    mode = Mode::Command;
+                    break;
+                case Mode::Command:
+                    if (key == 0 || value.empty()) {
+                        throw Base::BadFormatError("Badly formatted GCode command");
+                    }
+                    setName(cmd, key, value, true);
+                    value.clear();
+                    mode = Mode::Argument;
+                    break;
+                case Mode::Argument:
+                    if (key == 0 || value.empty()) {
+                        throw Base::BadFormatError("Badly formatted GCode argument");
+                    }
+                    cmd.Parameters[std::string(1, toUpper(key))] = toDouble(value);
+                    value.clear();
+                    break;
+                case Mode::Comment:
+                    value += c;
+                    break;
+            }
+            key = c;
+        }
+        else if (c == '(') {
+            mode = Mode::Comment;
+        }
+        else if (c == ')') {
+            key = '(';
+            value += ')';
+        }
+        else if (mode == Mode::Comment) {
+            // other characters only matter in a comment
+            value += c;
+        }
+    }
+
+    if (!annotations.empty()) {
+        cmd.setAnnotations(std::string(annotations));
+    }
+
+    if (key == 0 || value.empty()) {
+        throw Base::BadFormatError("Badly formatted GCode argument");
+    }
+    if (mode == Mode::Command || mode == Mode::Comment) {
+        setName(cmd, key, value, mode == Mode::Command);
+    }
+    else {
+        cmd.Parameters[std::string(1, toUpper(key))] = toDouble(value);
+    }
+}
+
+std::vector<Command*> GCode::parseProgram(std::string_view gcode, int threads)
+{
+    int num = countThreads(threads, gcode.size(), MinBytesPerThread);
+    std::vector<std::size_t> starts {0};
+    for (int i = 1; i < num; i++) {
+        std::size_t pos = std::max(starts.back(), gcode.size() * i / num);
+        pos = findChunkStart(gcode, pos);
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        starts.push_back(pos);
+    }
+    starts.push_back(gcode.size());
+
+    std::vector<Chunk> chunks(starts.size() - 1);
+    forEachChunk(chunks.size(), [&](std::size_t i) {
+        try {
+            splitProgram(gcode.substr(starts[i], starts[i + 1] - starts[i]), chunks[i]);
+        }
+        catch (...) {
+            chunks[i].error = std::current_exception();
+        }
+    });
+
+    // a chunk is only parsed correctly if all chunks in front of it are complete
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        if (chunks[i].error) {
+            deleteCommands(chunks);
+            std::rethrow_exception(chunks[i].error);
+        }
+        if (chunks[i].openComment && i + 1 < chunks.size()) {
+            // a comment spans several chunks, which is rare enough to start over in one go
+            deleteCommands(chunks);
+            chunks.resize(1);
+            chunks[0] = Chunk();
+            try {
+                splitProgram(gcode, chunks[0]);
+            }
+            catch (...) {
+                deleteCommands(chunks);
+                throw;
+            }
+            break;
+        }
+    }
+
+    // the units are modal, so the units at the start of each chunk are needed first
+    std::vector<char> inches(chunks.size(), 0);
+    for (std::size_t i = 0; i + 1 < chunks.size(); i++) {
+        inches[i + 1] = inches[i];
+        for (const auto* cmd : chunks[i].commands) {
+            if (cmd->Name == "G20") {
+                inches[i + 1] = 1;
+            }
+            else if (cmd->Name == "G21") {
+                inches[i + 1] = 0;
+            }
+        }
+    }
+    forEachChunk(chunks.size(), [&](std::size_t i) {
+        applyUnits(chunks[i].commands, inches[i] != 0);
+    });
+
+    return joinChunks(chunks);
+}
+
+std::vector<Command*> GCode::parseLines(std::string_view gcode, int threads)
+{
+    int num = countThreads(threads, gcode.size(), MinBytesPerThread);
+    std::vector<std::size_t> starts {0};
+    for (int i = 1; i < num; i++) {
+        std::size_t pos = std::max(starts.back(), gcode.size() * i / num);
+        pos = gcode.find('\n', pos);
+        if (pos == std::string_view::npos) {
+            break;
+        }
+        starts.push_back(pos + 1);
+    }
+    starts.push_back(gcode.size());
+
+    std::vector<Chunk> chunks(starts.size() - 1);
+    forEachChunk(chunks.size(), [&](std::size_t i) {
+        try {
+            std::string_view text = gcode.substr(starts[i], starts[i + 1] - starts[i]);
+            while (!text.empty()) {
+                std::size_t end = std::min(text.find('\n'), text.size());
+                if (end > 0) {
+                    auto cmd = std::make_unique<Command>();
+                    parseCommand(text.substr(0, end), *cmd);
+                    chunks[i].commands.push_back(cmd.release());
+                }
+                text.remove_prefix(std::min(end + 1, text.size()));
+            }
+        }
+        catch (...) {
+            chunks[i].error = std::current_exception();
+        }
+    });
+
+    for (auto& chunk : chunks) {
+        if (chunk.error) {
+            deleteCommands(chunks);
+            std::rethrow_exception(chunk.error);
+        }
+    }
+    return joinChunks(chunks);
+}
+
+void GCode::appendCommand(std::string& out, const Command& cmd, int precision, bool padzero)
+{
+    out += cmd.Name;
+    if (precision < 0) {
+        precision = 0;
+    }
+
+    // the values are rounded in integer arithmetic to the given number of decimals
+    double scale = std::pow(10.0, precision + 1);
+    std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
+    for (const auto& [key, value] : cmd.Parameters) {
+        if (key == "N") {
+            continue;
+        }
+
+        out += ' ';
+        out += key;
+
+        auto v = static_cast<std::int64_t>(value * scale);
+        if (v < 0) {
+            v = -v;
+            out += '-';
+        }
+        v = (v + 5) / 10;
+        appendNumber(out, v / iscale);
+        if (!precision) {
+            continue;
+        }
+
+        int width = precision;
+        std::int64_t digits = v % iscale;
+        if (!padzero) {
+            if (!digits) {
+                continue;
+            }
+            while (digits % 10 == 0) {
+                digits /= 10;
+                --width;
+            }
+        }
+        out += '.';
+        std::size_t size = out.size();
+        appendNumber(out, digits);
+        std::size_t length = out.size() - size;
+        if (length < std::size_t(width)) {
+            out.insert(size, std::size_t(width) - length, '0');
+        }
+    }
+
+    // annotations follow as a comment
+    if (!cmd.Annotations.empty()) {
+        out += "; ";
+        bool first = true;
+        for (const auto& [key, value] : cmd.Annotations) {
+            if (!first) {
+                out += ' ';
+            }
+            first = false;
+            out += key;
+            out += ':';
+            if (std::holds_alternative<std::string>(value)) {
+                out += '\'';
+                out += std::get<std::string>(value);
+                out += '\'';
+            }
+            else {
+                char buffer[512];
+                auto result = std::to_chars(
+                    buffer,
+                    buffer + sizeof(buffer),
+                    std::get<double>(value),
+                    std::chars_format::fixed,
+                    6
+                );
+                out.append(buffer, result.ptr);
+            }
+        }
+    }
+}
+
+std::string GCode::writeProgram(const std::vector<Command*>& commands, int threads)
+{
+    std::size_t num = countThreads(threads, commands.size(), MinCommandsPerThread);
+    std::vector<std::string> parts(num);
+    forEachChunk(num, [&](std::size_t i) {
+        std::size_t begin = commands.size() * i / num;
+        std::size_t end = commands.size() * (i + 1) / num;
+        std::string& out = parts[i];
+        // a typical line is a few dozen characters
+        out.reserve((end - begin) * 32);
+        for (std::size_t j = begin; j < end; j++) {
+            appendCommand(out, *commands[j]);
+            out += '\n';
+        }
+    });
+
+    if (num == 1) {
+        return std::move(parts[0]);
+    }
+
+    std::size_t size = 0;
+    for (const auto& it : parts) {
+        size += it.size();
+    }
+    std::string result;
+    result.reserve(size);
+    for (const auto& it : parts) {
+        result += it;
+    }
+    return result;
+}
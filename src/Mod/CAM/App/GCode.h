@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Command.h"
+
+
+namespace Path
+{
+
+/**
+ * Reading and writing of G-code text.
+ *
+ * The parser works on views of the input and doesn't copy the commands out of it before they
+ * are tokenized. Large inputs are split into chunks at the start of a line and the chunks are
+ * parsed in parallel, the result is the same as if the input was parsed in one go. The writer
+ * formats the numbers without streams, large paths are written in parallel as well.
+ *
+ * The number of threads defaults to the number of cores, 1 disables the parallel processing.
+ */
+namespace GCode
+{
+
+/// Sets the name, parameters and annotations of \a cmd from a single command.
+PathExport void parseCommand(std::string_view gcode, Command& cmd);
+
+/**
+ * Splits a program into commands at every G or M word and every comment. G20 and G21 are not
+ * added but switch the units, commands in inches are scaled to millimeters. The caller takes
+ * ownership of the commands.
+ */
+PathExport std::vector<Command*> parseProgram(std::string_view gcode, int threads = 0);
+
+/**
+ * Parses one command per non-empty line, as written by writeProgram(). The caller takes
+ * ownership of the commands.
+ */
+PathExport std::vector<Command*> parseLines(std::string_view gcode, int threads = 0);
+
+/// Appends the G-code of \a cmd, including its annotations, to \a out.
+PathExport void appendCommand(
+    std::string& out,
+    const Command& cmd,
+    int precision = 6,
+    bool padzero = true
+);
+
+/// Returns the G-code of all commands, one per line.
+PathExport std::string writeProgram(const std::vector<Command*>& commands, int threads = 0);
+
+}  // namespace GCode
+
+}  // namespace Path
@@ -22,6 +22,8 @@
  ***************************************************************************/
 
 
+#include <iterator>
+
 #include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -29,6 +31,7 @@
 #include <Base/Writer.h>
 #include <Mod/CAM/App/PathSegmentWalker.h>
 
+#include "GCode.h"
 #include "Path.h"
 
 
@@ -313,94 +316,20 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void bulkAddCommand(const std::string& gcodestr, std::vector<Command*>& commands, bool& inches)
-{
-    Command* cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    }
-    else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    }
-    else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
-}
-
 void Toolpath::setFromGCode(const std::string instr)
 {
     clear();
-
-    // remove comments
-    // boost::regex e("\\(.*?\\)");
-    // std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
-
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos) {
-        if (str[found] == '(') {
-            // start of comment
-            if ((last > -1) && (mode == "command")) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(')', found + 1);
-        }
-        else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found - last + 1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found + 1);
-            mode = "command";
-        }
-        else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            last = found;
-            found = str.find_first_of("(gGmM", found + 1);
-        }
-    }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last, std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-        }
-    }
+    vpcCommands = GCode::parseProgram(instr);
     recalculate();
 }
 
 std::string Toolpath::toGCode() const
 {
-    std::string result;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        result += (*it)->toGCode();
-        result += "\n";
-    }
-    return result;
+    return GCode::writeProgram(vpcCommands);
 }
 
 void Toolpath::recalculate()  // recalculates the path cache
 {
-
     if (vpcCommands.empty()) {
         return;
     }
@@ -506,7 +435,7 @@ void Toolpath::Save(Writer& writer) const
 
 void Toolpath::SaveDocFile(Base::Writer& writer) const
 {
-    if (toGCode().empty()) {
+    if (vpcCommands.empty()) {
         return;
     }
     writer.Stream() << toGCode();
@@ -546,13 +475,9 @@ void Toolpath::addCommandNoRecalc(const Command& Cmd)
 
 void Toolpath::RestoreDocFile(Base::Reader& reader)
 {
-    std::string line;
-    while (std::getline(reader.getStream(), line)) {
-        if (!line.empty()) {
-            Command cmd;
-            cmd.setFromGCode(line);
-            addCommandNoRecalc(cmd);
-        }
-    }
+    // one command per line, see SaveDocFile()
+    std::string gcode {std::istreambuf_iterator<char>(reader.getStream()), {}};
+    std::vector<Command*> commands = GCode::parseLines(gcode);
+    vpcCommands.insert(vpcCommands.end(), commands.begin(), commands.end());
     recalculate();  // Only once, after all commands are loaded
 }
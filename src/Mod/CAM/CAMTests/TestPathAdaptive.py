@@ -199,6 +199,14 @@ class TestPathAdaptive(PathTestBase):
 
     def _executeAdaptive(self, opType, stockPath2d, path2d, clearedArea=None, **kwargs):
         """Create, configure, execute Adaptive2d and return total cleared area."""
+        results, a2d = self._runAdaptive(opType, stockPath2d, path2d, clearedArea, **kwargs)
+
+        # Return total cleared area and the configured instance
+        total_cleared = sum(r.ClearedArea for r in results)
+        return total_cleared, a2d
+
+    def _runAdaptive(self, opType, stockPath2d, path2d, clearedArea=None, **kwargs):
+        """Create, configure, execute Adaptive2d and return the results per region."""
         if clearedArea is None:
             clearedArea = []
 
@@ -213,6 +221,8 @@ class TestPathAdaptive(PathTestBase):
         a2d.forceInsideOut = kwargs.get("forceInsideOut", False)
         a2d.finishingProfile = kwargs.get("finishingProfile", True)
         a2d.keepToolDownDistRatio = kwargs.get("keepToolDownDistRatio", 3.0)
+        a2d.maxThreads = kwargs.get("maxThreads", 1)
+        a2d.tiledClearedArea = kwargs.get("tiledClearedArea", True)
         a2d.opType = opType
 
         # Create progress callback for visualization
@@ -228,9 +238,17 @@ class TestPathAdaptive(PathTestBase):
         for result in results:
             self.checkAdaptiveErrors(result)
 
-        # Return total cleared area and the configured instance
-        total_cleared = sum(r.ClearedArea for r in results)
-        return total_cleared, a2d
+        return results, a2d
+
+    def _createSeparateRegionsGeometry(self):
+        """Create stock with three separate rectangular pockets, which are separate regions."""
+        stockPath2d = [[[-5.0, -5.0], [85.0, -5.0], [85.0, 85.0], [-5.0, 85.0]]]
+        path2d = [
+            [[0.0, 0.0], [30.0, 0.0], [30.0, 30.0], [0.0, 30.0]],
+            [[50.0, 0.0], [80.0, 0.0], [80.0, 30.0], [50.0, 30.0]],
+            [[0.0, 50.0], [30.0, 50.0], [30.0, 80.0], [0.0, 80.0]],
+        ]
+        return stockPath2d, path2d
 
     def _calculateCornerUnclearableArea(self, tool_diameter):
         """Calculate unclearable area in a single corner due to circular tool."""
@@ -339,6 +357,69 @@ class TestPathAdaptive(PathTestBase):
             msg=f"Total cleared area {total_cleared} should be within {delta} of {expected_area}",
         )
 
+    def testClearInsideThreads(self):
+        """testClearInsideThreads() Test C++ Adaptive2d paths do not depend on the thread count."""
+        stockPath2d, path2d = self._createSeparateRegionsGeometry()
+
+        serial, _ = self._runAdaptive(
+            area.AdaptiveOperationType.ClearingInside, stockPath2d, path2d, maxThreads=1
+        )
+        parallel, _ = self._runAdaptive(
+            area.AdaptiveOperationType.ClearingInside, stockPath2d, path2d, maxThreads=3
+        )
+
+        # the regions are processed in parallel, but returned in the same order
+        self.assertEqual(len(serial), 3)
+        self.assertEqual(len(parallel), len(serial))
+        for r1, r2 in zip(serial, parallel):
+            self.assertEqual(r1.HelixCenterPoint, r2.HelixCenterPoint)
+            self.assertEqual(r1.StartPoint, r2.StartPoint)
+            self.assertEqual(r1.ReturnMotionType, r2.ReturnMotionType)
+            self.assertEqual(r1.ClearedArea, r2.ClearedArea)
+            self.assertEqual(r1.AdaptivePaths, r2.AdaptivePaths)
+
+    def testClearInsideTiledClearedArea(self):
+        """testClearInsideTiledClearedArea() Test C++ Adaptive2d with and without tiles."""
+        stockPath2d, path2d = self._createSeparateRegionsGeometry()
+        # Pre-cleared strip over the bottom 5 mm of the top left pocket
+        clearedArea = [[[-5.0, 45.0], [40.0, 45.0], [40.0, 55.0], [-5.0, 55.0]]]
+
+        tiled, a2d = self._runAdaptive(
+            area.AdaptiveOperationType.ClearingInside,
+            stockPath2d,
+            path2d,
+            clearedArea,
+            tiledClearedArea=True,
+        )
+        untiled, _ = self._runAdaptive(
+            area.AdaptiveOperationType.ClearingInside,
+            stockPath2d,
+            path2d,
+            clearedArea,
+            tiledClearedArea=False,
+        )
+
+        # The tiles keep a few more vertices at their borders, so the paths may differ slightly,
+        # but the cleared area must not
+        self.assertEqual(len(tiled), 3)
+        self.assertEqual(len(untiled), len(tiled))
+        for r1, r2 in zip(tiled, untiled):
+            self.assertAlmostEqual(r1.ClearedArea, r2.ClearedArea, delta=0.1)
+
+        # 2 corners of the top left pocket are in the pre-cleared area
+        corner_unclearable_area = self._calculateCornerUnclearableArea(a2d.toolDiameter)
+        pocket_area = 30.0 * 30.0 - 4 * corner_unclearable_area
+        overlapped_area = pocket_area - 30.0 * 5.0 + 2 * corner_unclearable_area
+        expected_areas = [overlapped_area, pocket_area, pocket_area]
+        delta = corner_unclearable_area / 2.0
+        for cleared, expected_area in zip(sorted(r.ClearedArea for r in tiled), expected_areas):
+            self.assertAlmostEqual(
+                cleared,
+                expected_area,
+                delta=delta,
+                msg=f"Cleared area {cleared} should be within {delta} of {expected_area}",
+            )
+
     def testClearOutside(self):
         """testClearOutside() Test C++ Adaptive2d clearing outside a simple rectangle."""
         # Create geometry
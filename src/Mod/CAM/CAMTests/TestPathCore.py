@@ -22,6 +22,7 @@
 # ***************************************************************************
 
 import FreeCAD
+import math
 import Path
 from CAMTests.PathTestUtils import PathTestBase
 
@@ -139,3 +140,33 @@ G0 Z0.500000
         path = Path.Path(commands)
 
         self.assertEqual(path.Length, 2)
+
+    def test51(self):
+        """Test Path.Length with arcs and after modifying the commands"""
+        commands = []
+        commands.append(Path.Command("G1", {"X": 1}))
+        commands.append(Path.Command("G2", {"X": 3, "I": 1, "J": 0}))
+        commands.append(Path.Command("G0", {"Z": 5}))
+        path = Path.Path(commands)
+
+        self.assertAlmostEqual(path.Length, 6 + math.pi, places=4)
+
+        path.deleteCommand(1)
+        self.assertAlmostEqual(path.Length, 6, places=4)
+
+        path.addCommands(Path.Command("G1", {"X": 1, "Y": 2}))
+        self.assertAlmostEqual(path.Length, 8, places=4)
+
+    def test60(self):
+        """Test reading back the gcode of a path with annotations"""
+        c1 = Path.Command("G1", {"X": 1.5, "Y": -2}, {"operation": "milling", "depth": 2.5})
+        c2 = Path.Command("(Mill the pocket)", {}, {"tool": "6mm"})
+        c3 = Path.Command("M3", {"S": 1000})
+        path = Path.Path([c1, c2, c3])
+
+        restored = Path.Path(path.toGCode())
+        self.assertEqual(len(restored.Commands), 3)
+        self.assertEqual(restored.toGCode(), path.toGCode())
+        self.assertEqual(restored.Commands[0].Annotations, {"operation": "milling", "depth": 2.5})
+        self.assertEqual(restored.Commands[1].Name, "(Mill the pocket)")
+        self.assertEqual(restored.Commands[1].Annotations, {"tool": "6mm"})
@@ -0,0 +1,838 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <numbers>
+#include <thread>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <Base/Exception.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+#include "DexelSim.h"
+
+
+using std::numbers::pi;
+
+namespace
+{
+// edge length of the blocks of the surface cache in grid cells
+constexpr int BlockSize = 16;
+// number of neighbouring rows of dexels processed by the same thread
+constexpr int RowChunk = 4;
+// below this number of ray intersections per thread starting the threads costs more than it saves
+constexpr std::size_t MinWorkPerThread = 20000;
+
+// Pool for the chunks of a move or a tessellation. It is not shared with other code, so the
+// simulation never waits for unrelated tasks.
+QThreadPool& dexelPool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
+// calls func(chunk) for every chunk, the first one in the calling thread and the others in the pool
+template<class Func>
+void forEachChunk(std::size_t chunks, Func func)
+{
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [&func, &errors](std::size_t i) {
+        try {
+            func(i);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    QSemaphore done;
+    for (std::size_t i = 1; i < chunks; i++) {
+        dexelPool().start([&run, &done, i]() {
+            run(i);
+            done.release();
+        });
+    }
+    run(0);
+    done.acquire(static_cast<int>(chunks) - 1);
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+bool contains(const std::vector<float>& dexel, float pos)
+{
+    // the intervals are closed
+    auto index = std::upper_bound(dexel.begin(), dexel.end(), pos) - dexel.begin();
+    return index % 2 == 1 || (index > 0 && dexel[index - 1] == pos);
+}
+
+// removes [start, end] from the intervals of the dexel and returns the removed length
+float subtract(std::vector<float>& dexel, float start, float end)
+{
+    if (dexel.empty() || start >= end || end <= dexel.front() || start >= dexel.back()) {
+        return 0.0F;
+    }
+
+    // the intervals [first, last) overlap with [start, end]
+    auto first = std::upper_bound(dexel.begin(), dexel.end(), start) - dexel.begin();
+    first -= first % 2;
+    auto last = std::lower_bound(dexel.begin(), dexel.end(), end) - dexel.begin();
+    last += last % 2;
+    if (first >= last) {
+        return 0.0F;
+    }
+
+    float removed = 0.0F;
+    for (auto i = first; i < last; i += 2) {
+        removed += std::min(dexel[i + 1], end) - std::max(dexel[i], start);
+    }
+
+    float keep[4];
+    int count = 0;
+    if (dexel[first] < start) {
+        keep[count++] = dexel[first];
+        keep[count++] = start;
+    }
+    if (dexel[last - 1] > end) {
+        keep[count++] = end;
+        keep[count++] = dexel[last - 1];
+    }
+    auto it = dexel.erase(dexel.begin() + first, dexel.begin() + last);
+    dexel.insert(it, keep, keep + count);
+    return removed;
+}
+}  // namespace
+
+//************************************************************************************************************
+// Tool poses and profile
+//************************************************************************************************************
+
+struct cDexelStock::Pose
+{
+    Base::Vector3d position;  // tool tip in stock coordinates
+    Base::Vector3d axis;      // tool axis in stock coordinates
+    Base::Vector3d machine;   // tool tip in machine coordinates
+};
+
+/*
+ * The tool as a solid of revolution around its axis. The profile gives the height of the bottom
+ * of the tool over the radius. The heights are made ascending, which fills the tool from its
+ * bottom up to its length like the height map of cStock does.
+ */
+class cDexelStock::Profile
+{
+public:
+    explicit Profile(const cSimTool& tool)
+    {
+        float height = -std::numeric_limits<float>::max();
+        for (const auto& it : tool.m_toolShape) {
+            height = std::max(height, it.heightPos);
+            if (radius.empty() || it.radiusPos > radius.back()) {
+                radius.push_back(it.radiusPos);
+                heights.push_back(height);
+            }
+        }
+        if (radius.empty()) {
+            radius.push_back(0.0);
+            heights.push_back(0.0);
+        }
+        if (radius.back() < tool.radius) {
+            radius.push_back(tool.radius);
+            heights.push_back(heights.back());
+        }
+        maxRadius = radius.back();
+        bottom = heights.front();
+        top = std::max(bottom + tool.length, heights.back());
+    }
+
+    // radius of the tool at height a above the tip, negative outside the tool
+    double RadiusAt(double a) const
+    {
+        if (a < bottom || a > top) {
+            return -1.0;
+        }
+        auto k = std::upper_bound(heights.begin(), heights.end(), a) - heights.begin() - 1;
+        if (k + 1 >= static_cast<long>(heights.size())) {
+            return maxRadius;
+        }
+        double h0 = heights[k];
+        double h1 = heights[k + 1];
+        return radius[k] + (a - h0) / (h1 - h0) * (radius[k + 1] - radius[k]);
+    }
+
+    // height of the bottom of the tool at radius r
+    double HeightAt(double r) const
+    {
+        auto k = std::lower_bound(radius.begin(), radius.end(), r) - radius.begin();
+        if (k == 0) {
+            return heights[0];
+        }
+        double r0 = radius[k - 1];
+        double r1 = radius[k];
+        return heights[k - 1] + (r - r0) / (r1 - r0) * (heights[k] - heights[k - 1]);
+    }
+
+    /*
+     * Intersects the ray origin + t * e with the tool, where e is the unit vector of the axis.
+     * The parameters of the intersection are returned in [t0, t1].
+     */
+    bool Intersect(const Pose& pose, const Base::Vector3d& origin, int axis, double step, double& t0, double& t1)
+        const
+    {
+        const Base::Vector3d& d = pose.axis;
+        Base::Vector3d q0 = origin - pose.position;
+        double a0 = q0 * d;
+        double ad = d[axis];
+        Base::Vector3d w0 = q0 - d * a0;
+        Base::Vector3d we = d * -ad;
+        we[axis] += 1.0;
+        double qa = we * we;
+        double qb = w0 * we;
+        double qc = w0 * w0;
+
+        // the ray is perpendicular to the tool axis and crosses a circle of the tool
+        if (std::abs(ad) < 1e-9) {
+            double r = RadiusAt(a0);
+            double disc = qb * qb - qa * (qc - r * r);
+            if (r < 0.0 || disc < 0.0) {
+                return false;
+            }
+            double s = std::sqrt(disc);
+            t0 = (-qb - s) / qa;
+            t1 = (-qb + s) / qa;
+            return true;
+        }
+
+        // the ray is parallel to the tool axis and crosses the tool between bottom and top
+        if (qa < 1e-12) {
+            double r = std::sqrt(qc);
+            if (r > maxRadius) {
+                return false;
+            }
+            double ta = (HeightAt(r) - a0) / ad;
+            double tb = (top - a0) / ad;
+            t0 = std::min(ta, tb);
+            t1 = std::max(ta, tb);
+            return true;
+        }
+
+        // otherwise clip the ray with the enclosing cylinder and search the boundary in there
+        double disc = qb * qb - qa * (qc - maxRadius * maxRadius);
+        if (disc < 0.0) {
+            return false;
+        }
+        double s = std::sqrt(disc);
+        double ta = (bottom - a0) / ad;
+        double tb = (top - a0) / ad;
+        double lo = std::max(std::min(ta, tb), (-qb - s) / qa);
+        double hi = std::min(std::max(ta, tb), (-qb + s) / qa);
+        if (lo > hi) {
+            return false;
+        }
+
+        auto inside = [&](double t) {
+            double r = RadiusAt(a0 + t * ad);
+            return r >= 0.0 && qc + t * (2.0 * qb + t * qa) <= r * r;
+        };
+        auto refine = [&](double in, double out) {
+            for (int i = 0; i < 12; i++) {
+                double mid = 0.5 * (in + out);
+                (inside(mid) ? in : out) = mid;
+            }
+            return in;
+        };
+
+        // the tool is convex for the usual profiles, so there is a single interval
+        int count = std::clamp(static_cast<int>(std::ceil((hi - lo) / step)), 2, 64);
+        int first = -1;
+        int last = -1;
+        for (int i = 0; i <= count; i++) {
+            if (inside(lo + (hi - lo) * i / count)) {
+                first = first < 0 ? i : first;
+                last = i;
+            }
+        }
+        if (first < 0) {
+            return false;
+        }
+        auto param = [&](int i) {
+            return lo + (hi - lo) * i / count;
+        };
+        t0 = first > 0 ? refine(param(first), param(first - 1)) : lo;
+        t1 = last < count ? refine(param(last), param(last + 1)) : hi;
+        return true;
+    }
+
+    // bounding box of the tool at the pose
+    Base::BoundBox3d GetBoundBox(const Pose& pose) const
+    {
+        Base::BoundBox3d box;
+        box.Add(pose.position + pose.axis * bottom);
+        box.Add(pose.position + pose.axis * top);
+        double ext[3];
+        for (int i = 0; i < 3; i++) {
+            ext[i] = maxRadius * std::sqrt(std::max(0.0, 1.0 - pose.axis[i] * pose.axis[i]));
+        }
+        box.MinX -= ext[0];
+        box.MaxX += ext[0];
+        box.MinY -= ext[1];
+        box.MaxY += ext[1];
+        box.MinZ -= ext[2];
+        box.MaxZ += ext[2];
+        return box;
+    }
+
+    std::vector<double> radius;
+    std::vector<double> heights;
+    double maxRadius;
+    double bottom;
+    double top;
+};
+
+//************************************************************************************************************
+// tri-dexel stock
+//************************************************************************************************************
+
+cDexelStock::cDexelStock(const Base::BoundBox3d& box, float res)
+    : m_box(box)
+{
+    if (!(res > 0.0F) || !std::isfinite(res)) {
+        throw Base::ValueError("Dexel simulation: the resolution must be positive");
+    }
+    if (!box.IsValid()) {
+        throw Base::ValueError("Dexel simulation: invalid stock bounding box");
+    }
+
+    double length[3] = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    std::size_t blocks = 1;
+    for (int axis = 0; axis < 3; axis++) {
+        double nodes = std::ceil(length[axis] / res) + 1.0;
+        if (!(length[axis] > 0.0) || !(nodes < std::numeric_limits<int>::max())) {
+            throw Base::ValueError("Dexel simulation: the stock must have a finite volume");
+        }
+        m_size[axis] = std::max(2, static_cast<int>(nodes));
+        m_step[axis] = length[axis] / (m_size[axis] - 1);
+        m_blocks[axis] = (m_size[axis] + BlockSize - 1) / BlockSize;
+        blocks *= m_blocks[axis];
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        std::size_t count = std::size_t(m_size[(axis + 1) % 3]) * m_size[(axis + 2) % 3];
+        m_dexels[axis].assign(count, Dexel {Coord(axis, 0), Coord(axis, m_size[axis] - 1)});
+    }
+
+    m_blockFacets.resize(blocks);
+    m_dirty.assign(blocks, 1);
+}
+
+cDexelStock::~cDexelStock() = default;
+
+float cDexelStock::Coord(int axis, int index) const
+{
+    double min[3] = {m_box.MinX, m_box.MinY, m_box.MinZ};
+    double max[3] = {m_box.MaxX, m_box.MaxY, m_box.MaxZ};
+    if (index <= 0) {
+        return static_cast<float>(min[axis]);
+    }
+    if (index >= m_size[axis] - 1) {
+        return static_cast<float>(max[axis]);
+    }
+    return static_cast<float>(min[axis] + index * m_step[axis]);
+}
+
+int cDexelStock::CountThreads(std::size_t work) const
+{
+    int num = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    auto limit = static_cast<int>(std::min<std::size_t>(work / MinWorkPerThread, 256));
+    return std::max(std::min(num, limit), 1);
+}
+
+void cDexelStock::SetModel(const MeshCore::MeshKernel& model, float tolerance)
+{
+    m_tolerance = tolerance;
+    m_model.assign(m_dexels[2].size(), Dexel());
+
+    // shift the rays a little to not hit the edges of adjacent facets exactly
+    double shiftX = m_step[0] * 1.234567e-4;
+    double shiftY = m_step[1] * 2.345678e-4;
+    for (MeshCore::FacetIndex index = 0; index < model.CountFacets(); index++) {
+        MeshCore::MeshGeomFacet facet = model.GetFacet(index);
+        const Base::Vector3f& p0 = facet._aclPoints[0];
+        const Base::Vector3f& p1 = facet._aclPoints[1];
+        const Base::Vector3f& p2 = facet._aclPoints[2];
+        double area = double(p1.x - p0.x) * (p2.y - p0.y) - double(p2.x - p0.x) * (p1.y - p0.y);
+        if (area == 0.0) {
+            continue;
+        }
+
+        Base::BoundBox3f box = facet.GetBoundBox();
+        auto first = [&](int axis, double value) {
+            double min = axis == 0 ? m_box.MinX : m_box.MinY;
+            return std::max(0, static_cast<int>(std::ceil((value - min) / m_step[axis])) - 1);
+        };
+        auto last = [&](int axis, double value) {
+            double min = axis == 0 ? m_box.MinX : m_box.MinY;
+            return std::min(m_size[axis] - 1, static_cast<int>((value - min) / m_step[axis]) + 1);
+        };
+        for (int j = first(1, box.MinY); j <= last(1, box.MaxY); j++) {
+            double y = Coord(1, j) + shiftY;
+            for (int i = first(0, box.MinX); i <= last(0, box.MaxX); i++) {
+                double x = Coord(0, i) + shiftX;
+                // barycentric coordinates of the ray in the projected facet
+                double u = ((p1.x - x) * (p2.y - y) - (p2.x - x) * (p1.y - y)) / area;
+                double v = ((p2.x - x) * (p0.y - y) - (p0.x - x) * (p2.y - y)) / area;
+                double w = 1.0 - u - v;
+                if (u < 0.0 || v < 0.0 || w < 0.0) {
+                    continue;
+                }
+                auto z = static_cast<float>(u * p0.z + v * p1.z + w * p2.z);
+                m_model[i + j * m_size[0]].push_back(z);
+            }
+        }
+    }
+
+    // the crossings of a closed mesh pair up to the intervals inside
+    for (auto& it : m_model) {
+        std::sort(it.begin(), it.end());
+        it.resize(it.size() - it.size() % 2);
+    }
+}
+
+void cDexelStock::ApplyLinearTool(
+    const Base::Vector3d& p1,
+    float a1,
+    const Base::Vector3d& p2,
+    float a2,
+    const cSimTool& tool
+)
+{
+    Profile profile(tool);
+    double angle1 = a1 * pi / 180.0;
+    double angle2 = a2 * pi / 180.0;
+
+    // no point of the tool moves more than half a grid step between two poses
+    double reach = std::max(std::hypot(p1.y, p1.z), std::hypot(p2.y, p2.z)) + profile.top
+        + profile.maxRadius;
+    double dist = (p2 - p1).Length() + std::abs(angle2 - angle1) * reach;
+    double minStep = std::min({m_step[0], m_step[1], m_step[2]});
+    int steps = std::max(1, static_cast<int>(std::ceil(dist / (0.5 * minStep))));
+
+    std::vector<Pose> poses(steps + 1);
+    for (int i = 0; i <= steps; i++) {
+        double t = double(i) / steps;
+        Pose& pose = poses[i];
+        pose.machine = p1 + (p2 - p1) * t;
+        // the stock is rotated around the x axis, so the tool is rotated the other way
+        double angle = angle1 + (angle2 - angle1) * t;
+        double sina = std::sin(angle);
+        double cosa = std::cos(angle);
+        pose.position.Set(
+            pose.machine.x,
+            pose.machine.y * cosa + pose.machine.z * sina,
+            pose.machine.z * cosa - pose.machine.y * sina
+        );
+        pose.axis.Set(0.0, sina, cosa);
+    }
+    Sweep(poses, profile);
+}
+
+void cDexelStock::ApplyCircularTool(
+    const Base::Vector3d& p1,
+    const Base::Vector3d& p2,
+    const Base::Vector3d& center,
+    float angle,
+    const cSimTool& tool,
+    bool isCCW
+)
+{
+    Profile profile(tool);
+    double sang = std::atan2(p1.y - center.y, p1.x - center.x);
+    double eang = std::atan2(p2.y - center.y, p2.x - center.x);
+    double ang = eang - sang;
+    if (!isCCW && ang >= 0) {
+        ang -= 2 * pi;
+    }
+    if (isCCW && ang <= 0) {
+        ang += 2 * pi;
+    }
+
+    double rad1 = std::hypot(p1.x - center.x, p1.y - center.y);
+    double rad2 = std::hypot(p2.x - center.x, p2.y - center.y);
+    double minStep = std::min({m_step[0], m_step[1], m_step[2]});
+    double dist = std::abs(ang) * (std::max(rad1, rad2) + profile.maxRadius)
+        + std::abs(p2.z - p1.z);
+    int steps = std::max(1, static_cast<int>(std::ceil(dist / (0.5 * minStep))));
+
+    double rot = angle * pi / 180.0;
+    double sina = std::sin(rot);
+    double cosa = std::cos(rot);
+    std::vector<Pose> poses(steps + 1);
+    for (int i = 0; i <= steps; i++) {
+        double t = double(i) / steps;
+        double a = sang + ang * t;
+        double r = rad1 + (rad2 - rad1) * t;
+        Pose& pose = poses[i];
+        pose.machine.Set(
+            center.x + r * std::cos(a),
+            center.y + r * std::sin(a),
+            p1.z + (p2.z - p1.z) * t
+        );
+        pose.position.Set(
+            pose.machine.x,
+            pose.machine.y * cosa + pose.machine.z * sina,
+            pose.machine.z * cosa - pose.machine.y * sina
+        );
+        pose.axis.Set(0.0, sina, cosa);
+    }
+    Sweep(poses, profile);
+}
+
+void cDexelStock::Sweep(const std::vector<Pose>& poses, const Profile& profile)
+{
+    std::vector<Base::BoundBox3d> boxes;
+    boxes.reserve(poses.size());
+    Base::BoundBox3d sweptBox;
+    for (const auto& pose : poses) {
+        boxes.push_back(profile.GetBoundBox(pose));
+        sweptBox.Add(boxes.back());
+    }
+    std::size_t move = m_moves++;
+    if (!sweptBox.Intersect(m_box)) {
+        return;
+    }
+    MarkDirty(sweptBox);
+
+    double min[3] = {m_box.MinX, m_box.MinY, m_box.MinZ};
+    auto range = [&](const Base::BoundBox3d& box, int axis, int& first, int& last) {
+        double lo[3] = {box.MinX, box.MinY, box.MinZ};
+        double hi[3] = {box.MaxX, box.MaxY, box.MaxZ};
+        first = std::max(0, static_cast<int>(std::ceil((lo[axis] - min[axis]) / m_step[axis])));
+        last = std::min(
+            m_size[axis] - 1,
+            static_cast<int>(std::floor((hi[axis] - min[axis]) / m_step[axis]))
+        );
+    };
+
+    // estimate the work by the number of z dexels the tool crosses
+    double area = (2.0 * profile.maxRadius / m_step[0] + 1) * (2.0 * profile.maxRadius / m_step[1] + 1);
+    int num = CountThreads(static_cast<std::size_t>(3.0 * area * poses.size()));
+
+    // the results of the z dexels are kept per row and reduced in the order of the rows, so
+    // they don't depend on the number of threads
+    struct Result
+    {
+        double removed = 0.0;
+        float depth = 0.0F;
+        std::size_t pose = 0;
+    };
+    std::vector<Result> rows(m_size[1]);
+    double weight[3][2];
+    for (int axis = 0; axis < 3; axis++) {
+        weight[axis][0] = 0.5 * m_step[axis];
+        weight[axis][1] = m_step[axis];
+    }
+    double minStep = std::min({m_step[0], m_step[1], m_step[2]});
+
+    forEachChunk(num, [&](std::size_t chunk) {
+        for (int axis = 0; axis < 3; axis++) {
+            int uaxis = (axis + 1) % 3;
+            int vaxis = (axis + 2) % 3;
+            for (std::size_t index = 0; index < poses.size(); index++) {
+                const Pose& pose = poses[index];
+                int ufirst, ulast, vfirst, vlast;
+                range(boxes[index], uaxis, ufirst, ulast);
+                range(boxes[index], vaxis, vfirst, vlast);
+                for (int v = vfirst; v <= vlast; v++) {
+                    if (std::size_t(v / RowChunk) % num != chunk) {
+                        continue;
+                    }
+                    for (int u = ufirst; u <= ulast; u++) {
+                        Base::Vector3d origin;
+                        origin[uaxis] = Coord(uaxis, u);
+                        origin[vaxis] = Coord(vaxis, v);
+                        double t0, t1;
+                        if (!profile.Intersect(pose, origin, axis, 0.25 * minStep, t0, t1)) {
+                            continue;
+                        }
+
+                        auto start = static_cast<float>(t0);
+                        auto end = static_cast<float>(t1);
+                        float removed = subtract(GetDexel(axis, u, v), start, end);
+                        if (axis != 2) {
+                            continue;
+                        }
+
+                        // the volume and the gouges are taken from the z dexels
+                        Result& result = rows[v];
+                        double wu = weight[uaxis][u > 0 && u < m_size[uaxis] - 1];
+                        double wv = weight[vaxis][v > 0 && v < m_size[vaxis] - 1];
+                        result.removed += removed * wu * wv;
+                        if (m_model.empty()) {
+                            continue;
+                        }
+                        const Dexel& model = m_model[u + v * m_size[uaxis]];
+                        for (std::size_t i = 0; i < model.size(); i += 2) {
+                            float depth = std::min(end, model[i + 1]) - std::max(start, model[i]);
+                            if (depth > m_tolerance && depth > result.depth) {
+                                result.depth = depth;
+                                result.pose = index;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    Result total;
+    for (const auto& it : rows) {
+        total.removed += it.removed;
+        if (it.depth > total.depth) {
+            total.depth = it.depth;
+            total.pose = it.pose;
+        }
+    }
+    m_removed += total.removed;
+    if (total.depth > 0.0F) {
+        m_gouges.push_back({move, poses[total.pose].machine, total.depth});
+    }
+}
+
+void cDexelStock::MarkDirty(const Base::BoundBox3d& box)
+{
+    // a changed node moves the points of the cells around it and these change their neighbours
+    double lo[3] = {box.MinX - m_box.MinX, box.MinY - m_box.MinY, box.MinZ - m_box.MinZ};
+    double hi[3] = {box.MaxX - m_box.MinX, box.MaxY - m_box.MinY, box.MaxZ - m_box.MinZ};
+    int first[3];
+    int last[3];
+    for (int axis = 0; axis < 3; axis++) {
+        double step = std::max(m_step[axis], 1e-12);
+        int nodeFirst = static_cast<int>(std::floor(lo[axis] / step)) - 2;
+        int nodeLast = static_cast<int>(std::ceil(hi[axis] / step)) + 2;
+        first[axis] = std::clamp(nodeFirst, 0, m_size[axis] - 1) / BlockSize;
+        last[axis] = std::clamp(nodeLast, 0, m_size[axis] - 1) / BlockSize;
+    }
+    for (int z = first[2]; z <= last[2]; z++) {
+        for (int y = first[1]; y <= last[1]; y++) {
+            for (int x = first[0]; x <= last[0]; x++) {
+                m_dirty[x + m_blocks[0] * (y + m_blocks[1] * z)] = 1;
+            }
+        }
+    }
+}
+
+double cDexelStock::GetVolume() const
+{
+    double volume = 0.0;
+    for (int j = 0; j < m_size[1]; j++) {
+        double wy = (j > 0 && j < m_size[1] - 1) ? m_step[1] : 0.5 * m_step[1];
+        for (int i = 0; i < m_size[0]; i++) {
+            double wx = (i > 0 && i < m_size[0] - 1) ? m_step[0] : 0.5 * m_step[0];
+            const Dexel& dexel = GetDexel(2, i, j);
+            double length = 0.0;
+            for (std::size_t k = 0; k < dexel.size(); k += 2) {
+                length += dexel[k + 1] - dexel[k];
+            }
+            volume += length * wx * wy;
+        }
+    }
+    return volume;
+}
+
+bool cDexelStock::IsInside(int i, int j, int k) const
+{
+    if (i < 0 || j < 0 || k < 0 || i >= m_size[0] || j >= m_size[1] || k >= m_size[2]) {
+        return false;
+    }
+    return contains(GetDexel(2, i, j), Coord(2, k));
+}
+
+Base::Vector3f cDexelStock::GetCrossing(int axis, int i, int j, int k, bool lowerInside) const
+{
+    int node[3] = {i, j, k};
+    int uaxis = (axis + 1) % 3;
+    int vaxis = (axis + 2) % 3;
+    float c0 = Coord(axis, node[axis]);
+    float c1 = Coord(axis, node[axis] + 1);
+    float pos = lowerInside ? c0 : c1;
+
+    // edges to the nodes around the grid end at the boundary of the stock
+    if (node[axis] >= 0 && node[axis] + 1 < m_size[axis]) {
+        const Dexel& dexel = GetDexel(axis, node[uaxis], node[vaxis]);
+        if (lowerInside) {
+            // the end of the interval containing the lower node
+            auto index = std::upper_bound(dexel.begin(), dexel.end(), c0) - dexel.begin();
+            if (index % 2 == 1) {
+                pos = std::min(dexel[index], c1);
+            }
+        }
+        else {
+            // the start of the interval containing the upper node
+            auto index = std::lower_bound(dexel.begin(), dexel.end(), c1) - dexel.begin();
+            if (index % 2 == 1) {
+                pos = std::max(dexel[index - 1], c0);
+            }
+        }
+    }
+
+    Base::Vector3f point;
+    point[axis] = pos;
+    point[uaxis] = Coord(uaxis, node[uaxis]);
+    point[vaxis] = Coord(vaxis, node[vaxis]);
+    return point;
+}
+
+void cDexelStock::TessellateBlock(std::size_t block, std::vector<MeshCore::MeshGeomFacet>& facets) const
+{
+    int index[3] = {
+        static_cast<int>(block % m_blocks[0]),
+        static_cast<int>(block / m_blocks[0] % m_blocks[1]),
+        static_cast<int>(block / m_blocks[0] / m_blocks[1])
+    };
+    int lo[3];
+    int hi[3];
+    int dim[3];
+    for (int axis = 0; axis < 3; axis++) {
+        lo[axis] = index[axis] * BlockSize;
+        hi[axis] = std::min(lo[axis] + BlockSize, m_size[axis]);
+        dim[axis] = hi[axis] - lo[axis] + 3;
+    }
+
+    // inside state of the nodes from lo - 1 to hi + 1
+    std::vector<char> inside(std::size_t(dim[0]) * dim[1] * dim[2]);
+    auto nodeIndex = [&](int i, int j, int k) {
+        return (i - lo[0] + 1) + dim[0] * ((j - lo[1] + 1) + dim[1] * (k - lo[2] + 1));
+    };
+    for (int k = lo[2] - 1; k <= hi[2] + 1; k++) {
+        for (int j = lo[1] - 1; j <= hi[1] + 1; j++) {
+            for (int i = lo[0] - 1; i <= hi[0] + 1; i++) {
+                inside[nodeIndex(i, j, k)] = IsInside(i, j, k);
+            }
+        }
+    }
+
+    // the point of a cell is the mean of the crossings on its edges, computed on first use
+    std::vector<Base::Vector3f> points(inside.size());
+    std::vector<char> known(inside.size(), 0);
+    auto cellPoint = [&](int i, int j, int k) -> const Base::Vector3f& {
+        auto cell = nodeIndex(i, j, k);
+        if (!known[cell]) {
+            known[cell] = 1;
+            Base::Vector3f sum;
+            int count = 0;
+            for (int axis = 0; axis < 3; axis++) {
+                int uaxis = (axis + 1) % 3;
+                int vaxis = (axis + 2) % 3;
+                for (int du = 0; du < 2; du++) {
+                    for (int dv = 0; dv < 2; dv++) {
+                        int node[3] = {i, j, k};
+                        node[uaxis] += du;
+                        node[vaxis] += dv;
+                        bool in0 = inside[nodeIndex(node[0], node[1], node[2])];
+                        node[axis] += 1;
+                        bool in1 = inside[nodeIndex(node[0], node[1], node[2])];
+                        node[axis] -= 1;
+                        if (in0 != in1) {
+                            sum += GetCrossing(axis, node[0], node[1], node[2], in0);
+                            count++;
+                        }
+                    }
+                }
+            }
+            points[cell] = count > 0 ? sum / float(count) : sum;
+        }
+        return points[cell];
+    };
+
+    facets.clear();
+    for (int axis = 0; axis < 3; axis++) {
+        int uaxis = (axis + 1) % 3;
+        int vaxis = (axis + 2) % 3;
+        // edges from the node in front of the grid belong to the first block
+        int first[3] = {lo[0], lo[1], lo[2]};
+        if (lo[axis] == 0) {
+            first[axis] = -1;
+        }
+        for (int k = first[2]; k < hi[2]; k++) {
+            for (int j = first[1]; j < hi[1]; j++) {
+                for (int i = first[0]; i < hi[0]; i++) {
+                    int node[3] = {i, j, k};
+                    bool in0 = inside[nodeIndex(i, j, k)];
+                    node[axis] += 1;
+                    bool in1 = inside[nodeIndex(node[0], node[1], node[2])];
+                    if (in0 == in1) {
+                        continue;
+                    }
+
+                    // the quad connects the cells around the edge, facing the outside
+                    Base::Vector3f quad[4];
+                    const int offsets[4][2] = {{-1, -1}, {0, -1}, {0, 0}, {-1, 0}};
+                    for (int n = 0; n < 4; n++) {
+                        int cell[3] = {i, j, k};
+                        cell[uaxis] += offsets[n][0];
+                        cell[vaxis] += offsets[n][1];
+                        quad[in0 ? n : 3 - n] = cellPoint(cell[0], cell[1], cell[2]);
+                    }
+                    facets.emplace_back(quad[0], quad[1], quad[2]);
+                    facets.emplace_back(quad[0], quad[2], quad[3]);
+                }
+            }
+        }
+    }
+}
+
+void cDexelStock::Tessellate(std::vector<MeshCore::MeshGeomFacet>& facets)
+{
+    std::vector<std::size_t> dirty;
+    for (std::size_t block = 0; block < m_dirty.size(); block++) {
+        if (m_dirty[block]) {
+            dirty.push_back(block);
+        }
+    }
+
+    std::size_t work = dirty.size() * BlockSize * BlockSize * BlockSize;
+    int num = std::min<int>(CountThreads(work), std::max<std::size_t>(dirty.size(), 1));
+    forEachChunk(num, [&](std::size_t chunk) {
+        for (std::size_t i = chunk; i < dirty.size(); i += num) {
+            TessellateBlock(dirty[i], m_blockFacets[dirty[i]]);
+        }
+    });
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+
+    std::size_t count = 0;
+    for (const auto& it : m_blockFacets) {
+        count += it.size();
+    }
+    facets.clear();
+    facets.reserve(count);
+    for (const auto& it : m_blockFacets) {
+        facets.insert(facets.end(), it.begin(), it.end());
+    }
+}
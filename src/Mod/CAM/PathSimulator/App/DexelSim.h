@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+
+#include "VolSim.h"
+
+
+namespace MeshCore
+{
+class MeshKernel;
+}
+
+/**
+ * The cDexelStock class is a tri-dexel model of the stock for material removal simulation
+ * without a graphics context.
+ *
+ * The stock is stored as three sets of dexels, i.e. rays parallel to the x, y and z axis through
+ * the nodes of a regular grid. Each dexel holds the sorted intervals of its ray that are inside
+ * the material. Unlike the height map of cStock this represents undercuts, and the tool may have
+ * any direction in the yz plane as needed for a rotary A axis.
+ *
+ * A move subtracts the intersection of every dexel with the tool at a sequence of poses along
+ * the move. The tool is the solid of revolution of its profile. The rows of dexels are shared
+ * among several threads. The surface is extracted with surface nets, where the points on the
+ * grid edges come from the dexels along the edge. The surface is cached in blocks and only blocks
+ * touched by a move since the last extraction are extracted again.
+ */
+class PathSimulatorExport cDexelStock
+{
+public:
+    /// A move that cuts into the model
+    struct Gouge
+    {
+        std::size_t move;          // index of the move
+        Base::Vector3d position;   // tool position of the deepest cut
+        float depth;               // depth of the cut into the model
+    };
+
+    cDexelStock(const Base::BoundBox3d& box, float res);
+    ~cDexelStock();
+
+    /// Number of threads to use, 0 means the number of cores.
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+    /**
+     * Sets the model the moves are checked against. The model must be a closed mesh in stock
+     * coordinates. Cuts less deep than \a tolerance are not reported.
+     */
+    void SetModel(const MeshCore::MeshKernel& model, float tolerance);
+
+    /**
+     * Removes the material swept by the tool on a straight move from \a p1 to \a p2. The stock
+     * is rotated around the x axis by the A axis angles \a a1 and \a a2 in degrees.
+     */
+    void ApplyLinearTool(
+        const Base::Vector3d& p1,
+        float a1,
+        const Base::Vector3d& p2,
+        float a2,
+        const cSimTool& tool
+    );
+    /**
+     * Removes the material swept by the tool on an arc in the xy plane around \a center. The move
+     * is a helix if \a p1 and \a p2 have a different height.
+     */
+    void ApplyCircularTool(
+        const Base::Vector3d& p1,
+        const Base::Vector3d& p2,
+        const Base::Vector3d& center,
+        float angle,
+        const cSimTool& tool,
+        bool isCCW
+    );
+
+    /// Returns the surface of the stock. Only blocks changed since the last call are rebuilt.
+    void Tessellate(std::vector<MeshCore::MeshGeomFacet>& facets);
+    /// Returns the volume of the remaining material.
+    double GetVolume() const;
+    /// Returns the volume of the material removed so far.
+    double GetRemovedVolume() const
+    {
+        return m_removed;
+    }
+    /// Returns the moves that cut into the model.
+    const std::vector<Gouge>& GetGouges() const
+    {
+        return m_gouges;
+    }
+    /// Returns the number of moves applied so far.
+    std::size_t CountMoves() const
+    {
+        return m_moves;
+    }
+
+private:
+    struct Pose;
+    class Profile;
+    using Dexel = std::vector<float>;
+
+    void Sweep(const std::vector<Pose>& poses, const Profile& profile);
+    void MarkDirty(const Base::BoundBox3d& box);
+    void TessellateBlock(std::size_t block, std::vector<MeshCore::MeshGeomFacet>& facets) const;
+    int CountThreads(std::size_t work) const;
+
+    // grid nodes and dexels
+    float Coord(int axis, int index) const;
+    Dexel& GetDexel(int axis, int u, int v)
+    {
+        return m_dexels[axis][u + v * m_size[(axis + 1) % 3]];
+    }
+    const Dexel& GetDexel(int axis, int u, int v) const
+    {
+        return m_dexels[axis][u + v * m_size[(axis + 1) % 3]];
+    }
+    bool IsInside(int i, int j, int k) const;
+    Base::Vector3f GetCrossing(int axis, int i, int j, int k, bool lowerInside) const;
+
+private:
+    Base::BoundBox3d m_box;
+    int m_size[3];              // number of nodes along each axis
+    double m_step[3];           // distance of the nodes along each axis
+    std::vector<Dexel> m_dexels[3];
+    std::vector<Dexel> m_model;   // intervals of the model along the z dexels
+    float m_tolerance {0.0F};
+    double m_removed {0.0};
+    std::size_t m_moves {0};
+    std::vector<Gouge> m_gouges;
+
+    // surface cache
+    int m_blocks[3];
+    std::vector<std::vector<MeshCore::MeshGeomFacet>> m_blockFacets;
+    std::vector<char> m_dirty;
+    int threads {0};
+};
@@ -23,6 +23,8 @@
  ***************************************************************************/
 
 
+#include <Base/Exception.h>
+
 #include "PathSim.h"
 
 
@@ -37,9 +39,16 @@ PathSim::PathSim()
 PathSim::~PathSim()
 {}
 
-void PathSim::BeginSimulation(Part::TopoShape* stock, float resolution)
+void PathSim::BeginSimulation(Part::TopoShape* stock, float resolution, bool dexel)
 {
     Base::BoundBox3d bbox = stock->getBoundBox();
+    m_angle = 0.0F;
+    if (dexel) {
+        m_stock.reset();
+        m_dexelStock = std::make_unique<cDexelStock>(bbox, resolution);
+        return;
+    }
+    m_dexelStock.reset();
     m_stock = std::make_unique<cStock>(
         bbox.MinX,
         bbox.MinY,
@@ -51,6 +60,14 @@ void PathSim::BeginSimulation(Part::TopoShape* stock, float resolution)
     );
 }
 
+void PathSim::SetModel(const MeshCore::MeshKernel& model, float tolerance)
+{
+    if (!m_dexelStock) {
+        throw Base::RuntimeError("Gouge checks need a dexel simulation");
+    }
+    m_dexelStock->SetModel(model, tolerance);
+}
+
 void PathSim::SetToolShape(const TopoDS_Shape& toolShape, float resolution)
 {
     m_tool = std::make_unique<cSimTool>(toolShape, resolution);
@@ -61,7 +78,21 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     Point3D fromPos(*pos);
     Point3D toPos(*pos);
     toPos.UpdateCmd(*cmd);
-    if (m_tool) {
+    if (m_tool && m_dexelStock) {
+        Vector3d from(fromPos.x, fromPos.y, fromPos.z);
+        Vector3d to(toPos.x, toPos.y, toPos.z);
+        float angle = cmd->has("A") ? float(cmd->getValue("A")) : m_angle;
+        if (cmd->Name == "G0" || cmd->Name == "G1") {
+            m_dexelStock->ApplyLinearTool(from, m_angle, to, angle, *m_tool);
+        }
+        else if (cmd->Name == "G2" || cmd->Name == "G3") {
+            Vector3d center = from + cmd->getCenter();
+            center.z = from.z;
+            m_dexelStock->ApplyCircularTool(from, to, center, m_angle, *m_tool, cmd->Name == "G3");
+        }
+        m_angle = angle;
+    }
+    else if (m_tool) {
         if (cmd->Name == "G0" || cmd->Name == "G1") {
             m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
         }
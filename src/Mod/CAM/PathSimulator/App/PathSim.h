@@ -31,6 +31,7 @@
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
+#include "DexelSim.h"
 #include "VolSim.h"
 
 
@@ -49,13 +50,17 @@ public:
     PathSim();
     ~PathSim();
 
-    void BeginSimulation(Part::TopoShape* stock, float resolution);
+    void BeginSimulation(Part::TopoShape* stock, float resolution, bool dexel = false);
+    void SetModel(const MeshCore::MeshKernel& model, float tolerance);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
 
 public:
     std::unique_ptr<cStock> m_stock;
     std::unique_ptr<cSimTool> m_tool;
+    /// tri-dexel stock, used instead of m_stock if the simulation is started with dexel
+    std::unique_ptr<cDexelStock> m_dexelStock;
+    float m_angle {0.0F};  // current A axis angle
 };
 
 }  // namespace PathSimulator
@@ -7,6 +7,7 @@ from typing import Any, Final
 from Base.BaseClass import BaseClass
 from Base.Metadata import export
 from Base.Placement import Placement
+from Base.Vector import Vector
 from Part.App.TopoShape import TopoShape
 from Mesh.App.Mesh import Mesh
 from CAM.App.Command import Command
@@ -30,9 +31,31 @@ class PathSim(BaseClass):
     License: LGPL-2.1-or-later
     """
 
-    def BeginSimulation(self, stock: TopoShape, resolution: float) -> None:
+    def BeginSimulation(self, stock: TopoShape, resolution: float, dexel: bool = False) -> None:
         """
-        Start a simulation process on a box shape stock with given resolution
+        Start a simulation process on a box shape stock with given resolution.
+        If dexel is True the stock is a tri-dexel model which represents undercuts
+        and A axis moves, and is simulated on several threads.
+        """
+        ...
+
+    def SetModel(self, model: Mesh, tolerance: float = 0.0, /) -> None:
+        """
+        Set the closed mesh the moves of a dexel simulation are checked against.
+        Cuts into the model less deep than tolerance are not reported.
+        """
+        ...
+
+    def GetRemovedVolume(self) -> float:
+        """
+        Return the volume removed from the stock of a dexel simulation.
+        """
+        ...
+
+    def GetGouges(self) -> list[tuple[int, Vector, float]]:
+        """
+        Return the moves of a dexel simulation that cut into the model as tuples
+        of the index of the move, the tool position and the depth of the cut.
         """
         ...
 
@@ -24,6 +24,7 @@
 
 
 #include <Base/PlacementPy.h>
+#include <Base/VectorPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
@@ -59,23 +60,26 @@ int PathSimPy::PyInit(PyObject* /*args*/, PyObject* /*kwd*/)
 
 PyObject* PathSimPy::BeginSimulation(PyObject* args, PyObject* kwds)
 {
-    static const std::array<const char*, 3> kwlist {"stock", "resolution", nullptr};
+    static const std::array<const char*, 4> kwlist {"stock", "resolution", "dexel", nullptr};
     PyObject* pObjStock;
     float resolution;
+    PyObject* pObjDexel = Py_False;
     if (!Base::Wrapped_ParseTupleAndKeywords(
             args,
             kwds,
-            "O!f",
+            "O!f|O!",
             kwlist,
             &(Part::TopoShapePy::Type),
             &pObjStock,
-            &resolution
+            &resolution,
+            &PyBool_Type,
+            &pObjDexel
         )) {
         return nullptr;
     }
     PathSim* sim = getPathSimPtr();
     Part::TopoShape* stock = static_cast<Part::TopoShapePy*>(pObjStock)->getTopoShapePtr();
-    sim->BeginSimulation(stock, resolution);
+    sim->BeginSimulation(stock, resolution, Base::asBoolean(pObjDexel));
     Py_IncRef(Py_None);
     return Py_None;
 }
@@ -95,11 +99,72 @@ PyObject* PathSimPy::SetToolShape(PyObject* args)
     return Py_None;
 }
 
+PyObject* PathSimPy::SetModel(PyObject* args)
+{
+    PyObject* pObjModel;
+    float tolerance = 0.0F;
+    if (!PyArg_ParseTuple(args, "O!|f", &(Mesh::MeshPy::Type), &pObjModel, &tolerance)) {
+        return nullptr;
+    }
+    PY_TRY
+    {
+        const Mesh::MeshObject* model = static_cast<Mesh::MeshPy*>(pObjModel)->getMeshObjectPtr();
+        getPathSimPtr()->SetModel(model->getKernel(), tolerance);
+        Py_Return;
+    }
+    PY_CATCH
+}
+
+PyObject* PathSimPy::GetRemovedVolume(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    cDexelStock* stock = getPathSimPtr()->m_dexelStock.get();
+    if (!stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no dexel stock object");
+        return nullptr;
+    }
+    return Py::new_reference_to(Py::Float(stock->GetRemovedVolume()));
+}
+
+PyObject* PathSimPy::GetGouges(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    cDexelStock* stock = getPathSimPtr()->m_dexelStock.get();
+    if (!stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no dexel stock object");
+        return nullptr;
+    }
+    Py::List list;
+    for (const auto& it : stock->GetGouges()) {
+        list.append(Py::TupleN(
+            Py::Long(static_cast<long>(it.move)),
+            Py::asObject(new Base::VectorPy(it.position)),
+            Py::Float(it.depth)
+        ));
+    }
+    return Py::new_reference_to(list);
+}
+
 PyObject* PathSimPy::GetResultMesh(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
         return nullptr;
     }
+    if (cDexelStock* stock = getPathSimPtr()->m_dexelStock.get()) {
+        // the dexel stock has a single closed surface, so the inner mesh stays empty
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        stock->Tessellate(facets);
+        Mesh::MeshObject* mesh = new Mesh::MeshObject();
+        mesh->addFacets(facets);
+        PyObject* tuple = PyTuple_New(2);
+        PyTuple_SetItem(tuple, 0, new Mesh::MeshPy(mesh));
+        PyTuple_SetItem(tuple, 1, new Mesh::MeshPy(new Mesh::MeshObject()));
+        return tuple;
+    }
     cStock* stock = getPathSimPtr()->m_stock.get();
     if (!stock) {
         PyErr_SetString(PyExc_RuntimeError, "Simulation has stock object");
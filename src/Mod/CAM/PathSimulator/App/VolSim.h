@@ -170,7 +170,7 @@ struct cLineSegment
     float lenXY;
 };
 
-class cSimTool
+class PathSimulatorExport cSimTool
 {
 public:
     cSimTool(const TopoDS_Shape& toolShape, float res);
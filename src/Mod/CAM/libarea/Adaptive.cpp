@@ -28,7 +28,14 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
 #include <numbers>
+#include <thread>
+#include <tuple>
 
 namespace ClipperLib
 {
@@ -1036,30 +1043,33 @@ PerfCounter Perf_IsClearPath("IsClearPath");
 //***********************************
 // Cleared area bounding support
 //***********************************
+// The cleared area is kept in square tiles of a few tool diameters. Expanding the cleared area
+// and querying the area around the tool only touch the tiles nearby, so the cost of a step does
+// not grow with the size of the area cleared so far. The paths set by SetClearedPaths() are
+// split into tiles on first use of a tile. Without tiles the whole area is kept in a single tile.
 class ClearedArea
 {
 public:
-    ClearedArea(ClipperLib::cInt p_toolRadiusScaled)
+    ClearedArea(ClipperLib::cInt p_toolRadiusScaled, bool tiled)
     {
         toolRadiusScaled = p_toolRadiusScaled;
+        tileSize = tiled ? max<cInt>(4 * toolRadiusScaled, 64) : 0;
     };
 
     void SetClearedPaths(const Paths& paths)
     {
+        basePaths = paths;
+        tiles.clear();
         clearedPaths = paths;
-        bboxPathsInvalid = true;
+        clearedPathsInvalid = false;
         bboxClippedInvalid = true;
     }
 
     void AddClearedPaths(const Paths& paths)
     {
-        clip.Clear();
-        clip.AddPaths(clearedPaths, PolyType::ptSubject, true);
-        clip.AddPaths(paths, PolyType::ptClip, true);
-        clip.Execute(ClipType::ctUnion, clearedPaths);
-        CleanPolygons(clearedPaths);
-        bboxPathsInvalid = true;
-        bboxClippedInvalid = true;
+        Paths simplified;
+        SimplifyPolygons(paths, simplified);
+        AddToTiles(simplified);
     }
 
     void ExpandCleared(const Path toClearToolPath)
@@ -1072,13 +1082,7 @@ public:
         clipof.AddPath(toClearToolPath, JoinType::jtRound, EndType::etOpenRound);
         Paths toolCoverPoly;
         clipof.Execute(toolCoverPoly, toolRadiusScaled + 1);
-        clip.Clear();
-        clip.AddPaths(clearedPaths, PolyType::ptSubject, true);
-        clip.AddPaths(toolCoverPoly, PolyType::ptClip, true);
-        clip.Execute(ClipType::ctUnion, clearedPaths);
-        CleanPolygons(clearedPaths);
-        bboxPathsInvalid = true;
-        bboxClippedInvalid = true;
+        AddToTiles(toolCoverPoly);
         Perf_ExpandCleared.Stop();
     }
 
@@ -1091,63 +1095,201 @@ public:
             return clearedBoundedClipped;
         }
 
-        // second, check if the window needs to be recomputed
-        if (bboxClippedInvalid || !clearedBBWindow.Contains(toolBB)) {
-            const int deltaWindow = delta * clearedBoundedWindowScale;
-            clearedBBWindow.SetFirstPoint(IntPoint(toolPos.X - deltaWindow, toolPos.Y - deltaWindow));
-            clearedBBWindow.AddPoint(IntPoint(toolPos.X + deltaWindow, toolPos.Y + deltaWindow));
-
-            Path bbPath;
-            bbPath.push_back(IntPoint(toolPos.X - deltaWindow, toolPos.Y - deltaWindow));
-            bbPath.push_back(IntPoint(toolPos.X + deltaWindow, toolPos.Y - deltaWindow));
-            bbPath.push_back(IntPoint(toolPos.X + deltaWindow, toolPos.Y + deltaWindow));
-            bbPath.push_back(IntPoint(toolPos.X - deltaWindow, toolPos.Y + deltaWindow));
-            clip.Clear();
-            clip.AddPath(bbPath, PolyType::ptSubject, true);
-            clip.AddPaths(clearedPaths, PolyType::ptClip, true);
-            clip.Execute(ClipType::ctIntersection, clearedBoundedWindow);
-        }
-
-        // finally, perform the query using data from the window
-        clearedBBClippedInFocus.SetFirstPoint(IntPoint(toolPos.X - delta, toolPos.Y - delta));
-        clearedBBClippedInFocus.AddPoint(IntPoint(toolPos.X + delta, toolPos.Y + delta));
-
+        // otherwise clip the tiles around the tool, which also joins the parts of adjacent tiles
+        clearedBBClippedInFocus = toolBB;
         Path bbPath;
         bbPath.push_back(IntPoint(toolPos.X - delta, toolPos.Y - delta));
         bbPath.push_back(IntPoint(toolPos.X + delta, toolPos.Y - delta));
         bbPath.push_back(IntPoint(toolPos.X + delta, toolPos.Y + delta));
         bbPath.push_back(IntPoint(toolPos.X - delta, toolPos.Y + delta));
+        // GetClearedNear() may split new tiles with the same clipper, so call it first
+        const Paths& clearedNear = GetClearedNear(toolBB);
         clip.Clear();
         clip.AddPath(bbPath, PolyType::ptSubject, true);
-        clip.AddPaths(clearedBoundedWindow, PolyType::ptClip, true);
-        clip.Execute(ClipType::ctIntersection, clearedBoundedClipped);
+        clip.AddPaths(clearedNear, PolyType::ptClip, true);
+        clip.Execute(
+            ClipType::ctIntersection,
+            clearedBoundedClipped,
+            PolyFillType::pftEvenOdd,
+            PolyFillType::pftNonZero
+        );
+        CleanPolygons(clearedBoundedClipped);
 
         bboxClippedInvalid = false;
         return clearedBoundedClipped;
     }
 
+    // get the cleared area overlapping the box, split at the tile borders
+    const Paths& GetClearedNear(const BoundBox& box)
+    {
+        clearedNearPaths.clear();
+        for (cInt ty = TileIndex(box.minY); ty <= TileIndex(box.maxY); ty++) {
+            for (cInt tx = TileIndex(box.minX); tx <= TileIndex(box.maxX); tx++) {
+                const Paths& tile = GetTile(tx, ty);
+                clearedNearPaths.insert(clearedNearPaths.end(), tile.begin(), tile.end());
+            }
+        }
+        return clearedNearPaths;
+    }
+
     // get full cleared area
     Paths& GetCleared()
     {
+        if (clearedPathsInvalid) {
+            clip.Clear();
+            clip.AddPaths(basePaths, PolyType::ptSubject, true);
+            for (const auto& tile : tiles) {
+                clip.AddPaths(tile.second, PolyType::ptClip, true);
+            }
+            clip.Execute(
+                ClipType::ctUnion,
+                clearedPaths,
+                PolyFillType::pftEvenOdd,
+                PolyFillType::pftNonZero
+            );
+            CleanPolygons(clearedPaths);
+            clearedPathsInvalid = false;
+        }
         return clearedPaths;
     }
 
 private:
+    cInt TileIndex(cInt coord) const
+    {
+        if (tileSize == 0) {
+            return 0;
+        }
+        // round towards negative infinity
+        return coord >= 0 ? coord / tileSize : -((-coord - 1) / tileSize) - 1;
+    }
+
+    Path TileRect(cInt tx, cInt ty) const
+    {
+        Path rect;
+        rect.push_back(IntPoint(tx * tileSize, ty * tileSize));
+        rect.push_back(IntPoint((tx + 1) * tileSize, ty * tileSize));
+        rect.push_back(IntPoint((tx + 1) * tileSize, (ty + 1) * tileSize));
+        rect.push_back(IntPoint(tx * tileSize, (ty + 1) * tileSize));
+        return rect;
+    }
+
+    Paths& GetTile(cInt tx, cInt ty)
+    {
+        auto it = tiles.find({tx, ty});
+        if (it != tiles.end()) {
+            return it->second;
+        }
+        Paths& tile = tiles[{tx, ty}];
+        if (tileSize == 0) {
+            tile = basePaths;
+        }
+        else if (!basePaths.empty()) {
+            clip.Clear();
+            clip.AddPath(TileRect(tx, ty), PolyType::ptSubject, true);
+            clip.AddPaths(basePaths, PolyType::ptClip, true);
+            clip.Execute(ClipType::ctIntersection, tile);
+        }
+        return tile;
+    }
+
+    // paths must be oriented like clipper output, i.e. outer boundaries counter-clockwise
+    void AddToTiles(const Paths& paths)
+    {
+        bool first = true;
+        BoundBox bb;
+        for (const Path& path : paths) {
+            for (const IntPoint& pt : path) {
+                if (first) {
+                    bb.SetFirstPoint(pt);
+                    first = false;
+                }
+                bb.AddPoint(pt);
+            }
+        }
+        if (first) {
+            return;
+        }
+        if (tileSize == 0) {
+            Paths& tile = GetTile(0, 0);
+            clip.Clear();
+            clip.AddPaths(tile, PolyType::ptSubject, true);
+            clip.AddPaths(paths, PolyType::ptClip, true);
+            clip.Execute(
+                ClipType::ctUnion,
+                tile,
+                PolyFillType::pftNonZero,
+                PolyFillType::pftNonZero
+            );
+            CleanPolygons(tile);
+            clearedPathsInvalid = true;
+            bboxClippedInvalid = true;
+            return;
+        }
+
+        // the non-zero fill of the tile and the new paths is their union, so a single clip
+        // with the tile border updates the tile
+        for (cInt ty = TileIndex(bb.minY); ty <= TileIndex(bb.maxY); ty++) {
+            for (cInt tx = TileIndex(bb.minX); tx <= TileIndex(bb.maxX); tx++) {
+                Paths& tile = GetTile(tx, ty);
+                clip.Clear();
+                clip.AddPath(TileRect(tx, ty), PolyType::ptSubject, true);
+                clip.AddPaths(tile, PolyType::ptClip, true);
+                clip.AddPaths(paths, PolyType::ptClip, true);
+                clip.Execute(
+                    ClipType::ctIntersection,
+                    tile,
+                    PolyFillType::pftEvenOdd,
+                    PolyFillType::pftNonZero
+                );
+                CleanTile(tile, tx, ty);
+            }
+        }
+        clearedPathsInvalid = true;
+        bboxClippedInvalid = true;
+    }
+
+    // removes vertices close to their predecessor like CleanPolygons, but keeps the vertices on
+    // the tile border so that adjacent tiles still meet exactly
+    void CleanTile(Paths& tile, cInt tx, cInt ty) const
+    {
+        const cInt minX = tx * tileSize;
+        const cInt maxX = minX + tileSize;
+        const cInt minY = ty * tileSize;
+        const cInt maxY = minY + tileSize;
+        const auto onBorder = [&](const IntPoint& pt) {
+            return pt.X == minX || pt.X == maxX || pt.Y == minY || pt.Y == maxY;
+        };
+        size_t count = 0;
+        for (Path& path : tile) {
+            Path cleaned;
+            cleaned.reserve(path.size());
+            for (const IntPoint& pt : path) {
+                if (!cleaned.empty() && !onBorder(pt) && DistanceSqrd(cleaned.back(), pt) < 2.0) {
+                    continue;
+                }
+                cleaned.push_back(pt);
+            }
+            if (cleaned.size() > 2) {
+                tile[count++] = std::move(cleaned);
+            }
+        }
+        tile.resize(count);
+    }
+
     Clipper clip;
     ClipperOffset clipof;
+    Paths basePaths;
+    std::map<std::pair<cInt, cInt>, Paths> tiles;
     Paths clearedPaths;
-    Paths clearedBoundedWindow;
+    Paths clearedNearPaths;
     Paths clearedBoundedClipped;
-    Paths clearedBoundedPaths;
 
     ClipperLib::cInt toolRadiusScaled;
-    BoundBox clearedBBWindow;
+    ClipperLib::cInt tileSize;
     BoundBox clearedBBClippedInFocus;
-    BoundBox clearedBBPathsInFocus;
 
     bool bboxClippedInvalid = false;
-    bool bboxPathsInvalid = false;
-    int clearedBoundedWindowScale = 10;
+    bool clearedPathsInvalid = false;
 };
 
 //***************************************
@@ -1897,6 +2039,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
     }
 
     // 7) Loop over connected components using nesting level.
+    std::vector<std::tuple<Paths, Paths, Paths>> regions;
     for (const auto& current : toolBounds) {
         // nesting counts itself and the number of polygons containing it
         int nesting = getPathNestingLevel(current, toolBounds);
@@ -1971,14 +2114,113 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(
                 }
             }
 
-            // 10) Run core algorithm on (bounds, toolBounds, finishingPass, clearedArea)
-            ProcessPolyNode(boundPath, currentTBP, finishingPass, initialClearedPaths);
+            regions.emplace_back(boundPath, currentTBP, finishingPass);
         }
     }
 
+    // 10) Run core algorithm on (bounds, toolBounds, finishingPass, clearedArea)
+    ProcessRegions(regions, initialClearedPaths);
+
     return results;
 }
 
+void Adaptive2d::ProcessRegions(
+    const std::vector<std::tuple<Paths, Paths, Paths>>& regions,
+    const Paths& initialClearedPaths
+)
+{
+    size_t numThreads = maxThreads > 0 ? size_t(maxThreads) : std::thread::hardware_concurrency();
+    numThreads = min(numThreads, regions.size());
+#ifdef DEV_MODE
+    numThreads = 1;  // the performance counters and drawing functions are not thread safe
+#endif
+    if (numThreads <= 1) {
+        for (const auto& [boundPath, toolBoundPaths, finishingPass] : regions) {
+            ProcessPolyNode(boundPath, toolBoundPaths, finishingPass, initialClearedPaths);
+        }
+        return;
+    }
+
+    // The regions start from the same cleared area and do not depend on each other. Each thread
+    // works on its own copy of the state, and the results are kept in the order of the regions,
+    // so the output does not depend on the number of threads.
+    std::vector<std::list<AdaptiveOutput>> regionResults(regions.size());
+    std::mutex mutex;
+    std::condition_variable progressReady;
+    std::vector<TPaths> progressQueue;
+    std::atomic<bool> stop {false};
+    std::atomic<size_t> nextRegion {0};
+    size_t running = numThreads;
+    std::exception_ptr error;
+
+    const auto worker = [&]() {
+        Adaptive2d local(*this);
+        std::function<bool(TPaths)> queueProgress = [&](TPaths paths) {
+            std::lock_guard<std::mutex> lock(mutex);
+            progressQueue.push_back(std::move(paths));
+            progressReady.notify_one();
+            return stop.load();
+        };
+        local.progressCallback = &queueProgress;
+        try {
+            for (size_t i = nextRegion++; i < regions.size() && !stop; i = nextRegion++) {
+                const auto& [boundPath, toolBoundPaths, finishingPass] = regions[i];
+                local.results.clear();
+                local.current_region = int(i);
+                local.ProcessPolyNode(boundPath, toolBoundPaths, finishingPass, initialClearedPaths);
+                regionResults[i] = std::move(local.results);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            stop = true;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        running--;
+        progressReady.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; i++) {
+        threads.emplace_back(worker);
+    }
+
+    // the progress callback may call into python, so it is only called from this thread
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        progressReady.wait(lock, [&]() { return !progressQueue.empty() || running == 0; });
+        std::vector<TPaths> pending;
+        pending.swap(progressQueue);
+        bool done = running == 0;
+        lock.unlock();
+        for (TPaths& progressPaths : pending) {
+            if (progressCallback && !stop && (*progressCallback)(progressPaths)) {
+                stop = true;
+            }
+        }
+        lock.lock();
+        if (done && progressQueue.empty()) {
+            break;
+        }
+    }
+    lock.unlock();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    stopProcessing = stop;
+    current_region += int(regions.size());
+    for (auto& regionResult : regionResults) {
+        results.splice(results.end(), regionResult);
+    }
+}
+
 bool Adaptive2d::FindEntryPoint(
     TPaths& progressPaths,
     const Paths& toolBoundPaths,
@@ -2124,14 +2366,41 @@ bool Adaptive2d::IsClearPath(const Path& tp, ClearedArea& cleared, double safety
 {
     Perf_IsClearPath.Start();
     Clipper clip;
-    ClipperOffset clipof;
-    clipof.AddPath(tp, JoinType::jtRound, EndType::etOpenRound);
     Paths toolShape;
-    clipof.Execute(toolShape, toolRadiusScaled + safetyClearance);
+    if (tp.size() == 1) {
+        // most checks are for a single point, so offset a point once per clearance and move it
+        double delta = toolRadiusScaled + safetyClearance;
+        auto it = toolShapeCache.find(delta);
+        if (it == toolShapeCache.end()) {
+            ClipperOffset clipof;
+            clipof.AddPath(Path {IntPoint(0, 0)}, JoinType::jtRound, EndType::etOpenRound);
+            clipof.Execute(toolShape, delta);
+            it = toolShapeCache.emplace(delta, toolShape).first;
+        }
+        toolShape.resize(it->second.size());
+        for (size_t i = 0; i < toolShape.size(); i++) {
+            TranslatePath(it->second[i], toolShape[i], tp.front());
+        }
+    }
+    else {
+        ClipperOffset clipof;
+        clipof.AddPath(tp, JoinType::jtRound, EndType::etOpenRound);
+        clipof.Execute(toolShape, toolRadiusScaled + safetyClearance);
+    }
+    if (toolShape.empty() || toolShape.front().empty()) {
+        Perf_IsClearPath.Stop();
+        return true;
+    }
+    BoundBox toolShapeBB(toolShape.front().front());
+    for (const auto& p : toolShape) {
+        for (const auto& pt : p) {
+            toolShapeBB.AddPoint(pt);
+        }
+    }
     clip.AddPaths(toolShape, PolyType::ptSubject, true);
-    clip.AddPaths(cleared.GetCleared(), PolyType::ptClip, true);
+    clip.AddPaths(cleared.GetClearedNear(toolShapeBB), PolyType::ptClip, true);
     Paths crossing;
-    clip.Execute(ClipType::ctDifference, crossing);
+    clip.Execute(ClipType::ctDifference, crossing, PolyFillType::pftEvenOdd, PolyFillType::pftNonZero);
     double collisionArea = 0;
     for (auto& p : crossing) {
         collisionArea += fabs(Area(p));
@@ -2396,7 +2665,7 @@ bool Adaptive2d::MakeLeadPath(
     double stepSize = min(MIN_STEP_CLIPPER * 8, 0.2 * stepOverScaled + 1);
 
     // make a copy of clearedArea to update as the path progresses (for lead out only)
-    ClearedArea clearedArea(toolRadiusScaled);
+    ClearedArea clearedArea(toolRadiusScaled, tiledClearedArea);
     clearedArea.SetClearedPaths(clearedAreaOriginal.GetCleared());
 
     // compute acceptable tool end locations
@@ -2957,7 +3226,7 @@ void Adaptive2d::ProcessPolyNode(
     DoublePoint toolDir;
 
     // Initialize cleared area from previously cleared paths
-    ClearedArea cleared(toolRadiusScaled);
+    ClearedArea cleared(toolRadiusScaled, tiledClearedArea);
     cleared.SetClearedPaths(initialClearedPaths);
 
     long stepScaled = long(MIN_STEP_CLIPPER);
@@ -2988,7 +3257,7 @@ void Adaptive2d::ProcessPolyNode(
 #ifdef DEV_MODE
     clock_t start_clock = clock();
 #endif
-    ClearedArea clearedBeforePass(toolRadiusScaled);
+    ClearedArea clearedBeforePass(toolRadiusScaled, tiledClearedArea);
     clearedBeforePass.SetClearedPaths(cleared.GetCleared());
 
     DoublePoint lastExpandToolDir = toolDir;
@@ -3077,8 +3346,6 @@ void Adaptive2d::ProcessPolyNode(
                 lastExpandToolDir = toolDir;
 
                 // Find nearby uncleared area in the forward direction
-                Paths clearedArea = cleared.GetCleared();
-
                 // 1.5 > sqrt(2) for the constructed triangle to contain possible steps
                 double dist = (stepScaled + toolRadiusScaled) * 1.5;
                 Path triangle = {toolPos};
@@ -3092,11 +3359,20 @@ void Adaptive2d::ProcessPolyNode(
                     {(long long)(toolPos.X + leftAngle.X * dist),
                      (long long)(toolPos.Y + leftAngle.Y * dist)}
                 );
+                BoundBox triangleBB(triangle[0]);
+                triangleBB.AddPoint(triangle[1]);
+                triangleBB.AddPoint(triangle[2]);
 
+                Paths clearedArea;
                 clip.Clear();
                 clip.AddPath(triangle, PolyType::ptSubject, true);
-                clip.AddPaths(clearedArea, PolyType::ptClip, true);
-                clip.Execute(ClipType::ctDifference, clearedArea);
+                clip.AddPaths(cleared.GetClearedNear(triangleBB), PolyType::ptClip, true);
+                clip.Execute(
+                    ClipType::ctDifference,
+                    clearedArea,
+                    PolyFillType::pftEvenOdd,
+                    PolyFillType::pftNonZero
+                );
 
                 if (clearedArea.size() == 0) {
                     continue;
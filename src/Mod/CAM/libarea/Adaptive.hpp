@@ -26,7 +26,9 @@
 #include "clipper2/clipper.h"
 #include <vector>
 #include <list>
+#include <map>
 #include <optional>
+#include <tuple>
 #include <time.h>
 
 #pragma once
@@ -91,7 +93,7 @@ struct AdaptiveOutput
     bool FinishingLeadInFailed = false;
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> separate regions are processed on copies of it in multiple threads
 
 class Adaptive2d
 {
@@ -106,6 +108,8 @@ public:
     bool forceInsideOut = true;
     bool finishingProfile = true;
     double keepToolDownDistRatio = 3.0;  // keep tool down distance ratio
+    int maxThreads = 1;  // threads for processing separate regions, 0 = number of cores
+    bool tiledClearedArea = true;  // false keeps the cleared area in one polygon set
     OperationType opType = OperationType::otClearingInside;
 
     std::list<AdaptiveOutput> Execute(
@@ -140,6 +144,7 @@ private:
 
     std::function<bool(TPaths)>* progressCallback = NULL;
     Path toolGeometry;  // tool geometry at coord 0,0, should not be modified
+    std::map<double, Paths> toolShapeCache;  // tool shape at coord 0,0 by clearance radius
 
     void ProcessPolyNode(
         Paths boundPaths,
@@ -147,6 +152,10 @@ private:
         Paths finishingPaths,
         const Paths& initialClearedPaths
     );
+    void ProcessRegions(
+        const std::vector<std::tuple<Paths, Paths, Paths>>& regions,
+        const Paths& initialClearedPaths
+    );
     bool FindEntryPoint(
         TPaths& progressPaths,
         const Paths& toolBoundPaths,
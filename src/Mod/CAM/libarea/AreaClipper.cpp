@@ -16,7 +16,7 @@ bool CArea::HolesLinked()
 }
 
 // static const double PI = 3.1415926535897932;
-double CArea::m_clipper_scale = 10000.0;
+thread_local double CArea::m_clipper_scale = 10000.0;
 
 // Convert between PointD (double) and Point64 (int64) with scaling
 static Point64 ToPoint64(const PointD& p)
@@ -29,7 +29,7 @@ static PointD ToPointD(const Point64& p)
     return PointD((double)p.x / CArea::m_clipper_scale, (double)p.y / CArea::m_clipper_scale);
 }
 
-static std::list<PointD> pts_for_AddVertex;
+static thread_local std::list<PointD> pts_for_AddVertex;
 
 static void AddPoint(const PointD& p)
 {
@@ -38,7 +38,7 @@ using namespace std;
 namespace heeks
 {
 
-CAreaOrderer* CInnerCurves::area_orderer = NULL;
+thread_local CAreaOrderer* CInnerCurves::area_orderer = NULL;
 
 CInnerCurves::CInnerCurves(shared_ptr<CInnerCurves> pOuter, shared_ptr<CCurve> curve)
     : m_pOuter(pOuter)
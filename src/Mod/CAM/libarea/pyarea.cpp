@@ -441,6 +441,8 @@ void init_pyarea(py::module& m)
         .def_readwrite("finishingProfile", &Adaptive2d::finishingProfile)
         .def_readwrite("tolerance", &Adaptive2d::tolerance)
         .def_readwrite("keepToolDownDistRatio", &Adaptive2d::keepToolDownDistRatio)
+        .def_readwrite("maxThreads", &Adaptive2d::maxThreads)
+        .def_readwrite("tiledClearedArea", &Adaptive2d::tiledClearedArea)
         .def_readwrite("opType", &Adaptive2d::opType);
 }
 
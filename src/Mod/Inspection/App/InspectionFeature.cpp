@@ -23,15 +23,30 @@
  ***************************************************************************/
 
 #include <boost/core/ignore_unused.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
 #include <numeric>
 #include <limits>
 
-#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
-#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepExtrema_ExtPC.hxx>
+#include <BRepExtrema_ExtPF.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <Standard_Version.hxx>
 #include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Vertex.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <gp_Pnt.hxx>
 
@@ -48,6 +63,7 @@
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/PointCoordinates.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Points/App/PointsFeature.h>
@@ -65,6 +81,11 @@ InspectActualMesh::InspectActualMesh(const Mesh::MeshObject& rMesh)
     Base::Matrix4D tmp;
     _clTrf = rMesh.getTransform();
     _bApply = _clTrf != tmp;
+    if (_bApply) {
+        // transform all points at once instead of one point per call of getPoint()
+        _points = std::make_unique<MeshCore::MeshPointCoordinates>(_mesh.GetPoints());
+        _points->Transform(_clTrf);
+    }
 }
 
 InspectActualMesh::~InspectActualMesh() = default;
@@ -76,11 +97,10 @@ unsigned long InspectActualMesh::countPoints() const
 
 Base::Vector3f InspectActualMesh::getPoint(unsigned long index) const
 {
-    Base::Vector3f point = _mesh.GetPoint(index);
-    if (_bApply) {
-        _clTrf.multVec(point, point);
+    if (_points) {
+        return _points->GetPoint(index);
     }
-    return point;
+    return _mesh.GetPoint(index);
 }
 
 // ----------------------------------------------------------------
@@ -202,7 +222,10 @@ protected:
         assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
     }
 
-    void AddFacet(const MeshCore::MeshGeomFacet& rclFacet, unsigned long ulFacetIndex)
+    void GetFacetCells(
+        const MeshCore::MeshGeomFacet& rclFacet,
+        std::vector<unsigned long>& cells
+    ) const
     {
         unsigned long ulX1;
         unsigned long ulY1;
@@ -225,21 +248,19 @@ protected:
                 for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
                     for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                         if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                            cells.push_back(GetCellIndex(ulX, ulY, ulZ));
                         }
                     }
                 }
             }
         }
         else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+            cells.push_back(GetCellIndex(ulX1, ulY1, ulZ1));
         }
     }
 
     void InitGrid() override
     {
-        unsigned long i, j;
-
         Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
         float fLengthX = clBBMesh.LengthX();
@@ -255,14 +276,7 @@ protected:
         _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
         _fMinZ = clBBMesh.MinZ - 0.5f;
 
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
+        _aulGrid.Resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
     }
 
     void RebuildGrid() override
@@ -270,12 +284,19 @@ protected:
         _ulCtElements = _pclMesh->CountFacets();
         InitGrid();
 
-        unsigned long i = 0;
-        MeshCore::MeshFacetIterator clFIter(*_pclMesh);
-        clFIter.Transform(_transform);
-        for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-            AddFacet(*clFIter, i++);
-        }
+        const MeshCore::MeshPointArray& points = _pclMesh->GetPoints();
+        const MeshCore::MeshFacetArray& facets = _pclMesh->GetFacets();
+        FillGrid(
+            _ulCtElements,
+            [this, &points, &facets](MeshCore::ElementIndex i, std::vector<unsigned long>& cells) {
+                const MeshCore::MeshFacet& face = facets[i];
+                MeshCore::MeshGeomFacet facet;
+                for (int j = 0; j < 3; j++) {
+                    facet._aclPoints[j] = _transform * points[face._aulPoints[j]];
+                }
+                GetFacetCells(facet, cells);
+            }
+        );
     }
 
 private:
@@ -474,48 +495,472 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
-    : _rShape(shape)
+namespace
+{
+// Bounding volume hierarchy over the triangulation of the faces of a shape
+class FaceTree
+{
+public:
+    void addTriangle(const MeshCore::MeshGeomFacet& facet, int face)
+    {
+        triangles.push_back(facet);
+        faceOfTriangle.push_back(face);
+    }
+
+    void build()
+    {
+        std::vector<int> order(triangles.size());
+        std::iota(order.begin(), order.end(), 0);
+        nodes.clear();
+        nodes.reserve(2 * triangles.size() / leafSize + 1);
+        if (!order.empty()) {
+            buildNode(order, 0, static_cast<int>(order.size()));
+        }
+
+        std::vector<MeshCore::MeshGeomFacet> sortedTriangles;
+        std::vector<int> sortedFaces;
+        sortedTriangles.reserve(order.size());
+        sortedFaces.reserve(order.size());
+        for (int index : order) {
+            sortedTriangles.push_back(triangles[index]);
+            sortedFaces.push_back(faceOfTriangle[index]);
+        }
+        triangles.swap(sortedTriangles);
+        faceOfTriangle.swap(sortedFaces);
+    }
+
+    /// Distance to the nearest triangle, or \a maxDist if there is none closer
+    float nearestDistance(const Base::Vector3f& pnt, float maxDist) const
+    {
+        traverse(pnt, maxDist, [&](int index, float& dist) {
+            dist = std::min(dist, triangles[index].DistanceToPoint(pnt));
+        });
+        return maxDist;
+    }
+
+    /// Calls \a func for the face of every triangle not farther than \a maxDist
+    template<typename Func>
+    void forEachFaceWithin(const Base::Vector3f& pnt, float maxDist, Func&& func) const
+    {
+        traverse(pnt, maxDist, [&](int index, float& dist) {
+            if (triangles[index].DistanceToPoint(pnt) <= dist) {
+                func(faceOfTriangle[index]);
+            }
+        });
+    }
+
+private:
+    static constexpr int leafSize = 4;
+
+    struct Node
+    {
+        Base::BoundBox3f box;
+        int first {0};
+        int count {0};  // zero for inner nodes
+        int second {0};  // the first child directly follows its parent
+    };
+
+    void buildNode(std::vector<int>& order, int first, int count)
+    {
+        Node node;
+        Base::BoundBox3f centers;
+        for (int i = first; i < first + count; i++) {
+            const MeshCore::MeshGeomFacet& facet = triangles[order[i]];
+            for (const auto& point : facet._aclPoints) {
+                node.box.Add(point);
+            }
+            centers.Add(facet.GetGravityPoint());
+        }
+
+        int index = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+        if (count <= leafSize) {
+            nodes[index].first = first;
+            nodes[index].count = count;
+            return;
+        }
+
+        // split at the median of the longest axis
+        unsigned short axis = 0;
+        if (centers.LengthY() > centers.LengthX()) {
+            axis = 1;
+        }
+        if (centers.LengthZ() > std::max(centers.LengthX(), centers.LengthY())) {
+            axis = 2;
+        }
+        int half = count / 2;
+        std::nth_element(
+            order.begin() + first,
+            order.begin() + first + half,
+            order.begin() + first + count,
+            [&](int lhs, int rhs) {
+                return triangles[lhs].GetGravityPoint()[axis]
+                    < triangles[rhs].GetGravityPoint()[axis];
+            }
+        );
+
+        buildNode(order, first, half);
+        nodes[index].second = static_cast<int>(nodes.size());
+        buildNode(order, first + half, count - half);
+    }
+
+    static float squareDistance(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+    {
+        float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+        float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+        float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Visits the triangles of all leaves not farther than maxDist, the nearer child first.
+    // The visitor may decrease maxDist to prune the remaining nodes.
+    template<typename Func>
+    void traverse(const Base::Vector3f& pnt, float& maxDist, Func&& func) const
+    {
+        if (nodes.empty()) {
+            return;
+        }
+
+        std::array<int, 128> stack {};
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+            if (squareDistance(node.box, pnt) > maxDist * maxDist) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (int i = node.first; i < node.first + node.count; i++) {
+                    func(i, maxDist);
+                }
+            }
+            else {
+                int first = index + 1;
+                int second = node.second;
+                float distFirst = squareDistance(nodes[first].box, pnt);
+                float distSecond = squareDistance(nodes[second].box, pnt);
+                if (distFirst > distSecond) {
+                    std::swap(first, second);
+                }
+                stack[top++] = second;
+                stack[top++] = first;
+            }
+        }
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> triangles;
+    std::vector<int> faceOfTriangle;
+    std::vector<Node> nodes;
+};
+}  // namespace
+
+struct InspectNominalShape::Private
 {
-    distss = new BRepExtrema_DistShapeShape();
-    distss->LoadS1(_rShape);
+    TopTools_IndexedMapOfShape faces;
+    TopTools_IndexedMapOfShape edges;
+    TopTools_IndexedMapOfShape vertices;
+    std::vector<gp_Pnt> points;
+    // the edges and vertices bounding each face
+    std::vector<std::vector<int>> faceEdges;
+    std::vector<std::vector<int>> faceVertices;
+    // sub-shapes that must always be measured because they are not in the tree
+    std::vector<int> freeFaces;
+    std::vector<int> freeEdges;
+    std::vector<int> freeVertices;
+    FaceTree tree;
+    // upper bound of the difference between the distance to the triangulation and to the faces
+    float margin {0.0F};
+
+    void mapShapes(const TopoDS_Shape& shape)
+    {
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        TopExp::MapShapes(shape, TopAbs_EDGE, edges);
+        TopExp::MapShapes(shape, TopAbs_VERTEX, vertices);
+
+        for (int i = 1; i <= vertices.Extent(); i++) {
+            points.push_back(BRep_Tool::Pnt(TopoDS::Vertex(vertices(i))));
+        }
+
+        std::vector<bool> edgeOnFace(edges.Extent());
+        std::vector<bool> vertexOnFace(vertices.Extent());
+        faceEdges.resize(faces.Extent());
+        faceVertices.resize(faces.Extent());
+        for (int i = 0; i < faces.Extent(); i++) {
+            TopTools_IndexedMapOfShape subShapes;
+            TopExp::MapShapes(faces(i + 1), TopAbs_EDGE, subShapes);
+            for (int j = 1; j <= subShapes.Extent(); j++) {
+                const TopoDS_Edge& edge = TopoDS::Edge(subShapes(j));
+                int index = edges.FindIndex(edge) - 1;
+                edgeOnFace[index] = true;
+                if (BRep_Tool::IsGeometric(edge) && !BRep_Tool::Degenerated(edge)) {
+                    faceEdges[i].push_back(index);
+                }
+            }
+            subShapes.Clear();
+            TopExp::MapShapes(faces(i + 1), TopAbs_VERTEX, subShapes);
+            for (int j = 1; j <= subShapes.Extent(); j++) {
+                int index = vertices.FindIndex(subShapes(j)) - 1;
+                vertexOnFace[index] = true;
+                faceVertices[i].push_back(index);
+            }
+        }
 
-    // When having a solid then use its shell because otherwise the distance
-    // for inner points will always be zero
-    if (!_rShape.IsNull() && _rShape.ShapeType() == TopAbs_SOLID) {
-        TopExp_Explorer xp;
-        xp.Init(_rShape, TopAbs_SHELL);
-        if (xp.More()) {
-            distss->LoadS1(xp.Current());
-            isSolid = true;
+        for (int i = 0; i < edges.Extent(); i++) {
+            const TopoDS_Edge& edge = TopoDS::Edge(edges(i + 1));
+            if (!edgeOnFace[i] && BRep_Tool::IsGeometric(edge) && !BRep_Tool::Degenerated(edge)) {
+                freeEdges.push_back(i);
+            }
+        }
+        for (int i = 0; i < vertices.Extent(); i++) {
+            if (!vertexOnFace[i]) {
+                freeVertices.push_back(i);
+            }
         }
     }
-    // distss->SetDeflection(radius);
+
+    void buildTree(const TopoDS_Shape& shape)
+    {
+        // The triangulation is only used to find the faces near to a point,
+        // so a moderate accuracy is sufficient. A copy of the topology is
+        // meshed because the shape belongs to another document object and
+        // meshing it would replace the triangulation it is displayed with.
+        double deflection = Part::TopoShape(shape).getAccuracy();
+        BRepBuilderAPI_Copy copy(shape, Standard_False, Standard_False);
+        BRepMesh_IncrementalMesh
+            mesher(copy.Shape(), deflection, Standard_False, 0.5, Standard_True);
+
+        double maxDeflection = deflection;
+        for (int i = 0; i < faces.Extent(); i++) {
+            const TopoDS_Face& face = TopoDS::Face(copy.ModifiedShape(faces(i + 1)));
+            TopLoc_Location loc;
+            const Handle(Poly_Triangulation)& mesh = BRep_Tool::Triangulation(face, loc);
+            if (mesh.IsNull() || mesh->NbTriangles() == 0) {
+                freeFaces.push_back(i);
+                continue;
+            }
+
+            maxDeflection = std::max(maxDeflection, mesh->Deflection());
+            gp_Trsf trsf = loc.Transformation();
+            auto node = [&](Standard_Integer index) {
+#if OCC_VERSION_HEX < 0x070600
+                gp_Pnt pnt = mesh->Nodes()(index);
+#else
+                gp_Pnt pnt = mesh->Node(index);
+#endif
+                pnt.Transform(trsf);
+                return Base::Vector3f(float(pnt.X()), float(pnt.Y()), float(pnt.Z()));
+            };
+            for (Standard_Integer j = 1; j <= mesh->NbTriangles(); j++) {
+                Standard_Integer n1 {}, n2 {}, n3 {};
+#if OCC_VERSION_HEX < 0x070600
+                mesh->Triangles()(j).Get(n1, n2, n3);
+#else
+                mesh->Triangle(j).Get(n1, n2, n3);
+#endif
+                tree.addTriangle(MeshCore::MeshGeomFacet(node(n1), node(n2), node(n3)), i);
+            }
+        }
+
+        tree.build();
+        margin = float(3.0 * maxDeflection);
+    }
+};
+
+struct InspectNominalShape::ThreadState
+{
+    ThreadState(const Private& shapeData, const TopoDS_Shape& shape, bool solid)
+        : data(shapeData)
+        , faceExtrema(shapeData.faces.Extent())
+        , edgeExtrema(shapeData.edges.Extent())
+        , faceProps(shapeData.faces.Extent())
+        , faceStamp(shapeData.faces.Extent())
+        , edgeStamp(shapeData.edges.Extent())
+        , vertexStamp(shapeData.vertices.Extent())
+    {
+        builder.MakeVertex(vertex, gp_Pnt(), Precision::Confusion());
+        if (solid) {
+            classifier.Load(shape);
+        }
+    }
+
+    void reset(const gp_Pnt& pnt3d)
+    {
+        builder.UpdateVertex(vertex, pnt3d, Precision::Confusion());
+        squareDistance = std::numeric_limits<double>::max();
+        nearestFace = -1;
+        if (++stamp == 0) {
+            std::ranges::fill(faceStamp, 0);
+            std::ranges::fill(edgeStamp, 0);
+            std::ranges::fill(vertexStamp, 0);
+            stamp = 1;
+        }
+    }
+
+    void addFace(int index)
+    {
+        if (faceStamp[index] == stamp) {
+            return;
+        }
+        faceStamp[index] = stamp;
+
+        const TopoDS_Face& face = TopoDS::Face(data.faces(index + 1));
+        auto& extrema = faceExtrema[index];
+        if (!extrema) {
+            extrema = std::make_unique<BRepExtrema_ExtPF>();
+            extrema->Initialize(face, Extrema_ExtFlag_MIN);
+        }
+
+        // only contains the solutions inside the face
+        extrema->Perform(vertex, face);
+        if (extrema->IsDone()) {
+            for (Standard_Integer i = 1; i <= extrema->NbExt(); i++) {
+                if (extrema->SquareDistance(i) < squareDistance) {
+                    squareDistance = extrema->SquareDistance(i);
+                    nearestFace = index;
+                    extrema->Parameter(i, u, v);
+                }
+            }
+        }
+
+        for (int edge : data.faceEdges[index]) {
+            addEdge(edge);
+        }
+        for (int corner : data.faceVertices[index]) {
+            addVertex(corner);
+        }
+    }
+
+    void addEdge(int index)
+    {
+        if (edgeStamp[index] == stamp) {
+            return;
+        }
+        edgeStamp[index] = stamp;
+
+        auto& extrema = edgeExtrema[index];
+        if (!extrema) {
+            extrema = std::make_unique<BRepExtrema_ExtPC>();
+            extrema->Initialize(TopoDS::Edge(data.edges(index + 1)));
+        }
+
+        extrema->Perform(vertex);
+        if (extrema->IsDone()) {
+            for (Standard_Integer i = 1; i <= extrema->NbExt(); i++) {
+                if (extrema->IsMin(i) && extrema->SquareDistance(i) < squareDistance) {
+                    squareDistance = extrema->SquareDistance(i);
+                    nearestFace = -1;
+                }
+            }
+        }
+    }
+
+    void addVertex(int index)
+    {
+        if (vertexStamp[index] == stamp) {
+            return;
+        }
+        vertexStamp[index] = stamp;
+
+        double dist = data.points[index].SquareDistance(BRep_Tool::Pnt(vertex));
+        if (dist < squareDistance) {
+            squareDistance = dist;
+            nearestFace = -1;
+        }
+    }
+
+    const Private& data;
+    BRep_Builder builder;
+    TopoDS_Vertex vertex;
+    // created on demand because most threads only see a part of the shape
+    std::vector<std::unique_ptr<BRepExtrema_ExtPF>> faceExtrema;
+    std::vector<std::unique_ptr<BRepExtrema_ExtPC>> edgeExtrema;
+    std::vector<std::unique_ptr<BRepGProp_Face>> faceProps;
+    BRepClass3d_SolidClassifier classifier;
+    // marks the sub-shapes already measured for the current point
+    std::vector<unsigned int> faceStamp;
+    std::vector<unsigned int> edgeStamp;
+    std::vector<unsigned int> vertexStamp;
+    unsigned int stamp {0};
+    // the nearest sub-shape so far, nearestFace is -1 for edges and vertices
+    double squareDistance {std::numeric_limits<double>::max()};
+    int nearestFace {-1};
+    Standard_Real u {0.0};
+    Standard_Real v {0.0};
+};
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float offset)
+    : d(std::make_unique<Private>())
+    , _rShape(shape)
+    , _offset(offset)
+{
+    if (_rShape.IsNull()) {
+        return;
+    }
+
+    // For a solid the distance to its faces is measured, otherwise the
+    // distance for inner points would always be zero
+    isSolid = _rShape.ShapeType() == TopAbs_SOLID;
+    d->mapShapes(_rShape);
+    d->buildTree(_rShape);
 }
 
-InspectNominalShape::~InspectNominalShape()
+InspectNominalShape::~InspectNominalShape() = default;
+
+InspectNominalShape::ThreadState& InspectNominalShape::getThreadState() const
 {
-    delete distss;
+    std::thread::id id = std::this_thread::get_id();
+    {
+        std::shared_lock lock(stateMutex);
+        auto it = threadStates.find(id);
+        if (it != threadStates.end()) {
+            return *it->second;
+        }
+    }
+
+    auto state = std::make_unique<ThreadState>(*d, _rShape, isSolid);
+    std::unique_lock lock(stateMutex);
+    auto& entry = threadStates[id];
+    entry = std::move(state);
+    return *entry;
 }
 
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
+    ThreadState& state = getThreadState();
     gp_Pnt pnt3d(point.x, point.y, point.z);
-    BRepBuilderAPI_MakeVertex mkVert(pnt3d);
-    distss->LoadS2(mkVert.Vertex());
+    state.reset(pnt3d);
+
+    // only the faces with a triangle nearly as close as the nearest triangle can be the nearest
+    float maxDist = _offset + d->margin;
+    float nearest = d->tree.nearestDistance(point, maxDist);
+    if (nearest < maxDist) {
+        d->tree.forEachFaceWithin(point, nearest + d->margin, [&](int face) {
+            state.addFace(face);
+        });
+    }
+    for (int face : d->freeFaces) {
+        state.addFace(face);
+    }
+    for (int edge : d->freeEdges) {
+        state.addEdge(edge);
+    }
+    for (int vertex : d->freeVertices) {
+        state.addVertex(vertex);
+    }
 
     float fMinDist = std::numeric_limits<float>::max();
-    if (distss->Perform() && distss->NbSolution() > 0) {
-        fMinDist = (float)distss->Value();
+    if (state.squareDistance < std::numeric_limits<double>::max()) {
+        fMinDist = (float)std::sqrt(state.squareDistance);
         // the shape is a solid, check if the vertex is inside
         if (isSolid) {
-            if (isInsideSolid(pnt3d)) {
+            if (isInsideSolid(state, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
         else if (fMinDist > 0) {
             // check if the distance was computed from a face
-            if (isBelowFace(pnt3d)) {
+            if (isBelowFace(state, pnt3d)) {
                 fMinDist = -fMinDist;
             }
         }
@@ -523,37 +968,29 @@ float InspectNominalShape::getDistance(const Base::Vector3f& point) const
     return fMinDist;
 }
 
-bool InspectNominalShape::isInsideSolid(const gp_Pnt& pnt3d) const
+bool InspectNominalShape::isInsideSolid(ThreadState& state, const gp_Pnt& pnt3d) const
 {
     const Standard_Real tol = 0.001;
-    BRepClass3d_SolidClassifier classifier(_rShape);
-    classifier.Perform(pnt3d, tol);
-    return (classifier.State() == TopAbs_IN);
-}
-
-bool InspectNominalShape::isBelowFace(const gp_Pnt& pnt3d) const
-{
-    // check if the distance was computed from a face
-    for (Standard_Integer index = 1; index <= distss->NbSolution(); index++) {
-        if (distss->SupportTypeShape1(index) == BRepExtrema_IsInFace) {
-            TopoDS_Shape face = distss->SupportOnShape1(index);
-            Standard_Real u, v;
-            distss->ParOnFaceS1(index, u, v);
-            // gp_Pnt pnt = distss->PointOnShape1(index);
-            BRepGProp_Face props(TopoDS::Face(face));
-            gp_Vec normal;
-            gp_Pnt center;
-            props.Normal(u, v, center, normal);
-            gp_Vec dir(center, pnt3d);
-            Standard_Real scalar = normal.Dot(dir);
-            if (scalar < 0) {
-                return true;
-            }
-            break;
-        }
+    state.classifier.Perform(pnt3d, tol);
+    return (state.classifier.State() == TopAbs_IN);
+}
+
+bool InspectNominalShape::isBelowFace(ThreadState& state, const gp_Pnt& pnt3d) const
+{
+    if (state.nearestFace < 0) {
+        return false;
     }
 
-    return false;
+    auto& props = state.faceProps[state.nearestFace];
+    if (!props) {
+        props = std::make_unique<BRepGProp_Face>(TopoDS::Face(d->faces(state.nearestFace + 1)));
+    }
+    gp_Vec normal;
+    gp_Pnt center;
+    props->Normal(state.u, state.v, center, normal);
+    gp_Vec dir(center, pnt3d);
+    Standard_Real scalar = normal.Dot(dir);
+    return scalar < 0;
 }
 
 // ----------------------------------------------------------------
@@ -793,8 +1230,6 @@ short Feature::mustExecute() const
 
 App::DocumentObjectExecReturn* Feature::execute()
 {
-    bool useMultithreading = true;
-
     App::DocumentObject* pcActual = Actual.getValue();
     if (!pcActual) {
         throw Base::ValueError("No actual geometry to inspect specified");
@@ -810,7 +1245,6 @@ App::DocumentObjectExecReturn* Feature::execute()
         actual = new InspectActualPoints(pts->Points.getValue());
     }
     else if (pcActual->isDerivedFrom<Part::Feature>()) {
-        useMultithreading = false;
         Part::Feature* part = static_cast<Part::Feature*>(pcActual);
         actual = new InspectActualShape(part->Shape.getShape());
     }
@@ -833,7 +1267,6 @@ App::DocumentObjectExecReturn* Feature::execute()
             nominal = new InspectNominalPoints(pts->Points.getValue(), this->SearchRadius.getValue());
         }
         else if (it->isDerivedFrom<Part::Feature>()) {
-            useMultithreading = false;
             Part::Feature* part = static_cast<Part::Feature*>(it);
             nominal = new InspectNominalShape(part->Shape.getValue(), this->SearchRadius.getValue());
         }
@@ -930,55 +1363,43 @@ App::DocumentObjectExecReturn* Feature::execute()
 
     DistanceInspectionRMS res;
 
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS
-        // computation
-        QFuture<DistanceInspectionRMS> future
-            = QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::SequencerLauncher seq("Inspecting...", 100);
-        unsigned int currentStep = 0;
-        const unsigned int steps = static_cast<unsigned int>(actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(
-            &watcher,
-            &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
-            [&](int value) {
-                if (steps == 0) {
-                    return;
-                }
-                const unsigned int step = (100U * static_cast<unsigned int>(value)) / steps;
-                if (step > currentStep) {
-                    currentStep = step;
-                    seq.next();
-                }
+    // Build vector of increasing indices
+    std::vector<unsigned long> index(count);
+    std::iota(index.begin(), index.end(), 0);
+    // Perform map-reduce operation : compute distances and update sum of squares for RMS
+    // computation
+    QFuture<DistanceInspectionRMS> future
+        = QtConcurrent::mappedReduced(index, fMap, &DistanceInspectionRMS::operator+=);
+    // Setup progress bar
+    Base::SequencerLauncher seq("Inspecting...", 100);
+    unsigned int currentStep = 0;
+    const unsigned int steps = static_cast<unsigned int>(actual->countPoints());
+    QFutureWatcher<DistanceInspectionRMS> watcher;
+    QObject::connect(
+        &watcher,
+        &QFutureWatcher<DistanceInspectionRMS>::progressValueChanged,
+        [&](int value) {
+            if (steps == 0) {
+                return;
+            }
+            const unsigned int step = (100U * static_cast<unsigned int>(value)) / steps;
+            if (step > currentStep) {
+                currentStep = step;
+                seq.next();
             }
-        );
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(
-            &watcher,
-            &QFutureWatcher<DistanceInspectionRMS>::finished,
-            &loop,
-            &QEventLoop::quit
-        );
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
-    }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "…";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
-
-        for (unsigned int i = 0; i < count; i++) {
-            res += fMap(i);
         }
-    }
+    );
+    // Keep UI responsive during computation
+    QEventLoop loop;
+    QObject::connect(
+        &watcher,
+        &QFutureWatcher<DistanceInspectionRMS>::finished,
+        &loop,
+        &QEventLoop::quit
+    );
+    watcher.setFuture(future);
+    loop.exec();
+    res = future.result();
 
     Base::Console().message(
         "RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
@@ -24,6 +24,11 @@
 
 #pragma once
 
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
@@ -32,13 +37,13 @@
 
 
 class TopoDS_Shape;
-class BRepExtrema_DistShapeShape;
 class gp_Pnt;
 
 namespace MeshCore
 {
 class MeshKernel;
 class MeshGrid;
+class MeshPointCoordinates;
 }  // namespace MeshCore
 
 namespace Mesh
@@ -80,6 +85,8 @@ private:
     const MeshCore::MeshKernel& _mesh;
     bool _bApply;
     Base::Matrix4D _clTrf;
+    /// The transformed points, if a transformation is applied
+    std::unique_ptr<MeshCore::MeshPointCoordinates> _points;
 };
 
 class InspectionExport InspectActualPoints: public InspectActualGeometry
@@ -160,6 +167,15 @@ private:
     Points::PointsGrid* _pGrid;
 };
 
+/**
+ * Computes the distance to the faces, edges and vertices of a shape.
+ *
+ * The triangulated faces are kept in a bounding volume hierarchy that narrows
+ * down the faces that can be the nearest ones to a point. Only for those the
+ * exact distance is computed. getDistance() can be called from several threads
+ * at once, every thread uses its own extrema algorithms and solid classifier.
+ * Points farther away than \a offset from the shape are not measured.
+ */
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
 {
 public:
@@ -167,14 +183,22 @@ public:
     ~InspectNominalShape() override;
     float getDistance(const Base::Vector3f&) const override;
 
+    FC_DISABLE_COPY_MOVE(InspectNominalShape)
+
 private:
-    bool isInsideSolid(const gp_Pnt&) const;
-    bool isBelowFace(const gp_Pnt&) const;
+    struct Private;
+    struct ThreadState;
+    ThreadState& getThreadState() const;
+    bool isInsideSolid(ThreadState&, const gp_Pnt&) const;
+    bool isBelowFace(ThreadState&, const gp_Pnt&) const;
 
 private:
-    BRepExtrema_DistShapeShape* distss;
+    std::unique_ptr<Private> d;
     const TopoDS_Shape& _rShape;
+    float _offset;
     bool isSolid {false};
+    mutable std::shared_mutex stateMutex;
+    mutable std::map<std::thread::id, std::unique_ptr<ThreadState>> threadStates;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
@@ -24,7 +24,10 @@
 
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
+#include <numeric>
+#include <thread>
 
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
@@ -32,6 +35,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -2235,3 +2239,174 @@ const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
 {
     return _norm[pos];
 }
+
+//----------------------------------------------------------------------------
+
+void MeshAdjacency::Build(std::size_t ulCtElements, const RowFunction& fRow)
+{
+    int threads = int(std::thread::hardware_concurrency());
+    _aulOffsets.assign(ulCtElements + 1, 0);
+
+    // first pass: count the neighbours of each element
+    parallel_for(ulCtElements, threads, [this, &fRow](std::size_t begin, std::size_t end) {
+        std::vector<ElementIndex> row;
+        for (std::size_t i = begin; i < end; i++) {
+            row.clear();
+            fRow(static_cast<ElementIndex>(i), row);
+            _aulOffsets[i + 1] = row.size();
+        }
+    });
+
+    std::partial_sum(_aulOffsets.begin(), _aulOffsets.end(), _aulOffsets.begin());
+    _aulIndices.resize(_aulOffsets.back());
+
+    // second pass: copy the neighbours to their final positions
+    parallel_for(ulCtElements, threads, [this, &fRow](std::size_t begin, std::size_t end) {
+        std::vector<ElementIndex> row;
+        for (std::size_t i = begin; i < end; i++) {
+            row.clear();
+            fRow(static_cast<ElementIndex>(i), row);
+            std::copy(row.begin(), row.end(), _aulIndices.begin() + _aulOffsets[i]);
+        }
+    });
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactPointToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::size_t ulCtPoints = _rclMesh.CountPoints();
+    int threads = int(std::thread::hardware_concurrency());
+
+    // calls func once for every distinct point of a facet
+    auto forEachPoint = [&rFacets](FacetIndex index, auto&& func) {
+        const PointIndex* pts = rFacets[index]._aulPoints;
+        func(pts[0]);
+        if (pts[1] != pts[0]) {
+            func(pts[1]);
+        }
+        if (pts[2] != pts[0] && pts[2] != pts[1]) {
+            func(pts[2]);
+        }
+    };
+
+    // count the facets of each point, the counter of point i is stored at position i+1
+    std::vector<std::size_t> cursor(ulCtPoints + 1, 0);
+    parallel_for(rFacets.size(), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            forEachPoint(i, [&cursor](PointIndex pt) {
+                std::atomic_ref<std::size_t> count(cursor[pt + 1]);
+                count.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    });
+
+    std::partial_sum(cursor.begin(), cursor.end(), cursor.begin());
+    _aulOffsets = cursor;
+    _aulIndices.resize(_aulOffsets.back());
+
+    // scatter the facets to the rows of their points
+    parallel_for(rFacets.size(), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            forEachPoint(i, [this, &cursor, i](PointIndex pt) {
+                std::atomic_ref<std::size_t> pos(cursor[pt]);
+                _aulIndices[pos.fetch_add(1, std::memory_order_relaxed)] = i;
+            });
+        }
+    });
+
+    // the order within a row depends on the scheduling of the threads
+    parallel_for(ulCtPoints, threads, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            auto first = _aulIndices.begin();
+            std::sort(first + _aulOffsets[i], first + _aulOffsets[i + 1]);
+        }
+    });
+}
+
+Base::Vector3f MeshCompactPointToFacets::GetNormal(PointIndex pos) const
+{
+    Base::Vector3f normal;
+    MeshGeomFacet f;
+    for (FacetIndex it : (*this)[pos]) {
+        f = _rclMesh.GetFacet(it);
+        normal += f.Area() * f.GetNormal();
+    }
+
+    normal.Normalize();
+    return normal;
+}
+
+void MeshCompactPointToFacets::Neighbours(
+    FacetIndex ulFacetInd,
+    float fMaxDist,
+    MeshCollector& collect
+) const
+{
+    std::set<FacetIndex> visited;
+    Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
+
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    SearchNeighbours(rFacets, ulFacetInd, clCenter, fMaxDist * fMaxDist, visited, collect);
+}
+
+void MeshCompactPointToFacets::SearchNeighbours(
+    const MeshFacetArray& rFacets,
+    FacetIndex index,
+    const Base::Vector3f& rclCenter,
+    float fMaxDist2,
+    std::set<FacetIndex>& visited,
+    MeshCollector& collect
+) const
+{
+    if (visited.find(index) != visited.end()) {
+        return;
+    }
+
+    const MeshFacet& face = rFacets[index];
+    if (Base::DistanceP2(rclCenter, _rclMesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
+        return;
+    }
+
+    visited.insert(index);
+    collect.Append(_rclMesh, index);
+    for (PointIndex ptIndex : face._aulPoints) {
+        for (FacetIndex j : (*this)[ptIndex]) {
+            SearchNeighbours(rFacets, j, rclCenter, fMaxDist2, visited, collect);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactFacetToFacets::Rebuild(const MeshCompactPointToFacets& vf)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(rFacets.size(), [&rFacets, &vf](FacetIndex index, std::vector<ElementIndex>& row) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            Row faces = vf[ptIndex];
+            row.insert(row.end(), faces.begin(), faces.end());
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    });
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactPointToPoints::Rebuild(const MeshCompactPointToFacets& vf)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(vf.CountElements(), [&rFacets, &vf](PointIndex index, std::vector<ElementIndex>& row) {
+        for (FacetIndex face : vf[index]) {
+            for (PointIndex ptIndex : rFacets[face]._aulPoints) {
+                if (ptIndex != index) {
+                    row.push_back(ptIndex);
+                }
+            }
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    });
+}
@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <set>
 #include <vector>
@@ -704,4 +706,178 @@ private:
     std::vector<Base::Vector3f> _norm;
 };
 
+/**
+ * The MeshAdjacency class stores the neighbours of all elements of a mesh in compressed
+ * form.
+ *
+ * Instead of one set per element the neighbour indices of all elements are kept in one
+ * contiguous array and a second array holds the offset of each element into it. Thus, the
+ * neighbours of element \a i are in the range [offsets[i], offsets[i+1]). The neighbours of
+ * each element are sorted in ascending order and contain no duplicates.
+ *
+ * Unlike the MeshRef* classes the compact structures cannot be modified after they are built.
+ */
+class MeshExport MeshAdjacency
+{
+public:
+    /** A read-only view to the neighbour indices of a single element. */
+    class Row
+    {
+    public:
+        using const_iterator = const ElementIndex*;
+
+        Row(const_iterator first, const_iterator last)
+            : _first(first)
+            , _last(last)
+        {}
+        const_iterator begin() const
+        {
+            return _first;
+        }
+        const_iterator end() const
+        {
+            return _last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_last - _first);
+        }
+        bool empty() const
+        {
+            return _first == _last;
+        }
+
+    private:
+        const_iterator _first;
+        const_iterator _last;
+    };
+
+    /** Returns the neighbours of the given element. */
+    Row operator[](ElementIndex pos) const
+    {
+        const ElementIndex* data = _aulIndices.data();
+        return {data + _aulOffsets[pos], data + _aulOffsets[pos + 1]};
+    }
+    /** Returns the number of elements. */
+    std::size_t CountElements() const
+    {
+        return _aulOffsets.empty() ? 0 : _aulOffsets.size() - 1;
+    }
+    /** Returns the number of stored neighbour indices of all elements. */
+    std::size_t CountEntries() const
+    {
+        return _aulIndices.size();
+    }
+
+protected:
+    /** Writes the sorted neighbours of an element to the passed, empty array. */
+    using RowFunction = std::function<void(ElementIndex, std::vector<ElementIndex>&)>;
+
+    /** Rebuilds the rows of \a ulCtElements elements. \a fRow is called twice for each element,
+     * possibly concurrently from several threads for different elements: the first pass counts
+     * the neighbours of all elements, the second pass copies them to their final positions.
+     */
+    void Build(std::size_t ulCtElements, const RowFunction& fRow);
+
+    // NOLINTBEGIN
+    std::vector<std::size_t> _aulOffsets;
+    std::vector<ElementIndex> _aulIndices;
+    // NOLINTEND
+};
+
+/**
+ * The MeshCompactPointToFacets is the compact counterpart of MeshRefPointToFacets.
+ * The facets indexing a point are determined in parallel.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToFacets: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the area weighted average of the normals of the facets indexing the point.
+    Base::Vector3f GetNormal(PointIndex) const;
+    /// Collects all facets whose gravity points are closer than \a fMaxDist to the gravity
+    /// point of the facet \a ulFacetInd and which are connected to it over a path of such facets.
+    void Neighbours(FacetIndex ulFacetInd, float fMaxDist, MeshCollector& collect) const;
+
+private:
+    void SearchNeighbours(
+        const MeshFacetArray& rFacets,
+        FacetIndex index,
+        const Base::Vector3f& rclCenter,
+        float fMaxDist2,
+        std::set<FacetIndex>& visited,
+        MeshCollector& collect
+    ) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactFacetToFacets is the compact counterpart of MeshRefFacetToFacets.
+ * As there, the facets sharing a point with a facet include the facet itself.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactFacetToFacets: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactFacetToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild(MeshCompactPointToFacets(rclM));
+    }
+    /// Construction from the facets of all points of the same mesh
+    MeshCompactFacetToFacets(const MeshKernel& rclM, const MeshCompactPointToFacets& vf)
+        : _rclMesh(rclM)
+    {
+        Rebuild(vf);
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild(const MeshCompactPointToFacets&);
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactPointToPoints is the compact counterpart of MeshRefPointToPoints.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToPoints: public MeshAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToPoints(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild(MeshCompactPointToFacets(rclM));
+    }
+    /// Construction from the facets of all points of the same mesh
+    MeshCompactPointToPoints(const MeshKernel& rclM, const MeshCompactPointToFacets& vf)
+        : _rclMesh(rclM)
+    {
+        Rebuild(vf);
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild(const MeshCompactPointToFacets&);
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
 }  // namespace MeshCore
@@ -24,6 +24,7 @@
 
 
 #include <algorithm>
+#include <thread>
 
 
 #include <Base/Exception.h>
@@ -56,6 +57,7 @@ void MeshBuilder::SetTolerance(float fTol)
 
 void MeshBuilder::Initialize(size_t ctFacets, bool deletion)
 {
+    _meshKernel.IncrementRevision();
     if (deletion) {
         // Clear the mesh structure and free all memory
         _meshKernel.Clear();
@@ -270,6 +272,7 @@ void MeshBuilder::Finish(bool freeMemory)
     }
 
     _meshKernel.RecalcBoundBox();
+    _meshKernel.IncrementRevision();
 }
 
 // ----------------------------------------------------------------------------
@@ -355,45 +358,94 @@ void MeshFastBuilder::AddFacet(const MeshGeomFacet& facetPoints)
     }
 }
 
+void MeshFastBuilder::AddFacets(
+    size_type ctFacets,
+    const std::function<void(size_type, Base::Vector3f*)>& facetPoints
+)
+{
+    QVector<Private::Vertex>& verts = p->verts;
+    auto offset = verts.size();
+    verts.resize(offset + 3 * ctFacets);
+    Private::Vertex* data = verts.data() + offset;
+
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_for(size_t(ctFacets), threads, [data, &facetPoints](size_t begin, size_t end) {
+        Base::Vector3f points[3];
+        for (size_t i = begin; i < end; i++) {
+            facetPoints(static_cast<size_type>(i), points);
+            for (int j = 0; j < 3; j++) {
+                data[3 * i + j] = Private::Vertex(points[j].x, points[j].y, points[j].z);
+            }
+        }
+    });
+}
+
 void MeshFastBuilder::Finish()
 {
-    using size_type = QVector<Private::Vertex>::size_type;
     QVector<Private::Vertex>& verts = p->verts;
-    size_type ulCtPts = verts.size();
-    for (size_type i = 0; i < ulCtPts; ++i) {
-        verts[i].i = i;
-    }
+    size_t ulCtPts = static_cast<size_t>(verts.size());
+    Private::Vertex* data = verts.data();
 
-    // std::sort(verts.begin(), verts.end());
     int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_for(ulCtPts, threads, [data](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            data[i].i = static_cast<MeshFastBuilder::size_type>(i);
+        }
+    });
+
+    // std::sort(verts.begin(), verts.end());
     MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
+    data = verts.data();
 
-    QVector<FacetIndex> indices(ulCtPts);
+    // Merge the duplicated points of the sorted array in parallel: Each chunk first counts the
+    // distinct points that start in it so that afterwards it knows the index of its first point.
+    auto isNewPoint = [data](size_t i) {
+        return i == 0 || data[i] != data[i - 1];
+    };
 
-    size_type vertex_count = 0;
-    for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
-        if (!vertex_count || *v != verts[vertex_count - 1]) {
-            verts[vertex_count++] = *v;
+    size_t chunks = std::max<size_t>(std::min<size_t>(std::max(threads, 1), ulCtPts), 1);
+    std::vector<size_t> chunkStart(chunks + 1, 0);
+    MeshCore::parallel_for(chunks, int(chunks), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            size_t count = 0;
+            for (size_t i = ulCtPts * c / chunks; i < ulCtPts * (c + 1) / chunks; i++) {
+                if (isNewPoint(i)) {
+                    count++;
+                }
+            }
+            chunkStart[c + 1] = count;
         }
-
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
+    });
+    for (size_t c = 0; c < chunks; c++) {
+        chunkStart[c + 1] += chunkStart[c];
     }
 
-    size_type ulCt = verts.size() / 3;
-    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i = 0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3 * i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3 * i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
-    }
+    std::vector<PointIndex> indices(ulCtPts);
+    MeshPointArray rPoints(static_cast<PointIndex>(chunkStart[chunks]));
+    MeshCore::parallel_for(chunks, int(chunks), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            size_t next = chunkStart[c];
+            for (size_t i = ulCtPts * c / chunks; i < ulCtPts * (c + 1) / chunks; i++) {
+                const Private::Vertex& v = data[i];
+                if (isNewPoint(i)) {
+                    rPoints[next++] = MeshPoint(v.x, v.y, v.z);
+                }
+                indices[v.i] = static_cast<PointIndex>(next - 1);
+            }
+        }
+    });
 
-    verts.resize(vertex_count);
+    size_t ulCt = ulCtPts / 3;
+    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
+    MeshCore::parallel_for(ulCt, threads, [&rFacets, &indices](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            rFacets[i]._aulPoints[0] = indices[3 * i];
+            rFacets[i]._aulPoints[1] = indices[3 * i + 1];
+            rFacets[i]._aulPoints[2] = indices[3 * i + 2];
+        }
+    });
 
-    MeshPointArray rPoints;
-    rPoints.reserve(static_cast<size_t>(vertex_count));
-    for (const auto& v : verts) {
-        rPoints.push_back(MeshPoint(v.x, v.y, v.z));
-    }
+    verts.clear();
 
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <functional>
 #include <set>
 #include <vector>
 
@@ -221,6 +222,13 @@ public:
     /** Add new facet
      */
     void AddFacet(const MeshGeomFacet& facetPoints);
+    /** Add \a ctFacets new facets at once. \a facetPoints(i, points) must write the three points
+     * of the i-th facet to \a points. It is called concurrently from several threads.
+     */
+    void AddFacets(
+        size_type ctFacets,
+        const std::function<void(size_type, Base::Vector3f*)>& facetPoints
+    );
 
     /** Finishes building up the mesh structure. Must be done after adding facets.
      */
@@ -69,7 +69,7 @@ MeshCurvature::MeshCurvature(const MeshKernel& kernel, std::vector<FacetIndex> s
 void MeshCurvature::ComputePerFace(bool parallel)
 {
     myCurvature.clear();
-    MeshRefPointToFacets search(myKernel);
+    MeshCompactPointToFacets search(myKernel);
     FacetCurvature face(myKernel, search, myRadius, myMinPoints);
 
     if (!parallel) {
@@ -129,8 +129,8 @@ void MeshCurvature::ComputePerVertex()
     // get all points
     const MeshPointArray& pts = myKernel.GetPoints();
 
-    MeshCore::MeshRefPointToFacets pt2f(myKernel);
-    MeshCore::MeshRefPointToPoints pt2p(myKernel);
+    MeshCore::MeshCompactPointToFacets pt2f(myKernel);
+    MeshCore::MeshCompactPointToPoints pt2p(myKernel, pt2f);
     unsigned long numPoints = myKernel.CountPoints();
 
     myCurvature.clear();
@@ -164,9 +164,8 @@ void MeshCurvature::ComputePerVertex()
 
         int iV0 = i;
         int iV1;
-        const std::set<unsigned long>& nb = pt2p[i];
-        for (std::set<unsigned long>::const_iterator it = nb.begin(); it != nb.end(); ++it) {
-            iV1 = *it;
+        for (PointIndex it : pt2p[i]) {
+            iV1 = it;
 
             // Compute edge from V0 to V1, project to tangent plane of vertex,
             // and compute difference of adjacent normals.
@@ -380,11 +379,33 @@ FacetCurvature::FacetCurvature(
     unsigned long pt
 )
     : myKernel(kernel)
-    , mySearch(search)
+    , myRefSearch(&search)
     , myMinPoints(pt)
     , myRadius(r)
 {}
 
+FacetCurvature::FacetCurvature(
+    const MeshKernel& kernel,
+    const MeshCompactPointToFacets& search,
+    float r,
+    unsigned long pt
+)
+    : myKernel(kernel)
+    , myCompactSearch(&search)
+    , myMinPoints(pt)
+    , myRadius(r)
+{}
+
+void FacetCurvature::Neighbours(FacetIndex index, float distance, MeshCollector& collect) const
+{
+    if (myCompactSearch) {
+        myCompactSearch->Neighbours(index, distance, collect);
+    }
+    else {
+        myRefSearch->Neighbours(index, distance, collect);
+    }
+}
+
 CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
 {
     Base::Vector3f rkDir0, rkDir1;
@@ -399,7 +420,7 @@ CurvatureInfo FacetCurvature::Compute(FacetIndex index) const
     float searchDist = myRadius;
     int attempts = 0;
     do {
-        mySearch.Neighbours(index, searchDist, collect);
+        Neighbours(index, searchDist, collect);
         if (point_indices.empty()) {
             break;
         }
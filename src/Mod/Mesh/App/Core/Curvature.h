@@ -32,7 +32,9 @@ namespace MeshCore
 {
 
 class MeshKernel;
+class MeshCollector;
 class MeshRefPointToFacets;
+class MeshCompactPointToFacets;
 
 /** Curvature information. */
 struct MeshExport CurvatureInfo
@@ -44,12 +46,28 @@ struct MeshExport CurvatureInfo
 class MeshExport FacetCurvature
 {
 public:
-    FacetCurvature(const MeshKernel& kernel, const MeshRefPointToFacets& search, float, unsigned long);
+    FacetCurvature(
+        const MeshKernel& kernel,
+        const MeshRefPointToFacets& search,
+        float,
+        unsigned long
+    );
+    FacetCurvature(
+        const MeshKernel& kernel,
+        const MeshCompactPointToFacets& search,
+        float,
+        unsigned long
+    );
     CurvatureInfo Compute(FacetIndex index) const;
 
+private:
+    void Neighbours(FacetIndex index, float distance, MeshCollector& collect) const;
+
 private:
     const MeshKernel& myKernel;
-    const MeshRefPointToFacets& mySearch;
+    // exactly one of the search structures is set
+    const MeshRefPointToFacets* myRefSearch {nullptr};
+    const MeshCompactPointToFacets* myCompactSearch {nullptr};
     unsigned long myMinPoints;
     float myRadius;
 };
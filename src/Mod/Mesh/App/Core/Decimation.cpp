@@ -22,15 +22,129 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <ostream>
+#include <thread>
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
+namespace
+{
+
+/**
+ * Splits the facets of a mesh into spatially compact blocks of at most \a blockSize facets. The
+ * facet centers are split at the median along the longest axis until the blocks are small enough,
+ * so that the blocks have about the same size no matter how the facets are distributed.
+ */
+class MeshBlocks
+{
+public:
+    MeshBlocks(const MeshKernel& kernel, std::size_t blockSize)
+        : blockSize(std::max<std::size_t>(blockSize, 1))
+    {
+        const MeshPointArray& points = kernel.GetPoints();
+        const MeshFacetArray& facets = kernel.GetFacets();
+        centers.reserve(facets.size());
+        for (const auto& facet : facets) {
+            centers.push_back(
+                (points[facet._aulPoints[0]] + points[facet._aulPoints[1]]
+                 + points[facet._aulPoints[2]])
+                / 3.0F
+            );
+        }
+
+        sorted.resize(facets.size());
+        for (std::size_t i = 0; i < sorted.size(); i++) {
+            sorted[i] = FacetIndex(i);
+        }
+
+        offsets.push_back(0);
+        if (!sorted.empty()) {
+            Split(0, sorted.size());
+        }
+        centers.clear();
+        centers.shrink_to_fit();
+
+        // points used by the facets of more than one block must not be changed
+        std::vector<std::uint32_t> owner(points.size(), std::numeric_limits<std::uint32_t>::max());
+        locked.resize(points.size(), 0);
+        for (std::size_t block = 0; block < CountBlocks(); block++) {
+            for (std::size_t i = offsets[block]; i < offsets[block + 1]; i++) {
+                for (PointIndex point : facets[sorted[i]]._aulPoints) {
+                    if (owner[point] == std::numeric_limits<std::uint32_t>::max()) {
+                        owner[point] = std::uint32_t(block);
+                    }
+                    else if (owner[point] != block) {
+                        locked[point] = 1;
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t CountBlocks() const
+    {
+        return offsets.size() - 1;
+    }
+
+    /// The facets of all blocks, those of block i are in [offsets[i], offsets[i + 1]).
+    std::vector<FacetIndex> sorted;
+    std::vector<std::size_t> offsets;
+    /// Non-zero for every point that is shared by several blocks.
+    std::vector<char> locked;
+
+private:
+    void Split(std::size_t begin, std::size_t end)
+    {
+        if (end - begin <= blockSize) {
+            offsets.push_back(end);
+            return;
+        }
+
+        Base::BoundBox3f box;
+        for (std::size_t i = begin; i < end; i++) {
+            box.Add(centers[sorted[i]]);
+        }
+        std::array<float, 3> length = {box.LengthX(), box.LengthY(), box.LengthZ()};
+        auto axis = int(std::max_element(length.begin(), length.end()) - length.begin());
+
+        std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(
+            sorted.begin() + std::ptrdiff_t(begin),
+            sorted.begin() + std::ptrdiff_t(mid),
+            sorted.begin() + std::ptrdiff_t(end),
+            [this, axis](FacetIndex lhs, FacetIndex rhs) {
+                return centers[lhs][axis] < centers[rhs][axis];
+            }
+        );
+        Split(begin, mid);
+        Split(mid, end);
+    }
+
+    std::size_t blockSize;
+    std::vector<Base::Vector3f> centers;
+};
+
+/// The simplified facets of a block
+struct BlockResult
+{
+    std::vector<Simplify::Vertex> vertices;
+    std::vector<Simplify::Triangle> triangles;
+};
+
+}  // namespace
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
     : myKernel(mesh)
 {}
@@ -154,3 +268,164 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+template<class Func>
+void MeshSimplify::simplifyBlocks(const BlockParameters& params, Func&& consume) const
+{
+    const MeshPointArray& points = myKernel.GetPoints();
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    MeshBlocks blocks(myKernel, params.blockSize);
+
+    auto simplifyBlock = [&](std::size_t block, BlockResult& result) {
+        std::size_t begin = blocks.offsets[block];
+        std::size_t end = blocks.offsets[block + 1];
+
+        // the points of the block, sorted by their index in the mesh
+        std::vector<PointIndex> pointIndices;
+        pointIndices.reserve(3 * (end - begin));
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[blocks.sorted[i]];
+            pointIndices.insert(pointIndices.end(), facet._aulPoints, facet._aulPoints + 3);
+        }
+        std::sort(pointIndices.begin(), pointIndices.end());
+        pointIndices.erase(std::unique(pointIndices.begin(), pointIndices.end()), pointIndices.end());
+
+        Simplify alg;
+        alg.vertices.reserve(pointIndices.size());
+        for (PointIndex index : pointIndices) {
+            Simplify::Vertex v;
+            v.tstart = 0;
+            v.tcount = 0;
+            v.border = 0;
+            v.p = points[index];
+            if (blocks.locked[index]) {
+                v.locked = 1;
+                v.id = int(index);
+            }
+            alg.vertices.push_back(v);
+        }
+
+        alg.triangles.reserve(end - begin);
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[blocks.sorted[i]];
+            Simplify::Triangle t;
+            t.deleted = 0;
+            t.dirty = 0;
+            for (double& j : t.err) {
+                j = 0.0;
+            }
+            for (int j = 0; j < 3; j++) {
+                auto it = std::lower_bound(
+                    pointIndices.begin(),
+                    pointIndices.end(),
+                    facet._aulPoints[j]
+                );
+                t.v[j] = int(it - pointIndices.begin());
+            }
+            alg.triangles.push_back(t);
+        }
+
+        if (params.maxDistance > 0.0F) {
+            // the quadric error is the sum of the squared distances to the planes of the facets
+            alg.max_error = double(params.maxDistance) * double(params.maxDistance);
+        }
+
+        auto numFacets = static_cast<float>(end - begin);
+        int target_count = static_cast<int>(numFacets * (1.0F - params.reduction));
+        alg.simplify_mesh(target_count, params.tolerance);
+
+        result.vertices.swap(alg.vertices);
+        result.triangles.swap(alg.triangles);
+    };
+
+    // simplify as many blocks at a time as threads are used and pass the results in order
+    int threads = params.threads > 0 ? params.threads : int(std::thread::hardware_concurrency());
+    std::size_t wave = std::max(threads, 1);
+    for (std::size_t first = 0; first < blocks.CountBlocks(); first += wave) {
+        std::size_t count = std::min(wave, blocks.CountBlocks() - first);
+        std::vector<BlockResult> results(count);
+        parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                simplifyBlock(first + i, results[i]);
+            }
+        });
+        for (auto& result : results) {
+            consume(result);
+        }
+    }
+}
+
+void MeshSimplify::simplify(const BlockParameters& params)
+{
+    MeshPointArray new_points;
+    MeshFacetArray new_facets;
+
+    // the locked points are shared by several blocks and must only be added once
+    std::vector<PointIndex> lockedIndex(myKernel.CountPoints(), POINT_INDEX_MAX);
+    simplifyBlocks(params, [&](BlockResult& result) {
+        std::vector<PointIndex> index(result.vertices.size());
+        for (std::size_t i = 0; i < result.vertices.size(); i++) {
+            const Simplify::Vertex& vertex = result.vertices[i];
+            if (vertex.id >= 0 && lockedIndex[vertex.id] != POINT_INDEX_MAX) {
+                index[i] = lockedIndex[vertex.id];
+                continue;
+            }
+
+            index[i] = PointIndex(new_points.size());
+            new_points.push_back(vertex.p);
+            if (vertex.id >= 0) {
+                lockedIndex[vertex.id] = index[i];
+            }
+        }
+
+        for (const auto& triangle : result.triangles) {
+            MeshFacet face;
+            face._aulPoints[0] = index[triangle.v[0]];
+            face._aulPoints[1] = index[triangle.v[1]];
+            face._aulPoints[2] = index[triangle.v[2]];
+            new_facets.push_back(face);
+        }
+    });
+
+    myKernel.Adopt(new_points, new_facets, true);
+}
+
+bool MeshSimplify::simplify(const BlockParameters& params, std::ostream& out) const
+{
+    std::ostream::pos_type start = out.tellp();
+    if (!out || start == std::ostream::pos_type(-1)) {
+        return false;
+    }
+
+    // the number of facets is written when all blocks are done
+    char header[80];
+    std::memset(header, ' ', sizeof(header));
+    std::memcpy(header, "MESH-MESH-MESH", 14);
+    out.write(header, sizeof(header));
+    uint32_t numFacets = 0;
+    out.write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+
+    simplifyBlocks(params, [&](BlockResult& result) {
+        uint16_t attribute = 0;
+        for (const auto& triangle : result.triangles) {
+            MeshGeomFacet facet(
+                result.vertices[triangle.v[0]].p,
+                result.vertices[triangle.v[1]].p,
+                result.vertices[triangle.v[2]].p
+            );
+            Base::Vector3f normal = facet.GetNormal();
+            out.write(reinterpret_cast<const char*>(&normal), 3 * sizeof(float));
+            for (const auto& point : facet._aclPoints) {
+                out.write(reinterpret_cast<const char*>(&point), 3 * sizeof(float));
+            }
+            out.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+        }
+        numFacets += uint32_t(result.triangles.size());
+    });
+
+    std::ostream::pos_type stop = out.tellp();
+    out.seekp(start + std::streamoff(sizeof(header)));
+    out.write(reinterpret_cast<const char*>(&numFacets), sizeof(numFacets));
+    out.seekp(stop);
+    return out.good();
+}
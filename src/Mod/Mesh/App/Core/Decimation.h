@@ -25,6 +25,9 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iosfwd>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
@@ -34,9 +37,48 @@ class MeshKernel;
 class MeshExport MeshSimplify
 {
 public:
+    /// Parameters of the block-wise simplification
+    struct BlockParameters
+    {
+        /// The share of facets to remove, between 0 and 1.
+        float reduction = 0.5F;
+        /// The tolerance of the quadric error, 0 to ignore it.
+        float tolerance = 0.0F;
+        /**
+         * Limits the quadric error of an edge collapse to the square of this value. The quadric
+         * error is the sum of the squared distances of the new point to the planes of the
+         * original facets merged into it, so no such plane is farther away than \a maxDistance.
+         * This is not a bound of the Hausdorff distance to the original mesh: the distance is
+         * measured to the infinite planes, not to the facets. 0 means no limit.
+         */
+        float maxDistance = 0.0F;
+        /// The approximate number of facets of a block.
+        std::size_t blockSize = 500000;
+        /// Number of blocks simplified at the same time, 0 means the number of cores.
+        int threads = 0;
+    };
+
     explicit MeshSimplify(MeshKernel&);
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
+    /**
+     * Splits the facets into spatial blocks of about \a blockSize facets and simplifies the
+     * blocks independently and in parallel. Points shared by several blocks are locked so that
+     * the blocks still fit together. Only the blocks that are simplified at the same time need
+     * the working memory of the algorithm, which allows it to reduce very large meshes.
+     */
+    void simplify(const BlockParameters&);
+    /**
+     * Simplifies the mesh like simplify(const BlockParameters&) but writes the facets of every
+     * block as binary STL to \a out as soon as it is done and keeps the mesh unchanged. The
+     * stream must be seekable to write the number of facets at the end. Returns false if writing
+     * failed.
+     */
+    bool simplify(const BlockParameters&, std::ostream& out) const;
+
+private:
+    template<class Func>
+    void simplifyBlocks(const BlockParameters&, Func&& consume) const;
 
 private:
     MeshKernel& myKernel;
@@ -24,6 +24,10 @@
 
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 
@@ -33,6 +37,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Evaluation.h"
+#include "FacetTree.h"
 #include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
@@ -306,88 +311,151 @@ bool MeshEvalSolid::Evaluate()
 
 // ----------------------------------------------------
 
-namespace MeshCore
+namespace
 {
 
-struct Edge_Index
-{
-    PointIndex p0, p1;
-    FacetIndex f;
-};
+using Edge_Index = MeshEdgeIndex::Edge;
 
 struct Edge_Less
 {
     bool operator()(const Edge_Index& x, const Edge_Index& y) const
     {
-        if (x.p0 < y.p0) {
-            return true;
+        if (x.p0 != y.p0) {
+            return x.p0 < y.p0;
         }
-        if (x.p0 > y.p0) {
-            return false;
+        if (x.p1 != y.p1) {
+            return x.p1 < y.p1;
         }
-        if (x.p1 < y.p1) {
-            return true;
+        // keep the facets of an edge in a defined order
+        return x.f < y.f;
+    }
+};
+
+int CountThreads(int threads)
+{
+    return threads > 0 ? threads : std::max(int(std::thread::hardware_concurrency()), 1);
+}
+
+// Writes the edges of the facets starting at index first to edges and sorts them.
+// Using and sorting a vector seems to be faster and more memory-efficient than a map.
+void SortedEdges(
+    const MeshFacetArray& facets,
+    FacetIndex first,
+    int threads,
+    std::vector<Edge_Index>& edges
+)
+{
+    std::size_t count = facets.size() - first;
+    edges.resize(3 * count);
+    parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const MeshFacet& facet = facets[first + i];
+            for (int j = 0; j < 3; j++) {
+                Edge_Index& item = edges[3 * i + j];
+                item.p0 = std::min<PointIndex>(facet._aulPoints[j], facet._aulPoints[(j + 1) % 3]);
+                item.p1 = std::max<PointIndex>(facet._aulPoints[j], facet._aulPoints[(j + 1) % 3]);
+                item.f = first + i;
+            }
         }
-        if (x.p1 > y.p1) {
-            return false;
+    });
+
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+}
+
+}  // namespace
+
+MeshEdgeIndex::MeshEdgeIndex(const MeshKernel& rclM, int threads)
+    : _ulRevision(rclM.GetRevision())
+{
+    SortedEdges(rclM.GetFacets(), 0, CountThreads(threads), _aclEdges);
+
+    _aulOffsets.push_back(0);
+    for (std::size_t i = 1; i < _aclEdges.size(); i++) {
+        const Edge& prev = _aclEdges[i - 1];
+        const Edge& next = _aclEdges[i];
+        if (prev.p0 != next.p0 || prev.p1 != next.p1) {
+            _aulOffsets.push_back(i);
         }
-        return false;
     }
-};
+    if (!_aclEdges.empty()) {
+        _aulOffsets.push_back(_aclEdges.size());
+    }
+}
+
+std::shared_ptr<const MeshEdgeIndex> MeshEvaluation::GetEdgeIndex() const
+{
+    // any modification of the mesh after building the index makes it useless
+    if (_edgeIndex && _edgeIndex->GetRevision() == _rclMesh.GetRevision()
+        && _edgeIndex->CountFacets() == _rclMesh.CountFacets()) {
+        return _edgeIndex;
+    }
+    return std::make_shared<const MeshEdgeIndex>(_rclMesh);
+}
 
-}  // namespace MeshCore
+// ----------------------------------------------------
 
-bool MeshEvalTopology::Evaluate()
+void MeshEvalPipeline::Add(MeshEvaluation& eval)
 {
-    // Using and sorting a vector seems to be faster and more memory-efficient
-    // than a map.
-    const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
+    evaluations.push_back(&eval);
+}
 
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking topology...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
+bool MeshEvalPipeline::Evaluate()
+{
+    auto usesEdges = [](const MeshEvaluation* eval) {
+        return eval->UsesEdgeIndex();
+    };
+    if (std::ranges::any_of(evaluations, usesEdges)) {
+        auto index = std::make_shared<const MeshEdgeIndex>(_rclMesh, threads);
+        for (MeshEvaluation* eval : evaluations) {
+            if (eval->UsesEdgeIndex()) {
+                eval->SetEdgeIndex(index);
+            }
         }
+    }
 
-        seq.next();
+    // each evaluation runs in its own thread as long as there are enough of them, except for
+    // those using the flags of the mesh which run afterwards
+    std::vector<std::size_t> concurrent;
+    std::vector<std::size_t> serial;
+    for (std::size_t i = 0; i < evaluations.size(); i++) {
+        (evaluations[i]->UsesMeshFlags() ? serial : concurrent).push_back(i);
+    }
+
+    results.assign(evaluations.size(), 0);
+    auto evaluate = [this, &concurrent](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t pos = concurrent[i];
+            results[pos] = evaluations[pos]->Evaluate() ? 1 : 0;
+        }
+    };
+    parallel_for(concurrent.size(), CountThreads(threads), evaluate);
+    for (std::size_t pos : serial) {
+        results[pos] = evaluations[pos]->Evaluate() ? 1 : 0;
     }
 
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    return std::ranges::find(results, 0) == results.end();
+}
+
+// ----------------------------------------------------
+
+bool MeshEvalTopology::Evaluate()
+{
+    std::shared_ptr<const MeshEdgeIndex> edges = GetEdgeIndex();
 
     // search for non-manifold edges
-    PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     nonManifoldList.clear();
     nonManifoldFacets.clear();
-
-    int count = 0;
-    std::vector<FacetIndex> facets;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            count++;
-            facets.push_back(pE->f);
-        }
-        else {
-            if (count > 2) {
-                // Edge that is shared by more than 2 facets
-                nonManifoldList.emplace_back(p0, p1);
-                nonManifoldFacets.push_back(facets);
+    for (std::size_t i = 0; i < edges->CountEdges(); i++) {
+        std::span<const MeshEdgeIndex::Edge> edge = (*edges)[i];
+        if (edge.size() > 2) {
+            // Edge that is shared by more than 2 facets
+            std::vector<FacetIndex> facets;
+            facets.reserve(edge.size());
+            for (const auto& it : edge) {
+                facets.push_back(it.f);
             }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            facets.clear();
-            facets.push_back(pE->f);
-            count = 1;
+            nonManifoldList.emplace_back(edge.front().p0, edge.front().p1);
+            nonManifoldFacets.push_back(facets);
         }
     }
 
@@ -401,13 +469,15 @@ void MeshEvalTopology::GetFacetManifolds(std::vector<FacetIndex>& raclFacetIndLi
     const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pI;
 
+    std::vector<std::pair<PointIndex, PointIndex>> nonManifolds(nonManifoldList);
+    std::ranges::sort(nonManifolds);
     for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
         for (int i = 0; i < 3; i++) {
             PointIndex ulPt0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
             PointIndex ulPt1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
             std::pair<PointIndex, PointIndex> edge = std::make_pair(ulPt0, ulPt1);
 
-            if (std::ranges::find(nonManifoldList, edge) != nonManifoldList.end()) {
+            if (std::ranges::binary_search(nonManifolds, edge)) {
                 raclFacetIndList.push_back(pI - rclFAry.begin());
             }
         }
@@ -478,16 +548,16 @@ bool MeshEvalPointManifolds::Evaluate()
     this->nonManifoldPoints.clear();
     this->facetsOfNonManifoldPoints.clear();
 
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshCompactPointToPoints vv_it(_rclMesh, vf_it);
 
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (PointIndex index = 0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<FacetIndex>& nf = vf_it[index];
-        const std::set<PointIndex>& np = vv_it[index];
+        MeshAdjacency::Row nf = vf_it[index];
+        MeshAdjacency::Row np = vv_it[index];
 
-        std::set<unsigned long>::size_type sp {}, sf {};
+        std::size_t sp {}, sf {};
         sp = np.size();
         sf = nf.size();
         // for an inner point the number of adjacent points is equal to the number of shared faces
@@ -600,81 +670,86 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+template<class Func>
+void MeshEvalSelfIntersection::SearchIntersections(Func&& func) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
+    // func(pairs, seq) gets the pairs of intersecting facets of a block of facets and returns
+    // false to stop the search
+    MeshFacetTree tree(_rclMesh);
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
+    using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
+    auto intersections = [&](FacetIndex index, FacetPairs& pairs) {
+        const MeshFacet& rface1 = rFaces[index];
+        MeshGeomFacet facet1 = _rclMesh.GetFacet(rface1);
+        std::size_t first = pairs.size();
         Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+        tree.Search(tree.GetBoundBox(index), [&](FacetIndex other) {
+            // every pair is only checked once
+            if (other <= index) {
+                return;
+            }
+            // If the facets share a common vertex we do not check for self-intersections
+            // because they could but usually do not intersect each other and the algorithm
+            // below would detect false-positives, otherwise
+            const MeshFacet& rface2 = rFaces[other];
+            for (PointIndex point : rface1._aulPoints) {
+                if (rface2.HasPoint(point)) {
+                    return;  // ignore facets sharing a common vertex
                 }
+            }
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
-                    }
+            MeshGeomFacet facet2 = _rclMesh.GetFacet(rface2);
+            if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                pairs.emplace_back(index, other);
+            }
+        });
+        std::sort(pairs.begin() + std::ptrdiff_t(first), pairs.end());
+    };
+
+    // The facets are checked in blocks by several threads, between the blocks the progress is
+    // reported and the search can be stopped.
+    int numThreads = CountThreads(threads);
+    std::size_t count = rFaces.size();
+    std::size_t blockSize = 4096 * std::size_t(numThreads);
+    std::size_t numBlocks = (count + blockSize - 1) / blockSize;
+    Base::SequencerLauncher seq("Checking for self-intersections...", numBlocks);
+    for (std::size_t start = 0; start < count; start += blockSize) {
+        std::size_t size = std::min(blockSize, count - start);
+        std::vector<FacetPairs> chunks(numThreads);
+        std::size_t numChunks = chunks.size();
+        parallel_for(numChunks, numThreads, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t chunk = begin; chunk < end; chunk++) {
+                std::size_t first = start + size * chunk / numChunks;
+                std::size_t last = start + size * (chunk + 1) / numChunks;
+                for (std::size_t index = first; index < last; index++) {
+                    intersections(FacetIndex(index), chunks[chunk]);
                 }
             }
+        });
+
+        FacetPairs pairs;
+        for (const auto& it : chunks) {
+            pairs.insert(pairs.end(), it.begin(), it.end());
+        }
+        if (!func(pairs, seq)) {
+            return;
         }
     }
+}
 
-    return true;
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    bool ok = true;
+    using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
+    SearchIntersections([&ok](const FacetPairs& pairs, Base::SequencerLauncher& seq) {
+        seq.next();
+        // abort after the first detected self-intersection
+        ok = pairs.empty();
+        return ok;
+    });
+
+    return ok;
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -707,77 +782,12 @@ void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection
 ) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
+    using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
+    SearchIntersections([&intersection](const FacetPairs& pairs, Base::SequencerLauncher& seq) {
         seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+        intersection.insert(intersection.end(), pairs.begin(), pairs.end());
+        return true;
+    });
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -817,7 +827,14 @@ bool MeshFixSelfIntersection::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalNeighbourhood::Evaluate()
+namespace
+{
+
+// Calls func(f0, f1) for the facets of all edges whose neighbourhood isn't set correctly. f1 is
+// FACET_INDEX_MAX for an open edge that isn't marked as such. The edges are checked by several
+// threads, so func may be called concurrently.
+template<class Func>
+void CheckNeighbourhood(const MeshFacetArray& rclFAry, const MeshEdgeIndex& edges, Func func)
 {
     // Note: If more than two facets are attached to the edge then we have a
     // non-manifold edge here.
@@ -826,44 +843,17 @@ bool MeshEvalNeighbourhood::Evaluate()
     // edges and thus we ignore this case.
     // Non-manifolds are an own category of errors and are handled by the class
     // MeshEvalTopology.
-    //
-    // Using and sorting a vector seems to be faster and more memory-efficient
-    // than a map.
-    const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
-        }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
-
-    PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
-    PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
-        }
-        else {
+    int threads = CountThreads(0);
+    parallel_for(edges.CountEdges(), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::span<const MeshEdgeIndex::Edge> edge = edges[i];
+            PointIndex p0 = edge.front().p0;
+            PointIndex p1 = edge.front().p1;
             // we handle only the cases for 1 and 2, for all higher
             // values we have a non-manifold that is ignored here
-            if (count == 2) {
+            if (edge.size() == 2) {
+                FacetIndex f0 = edge[0].f;
+                FacetIndex f1 = edge[1].f;
                 const MeshFacet& rFace0 = rclFAry[f0];
                 const MeshFacet& rFace1 = rclFAry[f1];
                 unsigned short side0 = rFace0.Side(p0, p1);
@@ -871,92 +861,44 @@ bool MeshEvalNeighbourhood::Evaluate()
                 // Check whether rFace0 and rFace1 reference each other as
                 // neighbours
                 if (rFace0._aulNeighbours[side0] != f1 || rFace1._aulNeighbours[side1] != f0) {
-                    return false;
+                    func(f0, f1);
                 }
             }
-            else if (count == 1) {
+            else if (edge.size() == 1) {
+                FacetIndex f0 = edge[0].f;
                 const MeshFacet& rFace = rclFAry[f0];
                 unsigned short side = rFace.Side(p0, p1);
                 // should be "open edge" but isn't marked as such
                 if (rFace._aulNeighbours[side] != FACET_INDEX_MAX) {
-                    return false;
+                    func(f0, FACET_INDEX_MAX);
                 }
             }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
         }
-    }
+    });
+}
 
-    return true;
+}  // namespace
+
+bool MeshEvalNeighbourhood::Evaluate()
+{
+    std::atomic<bool> ok {true};
+    CheckNeighbourhood(_rclMesh.GetFacets(), *GetEdgeIndex(), [&ok](FacetIndex, FacetIndex) {
+        ok = false;
+    });
+    return ok;
 }
 
 std::vector<FacetIndex> MeshEvalNeighbourhood::GetIndices() const
 {
     std::vector<FacetIndex> inds;
-    const MeshFacetArray& rclFAry = _rclMesh.GetFacets();
-    std::vector<Edge_Index> edges;
-    edges.reserve(3 * rclFAry.size());
-
-    // build up an array of edges
-    MeshFacetArray::_TConstIterator pI;
-    Base::SequencerLauncher seq("Checking indices...", rclFAry.size());
-    for (pI = rclFAry.begin(); pI != rclFAry.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - rclFAry.begin();
-            edges.push_back(item);
+    std::mutex mutex;
+    CheckNeighbourhood(_rclMesh.GetFacets(), *GetEdgeIndex(), [&](FacetIndex f0, FacetIndex f1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        inds.push_back(f0);
+        if (f1 != FACET_INDEX_MAX) {
+            inds.push_back(f1);
         }
-
-        seq.next();
-    }
-
-    // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
-
-    PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
-    PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
-    int count = 0;
-    std::vector<Edge_Index>::iterator pE;
-    for (pE = edges.begin(); pE != edges.end(); ++pE) {
-        if (p0 == pE->p0 && p1 == pE->p1) {
-            f1 = pE->f;
-            count++;
-        }
-        else {
-            // we handle only the cases for 1 and 2, for all higher
-            // values we have a non-manifold that is ignored here
-            if (count == 2) {
-                const MeshFacet& rFace0 = rclFAry[f0];
-                const MeshFacet& rFace1 = rclFAry[f1];
-                unsigned short side0 = rFace0.Side(p0, p1);
-                unsigned short side1 = rFace1.Side(p0, p1);
-                // Check whether rFace0 and rFace1 reference each other as
-                // neighbours
-                if (rFace0._aulNeighbours[side0] != f1 || rFace1._aulNeighbours[side1] != f0) {
-                    inds.push_back(f0);
-                    inds.push_back(f1);
-                }
-            }
-            else if (count == 1) {
-                const MeshFacet& rFace = rclFAry[f0];
-                unsigned short side = rFace.Side(p0, p1);
-                // should be "open edge" but isn't marked as such
-                if (rFace._aulNeighbours[side] != FACET_INDEX_MAX) {
-                    inds.push_back(f0);
-                }
-            }
-
-            p0 = pE->p0;
-            p1 = pE->p1;
-            f0 = pE->f;
-            count = 1;
-        }
-    }
+    });
 
     // remove duplicates
     std::sort(inds.begin(), inds.end());
@@ -973,25 +915,10 @@ bool MeshFixNeighbourhood::Fixup()
 
 void MeshKernel::RebuildNeighbours(FacetIndex index)
 {
+    IncrementRevision();
+    // build up a sorted array of edges
     std::vector<Edge_Index> edges;
-    edges.reserve(3 * (this->_aclFacetArray.size() - index));
-
-    // build up an array of edges
-    auto pB = this->_aclFacetArray.begin();
-    for (auto pI = pB + index; pI != this->_aclFacetArray.end(); ++pI) {
-        for (int i = 0; i < 3; i++) {
-            Edge_Index item {};
-            item.p0 = std::min<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.p1 = std::max<PointIndex>(pI->_aulPoints[i], pI->_aulPoints[(i + 1) % 3]);
-            item.f = pI - pB;
-            edges.push_back(item);
-        }
-    }
-
-    // sort the edges
-    // std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = int(std::thread::hardware_concurrency());
-    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
+    SortedEdges(this->_aclFacetArray, index, CountThreads(0), edges);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
     PointIndex f0 = FACET_INDEX_MAX, f1 = FACET_INDEX_MAX;
@@ -1045,6 +972,7 @@ void MeshKernel::RebuildNeighbours(FacetIndex index)
 
 void MeshKernel::RebuildNeighbours()
 {
+    IncrementRevision();
     // complete rebuild
     RebuildNeighbours(0);
 }
@@ -26,6 +26,8 @@
 
 #include <cmath>
 #include <list>
+#include <memory>
+#include <span>
 
 #include "MeshKernel.h"
 #include "Visitor.h"
@@ -34,6 +36,55 @@
 namespace MeshCore
 {
 
+/**
+ * The MeshEdgeIndex class holds the edges of all facets of a mesh sorted by their points, so that
+ * the facets sharing an edge are adjacent. The index is built in parallel and can be shared by all
+ * evaluations of the edges of the same mesh.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshEdgeIndex
+{
+public:
+    /** The edge of a facet, the points are sorted in ascending order. */
+    struct Edge
+    {
+        PointIndex p0, p1;
+        FacetIndex f;
+    };
+
+    /// Construction, \a threads is the number of threads to use, 0 means the number of cores.
+    explicit MeshEdgeIndex(const MeshKernel& rclM, int threads = 0);
+
+    /** Returns the number of distinct edges. */
+    std::size_t CountEdges() const
+    {
+        return _aulOffsets.size() - 1;
+    }
+    /** Returns the edges of all facets sharing the distinct edge \a pos, sorted by facet index. */
+    std::span<const Edge> operator[](std::size_t pos) const
+    {
+        return {_aclEdges.data() + _aulOffsets[pos], _aclEdges.data() + _aulOffsets[pos + 1]};
+    }
+    /** Returns the number of facets of the mesh the index was built for. */
+    FacetIndex CountFacets() const
+    {
+        return static_cast<FacetIndex>(_aclEdges.size() / 3);
+    }
+    /** Returns the revision of the mesh the index was built for. */
+    unsigned long GetRevision() const
+    {
+        return _ulRevision;
+    }
+
+private:
+    std::vector<Edge> _aclEdges;
+    std::vector<std::size_t> _aulOffsets;
+    unsigned long _ulRevision;
+};
+
+// ----------------------------------------------------
+
 /**
  * The MeshEvaluation class checks the mesh kernel for correctness with respect to a
  * certain criterion, such as manifoldness, self-intersections, etc.
@@ -63,9 +114,38 @@ public:
      */
     virtual bool Evaluate() = 0;
 
+    /**
+     * Lets the evaluation use the edges of \a index instead of building them again. The index
+     * is ignored as soon as the mesh has been modified after building it.
+     */
+    void SetEdgeIndex(std::shared_ptr<const MeshEdgeIndex> index)
+    {
+        _edgeIndex = std::move(index);
+    }
+    /// Returns true if the evaluation checks the edges of the mesh.
+    virtual bool UsesEdgeIndex() const
+    {
+        return false;
+    }
+    /**
+     * Returns true if the evaluation sets flags of the facets or points of the mesh. The flags
+     * are shared by all users of the mesh, so such an evaluation must not run at the same time
+     * as another one.
+     */
+    virtual bool UsesMeshFlags() const
+    {
+        return false;
+    }
+
 protected:
-    // NOLINTNEXTLINE
+    /// Returns the shared edge index or builds one if there is none or it is out of date.
+    std::shared_ptr<const MeshEdgeIndex> GetEdgeIndex() const;
+
+protected:
+    // NOLINTBEGIN
     const MeshKernel& _rclMesh; /**< Mesh kernel */
+    std::shared_ptr<const MeshEdgeIndex> _edgeIndex;
+    // NOLINTEND
 };
 
 // ----------------------------------------------------
@@ -103,6 +183,42 @@ protected:
 
 // ----------------------------------------------------
 
+/**
+ * The MeshEvalPipeline class runs several evaluations of the same mesh at the same time.
+ * The edges of the mesh are built once and shared by all evaluations that need them.
+ * The evaluations that use the flags of the mesh run one after another once the others are done.
+ */
+class MeshExport MeshEvalPipeline
+{
+public:
+    explicit MeshEvalPipeline(const MeshKernel& rclB)
+        : _rclMesh(rclB)
+    {}
+
+    /// Number of threads to use, 0 means the number of cores.
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+    /// Adds an evaluation of the same mesh which must exist until Evaluate() returns.
+    void Add(MeshEvaluation& eval);
+    /// Runs all evaluations and returns false if one of them failed.
+    bool Evaluate();
+    /// Returns the result of the evaluation added as \a pos.
+    bool GetResult(std::size_t pos) const
+    {
+        return results[pos] != 0;
+    }
+
+private:
+    const MeshKernel& _rclMesh;
+    std::vector<MeshEvaluation*> evaluations;
+    std::vector<char> results;
+    int threads {0};
+};
+
+// ----------------------------------------------------
+
 /**
  * This class searches for nonuniform orientation of neighboured facets.
  * @author Werner Mayer
@@ -161,6 +277,11 @@ class MeshExport MeshEvalOrientation: public MeshEvaluation
 public:
     explicit MeshEvalOrientation(const MeshKernel& rclM);
     bool Evaluate() override;
+    /// GetIndices() marks the visited facets
+    bool UsesMeshFlags() const override
+    {
+        return true;
+    }
     std::vector<FacetIndex> GetIndices() const;
 
 private:
@@ -206,6 +327,10 @@ public:
         : MeshEvaluation(rclB)
     {}
     bool Evaluate() override;
+    bool UsesEdgeIndex() const override
+    {
+        return true;
+    }
 
     void GetFacetManifolds(std::vector<FacetIndex>& raclFacetIndList) const;
     unsigned long CountManifolds() const;
@@ -339,6 +464,18 @@ public:
     ) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<FacetIndex, FacetIndex>>&) const;
+    /// Number of threads to use, 0 means the number of cores.
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+
+private:
+    template<class Func>
+    void SearchIntersections(Func&& func) const;
+
+private:
+    int threads {0};
 };
 
 /**
@@ -373,6 +510,10 @@ public:
         : MeshEvaluation(rclB)
     {}
     bool Evaluate() override;
+    bool UsesEdgeIndex() const override
+    {
+        return true;
+    }
     std::vector<FacetIndex> GetIndices() const;
 };
 
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include <algorithm>
+
+#include "FacetTree.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr std::size_t MaxLeafSize = 4;
+}  // namespace
+
+MeshFacetTree::MeshFacetTree(const MeshKernel& mesh)
+{
+    FacetIndex count = mesh.CountFacets();
+    std::vector<Base::Vector3f> centers;
+    boxes.reserve(count);
+    centers.reserve(count);
+    facets.resize(count);
+    for (FacetIndex i = 0; i < count; i++) {
+        MeshGeomFacet facet = mesh.GetFacet(i);
+        boxes.push_back(facet.GetBoundBox());
+        centers.push_back(boxes.back().GetCenter());
+        facets[i] = i;
+    }
+
+    if (count > 0) {
+        Build(0, count, centers);
+    }
+}
+
+std::uint32_t MeshFacetTree::Build(
+    std::size_t begin,
+    std::size_t end,
+    std::vector<Base::Vector3f>& centers
+)
+{
+    auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    Base::BoundBox3f box, centerBox;
+    for (std::size_t i = begin; i < end; i++) {
+        box.Add(boxes[facets[i]]);
+        centerBox.Add(centers[facets[i]]);
+    }
+    nodes[index].box = box;
+    nodes[index].begin = begin;
+    nodes[index].end = end;
+
+    float length[3] = {centerBox.LengthX(), centerBox.LengthY(), centerBox.LengthZ()};
+    int axis = int(std::max_element(length, length + 3) - length);
+    if (end - begin <= MaxLeafSize || length[axis] <= 0.0F) {
+        return index;
+    }
+
+    // split at the median of the facet centers along the longest axis
+    std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(
+        facets.begin() + std::ptrdiff_t(begin),
+        facets.begin() + std::ptrdiff_t(mid),
+        facets.begin() + std::ptrdiff_t(end),
+        [&centers, axis](FacetIndex lhs, FacetIndex rhs) {
+            return centers[lhs][axis] < centers[rhs][axis];
+        }
+    );
+    Build(begin, mid, centers);
+    nodes[index].right = Build(mid, end, centers);
+    return index;
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetTree class is a bounding volume hierarchy of the facets of a mesh.
+ *
+ * The facets are split at the median of their centers along the longest axis, so the tree is
+ * balanced however the facets are distributed. Unlike MeshFacetGrid it needs no cell size and
+ * each facet is stored only once. The tree can be searched by several threads at the same time.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshFacetTree
+{
+public:
+    /// Construction
+    explicit MeshFacetTree(const MeshKernel& mesh);
+
+    /// Calls \a func for every facet whose bounding box intersects \a box.
+    template<class Func>
+    void Search(const Base::BoundBox3f& box, Func func) const
+    {
+        if (nodes.empty()) {
+            return;
+        }
+
+        std::vector<std::uint32_t> stack {0};
+        while (!stack.empty()) {
+            std::uint32_t index = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[index];
+            if (!node.box.Intersect(box)) {
+                continue;
+            }
+            if (node.right == 0) {
+                for (std::size_t i = node.begin; i < node.end; i++) {
+                    if (boxes[facets[i]].Intersect(box)) {
+                        func(facets[i]);
+                    }
+                }
+            }
+            else {
+                stack.push_back(node.right);
+                stack.push_back(index + 1);
+            }
+        }
+    }
+    /// Returns the bounding box of the facet \a index.
+    const Base::BoundBox3f& GetBoundBox(FacetIndex index) const
+    {
+        return boxes[index];
+    }
+
+private:
+    std::uint32_t Build(std::size_t begin, std::size_t end, std::vector<Base::Vector3f>& centers);
+
+    /// Every node owns a contiguous range of the sorted facet indices, the left child of an inner
+    /// node directly follows it.
+    struct Node
+    {
+        Base::BoundBox3f box;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        /// The index of the right child, 0 for leaves.
+        std::uint32_t right = 0;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<FacetIndex> facets;
+    std::vector<Base::BoundBox3f> boxes;
+};
+
+}  // namespace MeshCore
@@ -25,7 +25,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <future>
+#include <vector>
 
 
 namespace MeshCore
@@ -61,4 +63,30 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/** Splits the index range [0, size) into at most \a threads contiguous chunks of about the same
+ * size and calls \a func(begin, end) for each of them. All but the first chunk are processed by
+ * separate threads. Exceptions thrown by \a func are passed to the caller.
+ */
+template<class Func>
+static void parallel_for(std::size_t size, int threads, Func func)
+{
+    std::size_t chunks = std::min<std::size_t>(std::max(threads, 1), size);
+    if (chunks < 2) {
+        func(std::size_t(0), size);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks - 1);
+    for (std::size_t i = 1; i < chunks; i++) {
+        std::size_t begin = size * i / chunks;
+        std::size_t end = size * (i + 1) / chunks;
+        futures.push_back(std::async(std::launch::async, [&func, begin, end]() { func(begin, end); }));
+    }
+    func(std::size_t(0), size / chunks);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 }  // namespace MeshCore
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <thread>
 
 #include "Algorithm.h"
 #include "Grid.h"
@@ -35,6 +36,105 @@
 
 using namespace MeshCore;
 
+void MeshGridCells::Resize(std::size_t ulCtCells)
+{
+    _aulElements.clear();
+    _aulOffsets.assign(ulCtCells + 1, 0);
+}
+
+void MeshGridCells::Clear()
+{
+    _aulElements.clear();
+    _aulOffsets.clear();
+}
+
+void MeshGridCells::Build(std::size_t ulCtCells, std::size_t ulCtElements, const CellFunction& fCells)
+{
+    // Each thread handles a contiguous range of elements and keeps its own cell counters.
+    // Because the ranges are ordered the elements of each cell end up in ascending order.
+    const std::size_t minElementsPerThread = 16384;
+    const std::size_t maxCounters = std::size_t(1) << 26;
+    std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    threads = std::min(threads, std::max<std::size_t>(ulCtElements / minElementsPerThread, 1));
+    threads = std::min(
+        threads,
+        std::max<std::size_t>(maxCounters / std::max<std::size_t>(ulCtCells, 1), 1)
+    );
+
+    struct Chunk
+    {
+        std::size_t begin {0};
+        std::size_t end {0};
+        std::vector<unsigned long> cells;   // cell indices of all elements of the chunk
+        std::vector<unsigned long> counts;  // number of cell indices per element
+        std::vector<std::size_t> offsets;   // per cell: counter, then write position
+    };
+
+    std::vector<Chunk> chunks(threads);
+    for (std::size_t t = 0; t < threads; t++) {
+        chunks[t].begin = ulCtElements * t / threads;
+        chunks[t].end = ulCtElements * (t + 1) / threads;
+    }
+
+    auto runParallel = [&chunks](auto&& func) {
+        if (chunks.size() == 1) {
+            func(chunks.front());
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(chunks.size());
+        for (Chunk& chunk : chunks) {
+            workers.emplace_back([&func, &chunk]() { func(chunk); });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // first pass: determine and count the cells of each element
+    runParallel([ulCtCells, &fCells](Chunk& chunk) {
+        chunk.offsets.assign(ulCtCells, 0);
+        chunk.counts.reserve(chunk.end - chunk.begin);
+        chunk.cells.reserve(chunk.end - chunk.begin);
+        for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+            std::size_t size = chunk.cells.size();
+            fCells(static_cast<ElementIndex>(i), chunk.cells);
+            chunk.counts.push_back(static_cast<unsigned long>(chunk.cells.size() - size));
+            for (std::size_t j = size; j < chunk.cells.size(); j++) {
+                chunk.offsets[chunk.cells[j]]++;
+            }
+        }
+    });
+
+    // turn the counters into write positions of each chunk
+    _aulOffsets.resize(ulCtCells + 1);
+    std::size_t total = 0;
+    for (std::size_t c = 0; c < ulCtCells; c++) {
+        _aulOffsets[c] = total;
+        for (Chunk& chunk : chunks) {
+            std::size_t count = chunk.offsets[c];
+            chunk.offsets[c] = total;
+            total += count;
+        }
+    }
+    _aulOffsets[ulCtCells] = total;
+
+    // second pass: scatter the element indices
+    _aulElements.resize(total);
+    ElementIndex* elements = _aulElements.data();
+    runParallel([elements](Chunk& chunk) {
+        const unsigned long* cell = chunk.cells.data();
+        for (std::size_t i = chunk.begin; i < chunk.end; i++) {
+            for (unsigned long j = 0; j < chunk.counts[i - chunk.begin]; j++) {
+                elements[chunk.offsets[*cell++]++] = static_cast<ElementIndex>(i);
+            }
+        }
+        chunk = Chunk();
+    });
+}
+
+// ----------------------------------------------------------------
+
 MeshGrid::MeshGrid(const MeshKernel& rclM)
     : _pclMesh(&rclM)
     , _ulCtElements(0)
@@ -71,7 +171,7 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulGrid.Clear();
     _pclMesh = nullptr;
 }
 
@@ -129,14 +229,12 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
-        }
-    }
+    _aulGrid.Resize(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ);
+}
+
+void MeshGrid::FillGrid(unsigned long ulCtElements, const MeshGridCells::CellFunction& fCells)
+{
+    _aulGrid.Build(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ, ulCtElements, fCells);
 }
 
 unsigned long MeshGrid::Inside(
@@ -161,8 +259,8 @@ unsigned long MeshGrid::Inside(
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements
-                    .insert(raulElements.end(), _aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                MeshGridCells::Cell cell = GetCell(i, j, k);
+                raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             }
         }
     }
@@ -203,11 +301,8 @@ unsigned long MeshGrid::Inside(
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(
-                        raulElements.end(),
-                        _aulGrid[i][j][k].begin(),
-                        _aulGrid[i][j][k].end()
-                    );
+                    MeshGridCells::Cell cell = GetCell(i, j, k);
+                    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
                 }
             }
         }
@@ -240,7 +335,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB, std::set<ElementIn
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                MeshGridCells::Cell cell = GetCell(i, j, k);
+                raulElements.insert(cell.begin(), cell.end());
             }
         }
     }
@@ -470,7 +566,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Cell cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -482,7 +579,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            MeshGridCells::Cell cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -494,7 +592,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Cell cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY++;
@@ -506,7 +605,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            MeshGridCells::Cell cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY--;
@@ -518,7 +618,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Cell cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ++;
@@ -530,7 +631,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt, std::set<Elemen
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            MeshGridCells::Cell cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ--;
@@ -634,10 +736,10 @@ unsigned long MeshGrid::GetElements(
     std::set<ElementIndex>& raclInd
 ) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    if (!rclSet.empty()) {
-        raclInd.insert(rclSet.begin(), rclSet.end());
-        return rclSet.size();
+    MeshGridCells::Cell cell = GetCell(ulX, ulY, ulZ);
+    if (!cell.empty()) {
+        raclInd.insert(cell.begin(), cell.end());
+        return cell.size();
     }
 
     return 0;
@@ -655,9 +757,8 @@ unsigned long MeshGrid::GetElements(
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    MeshGridCells::Cell cell = GetCell(ulX, ulY, ulZ);
+    aulFacets.assign(cell.begin(), cell.end());
     return aulFacets.size();
 }
 
@@ -774,13 +875,19 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
-    }
+    const MeshPointArray& rPoints = _pclMesh->GetPoints();
+    const MeshFacetArray& rFacets = _pclMesh->GetFacets();
+    FillGrid(
+        _ulCtElements,
+        [this, &rPoints, &rFacets](ElementIndex i, std::vector<unsigned long>& cells) {
+            const MeshFacet& rFacet = rFacets[i];
+            MeshGeomFacet clFacet;
+            clFacet._aclPoints[0] = rPoints[rFacet._aulPoints[0]];
+            clFacet._aclPoints[1] = rPoints[rFacet._aulPoints[1]];
+            clFacet._aclPoints[2] = rPoints[rFacet._aulPoints[2]];
+            GetFacetCells(clFacet, cells);
+        }
+    );
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -1028,8 +1135,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(
     ElementIndex& rulFacetInd
 ) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    for (ElementIndex pI : rclSet) {
+    for (ElementIndex pI : GetCell(ulX, ulY, ulZ)) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
             rfMinDist = fDist;
@@ -1071,15 +1177,14 @@ MeshPointGrid::MeshPointGrid(const MeshKernel& rclM, float fGridLen)
     );
 }
 
-void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon)
+void MeshPointGrid::GetPointCells(const MeshPoint& rclPt, std::vector<unsigned long>& raulCells) const
 {
-    (void)fEpsilon;
     unsigned long ulX {};
     unsigned long ulY {};
     unsigned long ulZ {};
     Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
     if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+        raulCells.push_back(GetCellIndex(ulX, ulY, ulZ));
     }
 }
 
@@ -1136,13 +1241,13 @@ void MeshPointGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-
-    MeshPointIterator cPIter(*_pclMesh);
-
-    unsigned long i = 0;
-    for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
-        AddPoint(*cPIter, i++);
-    }
+    const MeshPointArray& rPoints = _pclMesh->GetPoints();
+    FillGrid(
+        _ulCtElements,
+        [this, &rPoints](ElementIndex i, std::vector<unsigned long>& cells) {
+            GetPointCells(rPoints[i], cells);
+        }
+    );
 }
 
 void MeshPointGrid::Pos(
@@ -1215,11 +1320,8 @@ bool MeshGridIterator::InitOnRay(
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(
-            raulElements.end(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end()
-        );
+        MeshGridCells::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1234,11 +1336,8 @@ bool MeshGridIterator::InitOnRay(
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(
-                raulElements.end(),
-                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end()
-            );
+            MeshGridCells::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+            raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             _bValidRay = true;
         }
     }
@@ -1301,11 +1400,8 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(
-            raulElements.end(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end()
-        );
+        MeshGridCells::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     else {
         _bValidRay = false;  // Beam leaked
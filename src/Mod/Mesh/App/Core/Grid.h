@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include <functional>
 #include <limits>
 #include <set>
+#include <vector>
 
 #include <Base/BoundBox.h>
 
@@ -46,6 +48,88 @@ class MeshGrid;
 
 static constexpr float MESHGRID_BBOX_EXTENSION = 10.0F;
 
+/**
+ * The MeshGridCells class stores the element indices of all cells of a grid
+ * in compressed form.
+ *
+ * Instead of one container per cell the indices of all cells are kept in one
+ * contiguous array and a second array holds the offset of each cell into it.
+ * Thus, the elements of cell \a i are in the range [offsets[i], offsets[i+1]).
+ * The indices of each cell are sorted in ascending order.
+ */
+class MeshExport MeshGridCells
+{
+public:
+    /** A read-only view to the element indices of a single cell. */
+    class Cell
+    {
+    public:
+        using const_iterator = const ElementIndex*;
+
+        Cell(const_iterator first, const_iterator last)
+            : _first(first)
+            , _last(last)
+        {}
+        const_iterator begin() const
+        {
+            return _first;
+        }
+        const_iterator end() const
+        {
+            return _last;
+        }
+        std::size_t size() const
+        {
+            return static_cast<std::size_t>(_last - _first);
+        }
+        bool empty() const
+        {
+            return _first == _last;
+        }
+
+    private:
+        const_iterator _first;
+        const_iterator _last;
+    };
+
+    /** Appends the indices of all cells the element with the given index belongs to. */
+    using CellFunction = std::function<void(ElementIndex, std::vector<unsigned long>&)>;
+
+    /** Removes all elements and sets the number of (empty) cells. */
+    void Resize(std::size_t ulCtCells);
+    /** Removes all elements and cells. */
+    void Clear();
+    /** Rebuilds the cells for \a ulCtElements elements. \a fCells is called once for each
+     * element, possibly concurrently from several threads for different elements. The cell
+     * indices it returns must be lower than \a ulCtCells and must not contain duplicates.
+     * The structure is built in two passes: the cells of all elements are determined in the
+     * first pass and counted per cell, in the second pass the element indices are scattered to
+     * their final positions. Both passes run in parallel on large element sets and give the
+     * same result as the sequential build.
+     */
+    void Build(std::size_t ulCtCells, std::size_t ulCtElements, const CellFunction& fCells);
+    /** Returns the elements of the given cell. */
+    Cell operator[](std::size_t ulCell) const
+    {
+        const ElementIndex* data = _aulElements.data();
+        return {data + _aulOffsets[ulCell], data + _aulOffsets[ulCell + 1]};
+    }
+    /** Returns the number of cells. */
+    std::size_t CountCells() const
+    {
+        return _aulOffsets.empty() ? 0 : _aulOffsets.size() - 1;
+    }
+    /** Returns the number of stored element indices of all cells. */
+    std::size_t CountEntries() const
+    {
+        return _aulElements.size();
+    }
+
+private:
+    std::vector<std::size_t> _aulOffsets;
+    std::vector<ElementIndex> _aulElements;
+};
+
 /**
  * The MeshGrid allows one to divide a global mesh object into smaller regions
  * of elements (e.g. facets, points or edges) depending on the resolution
@@ -161,7 +245,7 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        return static_cast<unsigned long>(GetCell(ulX, ulY, ulZ).size());
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -208,11 +292,24 @@ protected:
     virtual void RebuildGrid() = 0;
     /** Returns the number of stored elements. Must be implemented in sub-classes. */
     virtual unsigned long HasElements() const = 0;
+    /** Returns the index of the cell at the given grid position in the grid data structure. */
+    unsigned long GetCellIndex(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return (ulX * _ulCtGridsY + ulY) * _ulCtGridsZ + ulZ;
+    }
+    /** Returns the elements of the cell at the given grid position. */
+    MeshGridCells::Cell GetCell(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        return _aulGrid[GetCellIndex(ulX, ulY, ulZ)];
+    }
+    /** Fills the grid data structure with \a ulCtElements elements. \a fCells must append the
+     * cell indices (see GetCellIndex()) of the given element and may be called concurrently. */
+    void FillGrid(unsigned long ulCtElements, const MeshGridCells::CellFunction& fCells);
 
 protected:
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>> _aulGrid; /**< Grid data structure. */
-    const MeshKernel* _pclMesh;                                             /**< The mesh kernel. */
+    MeshGridCells _aulGrid;     /**< Grid data structure. */
+    const MeshKernel* _pclMesh; /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
     unsigned long _ulCtGridsY;   /**< Number of grid elements in z. */
@@ -307,10 +404,9 @@ protected:
         unsigned long& rulY,
         unsigned long& rulZ
     ) const;
-    /** Adds a new facet element to the grid structure. \a rclFacet is the geometric facet and \a
-     * ulFacetIndex the corresponding index in the mesh kernel. The facet is added to each grid
-     * element that intersects the facet. */
-    inline void AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Appends the indices of all grid cells that intersect the geometric facet \a rclFacet to \a
+     * raulCells. */
+    inline void GetFacetCells(const MeshGeomFacet& rclFacet, std::vector<unsigned long>& raulCells) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -357,9 +453,9 @@ public:
     bool Verify() const override;
 
 protected:
-    /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a
-     * ulPtIndex the corresponding index in the mesh kernel. */
-    void AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, float fEpsilon = 0.0F);
+    /** Appends the index of the grid cell that contains the point \a rclPt to \a raulCells. If
+     * the point lies outside the grid nothing is appended. */
+    void GetPointCells(const MeshPoint& rclPt, std::vector<unsigned long>& raulCells) const;
     /** Returns the grid numbers to the given point \a rclPoint. */
     void Pos(
         const Base::Vector3f& rclPoint,
@@ -393,11 +489,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(
-            raulElements.end(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end()
-        );
+        MeshGridCells::Cell cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -594,7 +687,10 @@ inline void MeshFacetGrid::PosWithCheck(
     assert((rulX < _ulCtGridsX) && (rulY < _ulCtGridsY) && (rulZ < _ulCtGridsZ));
 }
 
-inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float /*fEpsilon*/)
+inline void MeshFacetGrid::GetFacetCells(
+    const MeshGeomFacet& rclFacet,
+    std::vector<unsigned long>& raulCells
+) const
 {
     unsigned long ulX {};
     unsigned long ulY {};
@@ -613,37 +709,23 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet, ElementIndex
     clBB.Add(rclFacet._aclPoints[1]);
     clBB.Add(rclFacet._aclPoints[2]);
 
-    // float fDiagonalLength = clBB.CalcDiagonalLength();
-
-    // clBB.Enlarge(fEpsilon*fDiagonalLength);
-
     Pos(Base::Vector3f(clBB.MinX, clBB.MinY, clBB.MinZ), ulX1, ulY1, ulZ1);
     Pos(Base::Vector3f(clBB.MaxX, clBB.MaxY, clBB.MaxZ), ulX2, ulY2, ulZ2);
 
-    /*
-    if (ulX1 > 0) ulX1--;
-    if (ulY1 > 0) ulY1--;
-    if (ulZ1 > 0) ulZ1--;
-
-    if (ulX2 < (_ulCtGridsX-1)) ulX2++;
-    if (ulY2 < (_ulCtGridsY-1)) ulY2++;
-    if (ulZ2 < (_ulCtGridsZ-1)) ulZ2++;
-    */
-
     // falls Facet ueber mehrere BB reicht
     if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2)) {
         for (ulX = ulX1; ulX <= ulX2; ulX++) {
             for (ulY = ulY1; ulY <= ulY2; ulY++) {
                 for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        raulCells.push_back(GetCellIndex(ulX, ulY, ulZ));
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        raulCells.push_back(GetCellIndex(ulX1, ulY1, ulZ1));
     }
 }
 
@@ -25,9 +25,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
+#include <span>
 #include <sstream>
 #include <string_view>
+#include <version>
+#ifdef __cpp_lib_spanstream
+#include <spanstream>
+#endif
 
 
 #include <boost/algorithm/string.hpp>
@@ -36,6 +42,8 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
+#include <QFile>
+
 #include "IO/Reader3MF.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
@@ -140,6 +148,46 @@ private:
     Base::ifstream str;
 };
 
+#ifdef __cpp_lib_spanstream
+using MemoryStreambuf = std::spanbuf;
+#else
+using MemoryStreambuf = Base::BufferStreambuf;
+#endif
+
+// Maps a file into memory and provides an input stream to its content. Readers can then access
+// the data without copying it through a file buffer, and binary STL files are parsed in parallel.
+class MappedFile
+{
+public:
+    explicit MappedFile(const Base::FileInfo& fi)
+        : file(QString::fromStdString(fi.filePath()))
+        , str(&buf)
+    {
+        if (file.open(QIODevice::ReadOnly) && file.size() > 0) {
+            if (uchar* data = file.map(0, file.size())) {
+                buf.pubsetbuf(reinterpret_cast<char*>(data), file.size());
+                mapped = true;
+            }
+        }
+    }
+
+    bool isMapped() const
+    {
+        return mapped;
+    }
+
+    std::istream& getStream()
+    {
+        return str;
+    }
+
+private:
+    QFile file;
+    MemoryStreambuf buf {std::ios::in};
+    std::istream str;
+    bool mapped = false;
+};
+
 }  // namespace MeshCore
 
 // --------------------------------------------------------------
@@ -231,7 +279,13 @@ bool MeshInput::LoadAny(const char* FileName)
         throw Base::FileException("No permission on the file", FileName);
     }
 
-    Base::ifstream str(fi, std::ios::in | std::ios::binary);
+    // Read the data from a memory mapping of the file if possible
+    MappedFile mappedFile(fi);
+    Base::ifstream file;
+    if (!mappedFile.isMapped()) {
+        file.open(fi, std::ios::in | std::ios::binary);
+    }
+    std::istream& str = mappedFile.isMapped() ? mappedFile.getStream() : file;
 
     if (fi.hasExtension("bms")) {
         _rclMesh.Read(str);
@@ -818,6 +872,15 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
         return false;
     }
 
+    // Streams reading from memory, e.g. a memory-mapped file, are parsed directly
+    if (auto memory = dynamic_cast<MemoryStreambuf*>(input.rdbuf())) {
+        std::streamoff pos = memory->pubseekoff(0, std::ios::cur, std::ios::in);
+        std::span<char> data = memory->span();
+        if (pos >= 0 && std::size_t(pos) <= data.size()) {
+            return LoadBinarySTL(data.data() + pos, data.size() - std::size_t(pos));
+        }
+    }
+
     // Header-Info ueberlesen
     input.read(szInfo, sizeof(szInfo));
 
@@ -867,6 +930,45 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     return true;
 }
 
+/** Loads a binary STL file from a memory buffer. */
+bool MeshInput::LoadBinarySTL(const char* data, std::size_t size)
+{
+    // 80 bytes header info and the number of facets
+    const std::size_t headerSize = 80 + sizeof(uint32_t);
+    // normal, three points and 2 bytes attribute
+    const std::size_t recordSize = 12 * sizeof(float) + sizeof(uint16_t);
+
+    if (!data || size < headerSize) {
+        return false;
+    }
+
+    uint32_t ulCt = 0;
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+
+    // compare with the number of facets the buffer can hold
+    if (ulCt > (size - headerSize) / recordSize) {
+        return false;  // not a valid STL file
+    }
+
+    // The records have a fixed size, so they can be read independently of each other
+    const char* records = data + headerSize;
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.AddFacets(
+        static_cast<MeshFastBuilder::size_type>(ulCt),
+        [records, recordSize](MeshFastBuilder::size_type index, Base::Vector3f* points) {
+            float coords[12];
+            std::memcpy(coords, records + std::size_t(index) * recordSize, sizeof(coords));
+            // same point order as LoadBinarySTL(std::istream&)
+            points[0].Set(coords[9], coords[10], coords[11]);
+            points[1].Set(coords[3], coords[4], coords[5]);
+            points[2].Set(coords[6], coords[7], coords[8]);
+        }
+    );
+    builder.Finish();
+
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML(Base::XMLReader& reader)
 {
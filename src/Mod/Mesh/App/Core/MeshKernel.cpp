@@ -68,6 +68,7 @@ MeshKernel& MeshKernel::operator=(const MeshKernel& rclMesh)
         this->_aclFacetArray = rclMesh._aclFacetArray;
         this->_clBoundBox = rclMesh._clBoundBox;
         this->_bValid = rclMesh._bValid;
+        IncrementRevision();
     }
     return *this;
 }
@@ -79,6 +80,8 @@ MeshKernel& MeshKernel::operator=(MeshKernel&& rclMesh)
         this->_aclFacetArray = std::move(rclMesh._aclFacetArray);
         this->_clBoundBox = rclMesh._clBoundBox;
         this->_bValid = rclMesh._bValid;
+        IncrementRevision();
+        rclMesh.IncrementRevision();
     }
     return *this;
 }
@@ -99,6 +102,7 @@ MeshKernel& MeshKernel::operator=(const std::vector<MeshGeomFacet>& rclFAry)
 
 void MeshKernel::Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    IncrementRevision();
     _aclPointArray = rPoints;
     _aclFacetArray = rFacets;
     RecalcBoundBox();
@@ -109,6 +113,7 @@ void MeshKernel::Assign(const MeshPointArray& rPoints, const MeshFacetArray& rFa
 
 void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool checkNeighbourHood)
 {
+    IncrementRevision();
     _aclPointArray.swap(rPoints);
     _aclFacetArray.swap(rFacets);
     RecalcBoundBox();
@@ -119,6 +124,8 @@ void MeshKernel::Adopt(MeshPointArray& rPoints, MeshFacetArray& rFacets, bool ch
 
 void MeshKernel::Swap(MeshKernel& mesh)
 {
+    IncrementRevision();
+    mesh.IncrementRevision();
     this->_aclPointArray.swap(mesh._aclPointArray);
     this->_aclFacetArray.swap(mesh._aclFacetArray);
     this->_clBoundBox = mesh._clBoundBox;
@@ -132,6 +139,7 @@ MeshKernel& MeshKernel::operator+=(const MeshGeomFacet& rclSFacet)
 
 void MeshKernel::AddFacet(const MeshGeomFacet& rclSFacet)
 {
+    IncrementRevision();
     MeshFacet clFacet;
 
     // set corner points
@@ -181,6 +189,7 @@ MeshKernel& MeshKernel::operator+=(const std::vector<MeshGeomFacet>& rclFAry)
 
 void MeshKernel::AddFacets(const std::vector<MeshGeomFacet>& rclFAry)
 {
+    IncrementRevision();
     // Create a temp. kernel to get the topology of the passed triangles
     // and merge them with this kernel. This keeps properties and flags
     // of this mesh.
@@ -191,6 +200,7 @@ void MeshKernel::AddFacets(const std::vector<MeshGeomFacet>& rclFAry)
 
 unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry, bool checkManifolds)
 {
+    IncrementRevision();
     // if the manifold check shouldn't be done then just add all faces
     if (!checkManifolds) {
         return AddFacets(rclFAry);
@@ -202,6 +212,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry, bool
 
 unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry)
 {
+    IncrementRevision();
     FacetIndex countFacets = CountFacets();
     FacetIndex countValid = rclFAry.size();
     _aclFacetArray.reserve(countFacets + countValid);
@@ -217,6 +228,7 @@ unsigned long MeshKernel::AddFacets(const std::vector<MeshFacet>& rclFAry)
 
 unsigned long MeshKernel::AddFacetsIfValid(const std::vector<MeshFacet>& rclFAry)
 {
+    IncrementRevision();
     // Build map of edges of the referencing facets we want to append
 #ifdef FC_DEBUG
     [[maybe_unused]] unsigned long countPoints = CountPoints();
@@ -372,6 +384,7 @@ unsigned long MeshKernel::AddFacets(
     bool checkManifolds
 )
 {
+    IncrementRevision();
     for (auto it : rclPAry) {
         _clBoundBox.Add(it);
     }
@@ -381,6 +394,7 @@ unsigned long MeshKernel::AddFacets(
 
 void MeshKernel::Merge(const MeshKernel& rKernel)
 {
+    IncrementRevision();
     if (this != &rKernel) {
         const MeshPointArray& rPoints = rKernel._aclPointArray;
         const MeshFacetArray& rFacets = rKernel._aclFacetArray;
@@ -390,6 +404,7 @@ void MeshKernel::Merge(const MeshKernel& rKernel)
 
 void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFaces)
 {
+    IncrementRevision();
     if (rPoints.empty() || rFaces.empty()) {
         return;  // nothing to do
     }
@@ -444,12 +459,14 @@ void MeshKernel::Merge(const MeshPointArray& rPoints, const MeshFacetArray& rFac
 
 void MeshKernel::Cleanup()
 {
+    IncrementRevision();
     MeshCleanup meshCleanup(_aclPointArray, _aclFacetArray);
     meshCleanup.RemoveInvalids();
 }
 
 void MeshKernel::Clear()
 {
+    IncrementRevision();
     _aclPointArray.clear();
     _aclFacetArray.clear();
 
@@ -462,6 +479,7 @@ void MeshKernel::Clear()
 
 bool MeshKernel::DeleteFacet(const MeshFacetIterator& rclIter)
 {
+    IncrementRevision();
     FacetIndex ulNFacet {}, ulInd {};
 
     if (rclIter._clIter >= _aclFacetArray.end()) {
@@ -501,6 +519,7 @@ bool MeshKernel::DeleteFacet(const MeshFacetIterator& rclIter)
 
 bool MeshKernel::DeleteFacet(FacetIndex ulInd)
 {
+    IncrementRevision();
     if (ulInd >= _aclFacetArray.size()) {
         return false;
     }
@@ -513,6 +532,7 @@ bool MeshKernel::DeleteFacet(FacetIndex ulInd)
 
 void MeshKernel::DeleteFacets(const std::vector<FacetIndex>& raulFacets)
 {
+    IncrementRevision();
     _aclPointArray.SetProperty(0);
 
     // number of referencing facets per point
@@ -546,6 +566,7 @@ void MeshKernel::DeleteFacets(const std::vector<FacetIndex>& raulFacets)
 
 bool MeshKernel::DeletePoint(PointIndex ulInd)
 {
+    IncrementRevision();
     if (ulInd >= _aclPointArray.size()) {
         return false;
     }
@@ -558,6 +579,7 @@ bool MeshKernel::DeletePoint(PointIndex ulInd)
 
 bool MeshKernel::DeletePoint(const MeshPointIterator& rclIter)
 {
+    IncrementRevision();
     MeshFacetIterator pFIter(*this), pFEnd(*this);
     std::vector<MeshFacetIterator> clToDel;
     PointIndex ulInd {};
@@ -591,6 +613,7 @@ bool MeshKernel::DeletePoint(const MeshPointIterator& rclIter)
 
 void MeshKernel::DeletePoints(const std::vector<PointIndex>& raulPoints)
 {
+    IncrementRevision();
     _aclPointArray.ResetInvalid();
     for (PointIndex ptIndex : raulPoints) {
         _aclPointArray[ptIndex].SetInvalid();
@@ -627,6 +650,7 @@ void MeshKernel::DeletePoints(const std::vector<PointIndex>& raulPoints)
 
 void MeshKernel::ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bOnlySetInvalid)
 {
+    IncrementRevision();
     std::vector<MeshFacet>::iterator pFIter, pFEnd, pFNot;
 
     pFIter = _aclFacetArray.begin();
@@ -676,6 +700,7 @@ void MeshKernel::ErasePoint(PointIndex ulIndex, FacetIndex ulFacetIndex, bool bO
 
 void MeshKernel::RemoveInvalids()
 {
+    IncrementRevision();
     std::vector<unsigned long> aulDecrements;
     std::vector<unsigned long>::iterator pDIter;
     unsigned long ulDec {};
@@ -932,6 +957,7 @@ void MeshKernel::Write(std::ostream& rclOut) const
 
 void MeshKernel::Read(std::istream& rclIn)
 {
+    IncrementRevision();
     if (!rclIn || rclIn.bad()) {
         return;
     }
@@ -1126,6 +1152,7 @@ void MeshKernel::operator*=(const Base::Matrix4D& rclMat)
 
 void MeshKernel::Transform(const Base::Matrix4D& rclMat)
 {
+    IncrementRevision();
     auto clPIter = _aclPointArray.begin(), clPEIter = _aclPointArray.end();
 
     _clBoundBox.SetVoid();
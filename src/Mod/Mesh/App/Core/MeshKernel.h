@@ -166,6 +166,15 @@ public:
         return _bValid;
     }
 
+    /** Returns a counter that changes whenever the points or facets get modified, so that data
+     * derived from the mesh can tell whether it is still up to date. Changing flags or properties
+     * doesn't count as modification.
+     */
+    unsigned long GetRevision() const
+    {
+        return _ulRevision;
+    }
+
     /** Returns the array of all data points. */
     const MeshPointArray& GetPoints() const
     {
@@ -179,6 +188,7 @@ public:
     /** Returns a modifier for the point array */
     MeshPointModifier ModifyPoints()
     {
+        IncrementRevision();
         return MeshPointModifier(_aclPointArray);
     }
 
@@ -195,6 +205,7 @@ public:
     /** Returns a modifier for the facet array */
     MeshFacetModifier ModifyFacets()
     {
+        IncrementRevision();
         return MeshFacetModifier(_aclFacetArray);
     }
 
@@ -497,12 +508,18 @@ protected:
 private:
     unsigned long AddFacets(const std::vector<MeshFacet>& rclFAry);
     unsigned long AddFacetsIfValid(const std::vector<MeshFacet>& rclFAry);
+    /** Must be called by every method and friend class that modifies the points or facets. */
+    void IncrementRevision()
+    {
+        _ulRevision++;
+    }
 
 private:
     MeshPointArray _aclPointArray;        /**< Holds the array of geometric points. */
     MeshFacetArray _aclFacetArray;        /**< Holds the array of facets. */
     mutable Base::BoundBox3f _clBoundBox; /**< The current calculated bounding box. */
     bool _bValid {true};                  /**< Current state of validality. */
+    unsigned long _ulRevision {0};        /**< Counts the modifications of points and facets. */
 
     // friends
     friend class MeshPointIterator;
@@ -569,16 +586,19 @@ inline void MeshKernel::GetFacetNeighbours(
 
 inline void MeshKernel::MovePoint(PointIndex ulPtIndex, const Base::Vector3f& rclTrans)
 {
+    IncrementRevision();
     _aclPointArray[ulPtIndex] += rclTrans;
 }
 
 inline void MeshKernel::SetPoint(PointIndex ulPtIndex, const Base::Vector3f& rPoint)
 {
+    IncrementRevision();
     _aclPointArray[ulPtIndex] = rPoint;
 }
 
 inline void MeshKernel::SetPoint(PointIndex ulPtIndex, float x, float y, float z)
 {
+    IncrementRevision();
     _aclPointArray[ulPtIndex].Set(x, y, z);
 }
 
@@ -635,6 +655,7 @@ inline void MeshKernel::SetFacetPoints(
 )
 {
     assert(ulFaIndex < _aclFacetArray.size());
+    IncrementRevision();
     MeshFacet& rclFacet = _aclFacetArray[ulFaIndex];
     rclFacet._aulPoints[0] = rclP0;
     rclFacet._aulPoints[1] = rclP1;
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "Functional.h"
+#include "PointCoordinates.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+// below this number of points per thread starting the threads costs more than it saves
+constexpr std::size_t MinPointsPerThread = 65536;
+}  // namespace
+
+MeshPointCoordinates::MeshPointCoordinates(const MeshPointArray& points)
+{
+    Assign(points);
+}
+
+void MeshPointCoordinates::Assign(const MeshPointArray& points)
+{
+    std::size_t count = points.size();
+    _afX.resize(count);
+    _afY.resize(count);
+    _afZ.resize(count);
+    _aucFlags.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const MeshPoint& point = points[i];
+        _afX[i] = point.x;
+        _afY[i] = point.y;
+        _afZ[i] = point.z;
+        _aucFlags[i] = point._ucFlag;
+    }
+}
+
+void MeshPointCoordinates::Apply(MeshPointArray& points) const
+{
+    std::size_t count = std::min(points.size(), _afX.size());
+    for (std::size_t i = 0; i < count; i++) {
+        MeshPoint& point = points[i];
+        point.Set(_afX[i], _afY[i], _afZ[i]);
+        point._ucFlag = _aucFlags[i];
+    }
+}
+
+int MeshPointCoordinates::CountThreads() const
+{
+    int num = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    auto limit = static_cast<int>(std::min<std::size_t>(_afX.size() / MinPointsPerThread, 256));
+    return std::max(std::min(num, limit), 1);
+}
+
+template<class Func>
+void MeshPointCoordinates::ForEachChunk(std::size_t chunks, Func func) const
+{
+    // unlike parallel_for() this passes the chunk index to store the partial results
+    std::size_t size = _afX.size();
+    parallel_for(chunks, int(chunks), [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; chunk++) {
+            func(chunk, size * chunk / chunks, size * (chunk + 1) / chunks);
+        }
+    });
+}
+
+void MeshPointCoordinates::Transform(const Base::Matrix4D& mat)
+{
+    // compute in double precision like Base::Matrix4D::multVec()
+    const double m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2], m03 = mat[0][3];
+    const double m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2], m13 = mat[1][3];
+    const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+
+    float* px = _afX.data();
+    float* py = _afY.data();
+    float* pz = _afZ.data();
+    parallel_for(_afX.size(), CountThreads(), [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            double sx = static_cast<double>(px[i]);
+            double sy = static_cast<double>(py[i]);
+            double sz = static_cast<double>(pz[i]);
+            px[i] = static_cast<float>(m00 * sx + m01 * sy + m02 * sz + m03);
+            py[i] = static_cast<float>(m10 * sx + m11 * sy + m12 * sz + m13);
+            pz[i] = static_cast<float>(m20 * sx + m21 * sy + m22 * sz + m23);
+        }
+    });
+}
+
+void MeshPointCoordinates::Move(const Base::Vector3f& offset)
+{
+    float* px = _afX.data();
+    float* py = _afY.data();
+    float* pz = _afZ.data();
+    parallel_for(_afX.size(), CountThreads(), [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            px[i] += offset.x;
+            py[i] += offset.y;
+            pz[i] += offset.z;
+        }
+    });
+}
+
+Base::BoundBox3f MeshPointCoordinates::GetBoundBox() const
+{
+    // one box per chunk, merged afterwards
+    std::vector<Base::BoundBox3f> boxes(CountThreads());
+    ForEachChunk(boxes.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        auto minMax = [begin, end](const float* values, float& min, float& max) {
+            // same comparisons as Base::BoundBox3f::Add() so that NaN values are skipped alike
+            for (std::size_t i = begin; i < end; i++) {
+                min = values[i] < min ? values[i] : min;
+                max = values[i] > max ? values[i] : max;
+            }
+        };
+
+        Base::BoundBox3f& box = boxes[chunk];
+        minMax(_afX.data(), box.MinX, box.MaxX);
+        minMax(_afY.data(), box.MinY, box.MaxY);
+        minMax(_afZ.data(), box.MinZ, box.MaxZ);
+    });
+
+    Base::BoundBox3f box;
+    for (const auto& it : boxes) {
+        box.Add(it);
+    }
+    return box;
+}
+
+PointIndex MeshPointCoordinates::NearestPoint(const Base::Vector3f& point, float& distance) const
+{
+    struct Candidate
+    {
+        float dist2 = std::numeric_limits<float>::max();
+        PointIndex index = POINT_INDEX_MAX;
+    };
+
+    std::vector<Candidate> candidates(CountThreads());
+    ForEachChunk(candidates.size(), [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+        const auto invalid = static_cast<unsigned char>(MeshPoint::INVALID);
+        Candidate& best = candidates[chunk];
+        for (std::size_t i = begin; i < end; i++) {
+            float dx = _afX[i] - point.x;
+            float dy = _afY[i] - point.y;
+            float dz = _afZ[i] - point.z;
+            float dist2 = dx * dx + dy * dy + dz * dz;
+            if (dist2 < best.dist2 && (_aucFlags[i] & invalid) == 0) {
+                best.dist2 = dist2;
+                best.index = static_cast<PointIndex>(i);
+            }
+        }
+    });
+
+    // the chunks are in ascending order, so ties keep the lowest index
+    Candidate best;
+    for (const auto& it : candidates) {
+        if (it.dist2 < best.dist2) {
+            best = it;
+        }
+    }
+
+    distance = best.index != POINT_INDEX_MAX ? std::sqrt(best.dist2)
+                                              : std::numeric_limits<float>::max();
+    return best.index;
+}
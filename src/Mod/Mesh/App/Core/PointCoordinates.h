@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#pragma once
+
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Matrix.h>
+
+#include "Elements.h"
+
+
+namespace MeshCore
+{
+
+/**
+ * The MeshPointCoordinates class stores the points of a mesh as a structure of arrays, i.e. the
+ * x, y and z coordinates and the flags of the points in separate arrays.
+ *
+ * The MeshPointArray stays the storage of the mesh kernel. A MeshPointCoordinates object is a copy
+ * of it for algorithms that run the same operation over all points many times, e.g. transforming
+ * a mesh with a changing placement or searching for the nearest points of many positions. The
+ * loops over the contiguous coordinate arrays are simple enough to be vectorized by the compiler.
+ * Large arrays are additionally split among several threads.
+ */
+class MeshExport MeshPointCoordinates
+{
+public:
+    /** @name Construction */
+    //@{
+    MeshPointCoordinates() = default;
+    explicit MeshPointCoordinates(const MeshPointArray& points);
+    /// Copies the coordinates and flags of \a points.
+    void Assign(const MeshPointArray& points);
+    /// Writes the coordinates and flags back to \a points which must have the same size.
+    void Apply(MeshPointArray& points) const;
+    /// Number of threads to use, 0 means the number of cores.
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+    //@}
+
+    /** @name Access */
+    //@{
+    PointIndex Size() const
+    {
+        return static_cast<PointIndex>(_afX.size());
+    }
+    bool Empty() const
+    {
+        return _afX.empty();
+    }
+    Base::Vector3f GetPoint(PointIndex index) const
+    {
+        return Base::Vector3f(_afX[index], _afY[index], _afZ[index]);
+    }
+    void SetPoint(PointIndex index, const Base::Vector3f& point)
+    {
+        _afX[index] = point.x;
+        _afY[index] = point.y;
+        _afZ[index] = point.z;
+    }
+    const float* X() const
+    {
+        return _afX.data();
+    }
+    const float* Y() const
+    {
+        return _afY.data();
+    }
+    const float* Z() const
+    {
+        return _afZ.data();
+    }
+    //@}
+
+    /** @name Flag state */
+    //@{
+    bool IsFlag(PointIndex index, MeshPoint::TFlagType flag) const
+    {
+        auto bit = static_cast<unsigned char>(flag);
+        return (_aucFlags[index] & bit) == bit;
+    }
+    void SetFlag(PointIndex index, MeshPoint::TFlagType flag)
+    {
+        _aucFlags[index] |= static_cast<unsigned char>(flag);
+    }
+    void ResetFlag(PointIndex index, MeshPoint::TFlagType flag)
+    {
+        _aucFlags[index] &= ~static_cast<unsigned char>(flag);
+    }
+    bool IsValid(PointIndex index) const
+    {
+        return !IsFlag(index, MeshPoint::INVALID);
+    }
+    //@}
+
+    /** @name Kernels */
+    //@{
+    /// Transforms all points with \a mat. The result is the same as of Base::Matrix4D::multVec().
+    void Transform(const Base::Matrix4D& mat);
+    /// Moves all points by \a offset.
+    void Move(const Base::Vector3f& offset);
+    /// Returns the bounding box of all points.
+    Base::BoundBox3f GetBoundBox() const;
+    /**
+     * Returns the index of the valid point nearest to \a point and sets \a distance to its
+     * distance. If there is no valid point POINT_INDEX_MAX is returned.
+     */
+    PointIndex NearestPoint(const Base::Vector3f& point, float& distance) const;
+    //@}
+
+private:
+    int CountThreads() const;
+    template<class Func>
+    void ForEachChunk(std::size_t chunks, Func func) const;
+
+private:
+    std::vector<float> _afX;
+    std::vector<float> _afY;
+    std::vector<float> _afZ;
+    std::vector<unsigned char> _aucFlags;
+    int threads {0};
+};
+
+}  // namespace MeshCore
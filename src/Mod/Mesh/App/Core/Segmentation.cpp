@@ -25,9 +25,12 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
+#include <thread>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Segmentation.h"
 
 using namespace MeshCore;
@@ -556,6 +559,195 @@ bool MeshSurfaceVisitor::Visit(const MeshFacet& face, const MeshFacet&, FacetInd
 
 // --------------------------------------------------------
 
+namespace
+{
+/*
+ * Labels the connected regions of the accepted facets with the lowest facet index of each
+ * region. The facets are split into ranges whose regions are grown in parallel, afterwards
+ * the regions that touch each other over the range borders are merged.
+ */
+std::vector<FacetIndex>
+LabelRegions(const MeshFacetArray& rFacets, const std::vector<char>& accept, int threads)
+{
+    std::size_t count = rFacets.size();
+    std::size_t chunks = std::min<std::size_t>(std::max(threads, 1), count);
+    chunks = std::max<std::size_t>(chunks, 1);
+    std::vector<FacetIndex> label(count, FACET_INDEX_MAX);
+    std::vector<std::vector<std::pair<FacetIndex, FacetIndex>>> borders(chunks);
+
+    // grow the regions within each range
+    MeshCore::parallel_for(chunks, int(chunks), [&](std::size_t cbegin, std::size_t cend) {
+        std::vector<FacetIndex> front;
+        for (std::size_t c = cbegin; c < cend; c++) {
+            FacetIndex first = count * c / chunks;
+            FacetIndex last = count * (c + 1) / chunks;
+            for (FacetIndex seed = first; seed < last; seed++) {
+                if (!accept[seed] || label[seed] != FACET_INDEX_MAX) {
+                    continue;
+                }
+                label[seed] = seed;
+                front.push_back(seed);
+                while (!front.empty()) {
+                    FacetIndex index = front.back();
+                    front.pop_back();
+                    for (FacetIndex nb : rFacets[index]._aulNeighbours) {
+                        if (nb < first || nb >= last || !accept[nb]) {
+                            continue;
+                        }
+                        if (label[nb] == FACET_INDEX_MAX) {
+                            label[nb] = seed;
+                            front.push_back(nb);
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    // collect the neighbourhoods over the range borders
+    MeshCore::parallel_for(chunks, int(chunks), [&](std::size_t cbegin, std::size_t cend) {
+        for (std::size_t c = cbegin; c < cend; c++) {
+            FacetIndex first = count * c / chunks;
+            FacetIndex last = count * (c + 1) / chunks;
+            for (FacetIndex index = first; index < last; index++) {
+                if (!accept[index]) {
+                    continue;
+                }
+                for (FacetIndex nb : rFacets[index]._aulNeighbours) {
+                    if (nb >= last && nb < count && accept[nb]) {
+                        borders[c].emplace_back(label[index], label[nb]);
+                    }
+                }
+            }
+        }
+    });
+
+    // merge the touching regions, the lower label always becomes the root
+    std::vector<FacetIndex> parent(count);
+    std::iota(parent.begin(), parent.end(), FacetIndex(0));
+    auto find = [&parent](FacetIndex index) {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    };
+    for (const auto& border : borders) {
+        for (const auto& [label1, label2] : border) {
+            FacetIndex root1 = find(label1);
+            FacetIndex root2 = find(label2);
+            if (root1 < root2) {
+                parent[root2] = root1;
+            }
+            else if (root2 < root1) {
+                parent[root1] = root2;
+            }
+        }
+    }
+
+    // as a parent is always lower than its children one pass points all labels to their roots
+    for (std::size_t index = 0; index < count; index++) {
+        parent[index] = parent[parent[index]];
+    }
+    MeshCore::parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            if (accept[index]) {
+                label[index] = parent[label[index]];
+            }
+        }
+    });
+
+    return label;
+}
+}  // namespace
+
+void MeshSegmentAlgorithm::FindLocalSegments(
+    MeshSurfaceSegment& segm,
+    std::vector<FacetIndex>& resetVisited
+) const
+{
+    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
+    std::size_t count = rFAry.size();
+    int numThreads = threads > 0 ? threads : std::max(int(std::thread::hardware_concurrency()), 1);
+
+    // test all facets that are not yet part of a segment
+    std::vector<char> accept(count, 0);
+    MeshCore::parallel_for(count, numThreads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; index++) {
+            const MeshFacet& face = rFAry[index];
+            accept[index] = !face.IsFlag(MeshFacet::VISIT) && segm.TestFacet(face);
+        }
+    });
+
+    // sort the accepted facets by their region and within a region by their index
+    std::vector<FacetIndex> label = LabelRegions(rFAry, accept, numThreads);
+    std::vector<FacetIndex> order;
+    for (std::size_t index = 0; index < count; index++) {
+        if (accept[index]) {
+            order.push_back(index);
+        }
+    }
+    auto byRegion = [&label](FacetIndex index1, FacetIndex index2) {
+        return label[index1] < label[index2] || (label[index1] == label[index2] && index1 < index2);
+    };
+    MeshCore::parallel_sort(order.begin(), order.end(), byRegion, numThreads);
+
+    std::vector<FacetIndex> indices;
+    auto addRegion = [&](FacetIndex region) {
+        auto first = std::lower_bound(
+            order.begin(),
+            order.end(),
+            region,
+            [&label](FacetIndex index, FacetIndex value) { return label[index] < value; }
+        );
+        auto last = std::upper_bound(
+            first,
+            order.end(),
+            region,
+            [&label](FacetIndex value, FacetIndex index) { return value < label[index]; }
+        );
+        for (auto it = first; it != last; ++it) {
+            if (!rFAry[*it].IsFlag(MeshFacet::VISIT)) {
+                rFAry[*it].SetFlag(MeshFacet::VISIT);
+                indices.push_back(*it);
+            }
+        }
+    };
+
+    // Like the region growing, start from the first facet that is not visited and add the
+    // regions of its accepted neighbours to it. As the start facet is the lowest facet that is
+    // not visited, it's also the lowest facet of its region.
+    for (FacetIndex startFacet = 0; startFacet < count; startFacet++) {
+        const MeshFacet& face = rFAry[startFacet];
+        if (face.IsFlag(MeshFacet::VISIT)) {
+            continue;
+        }
+
+        indices.clear();
+        face.SetFlag(MeshFacet::VISIT);
+        if (segm.TestInitialFacet(startFacet)) {
+            indices.push_back(startFacet);
+        }
+        if (accept[startFacet]) {
+            addRegion(label[startFacet]);
+        }
+        for (FacetIndex nb : face._aulNeighbours) {
+            if (nb < count && accept[nb] && !rFAry[nb].IsFlag(MeshFacet::VISIT)) {
+                addRegion(label[nb]);
+            }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            std::sort(indices.begin(), indices.end());
+            segm.AddSegment(indices);
+        }
+    }
+}
+
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
 {
     // reset VISIT flags
@@ -576,6 +768,11 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        if (it->IsLocal()) {
+            FindLocalSegments(*it, resetVisited);
+            continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -55,6 +55,13 @@ public:
     MeshSurfaceSegment& operator=(MeshSurfaceSegment&&) = delete;
 
     virtual bool TestFacet(const MeshFacet& rclFacet) const = 0;
+    /// Returns true if TestFacet() only depends on the tested facet but not on the facets that
+    /// have been added to the segment. The facets of such segments are tested in parallel and
+    /// Initialize() and AddFacet() are not called for them.
+    virtual bool IsLocal() const
+    {
+        return false;
+    }
     virtual const char* GetType() const = 0;
     virtual void Initialize(FacetIndex);
     virtual bool TestInitialFacet(FacetIndex) const;
@@ -268,6 +275,10 @@ public:
         : MeshSurfaceSegment(minFacets)
         , info(ci)
     {}
+    bool IsLocal() const override
+    {
+        return true;
+    }
 
     const CurvatureInfo& GetInfo(std::size_t pos) const
     {
@@ -400,9 +411,21 @@ public:
         : myKernel(kernel)
     {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
+    /** Sets the number of threads used for local segments, 0 uses one thread per core.
+     * The result doesn't depend on the number of threads.
+     * \see MeshSurfaceSegment::IsLocal()
+     */
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+
+private:
+    void FindLocalSegments(MeshSurfaceSegment&, std::vector<FacetIndex>& resetVisited) const;
 
 private:
     const MeshKernel& myKernel;
+    int threads {0};
 };
 
 }  // namespace MeshCore
@@ -23,8 +23,14 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
 #include <fstream>
 #include <ios>
+#include <limits>
+#include <thread>
 
 
 #include <Base/Builder3D.h>
@@ -34,6 +40,8 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Elements.h"
+#include "FacetTree.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "SetOperations.h"
@@ -44,6 +52,138 @@
 using namespace Base;
 using namespace MeshCore;
 
+namespace
+{
+
+/**
+ * Filtered plane side test. Computes the signed distances of the corners of \a facet to the plane
+ * of \a other in double precision. Distances that are not certainly larger than \a tolerance,
+ * taking the rounding error of the computation into account, are set to zero. Returns false if
+ * \a other is degenerated.
+ */
+bool PlaneDistances(
+    const MeshGeomFacet& facet,
+    const MeshGeomFacet& other,
+    double tolerance,
+    std::array<double, 3>& dist,
+    Base::Vector3d& normal
+)
+{
+    Base::Vector3d base = Base::toVector<double>(other._aclPoints[0]);
+    Base::Vector3d u = Base::toVector<double>(other._aclPoints[1]) - base;
+    Base::Vector3d v = Base::toVector<double>(other._aclPoints[2]) - base;
+    normal = u % v;
+    Base::Vector3d magnitude(
+        std::fabs(u.y * v.z) + std::fabs(u.z * v.y),
+        std::fabs(u.z * v.x) + std::fabs(u.x * v.z),
+        std::fabs(u.x * v.y) + std::fabs(u.y * v.x)
+    );
+    double length = normal.Length();
+    if (length == 0.0) {
+        return false;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        Base::Vector3d dir = Base::toVector<double>(facet._aclPoints[i]) - base;
+        double value = normal * dir;
+        double bound = tolerance * length
+            + 8.0 * DBL_EPSILON
+                * (magnitude.x * std::fabs(dir.x) + magnitude.y * std::fabs(dir.y)
+                   + magnitude.z * std::fabs(dir.z));
+        dist[i] = std::fabs(value) > bound ? value / length : 0.0;
+    }
+
+    normal /= length;
+    return true;
+}
+
+/**
+ * Intersects two facets. Unlike MeshGeomFacet::IntersectWithFacet() the corners are classified
+ * against the plane of the other facet with PlaneDistances(), so that the result does not depend
+ * on the size of the facets. Coplanar and degenerated facets are passed to
+ * MeshGeomFacet::IntersectWithFacet(). Returns 0 if the facets do not intersect, 1 if they touch
+ * in a point and 2 if they intersect in a line segment.
+ */
+int IntersectFacets(
+    const MeshGeomFacet& f1,
+    const MeshGeomFacet& f2,
+    double tolerance,
+    Base::Vector3f& p0,
+    Base::Vector3f& p1
+)
+{
+    std::array<double, 3> dist1 {}, dist2 {};
+    Base::Vector3d normal1, normal2;
+    if (!PlaneDistances(f2, f1, tolerance, dist2, normal1)
+        || !PlaneDistances(f1, f2, tolerance, dist1, normal2)) {
+        return f1.IntersectWithFacet(f2, p0, p1);
+    }
+
+    auto separated = [](const std::array<double, 3>& dist) {
+        return (dist[0] > 0.0 && dist[1] > 0.0 && dist[2] > 0.0)
+            || (dist[0] < 0.0 && dist[1] < 0.0 && dist[2] < 0.0);
+    };
+    if (separated(dist1) || separated(dist2)) {
+        return 0;
+    }
+
+    Base::Vector3d dir = normal1 % normal2;
+    bool coplanar = dist2[0] == 0.0 && dist2[1] == 0.0 && dist2[2] == 0.0;
+    if (coplanar || dir.Length() == 0.0) {
+        return f1.IntersectWithFacet(f2, p0, p1);
+    }
+    dir.Normalize();
+
+    // the part of a facet that lies on the plane of the other facet, as interval along dir
+    struct Interval
+    {
+        double min = std::numeric_limits<double>::max();
+        double max = -std::numeric_limits<double>::max();
+        Base::Vector3d pmin, pmax;
+    };
+    auto interval = [&dir](const MeshGeomFacet& facet, const std::array<double, 3>& dist) {
+        Interval result;
+        auto add = [&](const Base::Vector3d& pnt) {
+            double param = pnt * dir;
+            if (param < result.min) {
+                result.min = param;
+                result.pmin = pnt;
+            }
+            if (param > result.max) {
+                result.max = param;
+                result.pmax = pnt;
+            }
+        };
+
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3;
+            Base::Vector3d pi = Base::toVector<double>(facet._aclPoints[i]);
+            if (dist[i] == 0.0) {
+                add(pi);
+            }
+            else if (dist[i] * dist[j] < 0.0) {
+                Base::Vector3d pj = Base::toVector<double>(facet._aclPoints[j]);
+                add(pi + (pj - pi) * (dist[i] / (dist[i] - dist[j])));
+            }
+        }
+        return result;
+    };
+
+    Interval int1 = interval(f1, dist1);
+    Interval int2 = interval(f2, dist2);
+    const Interval& lower = int1.min > int2.min ? int1 : int2;
+    const Interval& upper = int1.max < int2.max ? int1 : int2;
+    if (lower.min > upper.max + tolerance) {
+        return 0;
+    }
+
+    p0 = Base::toVector<float>(lower.pmin);
+    p1 = lower.min < upper.max ? Base::toVector<float>(upper.pmax) : p0;
+    return p0 == p1 ? 1 : 2;
+}
+
+}  // namespace
+
 
 SetOperations::SetOperations(
     const MeshKernel& cutMesh1,
@@ -145,9 +285,13 @@ void SetOperations::Do()
     }
 
     // Base::Sequencer().next();
-    CollectFacets(0, mult0);
-    // Base::Sequencer().next();
-    CollectFacets(1, mult1);
+    // both sides only read the cut edges and can be collected at the same time
+    float mult[2] = {mult0, mult1};
+    parallel_for(2, CountThreads(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t side = begin; side < end; side++) {
+            CollectFacets(int(side), mult[side]);
+        }
+    });
 
     std::vector<MeshGeomFacet> facets;
 
@@ -173,231 +317,140 @@ void SetOperations::Do()
     MeshDefinitions::SetMinPointDistance(saveMinMeshDistance);
 }
 
-void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1)
+int SetOperations::CountThreads() const
 {
-    MeshFacetGrid grid1(_cutMesh0, 20);
-    MeshFacetGrid grid2(_cutMesh1, 20);
-
-    unsigned long ctGx1 {}, ctGy1 {}, ctGz1 {};
-    grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
-
-    for (auto gx1 = 0UL; gx1 < ctGx1; gx1++) {
-        for (auto gy1 = 0UL; gy1 < ctGy1; gy1++) {
-            for (auto gz1 = 0UL; gz1 < ctGz1; gz1++) {
-                if (grid1.GetCtElements(gx1, gy1, gz1) > 0) {
-                    std::vector<FacetIndex> vecFacets2;
-                    grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-
-                    if (!vecFacets2.empty()) {
-                        std::set<FacetIndex> vecFacets1;
-                        grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-
-                        std::set<FacetIndex>::iterator it1;
-                        for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1) {
-                            FacetIndex fidx1 = *it1;
-                            MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-
-                            std::vector<FacetIndex>::iterator it2;
-                            for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2) {
-                                FacetIndex fidx2 = *it2;
-                                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                                MeshPoint p0, p1;
-
-                                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                                if (isect > 0) {
-                                    // optimize cut line if distance to nearest point is too small
-                                    float minDist1 = _minDistanceToPoint,
-                                          minDist2 = _minDistanceToPoint;
-                                    MeshPoint np0 = p0, np1 = p1;
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f1._aclPoints[i] - p0).Length();
-                                        float d2 = (f1._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f1._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            p1 = f1._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    // optimize cut line if distance to nearest point is too small
-                                    for (int i = 0; i < 3; i++)  // NOLINT
-                                    {
-                                        float d1 = (f2._aclPoints[i] - p0).Length();
-                                        float d2 = (f2._aclPoints[i] - p1).Length();
-                                        if (d1 < minDist1) {
-                                            minDist1 = d1;
-                                            np0 = f2._aclPoints[i];
-                                        }
-                                        if (d2 < minDist2) {
-                                            minDist2 = d2;
-                                            np1 = f2._aclPoints[i];
-                                        }
-                                    }  // for (int i = 0; i < 3; i++)
-
-                                    MeshPoint mp0 = np0;
-                                    MeshPoint mp1 = np1;
-
-                                    if (mp0 != mp1) {
-                                        facetsCuttingEdge0.insert(fidx1);
-                                        facetsCuttingEdge1.insert(fidx2);
-
-                                        _cutPoints.insert(mp0);
-                                        _cutPoints.insert(mp1);
-
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit0
-                                            = _cutPoints.insert(mp0);
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit1
-                                            = _cutPoints.insert(mp1);
-
-                                        _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                                        _facet2points[0][fidx1].push_back(pit0.first);
-                                        _facet2points[0][fidx1].push_back(pit1.first);
-                                        _facet2points[1][fidx2].push_back(pit0.first);
-                                        _facet2points[1][fidx2].push_back(pit1.first);
-                                    }
-                                    else {
-                                        std::pair<std::set<MeshPoint>::iterator, bool> pit
-                                            = _cutPoints.insert(mp0);
-
-                                        // do not insert a facet when only one corner point cuts the
-                                        // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
-                                        // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge0.insert(fidx1);
-                                            _facet2points[0][fidx1].push_back(pit.first);
-                                        }
-
-                                        // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
-                                        // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                                        {
-                                            facetsCuttingEdge1.insert(fidx2);
-                                            _facet2points[1][fidx2].push_back(pit.first);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+    int num = threads > 0 ? threads : int(std::thread::hardware_concurrency());
+    return std::max(num, 1);
 }
 
-void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+void SetOperations::Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1)
 {
-    // Triangulate Mesh
-    std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>::iterator it1;
-    for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1) {
-        std::vector<Vector3f> points;
-        std::set<MeshPoint> pointsSet;
-
-        FacetIndex fidx = it1->first;
-        MeshGeomFacet f = cutMesh.GetFacet(fidx);
-
-        // if (side == 1)
-        //     _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0,
-        //     1, 1);
-
-        // facet corner points
-        // const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
-        for (int i = 0; i < 3; i++)  // NOLINT
-        {
-            pointsSet.insert(f._aclPoints[i]);
-            points.push_back(f._aclPoints[i]);
+    // a cut segment between a facet of mesh 0 and a facet of mesh 1
+    struct Segment
+    {
+        FacetIndex facet0;
+        FacetIndex facet1;
+        MeshPoint point0;
+        MeshPoint point1;
+    };
+
+    auto intersect = [this](const MeshGeomFacet& f1, const MeshGeomFacet& f2, Segment& segment) {
+        MeshPoint p0, p1;
+        if (IntersectFacets(f1, f2, _minDistanceToPoint, p0, p1) <= 0) {
+            return false;
         }
 
-        // triangulated facets
-        std::list<std::set<MeshPoint>::iterator>::iterator it2;
-        for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2) {
-            if (pointsSet.find(*(*it2)) == pointsSet.end()) {
-                pointsSet.insert(*(*it2));
-                points.push_back(*(*it2));
+        // optimize cut line if distance to nearest point is too small
+        float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
+        MeshPoint np0 = p0, np1 = p1;
+        for (const auto* facet : {&f1, &f2}) {
+            for (const auto& pnt : facet->_aclPoints) {
+                float d1 = (pnt - p0).Length();
+                float d2 = (pnt - p1).Length();
+                if (d1 < minDist1) {
+                    minDist1 = d1;
+                    np0 = pnt;
+                }
+                if (d2 < minDist2) {
+                    minDist2 = d2;
+                    np1 = pnt;
+                }
             }
         }
 
-        Vector3f normal = f.GetNormal();
-        Vector3f base = points[0];
-        Vector3f dirX = points[1] - points[0];
-        dirX.Normalize();
-        Vector3f dirY = dirX % normal;
-
-        // project points to 2D plane
-        std::vector<Vector3f>::iterator it;
-        std::vector<Vector3f> vertices;
-        for (it = points.begin(); it != points.end(); ++it) {
-            Vector3f pv = *it;
-            pv.TransformToCoordinateSystem(base, dirX, dirY);
-            vertices.push_back(pv);
+        segment.point0 = np0;
+        segment.point1 = np1;
+        return true;
+    };
+
+    // The facets of mesh 0 are split into more chunks than threads to balance the load. Every
+    // chunk collects its segments in the order of the facets, so that the result does not depend
+    // on the number of threads.
+    MeshFacetTree tree(_cutMesh1);
+    FacetIndex count = _cutMesh0.CountFacets();
+    std::size_t chunks = std::min<std::size_t>(count, 8 * std::size_t(CountThreads()));
+    std::vector<std::vector<Segment>> segments(chunks);
+    parallel_for(chunks, CountThreads(), [&](std::size_t first, std::size_t last) {
+        for (std::size_t chunk = first; chunk < last; chunk++) {
+            std::vector<Segment>& result = segments[chunk];
+            for (FacetIndex fidx1 = count * chunk / chunks; fidx1 < count * (chunk + 1) / chunks;
+                 fidx1++) {
+                MeshGeomFacet f1 = _cutMesh0.GetFacet(fidx1);
+                tree.Search(f1.GetBoundBox(), [&](FacetIndex fidx2) {
+                    Segment segment {fidx1, fidx2, {}, {}};
+                    if (intersect(f1, _cutMesh1.GetFacet(fidx2), segment)) {
+                        result.push_back(segment);
+                    }
+                });
+            }
         }
+    });
 
-        DelaunayTriangulator tria;
-        tria.SetPolygon(vertices);
-        tria.TriangulatePolygon();
+    for (const auto& chunk : segments) {
+        for (const auto& segment : chunk) {
+            FacetIndex fidx1 = segment.facet0;
+            FacetIndex fidx2 = segment.facet1;
+            const MeshPoint& mp0 = segment.point0;
+            const MeshPoint& mp1 = segment.point1;
 
-        std::vector<MeshFacet> facets = tria.GetFacets();
-        for (auto& it : facets) {
-            if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
-                || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
-                continue;
-            }
+            if (mp0 != mp1) {
+                facetsCuttingEdge0.insert(fidx1);
+                facetsCuttingEdge1.insert(fidx2);
 
-            MeshGeomFacet facet(
-                points[it._aulPoints[0]],
-                points[it._aulPoints[1]],
-                points[it._aulPoints[2]]
-            );
-
-            // if (side == 1)
-            //  _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1],
-            //  facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            // if (facet.Area() < 0.0001f)
-            //{ // too small facet
-            //   continue;
-            // }
-
-            float dist0 = facet._aclPoints[0].DistanceToLine(
-                facet._aclPoints[1],
-                facet._aclPoints[1] - facet._aclPoints[2]
-            );
-            float dist1 = facet._aclPoints[1].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[2]
-            );
-            float dist2 = facet._aclPoints[2].DistanceToLine(
-                facet._aclPoints[0],
-                facet._aclPoints[0] - facet._aclPoints[1]
-            );
-
-            if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
-                || (dist2 < _minDistanceToPoint)) {
-                continue;
-            }
+                std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+                std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
 
-            // dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-            // dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-            // dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
+                _edges[Edge(mp0, mp1)] = EdgeInfo();
 
-            // if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 <
-            // _minDistanceToPoint))
-            //{
-            //   continue;
-            // }
+                _facet2points[0][fidx1].push_back(pit0.first);
+                _facet2points[0][fidx1].push_back(pit1.first);
+                _facet2points[1][fidx2].push_back(pit0.first);
+                _facet2points[1][fidx2].push_back(pit1.first);
+            }
+            else {
+                std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
+
+                // do not insert a facet when only one corner point cuts the
+                // edge if (!((mp0 == f1._aclPoints[0]) || (mp0 ==
+                // f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
+                {
+                    facetsCuttingEdge0.insert(fidx1);
+                    _facet2points[0][fidx1].push_back(pit.first);
+                }
 
-            facet.CalcNormal();
-            if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
-                std::swap(facet._aclPoints[0], facet._aclPoints[1]);
-                facet.CalcNormal();
+                // if (!((mp0 == f2._aclPoints[0]) || (mp0 ==
+                // f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
+                {
+                    facetsCuttingEdge1.insert(fidx2);
+                    _facet2points[1][fidx2].push_back(pit.first);
+                }
             }
+        }
+    }
+}
+
+void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
+{
+    using FacetPoints = std::map<FacetIndex, std::list<std::set<MeshPoint>::iterator>>;
+    std::vector<FacetPoints::const_iterator> cutFacets;
+    cutFacets.reserve(_facet2points[side].size());
+    for (auto it = _facet2points[side].cbegin(); it != _facet2points[side].cend(); ++it) {
+        cutFacets.push_back(it);
+    }
 
+    // the facets are triangulated independently of each other, only the assignment to the
+    // cut edges must be done in a fixed order
+    std::vector<std::vector<MeshGeomFacet>> triangulated(cutFacets.size());
+    parallel_for(cutFacets.size(), CountThreads(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            MeshGeomFacet facet = cutMesh.GetFacet(cutFacets[i]->first);
+            triangulated[i] = TriangulateFacet(facet, cutFacets[i]->second);
+        }
+    });
 
+    for (std::size_t i = 0; i < cutFacets.size(); i++) {
+        FacetIndex fidx = cutFacets[i]->first;
+        for (auto& facet : triangulated[i]) {
             for (int j = 0; j < 3; j++) {
                 auto eit = _edges.find(Edge(facet._aclPoints[j], facet._aclPoints[(j + 1) % 3]));
 
@@ -421,6 +474,91 @@ void SetOperations::TriangulateMesh(const MeshKernel& cutMesh, int side)
     }
 }
 
+std::vector<MeshGeomFacet> SetOperations::TriangulateFacet(
+    const MeshGeomFacet& f,
+    const std::list<std::set<MeshPoint>::iterator>& cutPoints
+) const
+{
+    std::vector<MeshGeomFacet> result;
+    std::vector<Vector3f> points;
+    std::set<MeshPoint> pointsSet;
+
+    // facet corner points
+    for (int i = 0; i < 3; i++)  // NOLINT
+    {
+        pointsSet.insert(f._aclPoints[i]);
+        points.push_back(f._aclPoints[i]);
+    }
+
+    // triangulated facets
+    for (const auto& it : cutPoints) {
+        if (pointsSet.find(*it) == pointsSet.end()) {
+            pointsSet.insert(*it);
+            points.push_back(*it);
+        }
+    }
+
+    Vector3f normal = f.GetNormal();
+    Vector3f base = points[0];
+    Vector3f dirX = points[1] - points[0];
+    dirX.Normalize();
+    Vector3f dirY = dirX % normal;
+
+    // project points to 2D plane
+    std::vector<Vector3f> vertices;
+    for (const auto& it : points) {
+        Vector3f pv = it;
+        pv.TransformToCoordinateSystem(base, dirX, dirY);
+        vertices.push_back(pv);
+    }
+
+    DelaunayTriangulator tria;
+    tria.SetPolygon(vertices);
+    tria.TriangulatePolygon();
+
+    std::vector<MeshFacet> facets = tria.GetFacets();
+    for (auto& it : facets) {
+        if ((it._aulPoints[0] == it._aulPoints[1]) || (it._aulPoints[1] == it._aulPoints[2])
+            || (it._aulPoints[2] == it._aulPoints[0])) {  // two same triangle corner points
+            continue;
+        }
+
+        MeshGeomFacet facet(
+            points[it._aulPoints[0]],
+            points[it._aulPoints[1]],
+            points[it._aulPoints[2]]
+        );
+
+        float dist0 = facet._aclPoints[0].DistanceToLine(
+            facet._aclPoints[1],
+            facet._aclPoints[1] - facet._aclPoints[2]
+        );
+        float dist1 = facet._aclPoints[1].DistanceToLine(
+            facet._aclPoints[0],
+            facet._aclPoints[0] - facet._aclPoints[2]
+        );
+        float dist2 = facet._aclPoints[2].DistanceToLine(
+            facet._aclPoints[0],
+            facet._aclPoints[0] - facet._aclPoints[1]
+        );
+
+        if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint)
+            || (dist2 < _minDistanceToPoint)) {
+            continue;
+        }
+
+        facet.CalcNormal();
+        if ((facet.GetNormal() * f.GetNormal()) < 0.0F) {  // adjust normal
+            std::swap(facet._aclPoints[0], facet._aclPoints[1]);
+            facet.CalcNormal();
+        }
+
+        result.push_back(facet);
+    }
+
+    return result;
+}
+
 void SetOperations::CollectFacets(int side, float mult)
 {
     // float distSave = MeshDefinitions::_fMinPointDistance;
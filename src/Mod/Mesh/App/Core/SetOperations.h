@@ -78,6 +78,11 @@ public:
      * polyline goes direct to the point
      */
     void Do();
+    /// Number of threads to use, 0 means the number of cores.
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
 
 private:
     const MeshKernel& _cutMesh0;  /** Mesh for set operations source 1 */
@@ -194,13 +199,21 @@ private:
     void Cut(std::set<FacetIndex>& facetsCuttingEdge0, std::set<FacetIndex>& facetsCuttingEdge1);
     /** Trianglute each facets cut with its cutting points */
     void TriangulateMesh(const MeshKernel& cutMesh, int side);
+    /** Triangulate a single facet with its cutting points */
+    std::vector<MeshGeomFacet> TriangulateFacet(
+        const MeshGeomFacet& facet,
+        const std::list<std::set<MeshPoint>::iterator>& cutPoints
+    ) const;
     /** search facets for adding (with region growing) */
     void CollectFacets(int side, float mult);
     /** close gap in the mesh */
     void CloseGaps(MeshBuilder& meshBuilder);
 
+    int CountThreads() const;
+
     /** visual debugger */
     Base::Builder3D _builder;
+    int threads {0};
 };
 
 /*!
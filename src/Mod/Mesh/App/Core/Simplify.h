@@ -12,7 +12,9 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices, vertex ids and a maximum edge error for the block-wise simplification
 
+#include <limits>
 #include <vector>
 
 using vec3f = Base::Vector3f;
@@ -82,11 +84,13 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;int id=-1;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
     std::vector<Ref> refs;
+    // edges with a higher quadric error are never collapsed
+    double max_error = std::numeric_limits<double>::max();
 
     void simplify_mesh(int target_count, double tolerance, double aggressiveness=7);
 
@@ -187,7 +191,7 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
 
             for (std::size_t j=0;j<3;++j)
             {
-                if (t.err[j]<threshold)
+                if (t.err[j]<threshold && t.err[j]<=max_error)
                 {
                     int i0=t.v[ j     ]; Vertex &v0 = vertices[i0];
                     int i1=t.v[(j+1)%3]; Vertex &v1 = vertices[i1];
@@ -196,6 +200,10 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices must keep their position
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
                     calculate_error(i0,i1,p);
@@ -476,6 +484,8 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].locked=vertices[i].locked;
+            vertices[dst].id=vertices[i].id;
             dst++;
         }
     }
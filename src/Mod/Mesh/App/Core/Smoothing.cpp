@@ -22,13 +22,16 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 
 
 #include <Base/Tools.h>
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
@@ -49,118 +52,166 @@ void AbstractSmoothing::initialize(Component comp, Continuity cont)
     this->continuity = cont;
 }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-    : AbstractSmoothing(m)
-{}
+int AbstractSmoothing::CountThreads() const
+{
+    if (threads > 0) {
+        return threads;
+    }
+    return std::max(int(std::thread::hardware_concurrency()), 1);
+}
 
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
+namespace
+{
+// Moves the points index(0), ..., index(count - 1) to the positions returned by newPoint.
+// If simultaneous is set, all new positions are computed, in parallel, before the first
+// point is moved. Thus, every point only depends on the positions of the previous iteration
+// and the result is the same for any number of threads. Otherwise every point is moved right
+// away and the next points see its new position.
+template<class IndexFunc, class PointFunc>
+void MovePoints(
+    MeshKernel& kernel,
+    std::size_t count,
+    int threads,
+    bool simultaneous,
+    IndexFunc index,
+    PointFunc newPoint
+)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    if (!simultaneous) {
+        for (std::size_t i = 0; i < count; i++) {
+            PointIndex pos = index(i);
+            kernel.SetPoint(pos, newPoint(pos));
+        }
+        return;
+    }
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    std::vector<Base::Vector3f> moved(count);
+    MeshCore::parallel_for(count, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            moved[i] = newPoint(index(i));
+        }
+    });
 
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+    for (std::size_t i = 0; i < count; i++) {
+        kernel.SetPoint(index(i), moved[i]);
+    }
+}
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+Base::Vector3f PlaneFitPoint(
+    const MeshPointArray& points,
+    const MeshCompactPointToPoints& vv_it,
+    PointIndex pos,
+    float maximum
+)
+{
+    const MeshPoint& pnt = points[pos];
+    MeshCompactPointToPoints::Row cv = vv_it[pos];
+    if (cv.size() < 3) {
+        return pnt;
+    }
 
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(pnt);
+    Base::Vector3f center = pnt;
+    for (PointIndex cv_it : cv) {
+        pf.AddPoint(points[cv_it]);
+        center += points[cv_it];
+    }
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+    float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
+    center.Scale(scale, scale, scale);
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+    // get the mean plane of the current vertex with the surrounding vertices
+    pf.Fit();
+    Base::Vector3f N = pf.GetNormal();
+    N.Normalize();
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+    // look in which direction we should move the vertex
+    Base::Vector3f L(pnt.x - center.x, pnt.y - center.y, pnt.z - center.z);
+    if (N * L < 0.0F) {
+        N.Scale(-1.0, -1.0, -1.0);
+    }
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+    // maximum value to move is distance to mean plane
+    float d = std::min<float>(std::fabs(maximum), std::fabs(N * L));
+    N.Scale(d, d, d);
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
-    }
+    return Base::Vector3f(pnt.x - N.x, pnt.y - N.y, pnt.z - N.z);
 }
 
-void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
+// works with the MeshRef* and MeshCompact* tables
+template<class PointToPoints, class PointToFacets>
+Base::Vector3f UmbrellaPoint(
+    const MeshPointArray& points,
+    const PointToPoints& vv_it,
+    const PointToFacets& vf_it,
+    PointIndex pos,
+    double stepsize
+)
 {
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    const MeshPoint& pnt = points[pos];
+    const auto& cv = vv_it[pos];
+    if (cv.size() < 3) {
+        return pnt;
+    }
+    if (cv.size() != vf_it[pos].size()) {
+        // do nothing for border points
+        return pnt;
+    }
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+    size_t n_count = cv.size();
+    double w {};
+    w = 1.0 / double(n_count);
 
-    for (unsigned int i = 0; i < iterations; i++) {
-        Base::Vector3f N, L;
-        for (PointIndex it : point_indices) {
-            v_it.Set(it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3) {
-                continue;
-            }
+    double delx = 0.0, dely = 0.0, delz = 0.0;
+    for (PointIndex cv_it : cv) {
+        delx += w * static_cast<double>(points[cv_it].x - pnt.x);
+        dely += w * static_cast<double>(points[cv_it].y - pnt.y);
+        delz += w * static_cast<double>(points[cv_it].z - pnt.z);
+    }
 
-            std::set<PointIndex>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
+    float x = static_cast<float>(static_cast<double>(pnt.x) + stepsize * delx);
+    float y = static_cast<float>(static_cast<double>(pnt.y) + stepsize * dely);
+    float z = static_cast<float>(static_cast<double>(pnt.z) + stepsize * delz);
+    return Base::Vector3f(x, y, z);
+}
+}  // namespace
 
-            float scale = 1.0F / (static_cast<float>(cv.size()) + 1.0F);
-            center.Scale(scale, scale, scale);
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+    : AbstractSmoothing(m)
+{}
 
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
 
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N * L < 0.0F) {
-                N.Scale(-1.0, -1.0, -1.0);
-            }
+    auto index = [](std::size_t i) {
+        return static_cast<PointIndex>(i);
+    };
+    auto newPoint = [this, &points, &vv_it](PointIndex pos) {
+        return PlaneFitPoint(points, vv_it, pos, this->maximum);
+    };
 
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>(std::fabs(this->maximum), fabs(N * L));
-            N.Scale(d, d, d);
+    for (unsigned int i = 0; i < iterations; i++) {
+        MovePoints(kernel, points.size(), CountThreads(), true, index, newPoint);
+    }
+}
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
 
-        // assign values without affecting iterators
-        PointIndex count = kernel.CountPoints();
-        for (PointIndex idx = 0; idx < count; idx++) {
-            kernel.SetPoint(idx, PointArray[idx]);
-        }
+    auto index = [&point_indices](std::size_t i) {
+        return point_indices[i];
+    };
+    auto newPoint = [this, &points, &vv_it](PointIndex pos) {
+        return PlaneFitPoint(points, vv_it, pos, this->maximum);
+    };
+
+    for (unsigned int i = 0; i < iterations; i++) {
+        MovePoints(kernel, point_indices.size(), CountThreads(), true, index, newPoint);
     }
 }
 
@@ -175,36 +226,14 @@ void LaplaceSmoothing::Umbrella(
 )
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
-
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
-    }
+    MovePoints(
+        kernel,
+        points.size(),
+        CountThreads(),
+        IsSimultaneous(),
+        [](std::size_t i) { return static_cast<PointIndex>(i); },
+        [&](PointIndex pos) { return UmbrellaPoint(points, vv_it, vf_it, pos, stepsize); }
+    );
 }
 
 void LaplaceSmoothing::Umbrella(
@@ -215,41 +244,55 @@ void LaplaceSmoothing::Umbrella(
 )
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    MovePoints(
+        kernel,
+        point_indices.size(),
+        CountThreads(),
+        IsSimultaneous(),
+        [&point_indices](std::size_t i) { return point_indices[i]; },
+        [&](PointIndex pos) { return UmbrellaPoint(points, vv_it, vf_it, pos, stepsize); }
+    );
+}
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
-        }
+void LaplaceSmoothing::Umbrella(
+    const MeshCompactPointToPoints& vv_it,
+    const MeshCompactPointToFacets& vf_it,
+    double stepsize
+)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MovePoints(
+        kernel,
+        points.size(),
+        CountThreads(),
+        IsSimultaneous(),
+        [](std::size_t i) { return static_cast<PointIndex>(i); },
+        [&](PointIndex pos) { return UmbrellaPoint(points, vv_it, vf_it, pos, stepsize); }
+    );
+}
 
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
-    }
+void LaplaceSmoothing::Umbrella(
+    const MeshCompactPointToPoints& vv_it,
+    const MeshCompactPointToFacets& vf_it,
+    double stepsize,
+    const std::vector<PointIndex>& point_indices
+)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    MovePoints(
+        kernel,
+        point_indices.size(),
+        CountThreads(),
+        IsSimultaneous(),
+        [&point_indices](std::size_t i) { return point_indices[i]; },
+        [&](PointIndex pos) { return UmbrellaPoint(points, vv_it, vf_it, pos, stepsize); }
+    );
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
@@ -258,8 +301,8 @@ void LaplaceSmoothing::Smooth(unsigned int iterations)
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
@@ -272,8 +315,8 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -285,8 +328,8 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel, vf_it);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -327,8 +370,8 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
     std::vector<unsigned long> point_indices(kernel.CountPoints());
     std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel, vf_it);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
@@ -340,8 +383,8 @@ void MedianFilterSmoothing::SmoothPoints(
     const std::vector<PointIndex>& point_indices
 )
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel, vf_it);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
@@ -349,66 +392,69 @@ void MedianFilterSmoothing::SmoothPoints(
 }
 
 void MedianFilterSmoothing::UpdatePoints(
-    const MeshRefFacetToFacets& ff_it,
-    const MeshRefPointToFacets& vf_it,
+    const MeshCompactFacetToFacets& ff_it,
+    const MeshCompactPointToFacets& vf_it,
     const std::vector<PointIndex>& point_indices
 )
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+    int threads = CountThreads();
 
     // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
+    std::vector<Base::Vector3d> realNormals(facets.size());
+    MeshCore::parallel_for(facets.size(), threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t pos = begin; pos < end; pos++) {
+            realNormals[pos] = Base::toVector<double>(kernel.GetFacet(pos).GetNormal());
+        }
+    });
 
     // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
+    std::vector<Base::Vector3d> faceNormals(facets.size());
+    MeshCore::parallel_for(facets.size(), threads, [&](std::size_t begin, std::size_t end) {
         std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+        for (FacetIndex pos = begin; pos < end; pos++) {
+            const Base::Vector3d& refNormal = realNormals[pos];
+            MeshCompactFacetToFacets::Row cv = ff_it[pos];
+            const MeshCore::MeshFacet& facet = facets[pos];
+
+            anglesWithFaces.clear();
+            for (auto fi : cv) {
+                const Base::Vector3d& faceNormal = realNormals[fi];
+                double angle = refNormal.GetAngle(faceNormal);
+
+                int absWeight = std::abs(weights);
+                if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                    if (weights < 0) {
+                        angle = -angle;
+                    }
+                    for (int i = 0; i < absWeight; i++) {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
                 }
-                for (int i = 0; i < absWeight; i++) {
+                else {
                     anglesWithFaces.emplace_back(angle, faceNormal);
                 }
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
 
-        faceNormals[pos] = find_median(anglesWithFaces);
-    }
+            faceNormals[pos] = find_median(anglesWithFaces);
+        }
+    });
 
     // Step 2: move vertices
-    for (auto pos : point_indices) {
+    auto newPoint = [&](PointIndex pos) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+        MeshCompactPointToFacets::Row cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
         for (auto it : cv) {
-            iter.Set(it);
+            MeshGeomFacet face = kernel.GetFacet(it);
 
-            double faceArea = iter->Area();
+            double faceArea = face.Area();
             totalArea += faceArea;
 
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
+            Base::Vector3d C = Base::toVector<double>(face.GetGravityPoint());
 
             Base::Vector3d PC = C - P;
             Base::Vector3d mT = faceNormals[it];
@@ -417,6 +463,15 @@ void MedianFilterSmoothing::UpdatePoints(
         }
 
         P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
-    }
+        return Base::toVector<float>(P);
+    };
+
+    MovePoints(
+        kernel,
+        point_indices.size(),
+        threads,
+        IsSimultaneous(),
+        [&point_indices](std::size_t i) { return point_indices[i]; },
+        newPoint
+    );
 }
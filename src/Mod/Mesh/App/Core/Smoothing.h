@@ -35,7 +35,9 @@ namespace MeshCore
 class MeshKernel;
 class MeshRefPointToPoints;
 class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
+class MeshCompactPointToPoints;
+class MeshCompactPointToFacets;
+class MeshCompactFacetToFacets;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -63,17 +65,48 @@ public:
     AbstractSmoothing& operator=(AbstractSmoothing&&) = delete;
 
     void initialize(Component comp, Continuity cont);
+    /** Sets the number of threads, 0 uses one thread per core. The points are only moved in
+     * parallel by the plane fit smoothing and in the simultaneous mode.
+     */
+    void SetThreads(int num)
+    {
+        threads = num;
+    }
+    int GetThreads() const
+    {
+        return threads;
+    }
+    /** If set, the new positions of all points of an iteration are computed from the positions
+     * of the previous iteration before any point is moved, so the points can be moved in
+     * parallel and the result doesn't depend on the point order or the number of threads.
+     * By default the Laplace, Taubin and median filter smoothing move every point right away,
+     * so a point sees the already moved positions of its predecessors. The plane fit smoothing
+     * always works simultaneously.
+     */
+    void SetSimultaneous(bool on)
+    {
+        simultaneous = on;
+    }
+    bool IsSimultaneous() const
+    {
+        return simultaneous;
+    }
 
     /** Smooth the triangle mesh. */
     virtual void Smooth(unsigned int) = 0;
     virtual void SmoothPoints(unsigned int, const std::vector<PointIndex>&) = 0;
 
+protected:
+    int CountThreads() const;
+
 protected:
     // NOLINTBEGIN
     MeshKernel& kernel;
 
     Component component {Normal};
     Continuity continuity {C0};
+    int threads {0};
+    bool simultaneous {false};
     // NOLINTEND
 };
 
@@ -115,6 +148,13 @@ protected:
         double,
         const std::vector<PointIndex>&
     );
+    void Umbrella(const MeshCompactPointToPoints&, const MeshCompactPointToFacets&, double);
+    void Umbrella(
+        const MeshCompactPointToPoints&,
+        const MeshCompactPointToFacets&,
+        double,
+        const std::vector<PointIndex>&
+    );
 
 private:
     double lambda {0.6307};
@@ -153,8 +193,8 @@ public:
 
 private:
     void UpdatePoints(
-        const MeshRefFacetToFacets&,
-        const MeshRefPointToFacets&,
+        const MeshCompactFacetToFacets&,
+        const MeshCompactPointToFacets&,
         const std::vector<PointIndex>&
     );
 
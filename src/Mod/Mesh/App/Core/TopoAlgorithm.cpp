@@ -43,9 +43,13 @@
 
 using namespace MeshCore;
 
+// the facets are modified directly, so the mesh counts as modified when the algorithm starts and
+// when it's done
 MeshTopoAlgorithm::MeshTopoAlgorithm(MeshKernel& rclM)
     : _rclMesh(rclM)
-{}
+{
+    _rclMesh.IncrementRevision();
+}
 
 MeshTopoAlgorithm::~MeshTopoAlgorithm()
 {
@@ -53,6 +57,7 @@ MeshTopoAlgorithm::~MeshTopoAlgorithm()
         Cleanup();
     }
     EndCache();
+    _rclMesh.IncrementRevision();
 }
 
 bool MeshTopoAlgorithm::InsertVertex(FacetIndex ulFacetPos, const Base::Vector3f& rclPoint)
@@ -353,6 +353,8 @@ void MeshTrimming::AdjustFacet(MeshFacet& facet, int iInd)
 {
     unsigned long tmp {};
 
+    myMesh.IncrementRevision();
+
     if (iInd == 1) {
         tmp = facet._aulPoints[0];
         facet._aulPoints[0] = facet._aulPoints[1];
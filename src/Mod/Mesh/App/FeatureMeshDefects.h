@@ -55,6 +55,11 @@ public:
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
     short mustExecute() const override;
+    /// the fixes work on a copy of the source mesh and only set their own mesh
+    bool canRecomputeConcurrently() const override
+    {
+        return true;
+    }
     //@}
 
     /// returns the type name of the ViewProvider
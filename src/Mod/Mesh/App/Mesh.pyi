@@ -438,7 +438,12 @@ class Mesh(ComplexGeoData):
     @constmethod
     def smooth(self, **kwargs) -> Any:
         """Smooth the mesh
-        smooth([iteration=1,maxError=FLT_MAX])"""
+        smooth([Method="Laplace", Iteration=1, Lambda, Micro, Maximum=1000, Weight=1,
+                Simultaneous=False, Threads=0])
+        Method is one of Laplace, Taubin, PlaneFit or MedianFilter.
+        Simultaneous computes all new positions of an iteration before any point is
+        moved, so that the points are moved in parallel. PlaneFit always does this.
+        Threads is the number of threads, 0 uses one per core."""
         ...
 
     def decimate(self) -> Any:
@@ -492,9 +497,10 @@ class Mesh(ComplexGeoData):
 
     @constmethod
     def getSegmentsByCurvature(self) -> Any:
-        """getSegmentsByCurvature(list) -> list
+        """getSegmentsByCurvature(list, [threads=0]) -> list
         The argument list gives a list if tuples where it defines the preferred maximum curvature,
         the preferred minimum curvature, the tolerances and the number of minimum faces for the segment.
+        The segments are searched with the given number of threads, 0 uses one per core.
         Example:
         c=(1.0, 0.0, 0.1, 0.1, 500) # search for a cylinder with radius 1.0
         p=(0.0, 0.0, 0.1, 0.1, 500) # search for a plane
@@ -721,7 +721,7 @@ bool PropertyMaterial::isSame(const App::Property& other) const
 // ----------------------------------------------------------------------------
 
 PropertyMeshKernel::PropertyMeshKernel()
-    : _meshObject(new MeshObject())
+    : _meshObject(std::make_shared<Base::Reference<MeshObject>>(new MeshObject()))
 {
     // Note: Normally this property is a member of a document object, i.e. the setValue()
     // method gets called in the constructor of a subclass of DocumentObject, e.g. Mesh::Feature.
@@ -743,64 +743,109 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 {
     // use the tmp. object to guarantee that the referenced mesh is not destroyed
     // before calling hasSetValue()
-    Base::Reference<MeshObject> tmp(_meshObject);
+    Base::Reference<MeshObject> tmp(getMeshObject());
     aboutToSetValue();
-    _meshObject = mesh;
+    if (mesh != getMeshObject()) {
+        resetMeshObject(std::make_shared<Base::Reference<MeshObject>>(mesh));
+    }
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
-    *_meshObject = mesh;
+    if (&mesh != getMeshObject()) {
+        detach(false);
+        *getMeshObject() = mesh;
+    }
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->setKernel(mesh);
+    detach(false);
+    getMeshObject()->setKernel(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detach(false);
+    getMeshObject()->swap(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detach(false);
+    getMeshObject()->swap(mesh);
     hasSetValue();
 }
 
+void PropertyMeshKernel::detach(bool keepData)
+{
+    if (_meshObject.use_count() < 2) {
+        return;
+    }
+
+    // the copies get the data while this property keeps its mesh object
+    MeshObject* mesh = getMeshObject();
+    MeshObject* data = nullptr;
+    if (keepData) {
+        data = new MeshObject(*mesh);
+    }
+    else {
+        data = new MeshObject();
+        data->swap(*mesh);
+        mesh->getKernel().Clear();
+        mesh->setTransform(data->getTransform());
+    }
+    auto own = std::make_shared<Base::Reference<MeshObject>>(mesh);
+    *_meshObject = data;
+    _meshObject = std::move(own);
+}
+
+void PropertyMeshKernel::resetMeshObject(SharedMeshObject mesh)
+{
+    // the Python wrapper must refer to the new mesh object, it holds a reference to it
+    if (meshPyObject) {
+        MeshObject* newMesh = *mesh;
+        MeshObject* oldMesh = meshPyObject->getMeshObjectPtr();
+        newMesh->ref();
+        meshPyObject->setTwinPointer(newMesh);
+        oldMesh->unref();
+    }
+
+    _meshObject = std::move(mesh);
+}
+
 const MeshObject& PropertyMeshKernel::getValue() const
 {
-    return *_meshObject;
+    return *getMeshObject();
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr() const
 {
-    return static_cast<MeshObject*>(_meshObject);
+    return getMeshObject();
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
-    return static_cast<MeshObject*>(_meshObject);
+    return getMeshObject();
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
-    return _meshObject->getBoundBox();
+    return getMeshObject()->getBoundBox();
 }
 
 unsigned int PropertyMeshKernel::getMemSize() const
 {
     unsigned int size = 0;
-    size += _meshObject->getMemSize();
+    size += getMeshObject()->getMemSize();
 
     return size;
 }
@@ -808,7 +853,8 @@ unsigned int PropertyMeshKernel::getMemSize() const
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
-    return static_cast<MeshObject*>(_meshObject);
+    detach(true);
+    return getMeshObject();
 }
 
 void PropertyMeshKernel::finishEditing()
@@ -819,14 +865,16 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
     aboutToSetValue();
-    _meshObject->transformGeometry(rclMat);
+    detach(true);
+    getMeshObject()->transformGeometry(rclMat);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex, Base::Vector3f>>& inds)
 {
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    detach(true);
+    MeshCore::MeshKernel& kernel = getMeshObject()->getKernel();
     for (const auto& it : inds) {
         kernel.SetPoint(it.first, it.second);
     }
@@ -835,21 +883,24 @@ void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<PointIndex,
 
 void PropertyMeshKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
-    _meshObject->setTransform(rclTrf);
+    if (getMeshObject()->getTransform() != rclTrf) {
+        detach(true);
+        getMeshObject()->setTransform(rclTrf);
+    }
 }
 
 Base::Matrix4D PropertyMeshKernel::getTransform() const
 {
-    return _meshObject->getTransform();
+    return getMeshObject()->getTransform();
 }
 
 PyObject* PropertyMeshKernel::getPyObject()
 {
     if (!meshPyObject) {
-        meshPyObject = new MeshPy(&*_meshObject);  // Lgtm[cpp/resource-not-released-in-destructor]
-                                                   // ** Not destroyed in this class because it is
-                                                   // reference-counted and destroyed elsewhere
-        meshPyObject->setConst();                  // set immutable
+        meshPyObject = new MeshPy(getMeshObject());  // Lgtm[cpp/resource-not-released-in-destructor]
+                                                     // ** Not destroyed in this class because it is
+                                                     // reference-counted and destroyed elsewhere
+        meshPyObject->setConst();                    // set immutable
         meshPyObject->parentProperty = this;
     }
 
@@ -862,7 +913,7 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
     if (PyObject_TypeCheck(value, &(MeshPy::Type))) {
         MeshPy* mesh = static_cast<MeshPy*>(value);
         // Do not allow one to reassign the same instance
-        if (&(*this->_meshObject) != mesh->getMeshObjectPtr()) {
+        if (getMeshObject() != mesh->getMeshObjectPtr()) {
             // Note: Copy the content, do NOT reference the same mesh object
             setValue(*(mesh->getMeshObjectPtr()));
         }
@@ -884,7 +935,7 @@ void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
     if (writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
-        MeshCore::MeshOutput saver(_meshObject->getKernel());
+        MeshCore::MeshOutput saver(getMeshObject()->getKernel());
         saver.SaveXML(writer);
     }
     else {
@@ -910,7 +961,8 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
-        _meshObject->getKernel().Adopt(points, facets);
+        detach(false);
+        getMeshObject()->getKernel().Adopt(points, facets);
         hasSetValue();
     }
     else {
@@ -921,29 +973,33 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
-    _meshObject->save(writer.Stream());
+    getMeshObject()->save(writer.Stream());
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
 {
     aboutToSetValue();
-    _meshObject->load(reader);
+    detach(false);
+    getMeshObject()->load(reader);
     hasSetValue();
 }
 
 App::Property* PropertyMeshKernel::Copy() const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: The copy references the same mesh object until one of both gets modified. This way
+    // recording a transaction doesn't depend on the size of the mesh.
     PropertyMeshKernel* prop = new PropertyMeshKernel();
-    *(prop->_meshObject) = *(this->_meshObject);
+    prop->resetMeshObject(_meshObject);
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property& from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    // Note: Share the mesh object of the other property, it gets copied before it is modified
     aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    if (prop._meshObject != _meshObject) {
+        resetMeshObject(prop._meshObject);
+    }
     hasSetValue();
 }
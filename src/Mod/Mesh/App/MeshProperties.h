@@ -26,6 +26,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -259,9 +260,13 @@ public:
     void setValue(const MeshObject& m);
     /** This method sets the mesh by copying the data. */
     void setValue(const MeshCore::MeshKernel& m);
-    /** Swaps the mesh data structure. */
+    /** Swaps the mesh data structure. If the mesh is still shared with a copy of
+     * this property the passed mesh is left empty.
+     */
     void swapMesh(MeshObject&);
-    /** Swaps the mesh data structure. */
+    /** Swaps the mesh data structure. If the mesh is still shared with a copy of
+     * this property the passed mesh is left empty.
+     */
     void swapMesh(MeshCore::MeshKernel&);
     /** Returns a the attached mesh object by reference. It cannot be modified
      * from outside.
@@ -317,12 +322,31 @@ public:
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
 
+    /** A copy shares the mesh object with this property until one of both gets
+     * modified. Recording a transaction therefore doesn't copy the mesh, and
+     * operations that replace the mesh never copy it at all. When this property
+     * gets modified it keeps its mesh object and the copies get the previous data,
+     * so that the Python wrapper always refers to the current mesh.
+     */
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
     //@}
 
 private:
-    Base::Reference<MeshObject> _meshObject;
+    using SharedMeshObject = std::shared_ptr<Base::Reference<MeshObject>>;
+    MeshObject* getMeshObject() const
+    {
+        return *_meshObject;
+    }
+    /** Hands the data over to the copies that still share the mesh object, so
+     * that this property can modify it. The mesh object either keeps the data or
+     * is left empty if \a keepData is false. */
+    void detach(bool keepData);
+    void resetMeshObject(SharedMeshObject mesh);
+
+private:
+    /// The mesh object, shared by this property and its copies
+    SharedMeshObject _meshObject;
     MeshPy* meshPyObject {nullptr};
 };
 
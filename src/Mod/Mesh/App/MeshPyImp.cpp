@@ -2005,19 +2005,32 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     double micro = 0;
     double maximum = 1000;
     int weight = 1;
-    static const std::array<const char*, 7>
-        keywords_smooth {"Method", "Iteration", "Lambda", "Micro", "Maximum", "Weight", nullptr};
+    int simultaneous = 0;
+    int threads = 0;
+    static const std::array<const char*, 9> keywords_smooth {
+        "Method",
+        "Iteration",
+        "Lambda",
+        "Micro",
+        "Maximum",
+        "Weight",
+        "Simultaneous",
+        "Threads",
+        nullptr
+    };
     if (!Base::Wrapped_ParseTupleAndKeywords(
             args,
             kwds,
-            "|sidddi",
+            "|sidddipi",
             keywords_smooth,
             &method,
             &iter,
             &lambda,
             &micro,
             &maximum,
-            &weight
+            &weight,
+            &simultaneous,
+            &threads
         )) {
         return nullptr;
     }
@@ -2026,8 +2039,13 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     {
         MeshPropertyLock lock(this->parentProperty);
         MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+        auto setup = [=](MeshCore::AbstractSmoothing& smooth) {
+            smooth.SetSimultaneous(simultaneous != 0);
+            smooth.SetThreads(threads);
+        };
         if (strcmp(method, "Laplace") == 0) {
             MeshCore::LaplaceSmoothing smooth(kernel);
+            setup(smooth);
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
@@ -2035,6 +2053,7 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
         }
         else if (strcmp(method, "Taubin") == 0) {
             MeshCore::TaubinSmoothing smooth(kernel);
+            setup(smooth);
             if (lambda > 0) {
                 smooth.SetLambda(lambda);
             }
@@ -2045,11 +2064,13 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
         }
         else if (strcmp(method, "PlaneFit") == 0) {
             MeshCore::PlaneFitSmoothing smooth(kernel);
+            setup(smooth);
             smooth.SetMaximum(maximum);
             smooth.Smooth(iter);
         }
         else if (strcmp(method, "MedianFilter") == 0) {
             MeshCore::MedianFilterSmoothing smooth(kernel);
+            setup(smooth);
             smooth.SetWeight(weight);
             smooth.Smooth(iter);
         }
@@ -2194,12 +2215,14 @@ PyObject* MeshPy::getSegmentsOfType(PyObject* args) const
 PyObject* MeshPy::getSegmentsByCurvature(PyObject* args) const
 {
     PyObject* l {};
-    if (!PyArg_ParseTuple(args, "O", &l)) {
+    int threads = 0;
+    if (!PyArg_ParseTuple(args, "O|i", &l, &threads)) {
         return nullptr;
     }
 
     const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
     MeshCore::MeshSegmentAlgorithm finder(kernel);
+    finder.SetThreads(threads);
     MeshCore::MeshCurvature meshCurv(kernel);
     meshCurv.ComputePerVertex();
 
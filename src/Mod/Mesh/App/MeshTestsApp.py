@@ -648,6 +648,32 @@ class MeshSubElement(unittest.TestCase):
         pass
 
 
+class MeshSmoothing(unittest.TestCase):
+    def setUp(self):
+        self.mesh = Mesh.createSphere(1.0, 20)
+
+    def testSimultaneousThreads(self):
+        points = []
+        for threads in (1, 4):
+            mesh = self.mesh.copy()
+            mesh.smooth(Method="Taubin", Iteration=3, Simultaneous=True, Threads=threads)
+            points.append(mesh.Topology[0])
+        self.assertEqual(points[0], points[1])
+
+        # by default every point is moved right away
+        mesh = self.mesh.copy()
+        mesh.smooth(Method="Laplace", Iteration=3)
+        other = self.mesh.copy()
+        other.smooth(Method="Laplace", Iteration=3, Simultaneous=True)
+        self.assertNotEqual(mesh.Topology[0], other.Topology[0])
+
+    def testSegmentsByCurvatureThreads(self):
+        sphere = (1.0, 1.0, 0.5, 0.5, 10)
+        segments = [self.mesh.getSegmentsByCurvature([sphere], threads) for threads in (1, 4)]
+        self.assertGreater(len(segments[0]), 0)
+        self.assertEqual(segments[0], segments[1])
+
+
 class MeshProperty(unittest.TestCase):
     def setUp(self):
         self.doc = FreeCAD.newDocument("MeshTest")
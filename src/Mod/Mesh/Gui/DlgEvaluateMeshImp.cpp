@@ -22,6 +22,11 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+
 #include <QDockWidget>
 #include <QMessageBox>
 #include <QPointer>
@@ -1195,97 +1200,105 @@ void DlgEvaluateMeshImp::onRepairAllTogetherClicked()
         Gui::Document* doc = Gui::Application::Instance->getDocument(docName);
         doc->openCommand(QT_TRANSLATE_NOOP("Command", "Repair Mesh"));
 
+        // the checks in the order their repairs are run
+        using Evaluations = std::vector<std::unique_ptr<MeshEvaluation>>;
+        struct RepairCheck
+        {
+            std::function<void(const MeshKernel&, Evaluations&)> create;
+            std::string repair;
+            bool enabled {true};
+            // once no defects are found the check is not repeated later on
+            bool once {false};
+        };
+
+        float epsilon = d->epsilonDegenerated;
+        std::vector<RepairCheck> checks;
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalSelfIntersection>(mesh));
+        }, "fixSelfIntersections()", true, true});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalFoldsOnSurface>(mesh));
+            evals.push_back(std::make_unique<MeshEvalFoldsOnBoundary>(mesh));
+            evals.push_back(std::make_unique<MeshEvalFoldOversOnSurface>(mesh));
+        }, "removeFoldsOnSurface()", d->enableFoldsCheck});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalOrientation>(mesh));
+        }, "harmonizeNormals()"});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalTopology>(mesh));
+        }, "removeNonManifolds()"});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalRangeFacet>(mesh));
+            evals.push_back(std::make_unique<MeshEvalRangePoint>(mesh));
+            evals.push_back(std::make_unique<MeshEvalCorruptedFacets>(mesh));
+            evals.push_back(std::make_unique<MeshEvalNeighbourhood>(mesh));
+        }, "fixIndices()"});
+        checks.push_back({[epsilon](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalDegeneratedFacets>(mesh, epsilon));
+        }, "fixDegenerations(" + std::to_string(epsilon) + ")"});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalDuplicateFacets>(mesh));
+        }, "removeDuplicatedFacets()"});
+        checks.push_back({[](const MeshKernel& mesh, Evaluations& evals) {
+            evals.push_back(std::make_unique<MeshEvalDuplicatePoints>(mesh));
+        }, "removeDuplicatedPoints()"});
+
+        auto evaluate = [](const Evaluations& evals) {
+            return std::ranges::all_of(evals, [](const auto& eval) { return eval->Evaluate(); });
+        };
+
         bool run = false;
-        bool self = true;
         int max_iter = 10;
-        const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
         try {
             do {
-                run = false;
+                // All checks of a pass are run at the same time on the unchanged mesh. A repair
+                // replaces the mesh, so the checks after it are run again.
+                std::vector<char> passed(checks.size(), 1);
                 {
-                    MeshEvalSelfIntersection eval(rMesh);
-                    if (self && !eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixSelfIntersections()",
-                            docName, objName);
-                        run = true;
-                    }
-                    else {
-                        self = false; // once no self-intersections found do not repeat it later on
-                    }
-                    qApp->processEvents();
-                }
-                if (d->enableFoldsCheck) {
-                    MeshEvalFoldsOnSurface s_eval(rMesh);
-                    MeshEvalFoldsOnBoundary b_eval(rMesh);
-                    MeshEvalFoldOversOnSurface f_eval(rMesh);
-                    if (!s_eval.Evaluate() || !b_eval.Evaluate() || !f_eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeFoldsOnSurface()",
-                            docName, objName);
-                        run = true;
+                    const MeshKernel& rMesh = d->meshFeature->Mesh.getValue().getKernel();
+                    std::vector<Evaluations> evals(checks.size());
+                    MeshEvalPipeline pipeline(rMesh);
+                    for (std::size_t i = 0; i < checks.size(); i++) {
+                        if (checks[i].enabled) {
+                            checks[i].create(rMesh, evals[i]);
+                        }
+                        for (const auto& eval : evals[i]) {
+                            pipeline.Add(*eval);
+                        }
                     }
-                    qApp->processEvents();
-                }
-                {
-                    MeshEvalOrientation eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").harmonizeNormals()",
-                            docName, objName);
-                        run = true;
+                    pipeline.Evaluate();
+                    std::size_t pos = 0;
+                    for (std::size_t i = 0; i < checks.size(); i++) {
+                        for (std::size_t j = 0; j < evals[i].size(); j++, pos++) {
+                            if (!pipeline.GetResult(pos)) {
+                                passed[i] = 0;
+                            }
+                        }
                     }
-                    qApp->processEvents();
                 }
-                {
-                    MeshEvalTopology eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeNonManifolds()",
-                            docName, objName);
-                        run = true;
-                    }
-                    qApp->processEvents();
-                }
-                {
-                    MeshEvalRangeFacet rf(rMesh);
-                    MeshEvalRangePoint rp(rMesh);
-                    MeshEvalCorruptedFacets cf(rMesh);
-                    MeshEvalNeighbourhood nb(rMesh);
-                    if (!rf.Evaluate() || !rp.Evaluate() || !cf.Evaluate() || !nb.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixIndices()",
-                            docName, objName);
-                        run = true;
+
+                run = false;
+                for (std::size_t i = 0; i < checks.size(); i++) {
+                    RepairCheck& check = checks[i];
+                    if (!check.enabled) {
+                        continue;
                     }
-                }
-                {
-                    MeshEvalDegeneratedFacets eval(rMesh, d->epsilonDegenerated);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").fixDegenerations(%f)",
-                            docName, objName, d->epsilonDegenerated);
-                        run = true;
+
+                    bool ok = passed[i] != 0;
+                    if (run) {
+                        Evaluations evals;
+                        check.create(d->meshFeature->Mesh.getValue().getKernel(), evals);
+                        ok = evaluate(evals);
                     }
-                    qApp->processEvents();
-                }
-                {
-                    MeshEvalDuplicateFacets eval(rMesh);
-                    if (!eval.Evaluate()) {
+
+                    if (!ok) {
                         Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedFacets()",
-                            docName, objName);
+                            "App.getDocument(\"%s\").getObject(\"%s\").%s",
+                            docName, objName, check.repair.c_str());
                         run = true;
                     }
-                    qApp->processEvents();
-                }
-                {
-                    MeshEvalDuplicatePoints eval(rMesh);
-                    if (!eval.Evaluate()) {
-                        Gui::Command::doCommand(Gui::Command::App,
-                            "App.getDocument(\"%s\").getObject(\"%s\").removeDuplicatedPoints()",
-                            docName, objName);
-                        run = true;
+                    else if (check.once) {
+                        check.enabled = false;
                     }
                     qApp->processEvents();
                 }
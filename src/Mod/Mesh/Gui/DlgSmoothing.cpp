@@ -115,6 +115,11 @@ bool DlgSmoothing::smoothSelection() const
     return ui->checkBoxSelection->isChecked();
 }
 
+bool DlgSmoothing::simultaneous() const
+{
+    return ui->checkBoxSimultaneous->isChecked();
+}
+
 void DlgSmoothing::onCheckBoxSelectionToggled(bool on)
 {
     Q_EMIT toggledSelection(on);
@@ -190,6 +195,7 @@ bool TaskSmoothing::accept()
         switch (widget->method()) {
             case MeshGui::DlgSmoothing::Taubin: {
                 MeshCore::TaubinSmoothing s(mm->getKernel());
+                s.SetSimultaneous(widget->simultaneous());
                 s.SetLambda(widget->lambdaStep());
                 s.SetMicro(widget->microStep());
                 if (widget->smoothSelection()) {
@@ -201,6 +207,7 @@ bool TaskSmoothing::accept()
             } break;
             case MeshGui::DlgSmoothing::Laplace: {
                 MeshCore::LaplaceSmoothing s(mm->getKernel());
+                s.SetSimultaneous(widget->simultaneous());
                 s.SetLambda(widget->lambdaStep());
                 if (widget->smoothSelection()) {
                     s.SmoothPoints(widget->iterations(), selection);
@@ -211,6 +218,7 @@ bool TaskSmoothing::accept()
             } break;
             case MeshGui::DlgSmoothing::MedianFilter: {
                 MeshCore::MedianFilterSmoothing s(mm->getKernel());
+                s.SetSimultaneous(widget->simultaneous());
                 if (widget->smoothSelection()) {
                     s.SmoothPoints(widget->iterations(), selection);
                 }
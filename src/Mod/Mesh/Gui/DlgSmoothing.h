@@ -58,6 +58,7 @@ public:
     double microStep() const;
     Smooth method() const;
     bool smoothSelection() const;
+    bool simultaneous() const;
 
 private:
     void methodClicked(int);
@@ -104,6 +105,10 @@ public:
     {
         return widget->smoothSelection();
     }
+    bool simultaneous() const
+    {
+        return widget->simultaneous();
+    }
 
 private:
     DlgSmoothing* widget;
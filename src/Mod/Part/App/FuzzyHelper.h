@@ -37,6 +37,7 @@ namespace FuzzyHelper
 {
 double PartExport getBooleanFuzzy();
 void PartExport setBooleanFuzzy(double base);
+/// Calls func with the fuzzy value set to base for the calling thread only
 void PartExport withBooleanFuzzy(double base, std::function<void()> func);
 }  // namespace FuzzyHelper
 
@@ -1547,7 +1547,9 @@ void Feature::onChanged(const App::Property* prop)
         if (this->isRecomputing()) {
             this->Shape._Shape.setTransform(this->Placement.getValue().toMatrix());
         }
-        else {
+        // A shape restored lazily or in parallel is not decoded yet. It was saved
+        // together with the placement, so there is nothing to adjust.
+        else if (!this->Shape.isPending()) {
             Base::Placement p;
             // shape must not be null to override the placement
             if (!this->Shape.getValue().IsNull()) {
@@ -79,6 +79,14 @@ public:
     /** @name methods override feature */
     //@{
     short mustExecute() const override;
+    /** Shape features are always recomputed serially. The element maps of all
+     * their shapes are hashed through the StringHasher of the document, which
+     * is not thread safe, and not every OCC algorithm they use is reentrant.
+     */
+    bool canRecomputeConcurrently() const override
+    {
+        return false;
+    }
     //@}
 
     /// returns the type name of the ViewProvider
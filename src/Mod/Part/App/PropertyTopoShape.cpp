@@ -23,7 +23,13 @@
  ***************************************************************************/
 
 
+#include <iterator>
+#include <span>
 #include <sstream>
+#include <version>
+#ifdef __cpp_lib_spanstream
+#include <spanstream>
+#endif
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
@@ -35,6 +41,8 @@
 #include <TopoDS.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <QThreadPool>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObject.h>
@@ -57,6 +65,51 @@ FC_LOG_LEVEL_INIT("App", true, true)
 namespace sp = std::placeholders;
 using namespace Part;
 
+#ifdef __cpp_lib_spanstream
+using MemoryStreambuf = std::spanbuf;
+#else
+using MemoryStreambuf = Base::BufferStreambuf;
+#endif
+
+namespace
+{
+
+// Pool that decodes the shapes of a parallel restore. It is not shared with
+// other code, so a waiting loadPending() never depends on unrelated tasks.
+QThreadPool& decodePool()
+{
+    static QThreadPool pool;
+    return pool;
+}
+
+// Decodes the data of a .brp or .bin file. May be called from any thread.
+TopoDS_Shape decodeShape(std::string& data, bool binary, const std::string& fileName)
+{
+    MemoryStreambuf buf(std::span<char>(data), std::ios::in);
+    std::istream str(&buf);
+    TopoDS_Shape shape;
+    try {
+        if (binary) {
+            TopoShape binShape;
+            binShape.importBinary(str);
+            shape = binShape.getShape();
+        }
+        else {
+            BRep_Builder builder;
+            BRepTools::Read(shape, str, builder);
+        }
+    }
+    catch (const Standard_Failure&) {
+        Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+    }
+    catch (const std::exception&) {
+        Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+    }
+    return shape;
+}
+
+}  // namespace
+
 TYPESYSTEM_SOURCE(Part::PropertyPartShape, App::PropertyComplexGeoData)
 
 PropertyPartShape::PropertyPartShape() = default;
@@ -66,6 +119,8 @@ PropertyPartShape::~PropertyPartShape() = default;
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    _Pending.reset();
+    _IsPending.store(false, std::memory_order_release);
     _Shape = sh;
     auto obj = freecad_cast<App::DocumentObject*>(getContainer());
     if (obj) {
@@ -96,6 +151,8 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
     aboutToSetValue();
+    _Pending.reset();
+    _IsPending.store(false, std::memory_order_release);
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if (obj) {
         _Shape.Tag = obj->getID();
@@ -107,11 +164,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    loadPending();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadPending();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -128,12 +187,21 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadPending();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    if (isPending()) {
+        std::lock_guard<std::mutex> lock(_PendingMutex);
+        if (_Pending && _Pending->boundBox) {
+            return *_Pending->boundBox;
+        }
+    }
+    loadPending();
+
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull()) {
         return box;
@@ -161,16 +229,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D& rclTrf)
 {
+    loadPending();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    loadPending();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D& rclTrf)
 {
+    loadPending();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -178,6 +249,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D& rclTrf)
 
 PyObject* PropertyPartShape::getPyObject()
 {
+    loadPending();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop) {
         prop->setConst();
@@ -225,8 +297,14 @@ App::Property* PropertyPartShape::Copy() const
     //        prop->_Shape = this->_Shape.makeElementCopy();
     //    } else
     //        prop->_Shape = this->_Shape;
+    std::lock_guard<std::mutex> lock(_PendingMutex);
     prop->_Shape = this->_Shape;
     prop->_Ver = this->_Ver;
+    if (_Pending) {
+        // the copy shares the data that is not decoded yet
+        prop->_Pending = _Pending;
+        prop->_IsPending.store(true, std::memory_order_release);
+    }
     return prop;
 }
 
@@ -234,6 +312,7 @@ void PropertyPartShape::Paste(const App::Property& from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if (prop) {
+        prop->loadPending();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -241,7 +320,14 @@ void PropertyPartShape::Paste(const App::Property& from)
 
 unsigned int PropertyPartShape::getMemSize() const
 {
-    return _Shape.getMemSize();
+    unsigned int size = _Shape.getMemSize();
+    if (isPending()) {
+        std::lock_guard<std::mutex> lock(_PendingMutex);
+        if (_Pending) {
+            size += static_cast<unsigned int>(_Pending->data->size());
+        }
+    }
+    return size;
 }
 
 void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier>& paths) const
@@ -355,7 +441,7 @@ void PropertyPartShape::beforeSave() const
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
-    if (owner && !_Shape.isNull() && _Shape.getElementMapSize() > 0) {
+    if (owner && (!_Shape.isNull() || isPending()) && _Shape.getElementMapSize() > 0) {
         auto ret = owner->getDocument()->addStringHasher(_Shape.Hasher);
         _HasherIndex = ret.second;
         _SaveHasher = ret.first;
@@ -367,7 +453,8 @@ void PropertyPartShape::Save(Base::Writer& writer) const
     // See SaveDocFile(), RestoreDocFile()
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
-    if (owner && !_Shape.isNull() && _Shape.getElementMapSize() > 0 && !_Shape.Hasher.isNull()) {
+    if (owner && (!_Shape.isNull() || isPending()) && _Shape.getElementMapSize() > 0
+        && !_Shape.Hasher.isNull()) {
         writer.Stream() << " HasherIndex=\"" << _HasherIndex << '"';
         if (_SaveHasher) {
             writer.Stream() << " SaveHasher=\"1\"";
@@ -388,6 +475,23 @@ void PropertyPartShape::Save(Base::Writer& writer) const
 
     bool binary = writer.getMode("BinaryBrep");
     bool toXML = writer.isForceXML();
+    if (toXML) {
+        loadPending();
+    }
+    // Allows a lazy restore to answer bounding box queries without decoding the shape.
+    // Written regardless of the restore mode of this session, because the file may be
+    // opened later with lazy restore.
+    std::optional<Base::BoundBox3d> box;
+    if (isPending()) {
+        box = _RestoredBox;
+    }
+    else if (!_Shape.isNull()) {
+        box = getBoundingBox();
+    }
+    if (box && box->IsValid()) {
+        writer.Stream() << " BoundBox=\"" << box->MinX << ' ' << box->MinY << ' ' << box->MinZ
+                        << ' ' << box->MaxX << ' ' << box->MaxY << ' ' << box->MaxZ << '"';
+    }
     if (!toXML) {
         writer.Stream() << " file=\""
                         << writer.addFile(getFileName(binary ? ".bin" : ".brp").c_str(), this)
@@ -446,6 +550,18 @@ void PropertyPartShape::Restore(Base::XMLReader& reader)
     int hasher_idx = reader.getAttribute<int>("HasherIndex", -1);
     int save_hasher = reader.getAttribute<int>("SaveHasher", 0);
 
+    _Pending.reset();
+    _IsPending.store(false, std::memory_order_release);
+    _RestoredBox.reset();
+    if (reader.hasAttribute("BoundBox")) {
+        std::istringstream str(reader.getAttribute<const char*>("BoundBox"));
+        str.imbue(std::locale::classic());
+        Base::BoundBox3d box;
+        if (str >> box.MinX >> box.MinY >> box.MinZ >> box.MaxX >> box.MaxY >> box.MaxZ) {
+            _RestoredBox = box;
+        }
+    }
+
     TopoShape shape;
 
     if (reader.hasAttribute("file")) {
@@ -534,6 +650,16 @@ void PropertyPartShape::Restore(Base::XMLReader& reader)
 
 void PropertyPartShape::afterRestore()
 {
+    // pick up the shape decoded by the thread pool
+    if (isPending()) {
+        std::unique_lock<std::mutex> lock(_PendingMutex);
+        bool decoding = _Pending && _Pending->queued;
+        lock.unlock();
+        if (decoding) {
+            loadPending();
+        }
+    }
+
     if (_Shape.isRestoreFailed()) {
         // this cause GeoFeature::updateElementReference() to call
         // PropertyLinkBase::updateElementReferences() with reverse = true, in
@@ -711,6 +837,19 @@ void PropertyPartShape::loadFromStream(Base::Reader& reader)
 
 void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
 {
+    if (isPending()) {
+        std::lock_guard<std::mutex> lock(_PendingMutex);
+        if (_Pending && _Pending->binary == writer.getMode("BinaryBrep")) {
+            // not decoded since it was restored, so write back the data as it was read
+            writer.Stream().write(
+                _Pending->data->data(),
+                static_cast<std::streamsize>(_Pending->data->size())
+            );
+            return;
+        }
+    }
+    loadPending();
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull()) {
@@ -739,6 +878,46 @@ void PropertyPartShape::SaveDocFile(Base::Writer& writer) const
 
 void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
 {
+    bool lazy = isLazyRestore();
+    if (lazy || isParallelRestore()) {
+        auto pending = std::make_shared<PendingShape>();
+        pending->data = std::make_shared<std::string>(
+            std::istreambuf_iterator<char>(reader),
+            std::istreambuf_iterator<char>()
+        );
+
+        // Notify about the new value like the eager restore below does and keep the
+        // element map version that was restored by Restore()
+        std::string ver = _Ver;
+        aboutToSetValue();
+        // an empty file means the stored shape was empty
+        if (pending->data->empty()) {
+            _Pending.reset();
+            _IsPending.store(false, std::memory_order_release);
+            _Shape.setShape(TopoDS_Shape(), false);
+        }
+        else {
+            pending->binary = Base::FileInfo(reader.getFileName()).hasExtension("bin");
+            pending->fileName = reader.getFileName();
+            pending->boundBox = _RestoredBox;
+            pending->task = std::packaged_task<TopoDS_Shape()>(
+                [data = pending->data, binary = pending->binary, fileName = pending->fileName]() {
+                    return decodeShape(*data, binary, fileName);
+                }
+            );
+            pending->decoded = pending->task.get_future().share();
+            if (!lazy) {
+                // only the reading of the zip entries stays on this thread
+                pending->queued = true;
+                decodePool().start([pending]() { pending->decode(); });
+            }
+            _Pending = std::move(pending);
+            _IsPending.store(true, std::memory_order_release);
+        }
+        hasSetValue();
+        _Ver = ver;
+        return;
+    }
 
     // save the element map
     auto elementMap = _Shape.resetElementMap();
@@ -781,6 +960,57 @@ void PropertyPartShape::RestoreDocFile(Base::Reader& reader)
     _Ver = ver;
 }
 
+bool PropertyPartShape::isLazyRestore()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+        ->GetBool("LazyShapeRestore", false);
+}
+
+bool PropertyPartShape::isParallelRestore()
+{
+    return App::GetApplication()
+        .GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part/General")
+        ->GetBool("ParallelShapeRestore", false);
+}
+
+void PropertyPartShape::loadPending() const
+{
+    if (!isPending()) {
+        return;
+    }
+
+    // Only take the pending data under the lock. Decoding it or waiting for the
+    // pool must not block other threads that only query the pending state.
+    std::shared_ptr<PendingShape> pending;
+    {
+        std::lock_guard<std::mutex> lock(_PendingMutex);
+        pending = _Pending;
+    }
+    if (!pending) {
+        return;
+    }
+
+    // decode it here unless the pool already started it
+    pending->decode();
+    TopoDS_Shape shape = pending->decoded.get();
+
+    std::lock_guard<std::mutex> lock(_PendingMutex);
+    // another thread already loaded it or a new value was set meanwhile
+    if (_Pending != pending) {
+        return;
+    }
+
+    // keep the element map that was restored meanwhile
+    _Shape.setShape(shape, false);
+    // tag the shape as setValue() does in the eager restore
+    if (auto obj = freecad_cast<App::DocumentObject*>(getContainer())) {
+        _Shape.Tag = obj->getID();
+    }
+    _Pending.reset();
+    _IsPending.store(false, std::memory_order_release);
+}
+
 // -------------------------------------------------------------------------
 
 ShapeHistory::ShapeHistory(
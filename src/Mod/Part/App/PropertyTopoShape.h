@@ -24,7 +24,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <future>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 #include <App/PropertyGeo.h>
@@ -110,18 +115,61 @@ public:
 
     void afterRestore() override;
 
+    /// Whether the shape was restored but not decoded yet, see isLazyRestore()
+    bool isPending() const
+    {
+        return _IsPending.load(std::memory_order_acquire);
+    }
+    /** Whether RestoreDocFile() keeps the stored BRep data and only decodes it on the
+     * first access to the shape. The element map is restored as usual and the bounding
+     * box is taken from the document if it was saved there.
+     */
+    static bool isLazyRestore();
+    /** Whether RestoreDocFile() hands the decoding of the stored BRep data to a thread
+     * pool. The decoded shapes are set in afterRestore(), i.e. in object order.
+     */
+    static bool isParallelRestore();
+
     friend class Feature;
 
 private:
     void saveToFile(Base::Writer& writer) const;
     void loadFromFile(Base::Reader& reader);
     void loadFromStream(Base::Reader& reader);
+    /// Decodes the shape data kept by a lazy restore
+    void loadPending() const;
 
 private:
-    TopoShape _Shape;
+    // BRep data of a lazy restore
+    struct PendingShape
+    {
+        std::shared_ptr<std::string> data;
+        bool binary = false;
+        std::string fileName;
+        std::optional<Base::BoundBox3d> boundBox;
+        // set if the data was handed to the thread pool
+        bool queued = false;
+        // decodes the data, run by the pool or the first thread that needs the shape
+        std::packaged_task<TopoDS_Shape()> task;
+        std::atomic_flag started = ATOMIC_FLAG_INIT;
+        std::shared_future<TopoDS_Shape> decoded;
+
+        void decode()
+        {
+            if (!started.test_and_set()) {
+                task();
+            }
+        }
+    };
+
+    mutable TopoShape _Shape;
     std::string _Ver;
     mutable int _HasherIndex = 0;
     mutable bool _SaveHasher = false;
+    mutable std::shared_ptr<PendingShape> _Pending;
+    mutable std::atomic<bool> _IsPending {false};
+    mutable std::mutex _PendingMutex;
+    std::optional<Base::BoundBox3d> _RestoredBox;
 };
 
 struct PartExport ShapeHistory
@@ -106,6 +106,7 @@
 #include <App/ElementNamingUtils.h>
 #include <Base/BoundBox.h>
 #include <Base/Exception.h>
+#include <Base/Profiler.h>
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
 #include <SignalException.h>
@@ -1423,6 +1424,8 @@ TopoShape& TopoShape::makeShapeWithElementMap(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     setShape(shape);
     if (shape.IsNull()) {
         FC_THROWM(NullShapeException, "Null shape");
@@ -2140,6 +2143,8 @@ TopoShape& TopoShape::makeElementEvolve(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Evolve;
     }
@@ -2220,6 +2225,8 @@ TopoShape& TopoShape::makeElementRuledSurface(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::RuledSurface;
     }
@@ -2370,6 +2377,8 @@ TopoShape& TopoShape::makeElementCompound(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (policy == SingleShapeCompoundCreationPolicy::returnShape && shapes.size() == 1) {
         *this = shapes[0];
         if (elementMapPolicy == ElementMapPolicy::Drop) {
@@ -2445,6 +2454,8 @@ TopoShape& TopoShape::makeElementPipeShell(
     double tolAngular
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::PipeShell;
     }
@@ -2523,6 +2534,8 @@ TopoShape& TopoShape::makeElementOffset(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Offset;
     }
@@ -2664,6 +2677,8 @@ TopoShape& TopoShape::makeElementOffsetFace(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (std::abs(innerOffset) < Precision::Confusion() && std::abs(offset) < Precision::Confusion()) {
         *this = shape;
         return *this;
@@ -2740,6 +2755,8 @@ TopoShape& TopoShape::makeElementOffset2D(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Offset2D;
     }
@@ -3080,6 +3097,8 @@ TopoShape& TopoShape::makeElementThickSolid(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Thicken;
     }
@@ -3153,6 +3172,8 @@ TopoShape& TopoShape::makeElementWires(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Wire;
     }
@@ -3425,6 +3446,8 @@ TopoShape& TopoShape::makeElementOrderedWires(
     TopoShapeMap* output
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Wire;
     }
@@ -3487,6 +3510,8 @@ TopoShape& TopoShape::makeElementTransform(
     CopyType copy
 )
 {
+    ZoneScoped;
+
     if (copy == CopyType::noCopy) {
         // OCCT checks the ScaleFactor against gp::Resolution() which is DBL_MIN!!!
         copy = trsf.ScaleFactor() * trsf.HVectorialPart().Determinant() < 0.
@@ -3534,6 +3559,8 @@ TopoShape& TopoShape::makeElementGTransform(
     CopyType copy
 )
 {
+    ZoneScoped;
+
     if (shape.isNull()) {
         FC_THROWM(NullShapeException, "Null input shape");
     }
@@ -3579,6 +3606,8 @@ TopoShape& TopoShape::makeElementCopy(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (shape.isNull()) {
         return *this;
     }
@@ -3790,6 +3819,8 @@ TopoShape& TopoShape::makeElementFilledFace(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::FilledFace;
     }
@@ -3991,6 +4022,8 @@ TopoShape& TopoShape::makeElementFilledFace(
 
 TopoShape& TopoShape::makeElementSolid(const TopoShape& shape, const char* op)
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Solid;
     }
@@ -4048,6 +4081,8 @@ TopoShape& TopoShape::makeElementSolid(const TopoShape& shape, const char* op)
 
 TopoShape& TopoShape::makeElementMirror(const TopoShape& shape, const gp_Ax2& ax2, const char* op)
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Mirror;
     }
@@ -4072,6 +4107,8 @@ TopoShape& TopoShape::makeElementSlice(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (shape.isNull()) {
         FC_THROWM(NullShapeException, "Null shape");
     }
@@ -4090,6 +4127,8 @@ TopoShape& TopoShape::makeElementSlices(
     const char* op
 )
 {
+    ZoneScoped;
+
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
     int index = 0;
@@ -4151,6 +4190,8 @@ TopoShape& TopoShape::makeElementFillet(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Fillet;
     }
@@ -4185,6 +4226,8 @@ TopoShape& TopoShape::makeElementChamfer(
     Flip flipDirection
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Chamfer;
     }
@@ -4245,6 +4288,8 @@ TopoShape& TopoShape::makeElementGeneralFuse(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::GeneralFuse;
     }
@@ -4313,6 +4358,8 @@ TopoShape& TopoShape::makeElementXor(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (shapes.empty()) {
         FC_THROWM(NullShapeException, "Null shape");
     }
@@ -4434,6 +4481,8 @@ TopoShape& TopoShape::makeElementShape(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     TopoDS_Shape shape;
     // OCCT 7.3.x requires calling Solid() and not Shape() to function correctly
     if (typeid(mkShape) == typeid(BRepPrimAPI_MakeHalfSpace)) {
@@ -4452,6 +4501,8 @@ TopoShape& TopoShape::makeElementShape(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Prism;
     }
@@ -4470,6 +4521,8 @@ TopoShape& TopoShape::makeElementLoft(
     const char* op
 )
 {
+    ZoneScoped;
+
     auto checkProfiles = [](const TopoShape& sh1, const TopoShape& sh2) {
         // The same TShape is used but the locations might be different
         // even if they result into the same transformation matrix.
@@ -4589,6 +4642,8 @@ TopoShape& TopoShape::makeElementLoft(
 
 TopoShape& TopoShape::makeElementPrism(const TopoShape& base, const gp_Vec& vec, const char* op)
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Extrude;
     }
@@ -4610,6 +4665,8 @@ TopoShape& TopoShape::makeElementPrismUntil(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Prism;
     }
@@ -4805,6 +4862,8 @@ TopoShape& TopoShape::makeElementRevolve(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Revolve;
     }
@@ -4835,6 +4894,8 @@ TopoShape& TopoShape::makeElementRevolution(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Revolve;
     }
@@ -4874,6 +4935,8 @@ TopoShape& TopoShape::makeElementDraft(
     const char* op
 )
 {
+    ZoneScoped;
+
     if (!op) {
         op = Part::OpCodes::Draft;
     }
@@ -4926,6 +4989,8 @@ TopoShape& TopoShape::makeElementFace(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     std::vector<TopoShape> shapes;
     if (shape.isNull()) {
         FC_THROWM(NullShapeException, "Null shape");
@@ -4947,6 +5012,8 @@ TopoShape& TopoShape::makeElementFace(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (!maker || !maker[0]) {
         maker = "Part::FaceMakerBullseye";
     }
@@ -5028,6 +5095,8 @@ public:
 
 TopoShape& TopoShape::makeElementRefine(const TopoShape& shape, const char* op, RefineFail no_fail)
 {
+    ZoneScoped;
+
     if (shape.isNull()) {
         if (no_fail == RefineFail::throwException) {
             FC_THROWM(NullShapeException, "Null shape");
@@ -5096,6 +5165,8 @@ TopoShape& TopoShape::makeElementBSplineFace(
     const char* op
 )
 {
+    ZoneScoped;
+
     std::vector<TopoShape> edges;
     for (auto& s : input) {
         auto e = s.getSubTopoShapes(TopAbs_EDGE);
@@ -5793,6 +5864,8 @@ const std::vector<TopoDS_Shape>& MapperHistory::generated(const TopoDS_Shape& s)
 // topo naming counterpart of TopoShape::makeShell()
 TopoShape& TopoShape::makeElementShell(bool silent, const char* op, ElementMapPolicy elementMapPolicy)
 {
+    ZoneScoped;
+
     if (silent) {
         if (isNull()) {
             return *this;
@@ -5899,6 +5972,8 @@ TopoShape& TopoShape::makeElementShellFromWires(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     BRepFill_Generator maker;
     for (auto& w : wires) {
         if (w.shapeType(silent) == TopAbs_WIRE) {
@@ -5993,6 +6068,8 @@ TopoShape& TopoShape::makeElementBoolean(
     ElementMapPolicy elementMapPolicy
 )
 {
+    ZoneScoped;
+
     if (!maker) {
         FC_THROWM(Base::CADKernelError, "no maker");
     }
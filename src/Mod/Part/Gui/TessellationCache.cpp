@@ -0,0 +1,627 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+#include <BinTools_ShapeSet.hxx>
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <Standard_Version.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_HArray1OfReal.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+
+#include <QCryptographicHash>
+
+#include <App/Application.h>
+#include <Base/Exception.h>
+#include <Base/Parameter.h>
+#include <Base/Stream.h>
+
+#include "TessellationCache.h"
+
+
+using namespace PartGui;
+
+namespace
+{
+void addData(QCryptographicHash& hash, const char* data, std::size_t size)
+{
+#if QT_VERSION < QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(data, static_cast<int>(size));
+#else
+    hash.addData(QByteArrayView(data, static_cast<qsizetype>(size)));
+#endif
+}
+
+// Identifies the format written by TessellationCache::save()
+constexpr uint32_t cacheMagic = 0x54455343;  // "TESC"
+constexpr uint32_t cacheVersion = 1;
+
+// Number of face identities remembered per entry. Every identity keeps its
+// TShape alive, so only the most recent ones are kept.
+constexpr std::size_t maxIdentities = 4;
+
+ParameterGrp::handle getParameterGroup()
+{
+    return App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part"
+    );
+}
+
+void writePolygon(Base::OutputStream& str, const Handle(Poly_PolygonOnTriangulation) & poly)
+{
+    if (poly.IsNull()) {
+        str << uint32_t(0);
+        return;
+    }
+
+    const TColStd_Array1OfInteger& nodes = poly->Nodes();
+    str << uint32_t(nodes.Length());
+    for (Standard_Integer i = nodes.Lower(); i <= nodes.Upper(); i++) {
+        str << int32_t(nodes(i));
+    }
+
+    str << poly->Deflection();
+    bool hasParameters = poly->HasParameters();
+    str << hasParameters;
+    if (hasParameters) {
+        const Handle(TColStd_HArray1OfReal)& params = poly->Parameters();
+        for (Standard_Integer i = params->Lower(); i <= params->Upper(); i++) {
+            str << params->Value(i);
+        }
+    }
+}
+
+// Reads the data written by TessellationCache::save(). The data comes from a
+// file that may be truncated or corrupt, so every count is checked against the
+// number of bytes left and every index against its range before it is used.
+class CacheReader
+{
+public:
+    explicit CacheReader(std::string&& data)
+        : size(data.size())
+        , in(std::move(data), std::ios::in | std::ios::binary)
+        , str(in)
+    {}
+
+    template<typename T>
+    T read()
+    {
+        T value {};
+        str >> value;
+        if (!in) {
+            throw Base::BadFormatError("Tessellation cache is truncated");
+        }
+        return value;
+    }
+    bool readBool()
+    {
+        auto value = read<uint8_t>();
+        if (value > 1) {
+            throw Base::BadFormatError("Tessellation cache is corrupt");
+        }
+        return value != 0;
+    }
+    /// Reads the number of the following items that take at least itemSize bytes each
+    uint32_t readCount(std::size_t itemSize)
+    {
+        auto count = read<uint32_t>();
+        expect(count * itemSize);
+        return count;
+    }
+    /// Checks that at least the given number of bytes is left
+    void expect(std::size_t bytes)
+    {
+        if (bytes > left()) {
+            throw Base::BadFormatError("Tessellation cache is truncated");
+        }
+    }
+    /// Reads a one-based index not greater than max
+    Standard_Integer readIndex(uint32_t max)
+    {
+        auto index = read<int32_t>();
+        if (index < 1 || static_cast<uint32_t>(index) > max) {
+            throw Base::BadFormatError("Tessellation cache has an invalid index");
+        }
+        return index;
+    }
+    std::string readString()
+    {
+        std::string value(readCount(1), '\0');
+        in.read(value.data(), static_cast<std::streamsize>(value.size()));
+        if (!in) {
+            throw Base::BadFormatError("Tessellation cache is truncated");
+        }
+        return value;
+    }
+
+private:
+    std::size_t left()
+    {
+        std::streamoff pos = in.tellg();
+        return pos < 0 ? 0 : size - static_cast<std::size_t>(pos);
+    }
+
+    std::size_t size;
+    std::istringstream in;
+    Base::InputStream str;
+};
+
+Handle(Poly_PolygonOnTriangulation) readPolygon(CacheReader& reader, uint32_t nbNodes)
+{
+    uint32_t count = reader.readCount(sizeof(int32_t));
+    if (count == 0) {
+        return {};
+    }
+    if (count < 2) {
+        throw Base::BadFormatError("Tessellation cache has an invalid polygon");
+    }
+
+    TColStd_Array1OfInteger nodes(1, static_cast<Standard_Integer>(count));
+    for (Standard_Integer i = 1; i <= nodes.Upper(); i++) {
+        nodes(i) = reader.readIndex(nbNodes);
+    }
+
+    auto deflection = reader.read<double>();
+    bool hasParameters = reader.readBool();
+
+    Handle(Poly_PolygonOnTriangulation) poly;
+    if (hasParameters) {
+        reader.expect(count * sizeof(double));
+        TColStd_Array1OfReal params(1, static_cast<Standard_Integer>(count));
+        for (Standard_Integer i = 1; i <= params.Upper(); i++) {
+            params(i) = reader.read<double>();
+        }
+        poly = new Poly_PolygonOnTriangulation(nodes, params);
+    }
+    else {
+        poly = new Poly_PolygonOnTriangulation(nodes);
+    }
+    poly->Deflection(deflection);
+    return poly;
+}
+
+void writeTriangulation(Base::OutputStream& str, const Handle(Poly_Triangulation) & mesh)
+{
+    int nbNodes = mesh->NbNodes();
+    int nbTriangles = mesh->NbTriangles();
+    bool hasUV = mesh->HasUVNodes();
+    str << uint32_t(nbNodes) << uint32_t(nbTriangles) << hasUV << mesh->Deflection();
+
+    for (int i = 1; i <= nbNodes; i++) {
+#if OCC_VERSION_HEX < 0x070600
+        const gp_Pnt& pnt = mesh->Nodes()(i);
+#else
+        gp_Pnt pnt = mesh->Node(i);
+#endif
+        str << pnt.X() << pnt.Y() << pnt.Z();
+        if (hasUV) {
+#if OCC_VERSION_HEX < 0x070600
+            const gp_Pnt2d& uv = mesh->UVNodes()(i);
+#else
+            gp_Pnt2d uv = mesh->UVNode(i);
+#endif
+            str << uv.X() << uv.Y();
+        }
+    }
+
+    for (int i = 1; i <= nbTriangles; i++) {
+        Standard_Integer n1 {}, n2 {}, n3 {};
+#if OCC_VERSION_HEX < 0x070600
+        mesh->Triangles()(i).Get(n1, n2, n3);
+#else
+        mesh->Triangle(i).Get(n1, n2, n3);
+#endif
+        str << int32_t(n1) << int32_t(n2) << int32_t(n3);
+    }
+}
+
+Handle(Poly_Triangulation) readTriangulation(CacheReader& reader)
+{
+    auto nbNodes = reader.read<uint32_t>();
+    auto nbTriangles = reader.read<uint32_t>();
+    bool hasUV = reader.readBool();
+    auto deflection = reader.read<double>();
+
+    // the nodes are followed by the triangles
+    std::size_t nodeSize = (hasUV ? 5 : 3) * sizeof(double);
+    std::size_t triangleSize = 3 * sizeof(int32_t);
+    reader.expect(nbNodes * nodeSize + nbTriangles * triangleSize);
+    if (nbNodes < 3 || nbTriangles == 0) {
+        throw Base::BadFormatError("Tessellation cache has an invalid triangulation");
+    }
+
+    Handle(Poly_Triangulation) mesh = new Poly_Triangulation(
+        static_cast<Standard_Integer>(nbNodes),
+        static_cast<Standard_Integer>(nbTriangles),
+        hasUV
+    );
+    mesh->Deflection(deflection);
+
+    for (int i = 1; i <= static_cast<int>(nbNodes); i++) {
+        auto x = reader.read<double>();
+        auto y = reader.read<double>();
+        auto z = reader.read<double>();
+#if OCC_VERSION_HEX < 0x070600
+        mesh->ChangeNodes()(i).SetCoord(x, y, z);
+#else
+        mesh->SetNode(i, gp_Pnt(x, y, z));
+#endif
+        if (hasUV) {
+            auto u = reader.read<double>();
+            auto v = reader.read<double>();
+#if OCC_VERSION_HEX < 0x070600
+            mesh->ChangeUVNodes()(i).SetCoord(u, v);
+#else
+            mesh->SetUVNode(i, gp_Pnt2d(u, v));
+#endif
+        }
+    }
+
+    for (int i = 1; i <= static_cast<int>(nbTriangles); i++) {
+        Standard_Integer n1 = reader.readIndex(nbNodes);
+        Standard_Integer n2 = reader.readIndex(nbNodes);
+        Standard_Integer n3 = reader.readIndex(nbNodes);
+#if OCC_VERSION_HEX < 0x070600
+        mesh->ChangeTriangles()(i).Set(n1, n2, n3);
+#else
+        mesh->SetTriangle(i, Poly_Triangle(n1, n2, n3));
+#endif
+    }
+
+    return mesh;
+}
+}  // namespace
+
+TessellationCache::TessellationCache()
+{
+    // the budget is given in MB
+    long size = getParameterGroup()->GetInt("TessellationCacheSize", 256);
+    maxMemSize = static_cast<std::size_t>(std::max(size, 0L)) * 1024 * 1024;
+}
+
+TessellationCache& TessellationCache::instance()
+{
+    static TessellationCache cache;
+    return cache;
+}
+
+bool TessellationCache::isEnabled()
+{
+    return getParameterGroup()->GetBool("EnableTessellationCache", true);
+}
+
+std::string TessellationCache::makeKey(
+    const TopoDS_Face& face,
+    double deflection,
+    double angularDeflection
+)
+{
+    // The key must not depend on where the face is placed, the triangulation
+    // is stored in the local coordinate system of the face.
+    TopoDS_Shape local = face.Located(TopLoc_Location()).Oriented(TopAbs_FORWARD);
+
+    std::ostringstream out(std::ios::out | std::ios::binary);
+    BinTools_ShapeSet shapeSet;
+#if OCC_VERSION_HEX >= 0x070600
+    shapeSet.SetWithTriangles(Standard_False);
+#endif
+    shapeSet.Add(local);
+    shapeSet.Write(out);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    std::string data = out.str();
+    addData(hash, data.data(), data.size());
+    addData(hash, reinterpret_cast<const char*>(&deflection), sizeof(deflection));
+    addData(hash, reinterpret_cast<const char*>(&angularDeflection), sizeof(angularDeflection));
+    return hash.result().toStdString();
+}
+
+bool TessellationCache::Identity::operator==(const Identity& other) const
+{
+    return tshape.get() == other.tshape.get() && location.IsEqual(other.location)
+        && deflection == other.deflection && angularDeflection == other.angularDeflection;
+}
+
+std::size_t TessellationCache::IdentityHash::operator()(const Identity& id) const
+{
+    // the location is only compared, faces of one TShape rarely differ in it
+    std::size_t seed = std::hash<const void*> {}(id.tshape.get());
+    seed ^= std::hash<double> {}(id.deflection) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<double> {}(id.angularDeflection) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+TessellationCache::Identity TessellationCache::makeIdentity(
+    const TopoDS_Face& face,
+    double deflection,
+    double angularDeflection
+)
+{
+    return Identity {face.TShape(), face.Location(), deflection, angularDeflection};
+}
+
+bool TessellationCache::attach(const Entry& entry, const TopoDS_Face& face)
+{
+    std::vector<TopoDS_Edge> edges;
+    for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+        edges.push_back(TopoDS::Edge(xp.Current()));
+    }
+    // the face has the same geometry but a different edge structure
+    if (edges.size() != entry.edges.size()) {
+        return false;
+    }
+
+    BRep_Builder builder;
+    TopLoc_Location loc = face.Location();
+    builder.UpdateFace(face, entry.triangulation);
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        const EdgePolygons& polys = entry.edges[i];
+        if (polys.forward.IsNull()) {
+            continue;
+        }
+        if (polys.reversed.IsNull()) {
+            builder.UpdateEdge(edges[i], polys.forward, entry.triangulation, loc);
+        }
+        else {
+            builder.UpdateEdge(edges[i], polys.forward, polys.reversed, entry.triangulation, loc);
+        }
+    }
+    return true;
+}
+
+bool TessellationCache::apply(
+    const TopoDS_Face& face,
+    double deflection,
+    double angularDeflection,
+    std::string& key
+)
+{
+    Identity id = makeIdentity(face, deflection, angularDeflection);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = identityIndex.find(id);
+        if (it != identityIndex.end()) {
+            key = it->second->key;
+            if (attach(*it->second, face)) {
+                // mark as most recently used
+                entries.splice(entries.begin(), entries, it->second);
+                stats.identityHits++;
+                return true;
+            }
+            stats.misses++;
+            return false;
+        }
+    }
+
+    // hash outside the lock, this is the expensive part
+    key = makeKey(face, deflection, angularDeflection);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end() || !attach(*it->second, face)) {
+        stats.misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, it->second);
+    addIdentity(it->second, std::move(id));
+    stats.hashHits++;
+    return true;
+}
+
+void TessellationCache::store(
+    const std::string& key,
+    const TopoDS_Face& face,
+    double deflection,
+    double angularDeflection
+)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.contains(key)) {
+        return;
+    }
+
+    TopLoc_Location loc;
+    Entry entry;
+    entry.key = key;
+    entry.triangulation = BRep_Tool::Triangulation(face, loc);
+    if (entry.triangulation.IsNull()) {
+        return;
+    }
+
+    for (TopExp_Explorer xp(face, TopAbs_EDGE); xp.More(); xp.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+        EdgePolygons polys;
+        if (BRep_Tool::IsClosed(edge, face)) {
+            polys.forward = BRep_Tool::PolygonOnTriangulation(
+                TopoDS::Edge(edge.Oriented(TopAbs_FORWARD)),
+                entry.triangulation,
+                loc
+            );
+            polys.reversed = BRep_Tool::PolygonOnTriangulation(
+                TopoDS::Edge(edge.Oriented(TopAbs_REVERSED)),
+                entry.triangulation,
+                loc
+            );
+        }
+        else {
+            polys.forward = BRep_Tool::PolygonOnTriangulation(edge, entry.triangulation, loc);
+        }
+        entry.edges.push_back(polys);
+    }
+
+    insert(std::move(entry));
+    // the new entry may have been evicted right away if it exceeds the budget
+    auto it = index.find(key);
+    if (it != index.end()) {
+        addIdentity(it->second, makeIdentity(face, deflection, angularDeflection));
+    }
+}
+
+void TessellationCache::save(std::ostream& out, const std::vector<std::string>& keys) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<const Entry*> saved;
+    for (const auto& key : keys) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            saved.push_back(&*it->second);
+        }
+    }
+
+    Base::OutputStream str(out);
+    str << cacheMagic << cacheVersion << uint32_t(saved.size());
+    for (const Entry* entry : saved) {
+        str << uint32_t(entry->key.size());
+        out.write(entry->key.data(), static_cast<std::streamsize>(entry->key.size()));
+        writeTriangulation(str, entry->triangulation);
+        str << uint32_t(entry->edges.size());
+        for (const auto& polys : entry->edges) {
+            writePolygon(str, polys.forward);
+            writePolygon(str, polys.reversed);
+        }
+    }
+}
+
+void TessellationCache::restore(std::istream& in)
+{
+    // the file is read completely to know how many bytes are left while reading it
+    CacheReader reader(std::string(std::istreambuf_iterator<char>(in), {}));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    try {
+        auto magic = reader.read<uint32_t>();
+        auto version = reader.read<uint32_t>();
+        if (magic != cacheMagic || version != cacheVersion) {
+            return;
+        }
+
+        // every entry takes at least its key size, two triangulation counts and an edge count
+        uint32_t count = reader.readCount(4 * sizeof(uint32_t));
+        for (uint32_t i = 0; i < count; i++) {
+            Entry entry;
+            entry.key = reader.readString();
+            entry.triangulation = readTriangulation(reader);
+
+            // every edge has the node counts of both polygons
+            uint32_t numEdges = reader.readCount(2 * sizeof(uint32_t));
+            entry.edges.resize(numEdges);
+            auto nbNodes = static_cast<uint32_t>(entry.triangulation->NbNodes());
+            for (auto& polys : entry.edges) {
+                polys.forward = readPolygon(reader, nbNodes);
+                polys.reversed = readPolygon(reader, nbNodes);
+            }
+
+            if (!index.contains(entry.key)) {
+                insert(std::move(entry));
+            }
+        }
+    }
+    catch (const Base::Exception&) {
+        // the rest of the file cannot be trusted, the faces of the broken entry and all
+        // following ones are meshed again
+    }
+}
+
+void TessellationCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    identityIndex.clear();
+    index.clear();
+    entries.clear();
+    memSize = 0;
+    stats = Statistics();
+}
+
+std::size_t TessellationCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+TessellationCache::Statistics TessellationCache::statistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void TessellationCache::addIdentity(EntryList::iterator it, Identity&& id)
+{
+    auto res = identityIndex.emplace(id, it);
+    if (!res.second) {
+        return;
+    }
+
+    std::list<Identity>& ids = it->identities;
+    ids.push_front(std::move(id));
+    if (ids.size() > maxIdentities) {
+        identityIndex.erase(ids.back());
+        ids.pop_back();
+    }
+}
+
+void TessellationCache::insert(Entry&& entry)
+{
+    entry.memSize = memSizeOf(entry);
+    memSize += entry.memSize;
+    entries.push_front(std::move(entry));
+    index[entries.front().key] = entries.begin();
+    evict();
+}
+
+void TessellationCache::evict()
+{
+    while (memSize > maxMemSize && !entries.empty()) {
+        const Entry& last = entries.back();
+        memSize -= last.memSize;
+        for (const auto& id : last.identities) {
+            identityIndex.erase(id);
+        }
+        index.erase(last.key);
+        entries.pop_back();
+    }
+}
+
+std::size_t TessellationCache::memSizeOf(const Entry& entry)
+{
+    const Handle(Poly_Triangulation)& mesh = entry.triangulation;
+    std::size_t size = sizeof(Entry) + entry.key.size();
+    size += mesh->NbNodes() * (mesh->HasUVNodes() ? 5 : 3) * sizeof(double);
+    size += mesh->NbTriangles() * 3 * sizeof(Standard_Integer);
+    for (const auto& polys : entry.edges) {
+        if (!polys.forward.IsNull()) {
+            size += polys.forward->NbNodes() * (sizeof(Standard_Integer) + sizeof(double));
+        }
+        if (!polys.reversed.IsNull()) {
+            size += polys.reversed->NbNodes() * (sizeof(Standard_Integer) + sizeof(double));
+        }
+    }
+    return size;
+}
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Poly_PolygonOnTriangulation.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_TShape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace PartGui
+{
+
+/**
+ * Process wide cache of face triangulations.
+ *
+ * Entries are keyed by a hash of the face geometry, independent of its
+ * location and orientation, together with the linear and angular deflection
+ * it was meshed with. Faces that did not change can therefore reuse their
+ * triangulation across recomputes, visibility changes and document reloads
+ * instead of being meshed by BRepMesh again.
+ *
+ * Computing the hash requires serializing the face. To keep redisplaying an
+ * unchanged shape cheap, each entry also remembers the identity (TShape,
+ * location and deflections) of the last faces it was applied to, and a face
+ * with a known identity is served without hashing it.
+ *
+ * The cache is bounded by an approximate memory budget and evicts the least
+ * recently used entries first.
+ */
+class PartGuiExport TessellationCache
+{
+public:
+    static TessellationCache& instance();
+
+    /// Whether the cache is enabled by the user preferences.
+    static bool isEnabled();
+
+    /**
+     * Computes the cache key of a face. The face must not carry a
+     * triangulation yet, i.e. it must be called after BRepTools::Clean().
+     */
+    static std::string makeKey(const TopoDS_Face& face, double deflection, double angularDeflection);
+
+    /**
+     * Attaches the cached triangulation and the polygons of its edges to
+     * @p face. The entry is looked up by the identity of the face first and
+     * by its hash only if the identity is unknown. @p key is set to the hash
+     * key of the face in any case, so that it can be passed to store() after
+     * meshing. Returns false if there is no entry for the face.
+     */
+    bool apply(
+        const TopoDS_Face& face,
+        double deflection,
+        double angularDeflection,
+        std::string& key
+    );
+
+    /// Stores the current triangulation of @p face under @p key.
+    void store(
+        const std::string& key,
+        const TopoDS_Face& face,
+        double deflection,
+        double angularDeflection
+    );
+
+    /// Writes the entries of @p keys that are in the cache to @p out.
+    void save(std::ostream& out, const std::vector<std::string>& keys) const;
+    /// Adds the entries written by save() to the cache.
+    void restore(std::istream& in);
+
+    void clear();
+    std::size_t size() const;
+
+    /// Counts how the faces passed to apply() were resolved
+    struct Statistics
+    {
+        std::size_t identityHits = 0;
+        std::size_t hashHits = 0;
+        std::size_t misses = 0;
+    };
+    Statistics statistics() const;
+
+private:
+    TessellationCache();
+
+    /**
+     * Cheap identity of a meshed face. The TShape handle keeps the shape
+     * alive so that its address cannot be reused by another face.
+     */
+    struct Identity
+    {
+        Handle(TopoDS_TShape) tshape;
+        TopLoc_Location location;
+        double deflection = 0.0;
+        double angularDeflection = 0.0;
+
+        bool operator==(const Identity& other) const;
+    };
+
+    struct IdentityHash
+    {
+        std::size_t operator()(const Identity& id) const;
+    };
+
+    struct EdgePolygons
+    {
+        Handle(Poly_PolygonOnTriangulation) forward;
+        // only set for seam edges
+        Handle(Poly_PolygonOnTriangulation) reversed;
+    };
+
+    struct Entry
+    {
+        std::string key;
+        Handle(Poly_Triangulation) triangulation;
+        std::vector<EdgePolygons> edges;
+        // faces this entry was recently applied to or stored from
+        std::list<Identity> identities;
+        std::size_t memSize = 0;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    static Identity makeIdentity(const TopoDS_Face& face, double deflection, double angularDeflection);
+    static bool attach(const Entry& entry, const TopoDS_Face& face);
+    void addIdentity(EntryList::iterator it, Identity&& id);
+    void insert(Entry&& entry);
+    void evict();
+    static std::size_t memSizeOf(const Entry& entry);
+
+    EntryList entries;
+    std::unordered_map<std::string, EntryList::iterator> index;
+    std::unordered_map<Identity, EntryList::iterator, IdentityHash> identityIndex;
+    Statistics stats;
+    std::size_t memSize = 0;
+    std::size_t maxMemSize;
+    mutable std::mutex mutex;
+};
+
+}  // namespace PartGui
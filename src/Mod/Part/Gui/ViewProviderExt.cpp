@@ -73,9 +73,12 @@
 #include <App/Document.h>
 #include <Base/Console.h>
 #include <Base/Parameter.h>
+#include <Base/Profiler.h>
 #include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 
+#include <Base/Reader.h>
+#include <Base/Writer.h>
 #include <Gui/BitmapFactory.h>
 #include <Gui/Control.h>
 #include <Gui/Selection/SoFCSelectionAction.h>
@@ -92,6 +95,7 @@
 #include "SoBrepFaceSet.h"
 #include "SoBrepPointSet.h"
 #include "TaskFaceAppearances.h"
+#include "TessellationCache.h"
 
 
 FC_LOG_LEVEL_INIT("Part", true, true)
@@ -1040,9 +1044,16 @@ void ViewProviderPartExt::setupCoinGeometry(
     SoBrepPointSet* nodeset,
     double deviation,
     double angularDeflection,
-    bool normalsFromUV
+    bool normalsFromUV,
+    std::vector<std::string>* tessellationKeys
 )
 {
+    ZoneScoped;
+
+    if (tessellationKeys) {
+        tessellationKeys->clear();
+    }
+
     if (Part::Tools::isShapeEmpty(shape)) {
         coords->point.setNum(0);
         norm->vector.setNum(0);
@@ -1093,7 +1104,57 @@ void ViewProviderPartExt::setupCoinGeometry(
     BRepTools::Clean(shape, Standard_True);
 #endif
 
-    BRepMesh_IncrementalMesh(shape, meshParams);
+    // Reuse the triangulation of faces that were already meshed with the same
+    // parameters. BRepMesh keeps the triangulation of these faces and only
+    // meshes the remaining ones.
+    bool useCache = TessellationCache::isEnabled();
+    std::vector<std::string> faceKeys;
+    std::vector<bool> cachedFaces;
+    bool needsMesh = true;
+    if (useCache) {
+        auto& cache = TessellationCache::instance();
+        TopTools_IndexedMapOfShape cacheFaceMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, cacheFaceMap);
+        TopTools_IndexedMapOfShape cacheEdgeMap;
+        TopExp::MapShapes(shape, TopAbs_EDGE, cacheEdgeMap);
+        TopTools_IndexedMapOfShape faceEdgeMap;
+        needsMesh = false;
+        for (int i = 1; i <= cacheFaceMap.Extent(); i++) {
+            const TopoDS_Face& face = TopoDS::Face(cacheFaceMap(i));
+            std::string key;
+            cachedFaces.push_back(cache.apply(face, deflection, AngDeflectionRads, key));
+            faceKeys.push_back(std::move(key));
+            needsMesh = needsMesh || !cachedFaces.back();
+            TopExp::MapShapes(face, TopAbs_EDGE, faceEdgeMap);
+        }
+        // free edges and vertices still need BRepMesh
+        needsMesh = needsMesh || cacheFaceMap.IsEmpty()
+            || faceEdgeMap.Extent() != cacheEdgeMap.Extent();
+    }
+
+    if (needsMesh) {
+        ZoneScopedN("BRepMesh");
+        BRepMesh_IncrementalMesh(shape, meshParams);
+    }
+
+    if (useCache) {
+        auto& cache = TessellationCache::instance();
+        TopTools_IndexedMapOfShape cacheFaceMap;
+        TopExp::MapShapes(shape, TopAbs_FACE, cacheFaceMap);
+        for (int i = 1; i <= cacheFaceMap.Extent(); i++) {
+            if (!cachedFaces[i - 1]) {
+                cache.store(
+                    faceKeys[i - 1],
+                    TopoDS::Face(cacheFaceMap(i)),
+                    deflection,
+                    AngDeflectionRads
+                );
+            }
+        }
+        if (tessellationKeys) {
+            *tessellationKeys = std::move(faceKeys);
+        }
+    }
 
     // We must reset the location here because the transformation data
     // are set in the placement property
@@ -1123,6 +1184,7 @@ void ViewProviderPartExt::setupCoinGeometry(
         }
         numFaces++;
     }
+    FC_PROFILE_COUNT("Triangles generated", numTriangles);
 
     // get an indexed map of edges
     TopTools_IndexedMapOfShape edgeMap;
@@ -1497,7 +1559,8 @@ void ViewProviderPartExt::updateVisual()
             nodeset,
             Deviation.getValue(),
             AngularDeflection.getValue(),
-            NormalsFromUV
+            NormalsFromUV,
+            &tessellationKeys
         );
 
         lastRenderedShape = shape;
@@ -1520,6 +1583,47 @@ void ViewProviderPartExt::updateVisual()
     setHighlightedPoints(PointColorArray.getValue());
 }
 
+void ViewProviderPartExt::Save(Base::Writer& writer) const
+{
+    Gui::ViewProviderGeometryObject::Save(writer);
+
+    // Optionally store the triangulation of the rendered faces so that the
+    // document can be displayed without meshing it again after opening.
+    ParameterGrp::handle hPart = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part"
+    );
+    if (!writer.isForceXML() && !tessellationKeys.empty()
+        && hPart->GetBool("SaveTessellationCache", false)) {
+        writer.Stream() << writer.ind() << "<TessellationCache file=""
+                        << writer.addFile("Tessellation.bin", this) << ""/>" << std::endl;
+    }
+}
+
+void ViewProviderPartExt::Restore(Base::XMLReader& reader)
+{
+    Gui::ViewProviderGeometryObject::Restore(reader);
+
+    // Older files end right after the properties. If there is no cache
+    // element this reads the end of the view provider element which is
+    // accepted by the caller.
+    if (reader.readNextElement() && strcmp(reader.localName(), "TessellationCache") == 0) {
+        std::string file(reader.getAttribute<const char*>("file"));
+        if (!file.empty() && TessellationCache::isEnabled()) {
+            reader.addFile(file.c_str(), this);
+        }
+    }
+}
+
+void ViewProviderPartExt::SaveDocFile(Base::Writer& writer) const
+{
+    TessellationCache::instance().save(writer.Stream(), tessellationKeys);
+}
+
+void ViewProviderPartExt::RestoreDocFile(Base::Reader& reader)
+{
+    TessellationCache::instance().restore(reader);
+}
+
 void ViewProviderPartExt::forceUpdate(bool enable)
 {
     if (enable) {
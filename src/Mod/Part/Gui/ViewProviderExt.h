@@ -28,6 +28,8 @@
 
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include <App/PropertyUnits.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -109,6 +111,14 @@ public:
     void finishRestoring() override;
     //@}
 
+    /** @name Persistence of the tessellation cache */
+    //@{
+    void Save(Base::Writer& writer) const override;
+    void Restore(Base::XMLReader& reader) override;
+    void SaveDocFile(Base::Writer& writer) const override;
+    void RestoreDocFile(Base::Reader& reader) override;
+    //@}
+
     /** @name Selection handling
      * This group of methods do the selection handling.
      * Here you can define how the selection for your ViewProfider
@@ -189,7 +199,8 @@ public:
         SoBrepPointSet* nodeset,
         double deviation,
         double angularDeflection,
-        bool normalsFromUV = false
+        bool normalsFromUV = false,
+        std::vector<std::string>* tessellationKeys = nullptr
     );
 
     static void setupCoinGeometry(
@@ -253,6 +264,8 @@ private:
 
     // shape that was last rendered so if it does not change we don't re-render it without need
     TopoDS_Shape lastRenderedShape;
+    // cache keys of the faces of the last rendered shape
+    std::vector<std::string> tessellationKeys;
 };
 
 }  // namespace PartGui
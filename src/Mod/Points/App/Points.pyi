@@ -60,6 +60,13 @@ class Points(object):
     def fromValid(self) -> Any:
         """Get a new point object from points with valid coordinates (i.e. that are not NaN)"""
         ...
+
+    @constmethod
+    def fromLevelOfDetail(self) -> Any:
+        """fromLevelOfDetail(maxPoints, [spacing=0.0]) -> Points
+        Get a new point object with an evenly distributed subset of at most maxPoints points.
+        If spacing is given, the subset is not refined beyond this point spacing."""
+        ...
     CountPoints: Final[int]
     """Return the number of vertices of the points object."""
 
@@ -27,9 +27,15 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <sstream>
 
+#include <Eigen/Core>
+#include <QtConcurrentMap>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>  // needed for compilation on some systems
@@ -249,94 +255,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(
-        std::streambuf::off_type off,
-        std::ios_base::seekdir way,
-        std::ios_base::openmode mode = std::ios::in | std::ios::out
-    ) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(
-        std::streambuf::pos_type pos,
-        std::ios_base::openmode which = std::ios::in | std::ios::out
-    ) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int lzfDecompress(
@@ -551,182 +469,519 @@ unsigned int lzfDecompress(
 
     return (static_cast<unsigned int>(op - static_cast<unsigned char*>(out_data)));
 }
-}  // namespace Points
 // NOLINTEND
 
-PlyReader::PlyReader() = default;
+// ----------------------------------------------------------------------------
 
-void PlyReader::read(const std::string& filename)
+enum class FieldType
 {
-    clear();
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
 
-    Base::FileInfo fi(filename);
-    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+// Location of a property in a block of binary data. The value of the i-th point
+// is at offset + i * stride which covers interleaved records as well as data that
+// is stored field by field.
+struct FieldLayout
+{
+    FieldType type {FieldType::Float32};
+    std::size_t offset {0};
+    std::size_t stride {0};
+};
 
-    std::string format;
-    std::vector<std::string> fields;
-    std::vector<std::string> types;
-    std::vector<int> sizes;
-    std::size_t offset = 0;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, offset, fields, types, sizes));
+template<typename T>
+double decodeValue(const char* data, bool swapByteOrder)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), data, sizeof(T));
+    if (swapByteOrder) {
+        std::ranges::reverse(bytes);
+    }
+    T value {};
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return static_cast<double>(value);
+}
 
-    this->width = numPoints;
-    this->height = 1;
+double decodeField(FieldType type, const char* data, bool swapByteOrder)
+{
+    switch (type) {
+        case FieldType::Int8:
+            return decodeValue<int8_t>(data, swapByteOrder);
+        case FieldType::UInt8:
+            return decodeValue<uint8_t>(data, swapByteOrder);
+        case FieldType::Int16:
+            return decodeValue<int16_t>(data, swapByteOrder);
+        case FieldType::UInt16:
+            return decodeValue<uint16_t>(data, swapByteOrder);
+        case FieldType::Int32:
+            return decodeValue<int32_t>(data, swapByteOrder);
+        case FieldType::UInt32:
+            return decodeValue<uint32_t>(data, swapByteOrder);
+        case FieldType::Float32:
+            return decodeValue<float>(data, swapByteOrder);
+        case FieldType::Float64:
+            return decodeValue<double>(data, swapByteOrder);
+    }
+    return 0.0;
+}
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
+std::size_t fieldSize(FieldType type)
+{
+    switch (type) {
+        case FieldType::Int8:
+        case FieldType::UInt8:
+            return 1;
+        case FieldType::Int16:
+        case FieldType::UInt16:
+            return 2;
+        case FieldType::Int32:
+        case FieldType::UInt32:
+        case FieldType::Float32:
+            return 4;
+        case FieldType::Float64:
+            return 8;
+    }
+    return 0;
+}
+
+FieldType plyFieldType(const std::string& t, int size)
+{
+    switch (size) {
+        case 1:
+            if (t == "char" || t == "int8") {
+                return FieldType::Int8;
+            }
+            if (t == "uchar" || t == "uint8") {
+                return FieldType::UInt8;
+            }
+            break;
+        case 2:
+            if (t == "short" || t == "int16") {
+                return FieldType::Int16;
+            }
+            if (t == "ushort" || t == "uint16") {
+                return FieldType::UInt16;
+            }
+            break;
+        case 4:
+            if (t == "int" || t == "int32") {
+                return FieldType::Int32;
+            }
+            if (t == "uint" || t == "uint32") {
+                return FieldType::UInt32;
+            }
+            if (t == "float" || t == "float32") {
+                return FieldType::Float32;
+            }
+            break;
+        case 8:
+            if (t == "double" || t == "float64") {
+                return FieldType::Float64;
+            }
+            break;
+        default:
+            break;
     }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
+    throw Base::BadFormatError("Unexpected type");
+}
+
+FieldType pcdFieldType(const std::string& type, int size)
+{
+    char t = type.empty() ? ' ' : type[0];
+    switch (size) {
+        case 1:
+            if (t == 'I') {
+                return FieldType::Int8;
+            }
+            if (t == 'U') {
+                return FieldType::UInt8;
+            }
+            break;
+        case 2:
+            if (t == 'I') {
+                return FieldType::Int16;
+            }
+            if (t == 'U') {
+                return FieldType::UInt16;
+            }
+            break;
+        case 4:
+            if (t == 'I') {
+                return FieldType::Int32;
+            }
+            if (t == 'U') {
+                return FieldType::UInt32;
+            }
+            if (t == 'F') {
+                return FieldType::Float32;
+            }
+            break;
+        case 8:
+            if (t == 'F') {
+                return FieldType::Float64;
+            }
+            break;
+        default:
+            break;
     }
+    throw Base::BadFormatError("Unexpected type");
+}
+
+// Writes the properties of the points directly into the buffers of a reader.
+// Every point only touches its own elements so that disjoint ranges of points
+// can be decoded in parallel.
+class PointDecoder
+{
+public:
+    enum class ColorMode
+    {
+        None,
+        Bytes,
+        Floats,
+        Packed,
+        PackedFloat
+    };
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
+    explicit PointDecoder(const std::vector<std::string>& fields)
+        : x {find(fields, {"x"})}
+        , y {find(fields, {"y"})}
+        , z {find(fields, {"z"})}
+        , normalX {find(fields, {"normal_x", "nx"})}
+        , normalY {find(fields, {"normal_y", "ny"})}
+        , normalZ {find(fields, {"normal_z", "nz"})}
+        , greyValue {find(fields, {"intensity"})}
+    {}
 
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
+    static int find(
+        const std::vector<std::string>& fields,
+        std::initializer_list<const char*> names
+    )
+    {
+        for (const char* name : names) {
+            auto it = std::ranges::find(fields, name);
+            if (it != fields.end()) {
+                return static_cast<int>(std::distance(fields.begin(), it));
+            }
+        }
+        return -1;
     }
 
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
+    void setColors(ColorMode mode, int r, int g, int b, int a)
+    {
+        colorMode = mode;
+        red = r;
+        green = g;
+        blue = b;
+        alpha = a;
     }
 
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
+    bool hasData() const
+    {
+        return x >= 0 && y >= 0 && z >= 0;
     }
 
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
+    void allocate(
+        std::size_t numPoints,
+        PointKernel& points,
+        std::vector<Base::Vector3f>& normals,
+        std::vector<float>& intensity,
+        std::vector<Base::Color>& colors
+    )
+    {
+        pointBuffer = &points;
+        points.resize(numPoints);
+        pnts = points.getBasicPoints().data();
+        if (normalX >= 0 && normalY >= 0 && normalZ >= 0) {
+            normalBuffer = &normals;
+            normals.resize(numPoints);
+            nrms = normals.data();
+        }
+        if (greyValue >= 0) {
+            greyBuffer = &intensity;
+            intensity.resize(numPoints);
+            grey = intensity.data();
+        }
+        if (colorMode != ColorMode::None) {
+            colorBuffer = &colors;
+            colors.resize(numPoints);
+            cols = colors.data();
+        }
     }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
+
+    /// Drops the points after \a numPoints if the file contains less than announced
+    void truncate(std::size_t numPoints)
+    {
+        pointBuffer->resize(numPoints);
+        if (normalBuffer) {
+            normalBuffer->resize(numPoints);
+        }
+        if (greyBuffer) {
+            greyBuffer->resize(numPoints);
+        }
+        if (colorBuffer) {
+            colorBuffer->resize(numPoints);
+        }
     }
 
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
+    /// Stores the point \a index, value(i) returns the value of the i-th field
+    template<typename Getter>
+    void decode(std::size_t index, Getter&& value) const
+    {
+        pnts[index].Set(
+            static_cast<float>(value(x)),
+            static_cast<float>(value(y)),
+            static_cast<float>(value(z))
+        );
+        if (nrms) {
+            nrms[index].Set(
+                static_cast<float>(value(normalX)),
+                static_cast<float>(value(normalY)),
+                static_cast<float>(value(normalZ))
+            );
+        }
+        if (grey) {
+            grey[index] = static_cast<float>(value(greyValue));
+        }
+        if (cols) {
+            cols[index] = decodeColor(value);
+        }
     }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
+
+private:
+    template<typename Getter>
+    Base::Color decodeColor(Getter&& value) const
+    {
+        Base::Color col;
+        switch (colorMode) {
+            case ColorMode::Bytes: {
+                float a = alpha >= 0 ? static_cast<float>(value(alpha)) : 1.0F;
+                col.set(
+                    static_cast<float>(value(red)) / 255.0F,
+                    static_cast<float>(value(green)) / 255.0F,
+                    static_cast<float>(value(blue)) / 255.0F,
+                    a / 255.0F
+                );
+            } break;
+            case ColorMode::Floats:
+                col.set(
+                    static_cast<float>(value(red)),
+                    static_cast<float>(value(green)),
+                    static_cast<float>(value(blue)),
+                    alpha >= 0 ? static_cast<float>(value(alpha)) : 1.0F
+                );
+                break;
+            case ColorMode::Packed:
+                col.setPackedARGB(static_cast<uint32_t>(value(red)));
+                break;
+            case ColorMode::PackedFloat: {
+                static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t differ in size");
+                float f = static_cast<float>(value(red));
+                uint32_t packed {};
+                std::memcpy(&packed, &f, sizeof(packed));
+                col.setPackedARGB(packed);
+            } break;
+            case ColorMode::None:
+                break;
+        }
+        return col;
     }
 
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
+    int x, y, z;
+    int normalX, normalY, normalZ;
+    int greyValue;
+    int red {-1}, green {-1}, blue {-1}, alpha {-1};
+    ColorMode colorMode {ColorMode::None};
+
+    PointKernel* pointBuffer {nullptr};
+    std::vector<Base::Vector3f>* normalBuffer {nullptr};
+    std::vector<float>* greyBuffer {nullptr};
+    std::vector<Base::Color>* colorBuffer {nullptr};
+    PointKernel::value_type* pnts {nullptr};
+    Base::Vector3f* nrms {nullptr};
+    float* grey {nullptr};
+    Base::Color* cols {nullptr};
+};
+
+// Decodes count points of a block of binary data, splits larger blocks into
+// ranges that are decoded in parallel
+void decodeBlock(
+    const PointDecoder& decoder,
+    const char* data,
+    std::size_t first,
+    std::size_t count,
+    const std::vector<FieldLayout>& layout,
+    bool swapByteOrder
+)
+{
+    using Range = std::pair<std::size_t, std::size_t>;
+    auto decodeRange = [&](const Range& range) {
+        for (std::size_t i = range.first; i < range.second; i++) {
+            decoder.decode(first + i, [&](int col) {
+                const FieldLayout& field = layout[col];
+                const char* value = data + field.offset + i * field.stride;
+                return decodeField(field.type, value, swapByteOrder);
+            });
+        }
+    };
+
+    const std::size_t rangeSize = 65536;
+    std::vector<Range> ranges;
+    for (std::size_t i = 0; i < count; i += rangeSize) {
+        ranges.emplace_back(i, std::min(count, i + rangeSize));
     }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
+    if (ranges.size() > 1) {
+        QtConcurrent::blockingMap(ranges, decodeRange);
     }
-
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    else if (!ranges.empty()) {
+        decodeRange(ranges.front());
     }
+}
 
-    // rgb(a) field
-    Eigen::Index red = max_size;
-    Eigen::Index green = max_size;
-    Eigen::Index blue = max_size;
-    Eigen::Index alpha = max_size;
-    it = std::ranges::find(fields, "red");
-    if (it != fields.end()) {
-        red = std::distance(fields.begin(), it);
+// Reads interleaved records chunk by chunk so that the raw data is never
+// completely held in memory
+void readRecords(
+    std::istream& inp,
+    std::size_t numPoints,
+    const std::vector<FieldLayout>& layout,
+    std::size_t recordSize,
+    bool swapByteOrder,
+    const PointDecoder& decoder
+)
+{
+    if (recordSize == 0) {
+        return;
     }
 
-    it = std::ranges::find(fields, "green");
-    if (it != fields.end()) {
-        green = std::distance(fields.begin(), it);
+    const std::size_t chunkSize = std::max<std::size_t>(1, (std::size_t(1) << 22) / recordSize);
+    std::vector<char> buffer(std::min(numPoints, chunkSize) * recordSize);
+    for (std::size_t first = 0; first < numPoints; first += chunkSize) {
+        std::size_t count = std::min(chunkSize, numPoints - first);
+        if (!inp.read(buffer.data(), static_cast<std::streamsize>(count * recordSize))) {
+            throw Base::BadFormatError("Unexpected end of file");
+        }
+        decodeBlock(decoder, buffer.data(), first, count, layout, swapByteOrder);
     }
+}
 
-    it = std::ranges::find(fields, "blue");
-    if (it != fields.end()) {
-        blue = std::distance(fields.begin(), it);
-    }
+// Reads numPoints lines after skipping the first skip lines, returns the number
+// of points that were read
+std::size_t readAsciiRecords(
+    std::istream& inp,
+    std::size_t skip,
+    std::size_t numPoints,
+    const PointDecoder& decoder
+)
+{
+    std::string line;
+    std::size_t row = 0;
+    std::vector<std::string> list;
+    while (row < numPoints && std::getline(inp, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+
+        // since the file is loaded in binary mode we may get the CR at the end
+        boost::trim(line);
+        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
 
-    it = std::ranges::find(fields, "alpha");
-    if (it != fields.end()) {
-        alpha = std::distance(fields.begin(), it);
+        decoder.decode(row, [&](int col) {
+            if (static_cast<std::size_t>(col) < list.size()) {
+                return boost::lexical_cast<double>(list[col]);
+            }
+            return 0.0;
+        });
+
+        ++row;
     }
 
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    return row;
+}
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+// Throws if the stream ends before the announced number of points
+void checkAvailableSize(std::istream& inp, std::size_t offset, std::size_t neededSize)
+{
+    std::streambuf* buf = inp.rdbuf();
+    if (buf) {
+        std::streamoff ulCurr =
+            buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
+        std::streamoff ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
+        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
+        if (ulCurr + static_cast<std::streamoff>(neededSize) > ulSize) {
+            throw Base::BadFormatError("File expects too many elements");
         }
     }
+}
+}  // namespace Points
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+PlyReader::PlyReader() = default;
+
+void PlyReader::read(const std::string& filename)
+{
+    clear();
+
+    Base::FileInfo fi(filename);
+    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+
+    std::string format;
+    std::vector<std::string> fields;
+    std::vector<std::string> types;
+    std::vector<int> sizes;
+    std::size_t offset = 0;
+    std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
+
+    this->width = static_cast<int>(numPoints);
+    this->height = 1;
+
+    PointDecoder decoder(fields);
+    int red = PointDecoder::find(fields, {"red"});
+    int green = PointDecoder::find(fields, {"green"});
+    int blue = PointDecoder::find(fields, {"blue"});
+    int alpha = PointDecoder::find(fields, {"alpha"});
+    if (red >= 0 && green >= 0 && blue >= 0) {
+        if (types[red] == "uchar") {
+            decoder.setColors(PointDecoder::ColorMode::Bytes, red, green, blue, alpha);
+        }
+        else if (types[red] == "float") {
+            decoder.setColors(PointDecoder::ColorMode::Floats, red, green, blue, alpha);
         }
     }
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
-        }
+    if (!decoder.hasData()) {
+        return;
     }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(
-                    static_cast<float>(r) / 255.0F,
-                    static_cast<float>(g) / 255.0F,
-                    static_cast<float>(b) / 255.0F,
-                    static_cast<float>(a) / 255.0F
-                );
-            }
+    if (format == "ascii") {
+        decoder.allocate(numPoints, points, normals, intensity, colors);
+        std::size_t count = readAsciiRecords(inp, offset, numPoints, decoder);
+        decoder.truncate(count);
+    }
+    else {
+        std::vector<FieldLayout> layout;
+        std::size_t recordSize = 0;
+        for (std::size_t i = 0; i < fields.size(); i++) {
+            FieldType type = plyFieldType(types[i], sizes[i]);
+            layout.push_back({type, recordSize, 0});
+            recordSize += fieldSize(type);
         }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
-                }
-                colors.emplace_back(r, g, b, a);
-            }
+        for (auto& field : layout) {
+            field.stride = recordSize;
         }
+
+        checkAvailableSize(inp, offset, recordSize * numPoints);
+        decoder.allocate(numPoints, points, normals, intensity, colors);
+        bool swapByteOrder = (format == "binary_big_endian");
+        readRecords(inp, numPoints, layout, recordSize, swapByteOrder, decoder);
     }
 }
 
@@ -902,138 +1157,6 @@ std::size_t PlyReader::readHeader(
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = Eigen::Index(data.rows());
-    Eigen::Index numFields = Eigen::Index(data.cols());
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PlyReader::readBinary(
-    bool swapByteOrder,
-    std::istream& inp,
-    std::size_t offset,
-    const std::vector<std::string>& types,
-    const std::vector<int>& sizes,
-    Eigen::MatrixXd& data
-)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1051,154 +1174,73 @@ void PcdReader::read(const std::string& filename)
     std::vector<std::string> fields;
     std::vector<std::string> types;
     std::vector<int> sizes;
-    Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
+    std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
+    PointDecoder decoder(fields);
+    int rgba = PointDecoder::find(fields, {"rgb", "rgba"});
+    if (rgba >= 0) {
+        if (types[rgba] == "U") {
+            decoder.setColors(PointDecoder::ColorMode::Packed, rgba, -1, -1, -1);
         }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
+        else if (types[rgba] == "F") {
+            decoder.setColors(PointDecoder::ColorMode::PackedFloat, rgba, -1, -1, -1);
         }
     }
 
-    std::vector<std::string>::iterator it;
-    Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
-
-    // x field
-    Eigen::Index x = max_size;
-    it = std::ranges::find(fields, "x");
-    if (it != fields.end()) {
-        x = std::distance(fields.begin(), it);
-    }
-
-    // y field
-    Eigen::Index y = max_size;
-    it = std::ranges::find(fields, "y");
-    if (it != fields.end()) {
-        y = std::distance(fields.begin(), it);
+    if (!decoder.hasData()) {
+        return;
     }
 
-    // z field
-    Eigen::Index z = max_size;
-    it = std::ranges::find(fields, "z");
-    if (it != fields.end()) {
-        z = std::distance(fields.begin(), it);
-    }
-
-    // normal x field
-    Eigen::Index normal_x = max_size;
-    it = std::ranges::find(fields, "normal_x");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nx");
-    }
-    if (it != fields.end()) {
-        normal_x = std::distance(fields.begin(), it);
-    }
-
-    // normal y field
-    Eigen::Index normal_y = max_size;
-    it = std::ranges::find(fields, "normal_y");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "ny");
-    }
-    if (it != fields.end()) {
-        normal_y = std::distance(fields.begin(), it);
-    }
-
-    // normal z field
-    Eigen::Index normal_z = max_size;
-    it = std::ranges::find(fields, "normal_z");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "nz");
-    }
-    if (it != fields.end()) {
-        normal_z = std::distance(fields.begin(), it);
+    if (format == "ascii") {
+        decoder.allocate(numPoints, points, normals, intensity, colors);
+        std::size_t count = readAsciiRecords(inp, 0, numPoints, decoder);
+        decoder.truncate(count);
+        return;
     }
 
-    // intensity field
-    Eigen::Index greyvalue = max_size;
-    it = std::ranges::find(fields, "intensity");
-    if (it != fields.end()) {
-        greyvalue = std::distance(fields.begin(), it);
+    std::vector<FieldLayout> layout;
+    std::size_t recordSize = 0;
+    for (std::size_t i = 0; i < fields.size(); i++) {
+        FieldType type = pcdFieldType(types[i], sizes[i]);
+        layout.push_back({type, recordSize, 0});
+        recordSize += fieldSize(type);
     }
 
-    // rgb(a) field
-    Eigen::Index rgba = max_size;
-    it = std::ranges::find(fields, "rgb");
-    if (it == fields.end()) {
-        it = std::ranges::find(fields, "rgba");
-    }
-    if (it != fields.end()) {
-        rgba = std::distance(fields.begin(), it);
-    }
-
-    // transfer the data
-    bool hasData = (x != max_size && y != max_size && z != max_size);
-    bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
-    bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    if (format == "binary") {
+        for (auto& field : layout) {
+            field.stride = recordSize;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
-        }
+        checkAvailableSize(inp, 0, recordSize * numPoints);
+        decoder.allocate(numPoints, points, normals, intensity, colors);
+        readRecords(inp, numPoints, layout, recordSize, false, decoder);
     }
+    else if (format == "binary_compressed") {
+        unsigned int c {};
+        unsigned int u {};
+        Base::InputStream str(inp);
+        str >> c >> u;
 
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        // the data is stored field by field
+        if (u < recordSize * numPoints) {
+            throw Base::BadFormatError("File expects too many elements");
         }
-    }
-
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
-            }
+        for (auto& field : layout) {
+            field.offset *= numPoints;
+            field.stride = fieldSize(field.type);
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+
+        std::vector<char> uncompressed(u);
+        {
+            std::vector<char> compressed(c);
+            inp.read(compressed.data(), c);
+            if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) != u) {
+                throw Base::BadFormatError("Failed to decompress binary data");
             }
         }
+
+        decoder.allocate(numPoints, points, normals, intensity, colors);
+        decodeBlock(decoder, uncompressed.data(), 0, numPoints, layout, false);
     }
 }
 
@@ -1275,141 +1317,6 @@ std::size_t PcdReader::readHeader(
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    Eigen::Index row = 0;
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty()) {
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        Eigen::Index size = Eigen::Index(list.size());
-        for (Eigen::Index col = 0; col < size && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
-void PcdReader::readBinary(
-    bool transpose,
-    std::istream& inp,
-    const std::vector<std::string>& types,
-    const std::vector<int>& sizes,
-    Eigen::MatrixXd& data
-)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 namespace
@@ -1433,22 +1340,22 @@ public:
         }
     }
 
-    std::vector<Base::Color> getColors() const
+    std::vector<Base::Color>& getColors()
     {
         return colors;
     }
 
-    std::vector<float> getItensity() const
+    std::vector<float>& getItensity()
     {
         return intensity;
     }
 
-    const PointKernel& getPoints() const
+    PointKernel& getPoints()
     {
         return points;
     }
 
-    const std::vector<Base::Vector3f>& getNormals() const
+    std::vector<Base::Vector3f>& getNormals()
     {
         return normals;
     }
@@ -1456,6 +1363,15 @@ public:
 private:
     void readData3D(const e57::VectorNode& data3D)
     {
+        // reserve the space for all scans to avoid the reallocations while reading
+        int64_t numPoints = 0;
+        for (int child = 0; child < data3D.childCount(); ++child) {
+            e57::StructureNode scan_data(data3D.get(child));
+            e57::CompressedVectorNode cvn(scan_data.get("points"));
+            numPoints += cvn.childCount();
+        }
+        points.reserve(static_cast<std::size_t>(numPoints));
+
         for (int child = 0; child < data3D.childCount(); ++child) {
             e57::StructureNode scan_data(data3D.get(child));
             Base::Placement plm;
@@ -1733,6 +1649,17 @@ private:
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
 
+        std::size_t capacity = points.getBasicPoints().capacity();
+        if (hasColor) {
+            colors.reserve(capacity);
+        }
+        if (hasItensity) {
+            intensity.reserve(capacity);
+        }
+        if (hasNormal) {
+            normals.reserve(capacity);
+        }
+
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
                 filter = false;
@@ -1864,7 +1791,8 @@ private:
     bool useColor;
     bool checkState;
     double minDistance;
-    const size_t buf_size = 1024;
+    // number of points decoded by a single block read
+    const size_t buf_size = 65536;
     std::vector<Base::Color> colors;
     std::vector<float> intensity;
     PointKernel points;
@@ -1883,10 +1811,10 @@ void E57Reader::read(const std::string& filename)
     try {
         E57ReaderImp reader(filename, useColor, checkState, minDistance);
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
+        points = std::move(reader.getPoints());
+        normals = std::move(reader.getNormals());
+        colors = std::move(reader.getColors());
+        intensity = std::move(reader.getItensity());
         width = points.size();
         height = 1;
     }
@@ -24,8 +24,6 @@
 
 #pragma once
 
-#include <Eigen/Core>
-
 #include "Points.h"
 #include "Properties.h"
 
@@ -89,6 +87,9 @@ public:
     void read(const std::string& filename) override;
 };
 
+/** Reads PLY files. The point data is decoded in chunks directly into the
+ * buffers of the reader, binary chunks are decoded in parallel.
+ */
 class PointsExport PlyReader: public Reader
 {
 public:
@@ -104,17 +105,11 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(
-        bool swapByteOrder,
-        std::istream&,
-        std::size_t offset,
-        const std::vector<std::string>& types,
-        const std::vector<int>& sizes,
-        Eigen::MatrixXd& data
-    );
 };
 
+/** Reads PCD files. The point data is decoded in chunks directly into the
+ * buffers of the reader, binary chunks are decoded in parallel.
+ */
 class PointsExport PcdReader: public Reader
 {
 public:
@@ -129,14 +124,6 @@ private:
         std::vector<std::string>& types,
         std::vector<int>& sizes
     );
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(
-        bool transpose,
-        std::istream&,
-        const std::vector<std::string>& types,
-        const std::vector<int>& sizes,
-        Eigen::MatrixXd& data
-    );
 };
 
 class PointsExport E57Reader: public Reader
@@ -0,0 +1,535 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <utility>
+
+#include <QFile>
+
+#include <Base/Exception.h>
+
+#include "PointsOctree.h"
+
+
+using namespace Points;
+
+namespace
+{
+
+// Morton codes use at most 21 bits per axis so that they fit into 63 bits
+constexpr unsigned int MaxLevel = 21;
+
+std::uint64_t spreadBits(std::uint32_t value)
+{
+    std::uint64_t bits = value & 0x1fffff;
+    bits = (bits | bits << 32) & 0x1f00000000ffffULL;
+    bits = (bits | bits << 16) & 0x1f0000ff0000ffULL;
+    bits = (bits | bits << 8) & 0x100f00f00f00f00fULL;
+    bits = (bits | bits << 4) & 0x10c30c30c30c30c3ULL;
+    bits = (bits | bits << 2) & 0x1249249249249249ULL;
+    return bits;
+}
+
+// The Morton code of a point in a cube with 2^levels cells per axis
+std::uint64_t mortonCode(
+    const Base::Vector3f& pnt,
+    const Base::Vector3f& min,
+    float scale,
+    unsigned int levels
+)
+{
+    auto quantize = [scale, levels](float value, float origin) {
+        auto cell = static_cast<std::int64_t>((value - origin) * scale);
+        std::int64_t maxCell = (std::int64_t(1) << levels) - 1;
+        return static_cast<std::uint32_t>(std::clamp<std::int64_t>(cell, 0, maxCell));
+    };
+    return spreadBits(quantize(pnt.x, min.x)) | spreadBits(quantize(pnt.y, min.y)) << 1
+        | spreadBits(quantize(pnt.z, min.z)) << 2;
+}
+
+// Sorts the keys in place, by the byte at shift first and then by the lower ones
+void radixSort(std::uint64_t* first, std::uint64_t* last, int shift)
+{
+    constexpr std::ptrdiff_t minSize = 64;
+    if (last - first <= minSize || shift < 0) {
+        std::sort(first, last);
+        return;
+    }
+
+    auto bucketOf = [shift](std::uint64_t key) {
+        return static_cast<std::size_t>((key >> shift) & 0xff);
+    };
+    std::array<std::size_t, 256> counts {};
+    for (auto it = first; it != last; ++it) {
+        counts[bucketOf(*it)]++;
+    }
+
+    std::array<std::uint64_t*, 256> heads {};
+    std::array<std::uint64_t*, 256> tails {};
+    std::uint64_t* pos = first;
+    for (std::size_t bucket = 0; bucket < 256; bucket++) {
+        heads[bucket] = pos;
+        pos += counts[bucket];
+        tails[bucket] = pos;
+    }
+
+    // move every key to its bucket, the keys that are swapped out move on to theirs
+    for (std::size_t bucket = 0; bucket < 256; bucket++) {
+        while (heads[bucket] != tails[bucket]) {
+            std::uint64_t key = *heads[bucket];
+            std::size_t target = bucketOf(key);
+            while (target != bucket) {
+                std::swap(key, *heads[target]++);
+                target = bucketOf(key);
+            }
+            *heads[bucket]++ = key;
+        }
+    }
+
+    for (std::size_t bucket = 0; bucket < 256; bucket++) {
+        radixSort(tails[bucket] - counts[bucket], tails[bucket], shift - 8);
+    }
+}
+
+bool isValid(const Base::Vector3f& pnt)
+{
+    return std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z);
+}
+
+Base::BoundBox3f octantBox(const Base::BoundBox3f& box, unsigned int octant)
+{
+    // the x coordinate takes the lowest bit of every triple of a Morton code
+    float half = 0.5F * box.LengthX();
+    Base::Vector3f min(
+        box.MinX + ((octant & 1) ? half : 0.0F),
+        box.MinY + ((octant & 2) ? half : 0.0F),
+        box.MinZ + ((octant & 4) ? half : 0.0F)
+    );
+    return Base::BoundBox3f(min.x, min.y, min.z, min.x + half, min.y + half, min.z + half);
+}
+
+bool isOutside(const Base::BoundBox3f& box, const PointsOctree::Plane& plane)
+{
+    // test the corner that is farthest along the normal
+    Base::Vector3f corner(
+        plane.normal.x >= 0.0F ? box.MaxX : box.MinX,
+        plane.normal.y >= 0.0F ? box.MaxY : box.MinY,
+        plane.normal.z >= 0.0F ? box.MaxZ : box.MinZ
+    );
+    return plane.normal * corner < plane.distance;
+}
+
+float distanceToBox(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+    float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+    float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+}  // namespace
+
+PointsOctree::PointsOctree(const PointKernel& kernel, std::size_t maxLeafSize)
+    : transform(kernel.getTransform())
+    , maxLeafSize(std::max<std::size_t>(maxLeafSize, 1))
+{
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    if (pts.size() > maxSize) {
+        throw Base::ValueError("Too many points for a level of detail octree");
+    }
+
+    Base::BoundBox3f bbox;
+    std::size_t numValid = 0;
+    for (const auto& pnt : pts) {
+        if (isValid(pnt)) {
+            bbox.Add(pnt);
+            numValid++;
+        }
+    }
+
+    if (numValid == 0) {
+        return;
+    }
+
+    float length = std::max({bbox.LengthX(), bbox.LengthY(), bbox.LengthZ()});
+    if (length <= 0.0F) {
+        length = 1.0F;
+    }
+    Base::Vector3f center = bbox.GetCenter();
+    Base::Vector3f min = center - Base::Vector3f(0.5F * length, 0.5F * length, 0.5F * length);
+
+    // A key is the Morton code of a point followed by its index, so that a single array of unique
+    // keys is sorted and the order doesn't depend on the sort implementation. The index takes the
+    // lower bits and the code gets as many levels as fit into the remaining ones.
+    auto indexBits = static_cast<unsigned int>(std::bit_width(pts.size() - 1));
+    unsigned int levels = std::min(MaxLevel, (64 - indexBits) / 3);
+    float scale = static_cast<float>(std::uint64_t(1) << levels) / length;
+
+    std::vector<std::uint64_t> keys;
+    keys.reserve(numValid);
+    for (std::size_t index = 0; index < pts.size(); index++) {
+        const auto& pnt = pts[index];
+        if (isValid(pnt)) {
+            keys.push_back(mortonCode(pnt, min, scale, levels) << indexBits | index);
+        }
+    }
+    int shift = static_cast<int>((3 * levels + indexBits - 1) / 8 * 8);
+    radixSort(keys.data(), keys.data() + keys.size(), shift);
+
+    numPoints = numValid;
+    std::uint64_t indexMask = (std::uint64_t(1) << indexBits) - 1;
+    sortedIndices.resize(numPoints);
+    std::transform(keys.begin(), keys.end(), sortedIndices.begin(), [indexMask](std::uint64_t key) {
+        return static_cast<Index>(key & indexMask);
+    });
+    std::vector<std::uint64_t>().swap(keys);
+
+    // the codes are not kept, the nodes get them from the sorted points again
+    sortedPoints.reserve(numPoints);
+    for (Index index : sortedIndices) {
+        sortedPoints.push_back(pts[index]);
+    }
+
+    pointData = sortedPoints.data();
+    indexData = sortedIndices.data();
+
+    Node root;
+    root.box = Base::BoundBox3f(
+        min.x,
+        min.y,
+        min.z,
+        min.x + length,
+        min.y + length,
+        min.z + length
+    );
+    root.end = numPoints;
+    nodeList.push_back(root);
+    buildNodes(min, scale, levels);
+}
+
+PointsOctree::~PointsOctree()
+{
+    if (cacheFile) {
+        cacheFile->remove();
+    }
+}
+
+void PointsOctree::buildNodes(const Base::Vector3f& min, float scale, unsigned int levels)
+{
+    // breadth first, so that the children of a node are stored consecutively
+    for (std::size_t index = 0; index < nodeList.size(); index++) {
+        Node node = nodeList[index];
+        if (node.size() <= maxLeafSize || node.level >= levels) {
+            continue;
+        }
+
+        // the points of a node share the upper bits of their codes and are sorted by the rest
+        unsigned int shift = 3 * (levels - 1 - node.level);
+        auto octantOf = [&](const Base::Vector3f& pnt) {
+            return static_cast<unsigned int>((mortonCode(pnt, min, scale, levels) >> shift) & 7);
+        };
+
+        auto first = static_cast<std::uint32_t>(nodeList.size());
+        std::uint8_t numChildren = 0;
+        const Base::Vector3f* begin = pointData + node.begin;
+        const Base::Vector3f* end = pointData + node.end;
+        for (unsigned int octant = 0; octant < 8 && begin != end; octant++) {
+            auto next = std::partition_point(begin, end, [&](const Base::Vector3f& pnt) {
+                return octantOf(pnt) <= octant;
+            });
+            if (next != begin) {
+                Node child;
+                child.box = octantBox(node.box, octant);
+                child.begin = static_cast<std::size_t>(begin - pointData);
+                child.end = static_cast<std::size_t>(next - pointData);
+                child.level = node.level + 1;
+                nodeList.push_back(child);
+                numChildren++;
+                maxLevel = std::max<unsigned int>(maxLevel, child.level);
+            }
+            begin = next;
+        }
+
+        nodeList[index].firstChild = first;
+        nodeList[index].numChildren = numChildren;
+    }
+}
+
+bool PointsOctree::spill(const std::string& fileName)
+{
+    static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float));
+
+    if (cacheFile) {
+        return true;
+    }
+    if (numPoints == 0) {
+        return false;
+    }
+
+    // the indices go first so that both arrays are properly aligned in the mapping
+    auto indexBytes = static_cast<qint64>(numPoints * sizeof(Index));
+    auto pointBytes = static_cast<qint64>(numPoints * sizeof(Base::Vector3f));
+
+    auto file = std::make_unique<QFile>(QString::fromStdString(fileName));
+    if (!file->open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return false;
+    }
+
+    bool written
+        = file->write(reinterpret_cast<const char*>(sortedIndices.data()), indexBytes) == indexBytes
+        && file->write(reinterpret_cast<const char*>(sortedPoints.data()), pointBytes) == pointBytes
+        && file->flush();
+    uchar* data = written ? file->map(0, indexBytes + pointBytes) : nullptr;
+    if (!data) {
+        file->remove();
+        return false;
+    }
+
+    indexData = reinterpret_cast<const Index*>(data);
+    pointData = reinterpret_cast<const Base::Vector3f*>(data + indexBytes);
+    std::vector<Base::Vector3f>().swap(sortedPoints);
+    std::vector<Index>().swap(sortedIndices);
+    cacheFile = std::move(file);
+    return true;
+}
+
+bool PointsOctree::isSpilled() const
+{
+    return cacheFile != nullptr;
+}
+
+PointsOctree::Range PointsOctree::representation(const Node& node) const
+{
+    if (node.isLeaf()) {
+        return {node.begin, node.end, 1};
+    }
+
+    std::size_t step = (node.size() + maxLeafSize - 1) / maxLeafSize;
+    return {node.begin, node.end, step};
+}
+
+template<typename ErrorFunc>
+std::vector<PointsOctree::Range> PointsOctree::refine(
+    ErrorFunc&& error,
+    float maxError,
+    std::size_t budget
+) const
+{
+    std::vector<Range> ranges;
+    if (nodeList.empty()) {
+        return ranges;
+    }
+
+    // The error of a node is the spacing of its representation scaled by the factor the error
+    // function returns, or nothing if the node can be skipped. Leaves show all of their points.
+    auto errorOf = [&](const Node& node) -> std::optional<float> {
+        std::optional<float> factor = error(node);
+        if (!factor || node.isLeaf()) {
+            return factor ? std::optional<float>(0.0F) : std::nullopt;
+        }
+        auto count = static_cast<float>(representation(node).size());
+        return *factor * node.box.LengthX() / std::sqrt(count);
+    };
+
+    std::optional<float> rootError = errorOf(nodeList.front());
+    if (!rootError) {
+        return ranges;
+    }
+
+    // thin out the root if even its representation exceeds the budget
+    std::size_t total = representation(nodeList.front()).size();
+    if (total > budget) {
+        if (budget > 0) {
+            const Node& root = nodeList.front();
+            ranges.push_back({root.begin, root.end, (root.size() + budget - 1) / budget});
+        }
+        return ranges;
+    }
+
+    using Entry = std::pair<float, std::uint32_t>;
+    std::priority_queue<Entry> queue;
+    queue.emplace(*rootError, 0);
+
+    std::vector<std::uint32_t> selected;
+    std::array<Entry, 8> children {};
+    while (!queue.empty()) {
+        auto [nodeError, index] = queue.top();
+        queue.pop();
+
+        const Node& node = nodeList[index];
+        if (node.isLeaf() || nodeError <= maxError) {
+            selected.push_back(index);
+            continue;
+        }
+
+        std::size_t numVisible = 0;
+        std::size_t cost = 0;
+        for (std::uint32_t child = node.firstChild; child < node.firstChild + node.numChildren;
+             child++) {
+            if (std::optional<float> childError = errorOf(nodeList[child])) {
+                children[numVisible++] = {*childError, child};
+                cost += representation(nodeList[child]).size();
+            }
+        }
+
+        std::size_t own = representation(node).size();
+        if (total - own + cost > budget) {
+            selected.push_back(index);
+            continue;
+        }
+
+        total = total - own + cost;
+        for (std::size_t i = 0; i < numVisible; i++) {
+            queue.push(children[i]);
+        }
+    }
+
+    std::sort(selected.begin(), selected.end(), [this](std::uint32_t lhs, std::uint32_t rhs) {
+        return nodeList[lhs].begin < nodeList[rhs].begin;
+    });
+    ranges.reserve(selected.size());
+    for (std::uint32_t index : selected) {
+        ranges.push_back(representation(nodeList[index]));
+    }
+    return ranges;
+}
+
+std::vector<PointsOctree::Range> PointsOctree::select(
+    const View& view,
+    float maxError,
+    std::size_t budget
+) const
+{
+    return refine(
+        [&view](const Node& node) -> std::optional<float> {
+            for (const Plane& plane : view.planes) {
+                if (isOutside(node.box, plane)) {
+                    return std::nullopt;
+                }
+            }
+            if (!view.perspective) {
+                return view.pixelScale;
+            }
+            // inside the node the error is unbounded, so that the node gets refined
+            float distance = distanceToBox(node.box, view.position);
+            return view.pixelScale / std::max(distance, std::numeric_limits<float>::min());
+        },
+        maxError,
+        budget
+    );
+}
+
+std::vector<PointsOctree::Range> PointsOctree::select(float spacing, std::size_t budget) const
+{
+    return refine(
+        [](const Node&) -> std::optional<float> {
+            return 1.0F;
+        },
+        spacing,
+        budget
+    );
+}
+
+std::vector<PointsOctree::Range> PointsOctree::selectLevel(unsigned int level) const
+{
+    std::vector<Range> ranges;
+    if (nodeList.empty()) {
+        return ranges;
+    }
+
+    // nodes are stored breadth first, i.e. sorted by level
+    std::vector<std::uint32_t> nodes {0};
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        const Node& node = nodeList[nodes[i]];
+        if (node.level < level && !node.isLeaf()) {
+            for (std::uint32_t child = node.firstChild;
+                 child < node.firstChild + node.numChildren;
+                 child++) {
+                nodes.push_back(child);
+            }
+        }
+    }
+
+    std::vector<const Node*> selected;
+    for (std::uint32_t index : nodes) {
+        const Node& node = nodeList[index];
+        if (node.level == level || node.isLeaf()) {
+            selected.push_back(&node);
+        }
+    }
+    std::sort(selected.begin(), selected.end(), [](const Node* lhs, const Node* rhs) {
+        return lhs->begin < rhs->begin;
+    });
+
+    ranges.reserve(selected.size());
+    for (const Node* node : selected) {
+        ranges.push_back(representation(*node));
+    }
+    return ranges;
+}
+
+std::size_t PointsOctree::count(const std::vector<Range>& ranges)
+{
+    std::size_t num = 0;
+    for (const Range& range : ranges) {
+        num += range.size();
+    }
+    return num;
+}
+
+void PointsOctree::getPoints(
+    const std::vector<Range>& ranges,
+    std::vector<Base::Vector3f>& pts,
+    std::vector<std::size_t>* idx
+) const
+{
+    std::size_t num = count(ranges);
+    pts.reserve(pts.size() + num);
+    if (idx) {
+        idx->reserve(idx->size() + num);
+    }
+
+    for (const Range& range : ranges) {
+        for (std::size_t i = range.begin; i < range.end; i += range.step) {
+            pts.push_back(pointData[i]);
+            if (idx) {
+                idx->push_back(indexData[i]);
+            }
+        }
+    }
+}
+
+PointKernel PointsOctree::getKernel(const std::vector<Range>& ranges) const
+{
+    std::vector<Base::Vector3f> pts;
+    getPoints(ranges, pts);
+
+    PointKernel kernel;
+    kernel.setTransform(transform);
+    kernel.swap(pts);
+    return kernel;
+}
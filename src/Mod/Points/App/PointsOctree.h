@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+class QFile;
+
+namespace Points
+{
+
+/**
+ * Level of detail structure for large point clouds.
+ *
+ * The valid points of a kernel are sorted along the Morton curve of an octree over their bounding
+ * cube. Every node owns a contiguous range of the sorted points and, because the curve keeps
+ * neighbouring points together, an evenly strided subset of that range is a spatially uniform
+ * sample of the node. Coarse levels therefore cost no storage besides the node table.
+ *
+ * The sorted points can be moved to a cache file that is mapped into memory, so that only the
+ * node table stays resident and the operating system pages in the parts that are accessed.
+ */
+class PointsExport PointsOctree
+{
+public:
+    /// The index of a point in the kernel.
+    using Index = std::uint32_t;
+    /// The maximum number of points of a kernel, valid or not.
+    static constexpr std::size_t maxSize = std::numeric_limits<Index>::max();
+
+    struct Node
+    {
+        /// The cube of the node.
+        Base::BoundBox3f box;
+        /// The range of the sorted points inside the node.
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        /// The index of the first child, the children are stored consecutively. 0 for leaves.
+        std::uint32_t firstChild = 0;
+        std::uint8_t numChildren = 0;
+        std::uint8_t level = 0;
+
+        bool isLeaf() const
+        {
+            return numChildren == 0;
+        }
+        std::size_t size() const
+        {
+            return end - begin;
+        }
+    };
+
+    /// Every step-th sorted point in [begin, end).
+    struct Range
+    {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::size_t step = 1;
+
+        std::size_t size() const
+        {
+            return (end - begin + step - 1) / step;
+        }
+        bool operator==(const Range&) const = default;
+    };
+
+    /// A plane bounding the visible volume. Points with normal * p >= distance are inside.
+    struct Plane
+    {
+        Base::Vector3f normal;
+        float distance = 0.0F;
+    };
+
+    /// The camera as seen in the coordinate system of the points.
+    struct View
+    {
+        Base::Vector3f position;
+        bool perspective = true;
+        /// Pixels per unit length, at distance 1 for perspective views.
+        float pixelScale = 1.0F;
+        std::vector<Plane> planes;
+    };
+
+    /**
+     * Builds the octree of the valid points of @p kernel. Nodes with more than @p maxLeafSize
+     * points are subdivided, and the coarse representation of an inner node has about
+     * @p maxLeafSize points. Throws Base::ValueError if the kernel has more than maxSize points.
+     */
+    explicit PointsOctree(const PointKernel& kernel, std::size_t maxLeafSize = 4096);
+    ~PointsOctree();
+
+    PointsOctree(const PointsOctree&) = delete;
+    PointsOctree(PointsOctree&&) = delete;
+    PointsOctree& operator=(const PointsOctree&) = delete;
+    PointsOctree& operator=(PointsOctree&&) = delete;
+
+    /** @name Data access */
+    //@{
+    /// The number of sorted, i.e. valid, points.
+    std::size_t size() const
+    {
+        return numPoints;
+    }
+    /// The sorted points.
+    const Base::Vector3f* points() const
+    {
+        return pointData;
+    }
+    /// The index in the kernel of every sorted point.
+    const Index* indices() const
+    {
+        return indexData;
+    }
+    const std::vector<Node>& nodes() const
+    {
+        return nodeList;
+    }
+    unsigned int depth() const
+    {
+        return maxLevel;
+    }
+    //@}
+
+    /** @name Out-of-core storage */
+    //@{
+    /**
+     * Writes the sorted points to @p fileName, maps the file into memory and releases the
+     * in-memory copy. The file is removed again when the octree is destroyed. Returns false and
+     * keeps the points in memory if the file cannot be written or mapped.
+     */
+    bool spill(const std::string& fileName);
+    bool isSpilled() const;
+    //@}
+
+    /** @name Level of detail */
+    //@{
+    /**
+     * Selects the points to render for @p view. Nodes outside of the visible volume are skipped
+     * and nodes are refined until the projected point spacing drops below @p maxError pixels or
+     * @p budget points are selected.
+     */
+    std::vector<Range> select(const View& view, float maxError, std::size_t budget) const;
+    /**
+     * Selects a view independent subset of the points whose spacing is about @p spacing, or of
+     * at most @p budget points.
+     */
+    std::vector<Range> select(float spacing, std::size_t budget) const;
+    /// Selects the representation of all nodes at @p level and of the leaves above it.
+    std::vector<Range> selectLevel(unsigned int level) const;
+
+    /// The number of points in @p ranges.
+    static std::size_t count(const std::vector<Range>& ranges);
+    /// Appends the points of @p ranges and optionally their indices in the kernel.
+    void getPoints(
+        const std::vector<Range>& ranges,
+        std::vector<Base::Vector3f>& pts,
+        std::vector<std::size_t>* idx = nullptr
+    ) const;
+    /// Returns a kernel with the points of @p ranges, transformed like the source kernel.
+    PointKernel getKernel(const std::vector<Range>& ranges) const;
+    //@}
+
+private:
+    void buildNodes(const Base::Vector3f& min, float scale, unsigned int levels);
+    Range representation(const Node& node) const;
+    template<typename ErrorFunc>
+    std::vector<Range> refine(ErrorFunc&& error, float maxError, std::size_t budget) const;
+
+    Base::Matrix4D transform;
+    std::size_t maxLeafSize;
+    std::size_t numPoints = 0;
+    unsigned int maxLevel = 0;
+    std::vector<Node> nodeList;
+    std::vector<Base::Vector3f> sortedPoints;
+    std::vector<Index> sortedIndices;
+    const Base::Vector3f* pointData = nullptr;
+    const Index* indexData = nullptr;
+    std::unique_ptr<QFile> cacheFile;
+};
+
+}  // namespace Points
@@ -31,6 +31,7 @@
 #include <Base/VectorPy.h>
 
 #include "Points.h"
+#include "PointsOctree.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
 #include "PointsPy.cpp"
@@ -244,6 +245,19 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::fromLevelOfDetail(PyObject* args) const
+{
+    unsigned long maxPoints {};
+    float spacing = 0.0F;
+    if (!PyArg_ParseTuple(args, "k|f", &maxPoints, &spacing)) {
+        return nullptr;
+    }
+
+    PointsOctree octree(*getPointKernelPtr());
+    auto ranges = octree.select(spacing, maxPoints);
+    return new PointsPy(new PointKernel(octree.getKernel(ranges)));
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 
 
 #include <Base/Matrix.h>
@@ -40,46 +41,64 @@ using namespace Points;
 TYPESYSTEM_SOURCE(Points::PropertyPointKernel, App::PropertyComplexGeoData)
 
 PropertyPointKernel::PropertyPointKernel()
-    : _cPoints(new PointKernel())
+    : _cPoints(std::make_shared<Base::Reference<PointKernel>>(new PointKernel()))
 {}
 
+PropertyPointKernel::~PropertyPointKernel()
+{
+    if (pointsPyObject) {
+        // the wrapper keeps its own reference to the points
+        Py_DECREF(pointsPyObject);
+    }
+}
+
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
-    *_cPoints = m;
+    if (&m != getPoints()) {
+        detach(false);
+        *getPoints() = m;
+    }
     hasSetValue();
 }
 
 const PointKernel& PropertyPointKernel::getValue() const
 {
-    return *_cPoints;
+    return *getPoints();
 }
 
 const Data::ComplexGeoData* PropertyPointKernel::getComplexData() const
 {
-    return _cPoints;
+    return getPoints();
 }
 
 void PropertyPointKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
-    _cPoints->setTransform(rclTrf);
+    if (getPoints()->getTransform() != rclTrf) {
+        detach(true);
+        getPoints()->setTransform(rclTrf);
+    }
 }
 
 Base::Matrix4D PropertyPointKernel::getTransform() const
 {
-    return _cPoints->getTransform();
+    return getPoints()->getTransform();
 }
 
 Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 {
-    return _cPoints->getBoundBox();
+    return getPoints()->getBoundBox();
 }
 
 PyObject* PropertyPointKernel::getPyObject()
 {
-    PointsPy* points = new PointsPy(&*_cPoints);
-    points->setConst();  // set immutable
-    return points;
+    if (!pointsPyObject) {
+        pointsPyObject = new PointsPy(getPoints());
+        pointsPyObject->setConst();  // set immutable
+    }
+
+    Py_INCREF(pointsPyObject);
+    return pointsPyObject;
 }
 
 void PropertyPointKernel::setPyObject(PyObject* value)
@@ -97,7 +116,7 @@ void PropertyPointKernel::setPyObject(PyObject* value)
 
 void PropertyPointKernel::Save(Base::Writer& writer) const
 {
-    _cPoints->Save(writer);
+    getPoints()->Save(writer);
 }
 
 void PropertyPointKernel::Restore(Base::XMLReader& reader)
@@ -115,7 +134,8 @@ void PropertyPointKernel::Restore(Base::XMLReader& reader)
         mtrx.fromString(Matrix);
 
         aboutToSetValue();
-        _cPoints->setTransform(mtrx);
+        detach(true);
+        getPoints()->setTransform(mtrx);
         hasSetValue();
     }
 }
@@ -129,14 +149,16 @@ void PropertyPointKernel::SaveDocFile(Base::Writer& writer) const
 void PropertyPointKernel::RestoreDocFile(Base::Reader& reader)
 {
     aboutToSetValue();
-    _cPoints->RestoreDocFile(reader);
+    detach(false);
+    getPoints()->RestoreDocFile(reader);
     hasSetValue();
 }
 
 App::Property* PropertyPointKernel::Copy() const
 {
+    // the copy references the same points until one of both gets modified
     PropertyPointKernel* prop = new PropertyPointKernel();
-    (*prop->_cPoints) = (*this->_cPoints);
+    prop->resetPoints(_cPoints);
     return prop;
 }
 
@@ -144,19 +166,58 @@ void PropertyPointKernel::Paste(const App::Property& from)
 {
     aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    if (prop._cPoints != _cPoints) {
+        resetPoints(prop._cPoints);
+    }
     hasSetValue();
 }
 
+void PropertyPointKernel::detach(bool keepData)
+{
+    if (_cPoints.use_count() < 2) {
+        return;
+    }
+
+    // the copies get the points while this property keeps its kernel
+    PointKernel* kernel = getPoints();
+    PointKernel* points = nullptr;
+    if (keepData) {
+        points = new PointKernel(*kernel);
+    }
+    else {
+        points = new PointKernel();
+        points->setTransform(kernel->getTransform());
+        points->getBasicPoints().swap(kernel->getBasicPoints());
+    }
+    auto own = std::make_shared<Base::Reference<PointKernel>>(kernel);
+    *_cPoints = points;
+    _cPoints = std::move(own);
+}
+
+void PropertyPointKernel::resetPoints(SharedPointKernel kernel)
+{
+    // the Python wrapper must refer to the new kernel, it holds a reference to it
+    if (pointsPyObject) {
+        PointKernel* newPoints = *kernel;
+        PointKernel* oldPoints = pointsPyObject->getPointKernelPtr();
+        newPoints->ref();
+        pointsPyObject->setTwinPointer(newPoints);
+        oldPoints->unref();
+    }
+
+    _cPoints = std::move(kernel);
+}
+
 unsigned int PropertyPointKernel::getMemSize() const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    return sizeof(Base::Vector3f) * getPoints()->size();
 }
 
 PointKernel* PropertyPointKernel::startEditing()
 {
     aboutToSetValue();
-    return static_cast<PointKernel*>(_cPoints);
+    detach(true);
+    return getPoints();
 }
 
 void PropertyPointKernel::finishEditing()
@@ -170,35 +231,40 @@ void PropertyPointKernel::removeIndices(const std::vector<unsigned long>& uIndic
     std::vector<unsigned long> uSortedInds = uIndices;
     std::sort(uSortedInds.begin(), uSortedInds.end());
 
-    assert(uSortedInds.size() <= _cPoints->size());
-    if (uSortedInds.size() > _cPoints->size()) {
+    assert(uSortedInds.size() <= getPoints()->size());
+    if (uSortedInds.size() > getPoints()->size()) {
         return;
     }
 
-    PointKernel kernel;
-    kernel.setTransform(_cPoints->getTransform());
-    kernel.reserve(_cPoints->size() - uSortedInds.size());
+    // the remaining points replace the current ones instead of being copied into them
+    std::vector<PointKernel::value_type> remaining;
+    remaining.reserve(getPoints()->size() - uSortedInds.size());
 
     std::vector<unsigned long>::iterator pos = uSortedInds.begin();
     unsigned long index = 0;
-    for (PointKernel::const_iterator it = _cPoints->begin(); it != _cPoints->end(); ++it, ++index) {
+    const std::vector<PointKernel::value_type>& points = getPoints()->getBasicPoints();
+    for (auto it = points.begin(); it != points.end(); ++it, ++index) {
         if (pos == uSortedInds.end()) {
-            kernel.push_back(*it);
+            remaining.push_back(*it);
         }
         else if (index != *pos) {
-            kernel.push_back(*it);
+            remaining.push_back(*it);
         }
         else {
             ++pos;
         }
     }
 
-    setValue(kernel);
+    aboutToSetValue();
+    detach(false);
+    getPoints()->getBasicPoints().swap(remaining);
+    hasSetValue();
 }
 
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
     aboutToSetValue();
-    _cPoints->transformGeometry(rclMat);
+    detach(true);
+    getPoints()->transformGeometry(rclMat);
     hasSetValue();
 }
@@ -25,11 +25,15 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Points.h"
 
 namespace Points
 {
 
+class PointsPy;
+
 /** The point kernel property
  */
 class PointsExport PropertyPointKernel: public App::PropertyComplexGeoData
@@ -38,6 +42,12 @@ class PointsExport PropertyPointKernel: public App::PropertyComplexGeoData
 
 public:
     PropertyPointKernel();
+    ~PropertyPointKernel() override;
+
+    PropertyPointKernel(const PropertyPointKernel&) = delete;
+    PropertyPointKernel(PropertyPointKernel&&) = delete;
+    PropertyPointKernel& operator=(const PropertyPointKernel&) = delete;
+    PropertyPointKernel& operator=(PropertyPointKernel&&) = delete;
 
     /** @name Getter/setter */
     //@{
@@ -58,13 +68,19 @@ public:
 
     /** @name Python interface */
     //@{
+    /** Returns an immutable Python wrapper that always refers to the points of
+     * this property. */
     PyObject* getPyObject() override;
     void setPyObject(PyObject* value) override;
     //@}
 
     /** @name Undo/Redo */
     //@{
-    /// returns a new copy of the property (mainly for Undo/Redo and transactions)
+    /** returns a new copy of the property (mainly for Undo/Redo and transactions)
+     * The copy shares the points with this property until one of both gets modified.
+     * When this property gets modified it keeps its point kernel and the copies get
+     * the previous points.
+     */
     App::Property* Copy() const override;
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property& from) override;
@@ -89,7 +105,20 @@ public:
     //@}
 
 private:
-    Base::Reference<PointKernel> _cPoints;
+    using SharedPointKernel = std::shared_ptr<Base::Reference<PointKernel>>;
+    PointKernel* getPoints() const
+    {
+        return *_cPoints;
+    }
+    /// Hands the points over to the copies that still share them, the kernel keeps the points
+    /// or is left empty if keepData is false
+    void detach(bool keepData);
+    void resetPoints(SharedPointKernel kernel);
+
+private:
+    /// The point kernel, shared by this property and its copies
+    SharedPointKernel _cPoints;
+    PointsPy* pointsPyObject {nullptr};
 };
 
 }  // namespace Points
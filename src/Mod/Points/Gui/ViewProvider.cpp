@@ -23,10 +23,20 @@
  ***************************************************************************/
 
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <array>
 #include <limits>
-
+#include <map>
+
+#include <Inventor/SbPlane.h>
+#include <Inventor/SbViewVolume.h>
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/elements/SoGLCacheContextElement.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
+#include <Inventor/elements/SoViewportRegionElement.h>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
+#include <Inventor/nodes/SoCallback.h>
 #include <Inventor/nodes/SoCamera.h>
 #include <Inventor/nodes/SoCoordinate3.h>
 #include <Inventor/nodes/SoDrawStyle.h>
@@ -35,7 +45,9 @@
 #include <Inventor/nodes/SoMaterialBinding.h>
 #include <Inventor/nodes/SoNormal.h>
 #include <Inventor/nodes/SoPointSet.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
 
+#include <App/Application.h>
 #include <App/Document.h>
 #include <Base/Vector3D.h>
 #include <Gui/Application.h>
@@ -43,6 +55,7 @@
 #include <Gui/Selection/SoFCSelection.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
 #include <Mod/Points/App/Properties.h>
 
 #include "ViewProvider.h"
@@ -110,10 +123,29 @@ void ViewProviderPoints::onChanged(const App::Property* prop)
     }
 }
 
+std::size_t ViewProviderPoints::numSourcePoints() const
+{
+    if (lodIndices.empty()) {
+        return pcPointsCoord->point.getNum();
+    }
+    return lodSourceSize;
+}
+
 void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
 {
     const std::vector<Base::Color>& val = pcProperty->getValues();
 
+    if (!lodIndices.empty()) {
+        pcColorMat->diffuseColor.setNum(lodIndices.size());
+        SbColor* col = pcColorMat->diffuseColor.startEditing();
+        for (std::size_t i = 0; i < lodIndices.size(); i++) {
+            const Base::Color& it = val[lodIndices[i]];
+            col[i].setValue(it.r, it.g, it.b);
+        }
+        pcColorMat->diffuseColor.finishEditing();
+        return;
+    }
+
     pcColorMat->diffuseColor.setNum(val.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
@@ -129,6 +161,17 @@ void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* p
 {
     const std::vector<float>& val = pcProperty->getValues();
 
+    if (!lodIndices.empty()) {
+        pcColorMat->diffuseColor.setNum(lodIndices.size());
+        SbColor* col = pcColorMat->diffuseColor.startEditing();
+        for (std::size_t i = 0; i < lodIndices.size(); i++) {
+            float it = val[lodIndices[i]];
+            col[i].setValue(it, it, it);
+        }
+        pcColorMat->diffuseColor.finishEditing();
+        return;
+    }
+
     pcColorMat->diffuseColor.setNum(val.size());
     SbColor* col = pcColorMat->diffuseColor.startEditing();
 
@@ -144,6 +187,17 @@ void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcPrope
 {
     const std::vector<Base::Vector3f>& val = pcProperty->getValues();
 
+    if (!lodIndices.empty()) {
+        pcPointsNormal->vector.setNum(lodIndices.size());
+        SbVec3f* norm = pcPointsNormal->vector.startEditing();
+        for (std::size_t i = 0; i < lodIndices.size(); i++) {
+            const Base::Vector3f& it = val[lodIndices[i]];
+            norm[i].setValue(it.x, it.y, it.z);
+        }
+        pcPointsNormal->vector.finishEditing();
+        return;
+    }
+
     pcPointsNormal->vector.setNum(val.size());
     SbVec3f* norm = pcPointsNormal->vector.startEditing();
 
@@ -157,7 +211,8 @@ void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcPrope
 
 void ViewProviderPoints::setDisplayMode(const char* ModeName)
 {
-    int numPoints = pcPointsCoord->point.getNum();
+    // with level of detail only a subset is rendered, but the properties refer to all points
+    int numPoints = static_cast<int>(numSourcePoints());
 
     if (strcmp("Color", ModeName) == 0) {
         std::map<std::string, App::Property*> Map;
@@ -370,15 +425,36 @@ void ViewProviderPoints::clipPointsCallback(void*, SoEventCallback* n)
 
 PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
+struct ViewProviderScattered::LevelOfDetail
+{
+    std::unique_ptr<Points::PointsOctree> octree;
+    std::vector<Points::PointsOctree::Range> current;
+    std::vector<Points::PointsOctree::Range> pending;
+    // The last view of every GL context. A viewer whose camera didn't move must not request its
+    // subset again after another viewer caused an update, or both would keep redrawing.
+    std::map<uint32_t, std::pair<SbMatrix, SbVec2s>> views;
+    SoOneShotSensor sensor;
+    float maxError {2.0F};
+    std::size_t budget {0};
+};
+
 ViewProviderScattered::ViewProviderScattered()
+    : lod(std::make_unique<LevelOfDetail>())
 {
     pcPoints = new SoPointSet();
     pcPoints->ref();
+
+    pcLodCallback = new SoCallback();
+    pcLodCallback->ref();
+    pcLodCallback->setCallback(levelOfDetailCallback, this);
+    lod->sensor.setFunction(levelOfDetailSensorCB);
+    lod->sensor.setData(this);
 }
 
 ViewProviderScattered::~ViewProviderScattered()
 {
     pcPoints->unref();
+    pcLodCallback->unref();
 }
 
 void ViewProviderScattered::attach(App::DocumentObject* pcObj)
@@ -391,6 +467,7 @@ void ViewProviderScattered::attach(App::DocumentObject* pcObj)
     pcHighlight->subElementName = "Main";
 
     // Highlight for selection
+    pcHighlight->addChild(pcLodCallback);
     pcHighlight->addChild(pcPointsCoord);
     pcHighlight->addChild(pcPoints);
 
@@ -431,8 +508,12 @@ void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
-        ViewProviderPointsBuilder builder;
-        builder.createPoints(prop, pcPointsCoord, pcPoints);
+        const Points::PointKernel& kernel
+            = static_cast<const Points::PropertyPointKernel*>(prop)->getValue();
+        if (!buildLevelOfDetail(kernel)) {
+            ViewProviderPointsBuilder builder;
+            builder.createPoints(prop, pcPointsCoord, pcPoints);
+        }
 
         // The number of points might have changed, so force also a resize of the Inventor internals
         setActiveMode();
@@ -448,6 +529,124 @@ void ViewProviderScattered::updateData(const App::Property* prop)
     }
 }
 
+bool ViewProviderScattered::buildLevelOfDetail(const Points::PointKernel& kernel)
+{
+    if (lod->sensor.isScheduled()) {
+        lod->sensor.unschedule();
+    }
+    lod->octree.reset();
+    lod->current.clear();
+    lod->pending.clear();
+    lod->views.clear();
+    lodIndices.clear();
+    lodSourceSize = 0;
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Points/LevelOfDetail"
+    );
+    if (!hGrp->GetBool("Enabled", true)
+        || kernel.size() < hGrp->GetUnsigned("MinPoints", 2000000)
+        || kernel.size() > Points::PointsOctree::maxSize) {
+        return false;
+    }
+
+    lod->budget = std::max<std::size_t>(hGrp->GetUnsigned("PointBudget", 2000000), 1);
+    lod->maxError = static_cast<float>(hGrp->GetFloat("MaxError", 2.0));
+    lod->octree = std::make_unique<Points::PointsOctree>(kernel);
+    if (kernel.size() >= hGrp->GetUnsigned("SpillPoints", 50000000)) {
+        // if the cache file cannot be created the points simply stay in memory
+        lod->octree->spill(App::Application::getTempFileName("PointsLevelOfDetail"));
+    }
+    lodSourceSize = kernel.size();
+
+    // until the first rendering knows the camera show an evenly distributed subset
+    lod->pending = lod->octree->select(0.0F, lod->budget);
+    applyLevelOfDetail();
+    return true;
+}
+
+void ViewProviderScattered::applyLevelOfDetail()
+{
+    lod->current = lod->pending;
+
+    const Base::Vector3f* points = lod->octree->points();
+    const Points::PointsOctree::Index* indices = lod->octree->indices();
+    std::size_t numPoints = Points::PointsOctree::count(lod->current);
+
+    lodIndices.resize(numPoints);
+    pcPointsCoord->point.setNum(static_cast<int>(numPoints));
+    SbVec3f* vec = pcPointsCoord->point.startEditing();
+
+    std::size_t idx = 0;
+    for (const auto& range : lod->current) {
+        for (std::size_t i = range.begin; i < range.end; i += range.step, idx++) {
+            vec[idx].setValue(points[i].x, points[i].y, points[i].z);
+            lodIndices[idx] = indices[i];
+        }
+    }
+
+    pcPointsCoord->point.finishEditing();
+    pcPoints->numPoints = static_cast<int>(numPoints);
+}
+
+void ViewProviderScattered::levelOfDetailCallback(void* data, SoAction* action)
+{
+    auto self = static_cast<ViewProviderScattered*>(data);
+    LevelOfDetail& lod = *self->lod;
+    if (!lod.octree || !action->isOfType(SoGLRenderAction::getClassTypeId())) {
+        return;
+    }
+
+    // express the view volume in the coordinate system of the points
+    SoState* state = action->getState();
+    SbViewVolume volume = SoViewVolumeElement::get(state);
+    volume.transform(SoModelMatrixElement::get(state).inverse());
+    SbVec2s size = SoViewportRegionElement::get(state).getViewportSizePixels();
+    SbMatrix matrix = volume.getMatrix();
+
+    auto context = static_cast<uint32_t>(SoGLCacheContextElement::get(state));
+    auto it = lod.views.find(context);
+    if (it != lod.views.end() && it->second.first == matrix && it->second.second == size) {
+        return;
+    }
+    lod.views[context] = std::make_pair(matrix, size);
+
+    Points::PointsOctree::View view;
+    SbVec3f eye = volume.getProjectionPoint();
+    view.position.Set(eye[0], eye[1], eye[2]);
+    view.perspective = volume.getProjectionType() == SbViewVolume::PERSPECTIVE;
+    view.pixelScale = static_cast<float>(size[1]) / volume.getHeight();
+    if (view.perspective) {
+        // the height is measured at the near plane
+        view.pixelScale *= volume.getNearDist();
+    }
+
+    std::array<SbPlane, 6> planes;
+    volume.getViewVolumePlanes(planes.data());
+    for (const SbPlane& plane : planes) {
+        const SbVec3f& normal = plane.getNormal();
+        view.planes.push_back(
+            {Base::Vector3f(normal[0], normal[1], normal[2]), plane.getDistanceFromOrigin()}
+        );
+    }
+
+    // the scene graph must not be changed while it is traversed
+    lod.pending = lod.octree->select(view, lod.maxError, lod.budget);
+    if (lod.pending != lod.current && !lod.sensor.isScheduled()) {
+        lod.sensor.schedule();
+    }
+}
+
+void ViewProviderScattered::levelOfDetailSensorCB(void* data, SoSensor* /*sensor*/)
+{
+    auto self = static_cast<ViewProviderScattered*>(data);
+    if (self->lod->octree && self->lod->pending != self->lod->current) {
+        self->applyLevelOfDetail();
+        // update the per vertex colors and normals
+        self->setActiveMode();
+    }
+}
+
 void ViewProviderScattered::cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer)
 {
     // create the polygon from the picked points
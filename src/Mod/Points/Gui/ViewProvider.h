@@ -24,14 +24,20 @@
 
 #pragma once
 
+#include <memory>
+
 #include <Inventor/SbVec2f.h>
 
 #include <Gui/ViewProviderBuilder.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderFeaturePython.h>
 #include <Mod/Points/PointsGlobal.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 
+class SoAction;
+class SoCallback;
+class SoSensor;
 class SoSwitch;
 class SoPointSet;
 class SoIndexedPointSet;
@@ -113,8 +119,14 @@ protected:
     SoMaterial* pcColorMat;
     SoNormal* pcPointsNormal;
     SoDrawStyle* pcPointStyle;
+    /// The kernel index of every rendered point if only a subset is rendered, otherwise empty
+    std::vector<Points::PointsOctree::Index> lodIndices;
+    /// The number of points in the kernel if only a subset is rendered
+    std::size_t lodSourceSize {0};
 
 private:
+    std::size_t numSourcePoints() const;
+
     static App::PropertyFloatConstraint::Constraints floatRange;
 };
 
@@ -144,6 +156,22 @@ protected:
 
 protected:
     SoPointSet* pcPoints;
+
+private:
+    /** @name Level of detail
+     * Large clouds are sorted into an octree and only the subset that is needed for the current
+     * view is rendered.
+     */
+    //@{
+    bool buildLevelOfDetail(const Points::PointKernel& kernel);
+    void applyLevelOfDetail();
+    static void levelOfDetailCallback(void* data, SoAction* action);
+    static void levelOfDetailSensorCB(void* data, SoSensor* sensor);
+
+    struct LevelOfDetail;
+    std::unique_ptr<LevelOfDetail> lod;
+    SoCallback* pcLodCallback;
+    //@}
 };
 
 /**
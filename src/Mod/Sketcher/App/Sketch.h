@@ -701,6 +701,10 @@ public:
     {
         GCSsys.autoChooseAlgorithm = val;
     }
+    inline void setIncrementalSolve(bool val)
+    {
+        GCSsys.incremental = val;
+    }
     inline void setMaxIter(int maxiter)
     {
         GCSsys.maxIter = maxiter;
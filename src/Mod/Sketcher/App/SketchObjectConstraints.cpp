@@ -89,6 +89,12 @@ int SketchObject::solve(bool updateGeoAfterSolving /*=true*/)
     // We should have an updated Sketcher (sketchobject) geometry or this solve() should not have
     // happened therefore we update our sketch solver geometry with the SketchObject one.
     //
+    // Reuse the diagnosis of an unchanged constraint topology and skip the parts of the sketch
+    // that are already solved
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Sketcher/SolverAdvanced");
+    solvedSketch.setIncrementalSolve(hGrp->GetBool("IncrementalSolve", false));
+
     // set up a sketch (including dofs counting and diagnosing of conflicts)
     lastDoF = solvedSketch.setUpSketch(
         getCompleteGeometry(), Constraints.getValues(), getExternalGeometryCount());
@@ -98,6 +98,7 @@
 #endif
 
 #include <Base/Console.h>
+#include <Base/Profiler.h>
 #include <FCConfig.h>
 
 #include <boost/graph/connected_components.hpp>
@@ -503,6 +504,7 @@ System::System()
     , DL_tolgRedundant(1E-80)
     , DL_tolxRedundant(1E-80)
     , DL_tolfRedundant(1E-10)
+    , incremental(false)
 {
     // currently Eigen only supports multithreading for multiplications
     // There is no appreciable gain from using more threads
@@ -1737,6 +1739,8 @@ void System::declareDrivenParams(VEC_pD& params)
 
 void System::initSolution(Algorithm alg)
 {
+    ZoneScoped;
+
     // - Stores the current parameters values in the vector "reference"
     // - identifies any decoupled subsystems and partitions the original
     //   system into corresponding components
@@ -1853,6 +1857,15 @@ void System::initSolution(Algorithm alg)
 
     // calculates subSystems and subSystemsAux from clists, plists and reductionmaps
     clearSubSystems();
+
+    if (incremental) {
+        componentConstraints.resize(componentsSize);
+        i = plist.size();
+        for (const auto& constr : clistR) {
+            componentConstraints[components[i]].push_back(constr);
+            ++i;
+        }
+    }
     subSystems.resize(clists.size(), nullptr);
     subSystemsAux.resize(clists.size(), nullptr);
     for (std::size_t cid = 0; cid < clists.size(); ++cid) {
@@ -1904,6 +1917,9 @@ int System::solve(VEC_pD& params, bool isFine, Algorithm alg, bool isRedundantso
 
 int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
 {
+    ZoneScoped;
+    ZoneValue(subSystems.size());
+
     if (!isInit) {
         return Failed;
     }
@@ -1917,6 +1933,11 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
             resetToReference();
             isReset = true;
         }
+        if (incremental && isComponentSatisfied(cid, isRedundantsolving)) {
+            // not affected by the last change, e.g. a datum edit elsewhere
+            ++skippedComponents;
+            continue;
+        }
         if (subSystems[cid] && subSystemsAux[cid]) {
             res = std::max(res, solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
         }
@@ -1962,6 +1983,8 @@ int System::solve(SubSystem* subsys, bool isFine, Algorithm alg, bool isRedundan
 
 int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolving)
 {
+    ZoneScoped;
+
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
 #endif
@@ -2089,6 +2112,8 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
 
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 {
+    ZoneScoped;
+
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
 #endif
@@ -2268,6 +2293,8 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
 int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 {
+    ZoneScoped;
+
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
     extractSubsystem(subsys, isRedundantsolving);
 #endif
@@ -4530,6 +4557,8 @@ void System::extractSubsystem(SubSystem* subsys, bool isRedundantsolving)
 // treating the first of them as of higher priority than the second
 int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool isRedundantsolving)
 {
+    ZoneScoped;
+
     int xsizeA = subsysA->pSize();
     int xsizeB = subsysB->pSize();
     int csizeA = subsysA->cSize();
@@ -4773,6 +4802,8 @@ void System::makeReducedJacobian(
 
 int System::diagnose(Algorithm alg)
 {
+    ZoneScoped;
+
     // Analyses the constrainess grad of the system and provides feedback
     // The vector "conflictingTags" will hold a group of conflicting constraints
 
@@ -4815,6 +4846,17 @@ int System::diagnose(Algorithm alg)
     redundantTags.clear();
     partiallyRedundantTags.clear();
 
+    std::vector<int> topology;
+    std::vector<double> values;
+    if (incremental) {
+        topology = diagnosisTopology();
+        values = diagnosisValues();
+        if (restoreDiagnosis(topology, values)) {
+            ++diagnosisCacheHits;
+            return dofs;
+        }
+    }
+
     // This QR diagnosis uses a reduced Jacobian matrix to calculate the rank of the system
     // and identify conflicting and redundant constraints.
     //
@@ -4910,6 +4952,9 @@ int System::diagnose(Algorithm alg)
 #endif
 
     if (J.rows() == 0) {
+        if (incremental) {
+            storeDiagnosis(std::move(topology), std::move(values));
+        }
         return dofs;
     }
 
@@ -5071,9 +5116,154 @@ int System::diagnose(Algorithm alg)
     }
 #endif
 
+    if (incremental) {
+        storeDiagnosis(std::move(topology), std::move(values));
+    }
     return dofs;
 }
 
+std::vector<int> System::diagnosisTopology() const
+{
+    // Everything makeReducedJacobian() depends on apart from the parameter values: the unknowns,
+    // which of them are driven and which unknowns each driving constraint depends on.
+    std::vector<int> topology;
+    topology.push_back(static_cast<int>(plist.size()));
+    topology.push_back(autoChooseAlgorithm ? autoQRThreshold : -1 - int(qrAlgorithm));
+    topology.push_back(static_cast<int>(pdrivenlist.size()));
+    for (const auto param : pdrivenlist) {
+        auto it = pIndex.find(param);
+        topology.push_back(it != pIndex.end() ? it->second : -1);
+    }
+    for (const auto constr : clist) {
+        if (constr->getTag() < 0 || !constr->isDriving()) {
+            continue;
+        }
+        const VEC_pD& params = c2p.at(constr);
+        topology.push_back(static_cast<int>(constr->getTypeId()));
+        topology.push_back(constr->getTag());
+        topology.push_back(static_cast<int>(params.size()));
+        for (const auto param : params) {
+            auto it = pIndex.find(param);
+            topology.push_back(it != pIndex.end() ? it->second : -1);
+        }
+    }
+    return topology;
+}
+
+std::vector<double> System::diagnosisValues() const
+{
+    // A configuration that is singular for the current values, e.g. two tangent curves that
+    // touch in their end points, can have a different rank than the same topology elsewhere.
+    // The constraint errors cover values the constraints keep outside of the parameters.
+    std::vector<double> values;
+    values.reserve(plist.size() + pdrivenlist.size());
+    for (const auto param : plist) {
+        values.push_back(*param);
+    }
+    for (const auto param : pdrivenlist) {
+        values.push_back(*param);
+    }
+    for (const auto constr : clist) {
+        if (constr->getTag() < 0 || !constr->isDriving()) {
+            continue;
+        }
+        values.push_back(constr->error());
+    }
+    return values;
+}
+
+bool System::restoreDiagnosis(const std::vector<int>& topology, const std::vector<double>& values)
+{
+    auto it = std::ranges::find_if(diagnosisCache, [&](const DiagnosisCacheEntry& entry) {
+        return entry.topology == topology && entry.values == values
+            && entry.qrpivotThreshold == qrpivotThreshold;
+    });
+    if (it == diagnosisCache.end()) {
+        return false;
+    }
+    diagnosisCache.splice(diagnosisCache.begin(), diagnosisCache, it);
+
+    const DiagnosisCacheEntry& entry = diagnosisCache.front();
+    dofs = entry.dofs;
+    emptyDiagnoseMatrix = entry.emptyDiagnoseMatrix;
+    qrAlgorithm = entry.qrAlgorithm;
+    pDependentParameters.clear();
+    for (int index : entry.dependentParameters) {
+        pDependentParameters.push_back(plist[index]);
+    }
+    pDependentParametersGroups.clear();
+    for (const auto& group : entry.dependentParametersGroups) {
+        auto& params = pDependentParametersGroups.emplace_back();
+        for (int index : group) {
+            params.push_back(plist[index]);
+        }
+    }
+    hasDiagnosis = true;
+    return true;
+}
+
+void System::storeDiagnosis(std::vector<int>&& topology, std::vector<double>&& values)
+{
+    // With conflicting or redundant constraints the diagnosis also moved the parameters while
+    // solving the reduced systems. Such results depend too much on the parameter values.
+    if (!redundant.empty() || !conflictingTags.empty() || !redundantTags.empty()
+        || !partiallyRedundantTags.empty()) {
+        return;
+    }
+
+    auto toIndices = [this](const VEC_pD& params, VEC_I& indices) {
+        for (const auto param : params) {
+            auto it = pIndex.find(param);
+            if (it == pIndex.end()) {
+                return false;
+            }
+            indices.push_back(it->second);
+        }
+        return true;
+    };
+
+    DiagnosisCacheEntry entry;
+    entry.topology = std::move(topology);
+    entry.values = std::move(values);
+    entry.qrpivotThreshold = qrpivotThreshold;
+    entry.dofs = dofs;
+    entry.emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    entry.qrAlgorithm = qrAlgorithm;
+    if (!toIndices(pDependentParameters, entry.dependentParameters)) {
+        return;
+    }
+    for (const auto& group : pDependentParametersGroups) {
+        if (!toIndices(group, entry.dependentParametersGroups.emplace_back())) {
+            return;
+        }
+    }
+
+    // A few entries are enough to cover the repeated diagnoses of the block constraint handling
+    constexpr std::size_t maxEntries = 4;
+    diagnosisCache.push_front(std::move(entry));
+    if (diagnosisCache.size() > maxEntries) {
+        diagnosisCache.pop_back();
+    }
+}
+
+bool System::isComponentSatisfied(std::size_t cid, bool isRedundantsolving) const
+{
+    if (cid >= componentConstraints.size()) {
+        return false;
+    }
+    // Strict enough that none of the solvers would have changed the parameters
+    double tolf = isRedundantsolving ? DL_tolfRedundant : DL_tolf;
+    double err = 0.;
+    for (const auto constr : componentConstraints[cid]) {
+        double tmp = constr->error();
+        if (std::abs(tmp) > tolf) {
+            return false;
+        }
+        err += tmp * tmp;
+    }
+    return 0.5 * err <= smallF;
+}
+
 void System::makeDenseQRDecomposition(
     const Eigen::MatrixXd& J,
     const std::map<int, int>& jacobianconstraintmap,
@@ -5713,6 +5903,7 @@ void System::clearSubSystems()
     deleteAllContent(subSystemsAux);
     subSystems.clear();
     subSystemsAux.clear();
+    componentConstraints.clear();
 }
 
 double lineSearch(SubSystem* subsys, Eigen::VectorXd& xdir)
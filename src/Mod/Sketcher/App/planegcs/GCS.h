@@ -24,6 +24,9 @@
 
 #pragma once
 
+#include <list>
+#include <vector>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -134,6 +137,10 @@ private:
     // partitioned clist except equality constraints
     std::vector<std::vector<Constraint*>> clists;
     std::vector<MAP_pD_pD> reductionmaps;  // for simplification of equality constraints
+    // partitioned clist including equality constraints, i.e. all constraints whose errors have
+    // to vanish for a component to be solved
+    std::vector<std::vector<Constraint*>> componentConstraints;
+    bool isComponentSatisfied(std::size_t cid, bool isRedundantsolving) const;
 
     int dofs;
     std::set<Constraint*> redundant;
@@ -145,6 +152,32 @@ private:
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    // Result of a diagnosis that found neither conflicting nor redundant constraints. Parameters
+    // are stored as indices into plist so that the result can be applied to a rebuilt system.
+    // The rank of the Jacobian depends on the parameter values, so they are part of the key.
+    struct DiagnosisCacheEntry
+    {
+        std::vector<int> topology;
+        std::vector<double> values;
+        double qrpivotThreshold;
+        int dofs;
+        bool emptyDiagnoseMatrix;
+        QRAlgorithm qrAlgorithm;
+        VEC_I dependentParameters;
+        std::vector<VEC_I> dependentParametersGroups;
+    };
+    // most recently used first
+    std::list<DiagnosisCacheEntry> diagnosisCache;
+    // Describes the sparsity pattern of the reduced Jacobian used by diagnose()
+    std::vector<int> diagnosisTopology() const;
+    // Parameter values and constraint errors the reduced Jacobian is evaluated at
+    std::vector<double> diagnosisValues() const;
+    bool restoreDiagnosis(const std::vector<int>& topology, const std::vector<double>& values);
+    void storeDiagnosis(std::vector<int>&& topology, std::vector<double>&& values);
+    // statistics of the incremental mode
+    std::size_t diagnosisCacheHits = 0;
+    std::size_t skippedComponents = 0;
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
@@ -256,6 +289,10 @@ public:
     double DL_tolgRedundant;
     double DL_tolxRedundant;
     double DL_tolfRedundant;
+    // If true, the diagnosis of a system is reused when the system is rebuilt with the same
+    // constraint graph and parameter values, and components whose constraints are already
+    // satisfied are not solved.
+    bool incremental;
 
 public:
     System();
@@ -688,6 +725,14 @@ protected:
             return constraint->getTag() == tagID;
         });
     }
+    size_t _getDiagnosisCacheHits() const
+    {
+        return diagnosisCacheHits;
+    }
+    size_t _getSkippedComponents() const
+    {
+        return skippedComponents;
+    }
 };
 
 
@@ -19,6 +19,8 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <future>
 #include <thread>
@@ -29,10 +31,29 @@
 #include "App/Application.h"
 #include "App/Document.h"
 #include "App/FeatureTest.h"
+#include "App/MainThreadSignal.h"
 #include <src/App/InitApplication.h>
 
 using namespace std::chrono_literals;
 
+namespace
+{
+std::thread::id mainThreadId;
+std::atomic<int> offMainInvokes {0};
+
+bool isTestMainThread()
+{
+    return std::this_thread::get_id() == mainThreadId;
+}
+
+void invokeInline(std::function<void()>&& fn, bool /*blocking*/)
+{
+    // a real GUI would block here until the main thread is idle
+    ++offMainInvokes;
+    fn();
+}
+}  // namespace
+
 class AsyncRecomputeTest: public ::testing::Test
 {
 protected:
@@ -117,3 +138,152 @@ TEST_F(AsyncRecomputeTest, WorkerSafetyIsCheckedFromRequest)
         App::GetApplication().canRecomputeRequestOnWorker(App::RecomputeRequest::fromDocument(*_doc))
     );
 }
+
+class ParallelRecomputeTest: public AsyncRecomputeTest
+{
+protected:
+    void SetUp() override
+    {
+        AsyncRecomputeTest::SetUp();
+        _hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document"
+        );
+        _hGrp->SetBool("EnableParallelRecompute", true);
+        _hGrp->SetInt("ParallelRecomputeThreads", 2);
+    }
+
+    void TearDown() override
+    {
+        _hGrp->RemoveBool("EnableParallelRecompute");
+        _hGrp->RemoveInt("ParallelRecomputeThreads");
+        AsyncRecomputeTest::TearDown();
+    }
+
+    App::FeatureTestConcurrent* addConcurrent(const char* name, App::DocumentObject* source = nullptr)
+    {
+        auto* object = dynamic_cast<App::FeatureTestConcurrent*>(
+            _doc->addObject("App::FeatureTestConcurrent", name)
+        );
+        object->Source.setValue(source);
+        return object;
+    }
+
+    ParameterGrp::handle _hGrp;
+};
+
+TEST_F(ParallelRecomputeTest, IndependentObjectsRunConcurrently)
+{
+    auto* first = addConcurrent("First");
+    auto* second = addConcurrent("Second");
+
+    App::FeatureTestConcurrent::resetConcurrency(2);
+    EXPECT_EQ(_doc->recompute(), 2);
+
+    EXPECT_EQ(App::FeatureTestConcurrent::maxConcurrency(), 2);
+    EXPECT_EQ(first->Value.getValue(), 1);
+    EXPECT_EQ(second->Value.getValue(), 1);
+    EXPECT_FALSE(first->isTouched());
+    EXPECT_FALSE(second->isTouched());
+}
+
+TEST_F(ParallelRecomputeTest, DependentObjectsKeepTopologicalOrder)
+{
+    auto* first = addConcurrent("First");
+    auto* second = addConcurrent("Second", first);
+    auto* third = addConcurrent("Third", second);
+    auto* other = addConcurrent("Other");
+
+    std::vector<std::string> recomputed;
+    auto connection = _doc->signalRecomputedObject.connect([&](const App::DocumentObject& obj) {
+        recomputed.emplace_back(obj.getNameInDocument());
+    });
+
+    App::FeatureTestConcurrent::resetConcurrency(0);
+    EXPECT_EQ(_doc->recompute(), 4);
+    connection.disconnect();
+
+    EXPECT_EQ(first->Value.getValue(), 1);
+    EXPECT_EQ(second->Value.getValue(), 2);
+    EXPECT_EQ(third->Value.getValue(), 3);
+    EXPECT_EQ(other->Value.getValue(), 1);
+
+    auto position = [&recomputed](const char* name) {
+        return std::find(recomputed.begin(), recomputed.end(), name) - recomputed.begin();
+    };
+    ASSERT_EQ(recomputed.size(), 4);
+    EXPECT_LT(position("First"), position("Second"));
+    EXPECT_LT(position("Second"), position("Third"));
+}
+
+TEST_F(ParallelRecomputeTest, AbortFinishesPrecomputedObjects)
+{
+    auto* first = addConcurrent("First");
+    auto* second = addConcurrent("Second");
+    auto* third = addConcurrent("Third", second);
+    // the object that comes first in the recompute order aborts
+    auto* aborting = first;
+    auto* other = second;
+    auto order = App::Document::getDependencyList(_doc->getObjects(), App::Document::DepSort);
+    auto position = [&order](App::DocumentObject* obj) {
+        return std::find(order.begin(), order.end(), obj) - order.begin();
+    };
+    if (position(second) < position(first)) {
+        std::swap(aborting, other);
+    }
+    aborting->Abort.setValue(true);
+
+    std::vector<std::string> recomputed;
+    auto connection = _doc->signalRecomputedObject.connect([&](const App::DocumentObject& obj) {
+        recomputed.emplace_back(obj.getNameInDocument());
+    });
+
+    // the other object is executed together with the aborting one, ahead of the
+    // serial loop, which stops at the aborting object
+    App::FeatureTestConcurrent::resetConcurrency(2);
+    bool hasError = false;
+    _doc->recompute({}, false, &hasError);
+    connection.disconnect();
+
+    EXPECT_TRUE(hasError);
+    EXPECT_TRUE(aborting->isTouched());
+    EXPECT_EQ(other->Value.getValue(), 1);
+    EXPECT_FALSE(other->isTouched());
+    EXPECT_EQ(recomputed, std::vector<std::string> {other->getNameInDocument()});
+    EXPECT_EQ(third->Value.getValue(), 0);
+    EXPECT_TRUE(third->isTouched());
+}
+
+TEST_F(ParallelRecomputeTest, EmitsRunOnRecomputingThread)
+{
+    auto* first = addConcurrent("First");
+    auto* second = addConcurrent("Second");
+
+    mainThreadId = std::this_thread::get_id();
+    offMainInvokes = 0;
+    App::MainThreadSignalConfig::setHooks(&isTestMainThread, &invokeInline);
+    BOOST_SCOPE_EXIT_ALL(&)
+    {
+        App::MainThreadSignalConfig::setHooks(nullptr, nullptr);
+    };
+
+    std::vector<std::thread::id> emitters;
+    auto connection = _doc->signalChangedObject.connect(
+        [&](const App::DocumentObject&, const App::Property&) {
+            emitters.push_back(std::this_thread::get_id());
+        }
+    );
+
+    App::FeatureTestConcurrent::resetConcurrency(2);
+    EXPECT_EQ(_doc->recompute(), 2);
+    connection.disconnect();
+
+    EXPECT_EQ(App::FeatureTestConcurrent::maxConcurrency(), 2);
+    EXPECT_EQ(first->Value.getValue(), 1);
+    EXPECT_EQ(second->Value.getValue(), 1);
+    // the pool threads hand their emits to the waiting main thread
+    EXPECT_EQ(offMainInvokes, 0);
+    EXPECT_FALSE(emitters.empty());
+    EXPECT_TRUE(std::all_of(emitters.begin(), emitters.end(), [](std::thread::id id) {
+        return id == mainThreadId;
+    }));
+}
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <Base/MemoryStatistics.h>
+
+#include <cstring>
+#include <memory>
+
+using Base::MemoryStatistics;
+
+TEST(MemoryStatisticsTest, peakIsAtLeastResidentSize)
+{
+#if !defined(_WIN32) && !defined(__APPLE__) && !defined(__linux__)
+    GTEST_SKIP() << "Resident set size is not supported on this platform.";
+#endif
+
+    std::size_t resident = MemoryStatistics::residentSize();
+    EXPECT_GT(resident, 0);
+    EXPECT_GE(MemoryStatistics::peakResidentSize(), resident);
+}
+
+TEST(MemoryStatisticsTest, peakGrowsWithTouchedMemory)
+{
+#if !defined(__linux__)
+    GTEST_SKIP() << "Resetting the peak resident set size is only supported on Linux.";
+#endif
+
+    if (!MemoryStatistics::resetPeakResidentSize()) {
+        GTEST_SKIP() << "Kernel does not support resetting the peak resident set size.";
+    }
+    std::size_t before = MemoryStatistics::peakResidentSize();
+
+    const std::size_t size = 64 * 1024 * 1024;
+    auto buffer = std::make_unique<char[]>(size);
+    std::memset(buffer.get(), 1, size);
+
+    EXPECT_GE(MemoryStatistics::peakResidentSize(), before + size / 2);
+}
+
+TEST(MemoryStatisticsTest, allocationsAreNotCountedByDefault)
+{
+    // Only FreeCADCmd built with FREECAD_COUNT_ALLOCATIONS counts allocations
+    EXPECT_FALSE(MemoryStatistics::isCountingAllocations());
+    EXPECT_EQ(MemoryStatistics::allocationCount(), 0);
+}
@@ -2,9 +2,16 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <memory>
+#include <sstream>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
+#include <zipios++/zipfile.h>
+
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
 // which is derived from it
 
@@ -129,3 +136,122 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+namespace
+{
+
+class FileContent: public Base::Persistence
+{
+public:
+    explicit FileContent(std::string data)
+        : data {std::move(data)}
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(data.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << data;
+    }
+
+    std::string data;
+};
+
+std::string readEntry(const std::string& archive, const std::string& name)
+{
+    zipios::ZipFile zip(archive);
+    std::unique_ptr<std::istream> str(zip.getInputStream(name));
+    if (!str) {
+        return {};
+    }
+    std::stringstream content;
+    content << str->rdbuf();
+    return content.str();
+}
+
+}  // namespace
+
+class ZipWriterTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto dir = std::filesystem::temp_directory_path();
+        _first = (dir / "ZipWriterTest_first.zip").string();
+        _second = (dir / "ZipWriterTest_second.zip").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(_first);
+        std::filesystem::remove(_second);
+    }
+
+    Base::ZipWriter::EntryIndex write(
+        const std::string& fileName,
+        const std::vector<const FileContent*>& files,
+        const Base::ZipWriter::EntryIndex* previous = nullptr
+    )
+    {
+        Base::ZipWriter writer(fileName.c_str());
+        writer.setLevel(7);
+        writer.setParallelCompression(4);
+        if (previous) {
+            writer.setPreviousArchive(_first, *previous);
+        }
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        int index = 0;
+        for (auto file : files) {
+            writer.addFile(("File" + std::to_string(index++)).c_str(), file);
+        }
+        writer.writeFiles();
+        return writer.getEntryIndex();
+    }
+
+    std::string _first;
+    std::string _second;
+};
+
+TEST_F(ZipWriterTest, parallelCompression)
+{
+    // Arrange
+    FileContent large {std::string(100000, 'a') + "b"};
+    FileContent small {"small"};
+    FileContent empty {""};
+
+    // Act
+    auto index = write(_first, {&large, &small, &empty});
+
+    // Assert
+    EXPECT_EQ(readEntry(_first, "Document.xml"), "<Document/>");
+    EXPECT_EQ(readEntry(_first, "File0"), large.data);
+    EXPECT_EQ(readEntry(_first, "File1"), small.data);
+    EXPECT_EQ(readEntry(_first, "File2"), empty.data);
+    ASSERT_EQ(index.size(), 3);
+    EXPECT_EQ(index["File0"].size, large.data.size());
+    EXPECT_LT(index["File0"].compressedSize, index["File0"].size);
+}
+
+TEST_F(ZipWriterTest, reuseUnchangedFiles)
+{
+    // Arrange
+    FileContent unchanged {std::string(100000, 'a') + "b"};
+    FileContent changed {"before"};
+    auto previous = write(_first, {&unchanged, &changed});
+    changed.data = "after";
+
+    // Act
+    auto index = write(_second, {&unchanged, &changed}, &previous);
+
+    // Assert
+    EXPECT_EQ(readEntry(_second, "File0"), unchanged.data);
+    EXPECT_EQ(readEntry(_second, "File1"), changed.data);
+    EXPECT_EQ(index["File0"].compressedSize, previous["File0"].compressedSize);
+    EXPECT_NE(index["File1"].crc, previous["File1"].crc);
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <BRepBndLib.hxx>
+#include <BRepGProp.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <Bnd_Box.hxx>
+#include <GProp_GProps.hxx>
+#include <TopExp_Explorer.hxx>
+#include <gp_Ax2.hxx>
+
+#include <src/App/InitApplication.h>
+#include <Mod/CAM/App/Area.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class AreaTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    // a 20 x 20 x 10 block with a round pocket and a dome on top, so that
+    // the sections differ with the height
+    static std::unique_ptr<Path::Area> makeArea(long threads)
+    {
+        Path::AreaParams params;
+        params.SectionThreads = threads;
+        auto area = std::make_unique<Path::Area>(&params);
+        area->add(BRepPrimAPI_MakeBox(20.0, 20.0, 10.0).Shape(), Path::Area::OperationUnion);
+        area->add(
+            BRepPrimAPI_MakeSphere(gp_Pnt(14, 14, 8), 4.0).Shape(),
+            Path::Area::OperationUnion
+        );
+        area->add(
+            BRepPrimAPI_MakeCylinder(gp_Ax2(gp_Pnt(6, 6, 4), gp_Dir(0, 0, 1)), 3.0, 10.0).Shape(),
+            Path::Area::OperationDifference
+        );
+        return area;
+    }
+
+    static std::vector<double> heights()
+    {
+        std::vector<double> heights;
+        // not at the top of the block, where the section would be tangential
+        for (double z = 0.75; z < 12.0; z += 0.75) {
+            heights.push_back(z);
+        }
+        return heights;
+    }
+
+    // the sections are computed independently, so they must be identical
+    static void expectSameShape(const TopoDS_Shape& shape1, const TopoDS_Shape& shape2)
+    {
+        ASSERT_EQ(shape1.IsNull(), shape2.IsNull());
+        if (shape1.IsNull()) {
+            return;
+        }
+
+        int edges1 = 0;
+        for (TopExp_Explorer xp(shape1, TopAbs_EDGE); xp.More(); xp.Next()) {
+            edges1++;
+        }
+        int edges2 = 0;
+        for (TopExp_Explorer xp(shape2, TopAbs_EDGE); xp.More(); xp.Next()) {
+            edges2++;
+        }
+        EXPECT_EQ(edges1, edges2);
+
+        GProp_GProps props1;
+        GProp_GProps props2;
+        BRepGProp::LinearProperties(shape1, props1);
+        BRepGProp::LinearProperties(shape2, props2);
+        EXPECT_DOUBLE_EQ(props1.Mass(), props2.Mass());
+
+        Bnd_Box box1;
+        Bnd_Box box2;
+        BRepBndLib::Add(shape1, box1);
+        BRepBndLib::Add(shape2, box2);
+        double xMin1, yMin1, zMin1, xMax1, yMax1, zMax1;
+        double xMin2, yMin2, zMin2, xMax2, yMax2, zMax2;
+        box1.Get(xMin1, yMin1, zMin1, xMax1, yMax1, zMax1);
+        box2.Get(xMin2, yMin2, zMin2, xMax2, yMax2, zMax2);
+        EXPECT_DOUBLE_EQ(xMin1, xMin2);
+        EXPECT_DOUBLE_EQ(yMin1, yMin2);
+        EXPECT_DOUBLE_EQ(zMin1, zMin2);
+        EXPECT_DOUBLE_EQ(xMax1, xMax2);
+        EXPECT_DOUBLE_EQ(yMax1, yMax2);
+        EXPECT_DOUBLE_EQ(zMax1, zMax2);
+    }
+};
+
+TEST_F(AreaTest, sectionThreads)
+{
+    auto area1 = makeArea(1);
+    auto area4 = makeArea(4);
+    for (bool project : {false, true}) {
+        auto sections1 =
+            area1->makeSections(Path::Area::SectionModeAbsolute, project, 1, heights());
+        auto sections4 =
+            area4->makeSections(Path::Area::SectionModeAbsolute, project, 4, heights());
+        ASSERT_EQ(sections1.size(), heights().size());
+        ASSERT_EQ(sections4.size(), sections1.size());
+        for (std::size_t i = 0; i < sections1.size(); i++) {
+            expectSameShape(sections1[i]->getShape(), sections4[i]->getShape());
+            expectSameShape(
+                sections1[i]->makeOffset(-1, -0.5, 2),
+                sections4[i]->makeOffset(-1, -0.5, 2)
+            );
+        }
+    }
+}
+
+TEST_F(AreaTest, sectionThreadsBuild)
+{
+    // all the sections are built, offset and pocketed on the given threads
+    std::vector<std::unique_ptr<Path::Area>> areas;
+    for (long threads : {1, 4}) {
+        auto& area = areas.emplace_back(makeArea(threads));
+        Path::AreaParams params = area->getParams();
+        params.SectionCount = -1;
+        params.Stepdown = 0.5;
+        area->setParams(params);
+    }
+    expectSameShape(areas[0]->getShape(), areas[1]->getShape());
+    expectSameShape(areas[0]->makeOffset(-1, -0.5), areas[1]->makeOffset(-1, -0.5));
+    expectSameShape(
+        areas[0]->makePocket(-1, Path::Area::PocketModeOffset, 1.0),
+        areas[1]->makePocket(-1, Path::Area::PocketModeOffset, 1.0)
+    );
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <numbers>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <gp_Pnt.hxx>
+
+#include <Base/Exception.h>
+#include <src/App/InitApplication.h>
+#include <Mod/CAM/PathSimulator/App/DexelSim.h>
+#include <Mod/CAM/PathSimulator/App/PathSim.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class DexelSimTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static constexpr float toolResolution = 0.02F;
+    static constexpr float resolution = 0.25F;
+
+    static cSimTool flatEndmill(double radius)
+    {
+        return cSimTool(BRepPrimAPI_MakeCylinder(radius, 20.0).Shape(), toolResolution);
+    }
+
+    // only the bottom of the tool is sampled, so a sphere is a ball end mill
+    static cSimTool ballEndmill(double radius)
+    {
+        return cSimTool(
+            BRepPrimAPI_MakeSphere(gp_Pnt(0.0, 0.0, radius), radius).Shape(),
+            toolResolution
+        );
+    }
+
+    // a 20 x 20 x 10 stock
+    static constexpr double stockVolume = 4000.0;
+    static Base::BoundBox3d stockBox()
+    {
+        return Base::BoundBox3d(0.0, 0.0, 0.0, 20.0, 20.0, 10.0);
+    }
+
+    // the removed volume of a move is exact up to the dexels at its border
+    static void expectVolume(const cDexelStock& stock, double volume)
+    {
+        EXPECT_NEAR(stock.GetRemovedVolume(), volume, 0.05 * volume);
+        EXPECT_NEAR(stock.GetVolume(), stockVolume - volume, 0.05 * volume);
+    }
+};
+
+TEST_F(DexelSimTest, invalidStock)
+{
+    EXPECT_THROW(cDexelStock(stockBox(), 0.0F), Base::ValueError);
+    EXPECT_THROW(cDexelStock(stockBox(), -1.0F), Base::ValueError);
+    EXPECT_THROW(cDexelStock(Base::BoundBox3d(), 1.0F), Base::ValueError);
+    Base::BoundBox3d flat(0.0, 0.0, 0.0, 20.0, 20.0, 0.0);
+    EXPECT_THROW(cDexelStock(flat, 1.0F), Base::ValueError);
+    EXPECT_THROW(cDexelStock(stockBox(), 1e-9F), Base::ValueError);
+}
+
+TEST_F(DexelSimTest, straightSlot)
+{
+    cDexelStock stock(stockBox(), resolution);
+    EXPECT_NEAR(stock.GetVolume(), stockVolume, 1e-6);
+
+    // a slot of 6 x 5 through the stock
+    cSimTool tool = flatEndmill(3.0);
+    stock.ApplyLinearTool(Base::Vector3d(-5, 10, 5), 0.0F, Base::Vector3d(25, 10, 5), 0.0F, tool);
+    expectVolume(stock, 20.0 * 6.0 * 5.0);
+    EXPECT_EQ(stock.CountMoves(), 1);
+}
+
+TEST_F(DexelSimTest, ballEndGroove)
+{
+    cDexelStock stock(stockBox(), resolution);
+
+    // the center of the ball runs along the top of the stock
+    cSimTool tool = ballEndmill(3.0);
+    stock.ApplyLinearTool(Base::Vector3d(-5, 10, 7), 0.0F, Base::Vector3d(25, 10, 7), 0.0F, tool);
+    expectVolume(stock, 20.0 * std::numbers::pi * 9.0 / 2.0);
+}
+
+TEST_F(DexelSimTest, arcMoves)
+{
+    Part::TopoShape box(BRepPrimAPI_MakeBox(20.0, 20.0, 10.0).Shape());
+    PathSimulator::PathSim sim;
+    sim.BeginSimulation(&box, resolution, true);
+    sim.SetToolShape(BRepPrimAPI_MakeCylinder(1.0, 20.0).Shape(), toolResolution);
+
+    // a full circle of radius 5 around (10, 10) and 2 deep
+    Base::Placement start(Base::Vector3d(15, 10, 8), Base::Rotation());
+    Path::Command circle("G3", {{"X", 15.0}, {"Y", 10.0}, {"I", -5.0}, {"J", 0.0}});
+    std::unique_ptr<Base::Placement> end(sim.ApplyCommand(&start, &circle));
+    EXPECT_EQ(end->getPosition(), Base::Vector3d(15, 10, 8));
+    double ring = std::numbers::pi * (6.0 * 6.0 - 4.0 * 4.0);
+    EXPECT_NEAR(sim.m_dexelStock->GetRemovedVolume(), ring * 2.0, 0.05 * ring * 2.0);
+
+    // a clockwise half circle back up to the top, K is ignored in the xy plane
+    Path::Command helix(
+        "G2",
+        {{"X", 5.0}, {"Y", 10.0}, {"Z", 10.0}, {"I", -5.0}, {"J", 0.0}, {"K", 3.0}}
+    );
+    end.reset(sim.ApplyCommand(end.get(), &helix));
+    EXPECT_EQ(end->getPosition(), Base::Vector3d(5, 10, 10));
+    EXPECT_EQ(sim.m_dexelStock->CountMoves(), 2);
+    // the helix runs in the ring of the circle
+    EXPECT_NEAR(sim.m_dexelStock->GetRemovedVolume(), ring * 2.0, 0.05 * ring * 2.0);
+}
+
+TEST_F(DexelSimTest, threads)
+{
+    cSimTool flat = flatEndmill(3.0);
+    cSimTool ball = ballEndmill(2.0);
+    auto simulate = [&](int threads, std::vector<MeshCore::MeshGeomFacet>& facets) {
+        auto stock = std::make_unique<cDexelStock>(stockBox(), resolution);
+        stock->SetThreads(threads);
+        stock->ApplyLinearTool(
+            Base::Vector3d(-5, 10, 5),
+            0.0F,
+            Base::Vector3d(25, 3, 6),
+            0.0F,
+            flat
+        );
+        stock->ApplyCircularTool(
+            Base::Vector3d(15, 10, 8),
+            Base::Vector3d(5, 10, 4),
+            Base::Vector3d(10, 10, 8),
+            0.0F,
+            ball,
+            false
+        );
+        // with the stock rotated by the A axis
+        stock->ApplyLinearTool(
+            Base::Vector3d(10, -5, 4),
+            30.0F,
+            Base::Vector3d(10, 25, 4),
+            30.0F,
+            flat
+        );
+        stock->Tessellate(facets);
+        return stock;
+    };
+
+    std::vector<MeshCore::MeshGeomFacet> facets1;
+    std::vector<MeshCore::MeshGeomFacet> facets4;
+    auto stock1 = simulate(1, facets1);
+    auto stock4 = simulate(4, facets4);
+
+    // the same bits, not only about the same volume
+    EXPECT_EQ(stock1->GetRemovedVolume(), stock4->GetRemovedVolume());
+    EXPECT_EQ(stock1->GetVolume(), stock4->GetVolume());
+    ASSERT_EQ(facets1.size(), facets4.size());
+    for (std::size_t i = 0; i < facets1.size(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facets1[i]._aclPoints[j], facets4[i]._aclPoints[j]);
+        }
+    }
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Base/Exception.h>
+#include <src/App/InitApplication.h>
+#include <Mod/CAM/App/GCode.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class GCodeTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    // takes ownership of the commands returned by the parser
+    static std::vector<std::unique_ptr<Path::Command>> own(std::vector<Path::Command*> commands)
+    {
+        std::vector<std::unique_ptr<Path::Command>> result;
+        for (auto* cmd : commands) {
+            result.emplace_back(cmd);
+        }
+        return result;
+    }
+
+    static Path::Command parse(const std::string& gcode)
+    {
+        Path::Command cmd;
+        Path::GCode::parseCommand(gcode, cmd);
+        return cmd;
+    }
+
+    static std::string write(const Path::Command& cmd, int precision = 6, bool padzero = true)
+    {
+        std::string out;
+        Path::GCode::appendCommand(out, cmd, precision, padzero);
+        return out;
+    }
+};
+
+TEST_F(GCodeTest, parseCommand)
+{
+    Path::Command cmd = parse("g1 x1.5 Y-2 z.25 F1200");
+    EXPECT_EQ(cmd.Name, "G1");
+    ASSERT_EQ(cmd.Parameters.size(), 4);
+    EXPECT_DOUBLE_EQ(cmd.Parameters["X"], 1.5);
+    EXPECT_DOUBLE_EQ(cmd.Parameters["Y"], -2.0);
+    EXPECT_DOUBLE_EQ(cmd.Parameters["Z"], 0.25);
+    EXPECT_DOUBLE_EQ(cmd.Parameters["F"], 1200.0);
+
+    cmd = parse("G0X1Y2");
+    EXPECT_EQ(cmd.Name, "G0");
+    EXPECT_DOUBLE_EQ(cmd.Parameters["Y"], 2.0);
+
+    cmd = parse("G1 X3e2");
+    EXPECT_DOUBLE_EQ(cmd.Parameters["X"], 300.0);
+}
+
+TEST_F(GCodeTest, parseComment)
+{
+    Path::Command cmd = parse("(Tool: 5mm Endmill)");
+    EXPECT_EQ(cmd.Name, "(Tool: 5mm Endmill)");
+    EXPECT_TRUE(cmd.Parameters.empty());
+
+    auto commands = own(Path::GCode::parseProgram("(begin)\nG0 X1 (move) G1 X2\n(end)"));
+    ASSERT_EQ(commands.size(), 5);
+    EXPECT_EQ(commands[0]->Name, "(begin)");
+    EXPECT_EQ(commands[1]->Name, "G0");
+    EXPECT_EQ(commands[2]->Name, "(move)");
+    EXPECT_EQ(commands[3]->Name, "G1");
+    EXPECT_DOUBLE_EQ(commands[3]->Parameters["X"], 2.0);
+    EXPECT_EQ(commands[4]->Name, "(end)");
+}
+
+TEST_F(GCodeTest, parseAnnotations)
+{
+    Path::Command cmd = parse("G1 X1; tool:'T1' depth:2.5");
+    EXPECT_EQ(cmd.Name, "G1");
+    EXPECT_EQ(cmd.Parameters.size(), 1);
+    EXPECT_EQ(cmd.getAnnotationString("tool"), "T1");
+    EXPECT_DOUBLE_EQ(cmd.getAnnotationDouble("depth"), 2.5);
+
+    // the annotations stay with the command they follow
+    auto commands = own(Path::GCode::parseProgram("G1 X1; tool:'G2X3'\nG0 Z5\n"));
+    ASSERT_EQ(commands.size(), 2);
+    EXPECT_EQ(commands[0]->getAnnotationString("tool"), "G2X3");
+    EXPECT_EQ(commands[1]->Name, "G0");
+}
+
+TEST_F(GCodeTest, malformedNumbers)
+{
+    EXPECT_THROW(parse("G1 X"), Base::BadFormatError);
+    EXPECT_THROW(parse("G1 XY1"), Base::BadFormatError);
+    EXPECT_THROW(parse("G X1"), Base::BadFormatError);
+    EXPECT_THROW(parse(""), Base::BadFormatError);
+
+    // like atof() the longest valid prefix counts and no valid prefix gives 0
+    EXPECT_DOUBLE_EQ(parse("G1 X1.2.3").Parameters["X"], 1.2);
+    EXPECT_DOUBLE_EQ(parse("G1 X--1").Parameters["X"], 0.0);
+    EXPECT_DOUBLE_EQ(parse("G1 X-").Parameters["X"], 0.0);
+    EXPECT_TRUE(std::isinf(parse("G1 X1e999").Parameters["X"]));
+
+    EXPECT_THROW(Path::GCode::parseProgram("G0 X1\nG1 X"), Base::BadFormatError);
+    EXPECT_THROW(Path::GCode::parseLines("G0 X1\nG1 Y\n"), Base::BadFormatError);
+}
+
+TEST_F(GCodeTest, units)
+{
+    auto commands = own(Path::GCode::parseProgram("G1 X1\nG20\nG1 X1 F10\nG21\nG1 X1\n"));
+    ASSERT_EQ(commands.size(), 3);
+    EXPECT_DOUBLE_EQ(commands[0]->Parameters["X"], 1.0);
+    EXPECT_DOUBLE_EQ(commands[1]->Parameters["X"], 25.4);
+    EXPECT_DOUBLE_EQ(commands[1]->Parameters["F"], 254.0);
+    EXPECT_DOUBLE_EQ(commands[2]->Parameters["X"], 1.0);
+}
+
+TEST_F(GCodeTest, appendCommand)
+{
+    Path::Command cmd("G1", {{"X", 1.5}, {"Y", -0.25}, {"Z", 2.0}, {"N", 10.0}});
+    EXPECT_EQ(write(cmd), "G1 X1.500000 Y-0.250000 Z2.000000");
+    EXPECT_EQ(write(cmd, 6, false), "G1 X1.5 Y-0.25 Z2");
+    EXPECT_EQ(write(cmd, 2), "G1 X1.50 Y-0.25 Z2.00");
+    EXPECT_EQ(write(cmd, 0), "G1 X2 Y-0 Z2");
+
+    EXPECT_EQ(write(Path::Command("G0", {{"X", 0.0000004}})), "G0 X0.000000");
+    EXPECT_EQ(write(Path::Command("G0", {{"X", 0.0000005}})), "G0 X0.000001");
+    EXPECT_EQ(write(Path::Command("G0", {{"X", 123.0000999}})), "G0 X123.000100");
+
+    cmd = Path::Command("G1", {{"X", 1.0}}, {{"tool", std::string("T1")}, {"depth", 2.5}});
+    EXPECT_EQ(write(cmd), "G1 X1.000000; depth:2.500000 tool:'T1'");
+}
+
+TEST_F(GCodeTest, roundTrip)
+{
+    const double values[] = {0.0, 1.0, -1.0, 0.1, -0.123456, 1234567.891011, 1e-7, -98.7654321};
+    for (double value : values) {
+        Path::Command cmd("G1", {{"X", value}, {"F", std::fabs(value)}});
+        Path::Command read = parse(write(cmd));
+        EXPECT_EQ(read.Name, "G1");
+        EXPECT_NEAR(read.Parameters["X"], value, 5e-7);
+        EXPECT_NEAR(read.Parameters["F"], std::fabs(value), 5e-7);
+        // the written values are read back exactly
+        EXPECT_EQ(write(read), write(cmd));
+    }
+
+    std::vector<Path::Command*> commands {
+        new Path::Command("G0", {{"X", 1.0}, {"Y", 2.0}}),
+        new Path::Command("(comment)", {}),
+        new Path::Command(
+            "G2",
+            {{"X", 3.0}, {"I", 1.0}, {"J", -0.5}},
+            {{"op", std::string("Pocket")}}
+        ),
+        new Path::Command("M3", {{"S", 12000.0}}),
+    };
+    std::string gcode = Path::GCode::writeProgram(commands);
+    for (auto parser : {&Path::GCode::parseProgram, &Path::GCode::parseLines}) {
+        auto read = own(parser(gcode, 1));
+        ASSERT_EQ(read.size(), commands.size());
+        for (std::size_t i = 0; i < commands.size(); i++) {
+            EXPECT_EQ(write(*read[i]), write(*commands[i]));
+        }
+    }
+    for (auto* cmd : commands) {
+        delete cmd;
+    }
+}
+
+TEST_F(GCodeTest, threads)
+{
+    // large enough to be split into several chunks
+    std::string gcode;
+    for (int i = 0; gcode.size() < (5 << 20); i++) {
+        gcode += "G1 X" + std::to_string(i % 1000) + ".125 Y-" + std::to_string(i % 77) + "\n";
+        if (i % 10000 == 0) {
+            gcode += (i % 20000 == 0) ? "G20\n" : "G21\n";
+        }
+        if (i % 999 == 0) {
+            gcode += "(comment " + std::to_string(i) + ")\n";
+        }
+    }
+
+    auto serial = own(Path::GCode::parseProgram(gcode, 1));
+    auto parallel = own(Path::GCode::parseProgram(gcode, 4));
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); i++) {
+        ASSERT_EQ(serial[i]->Name, parallel[i]->Name);
+        ASSERT_EQ(serial[i]->Parameters, parallel[i]->Parameters);
+    }
+
+    std::vector<Path::Command*> commands;
+    for (const auto& cmd : serial) {
+        commands.push_back(cmd.get());
+    }
+    std::string written = Path::GCode::writeProgram(commands, 1);
+    EXPECT_EQ(Path::GCode::writeProgram(commands, 4), written);
+
+    std::vector<Path::Command*> lines = Path::GCode::parseLines(written, 4);
+    auto owner = own(lines);
+    EXPECT_EQ(Path::GCode::writeProgram(lines, 1), written);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <numbers>
+
+#include <src/App/InitApplication.h>
+#include <Mod/CAM/App/Path.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class ToolpathTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+};
+
+TEST_F(ToolpathTest, queriesFollowModifications)
+{
+    Path::Toolpath path;
+    path.addCommand(Path::Command("G1", {{"X", 3.0}}));
+    EXPECT_DOUBLE_EQ(path.getLength(), 3.0);
+
+    path.addCommandNoRecalc(Path::Command("G1", {{"X", 3.0}, {"Y", 4.0}}));
+    EXPECT_DOUBLE_EQ(path.getLength(), 7.0);
+
+    // the commands are modified in place, e.g. by Area
+    path.getCommands().back()->Parameters["Y"] = 0.0;
+    EXPECT_DOUBLE_EQ(path.getLength(), 3.0);
+    EXPECT_DOUBLE_EQ(path.getBoundBox().MaxY, 0.0);
+}
+
+TEST_F(ToolpathTest, length)
+{
+    Path::Toolpath path;
+    path.setFromGCode("G0 Z5\nG1 X10\nG2 X20 I5 J0\n");
+    EXPECT_DOUBLE_EQ(path.getLength(), 15.0 + 5.0 * std::numbers::pi);
+}
+
+TEST_F(ToolpathTest, boundBox)
+{
+    Path::Toolpath path;
+    path.setFromGCode("G0 X1 Y2 Z3\nG1 X4 Y-1\nG91\nG1 X1 Y1 Z-2\nG90\n");
+    Base::BoundBox3d bb = path.getBoundBox();
+    EXPECT_DOUBLE_EQ(bb.MinX, 0.0);
+    EXPECT_DOUBLE_EQ(bb.MinY, -1.0);
+    EXPECT_DOUBLE_EQ(bb.MinZ, 0.0);
+    EXPECT_DOUBLE_EQ(bb.MaxX, 5.0);
+    EXPECT_DOUBLE_EQ(bb.MaxY, 2.0);
+    EXPECT_DOUBLE_EQ(bb.MaxZ, 3.0);
+
+    EXPECT_FALSE(Path::Toolpath().getBoundBox().IsValid());
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
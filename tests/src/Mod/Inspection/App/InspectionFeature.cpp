@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRep_Tool.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+
+#include <src/App/InitApplication.h>
+#include <Mod/Inspection/App/InspectionFeature.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class InspectionFeatureTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static std::vector<Handle(Poly_Triangulation)> triangulations(const TopoDS_Shape& shape)
+    {
+        std::vector<Handle(Poly_Triangulation)> result;
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        for (int i = 1; i <= faces.Extent(); i++) {
+            TopLoc_Location loc;
+            result.push_back(BRep_Tool::Triangulation(TopoDS::Face(faces(i)), loc));
+        }
+        return result;
+    }
+};
+
+TEST_F(InspectionFeatureTest, nominalShapeDistance)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    Inspection::InspectNominalShape nominal(box, 5.0F);
+
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(0.5F, 0.5F, 2.0F)), 1.0F);
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(0.5F, 0.5F, 0.75F)), -0.25F);
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(2.0F, 2.0F, 0.5F)), std::sqrt(2.0F));
+}
+
+TEST_F(InspectionFeatureTest, nominalShapeKeepsTriangulation)
+{
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    {
+        // an untriangulated shape stays untriangulated
+        Inspection::InspectNominalShape nominal(box, 5.0F);
+        for (const auto& mesh : triangulations(box)) {
+            EXPECT_TRUE(mesh.IsNull());
+        }
+    }
+
+    // the triangulation of a displayed shape is not replaced
+    BRepMesh_IncrementalMesh(box, 0.5, Standard_False, 1.0);
+    auto meshes = triangulations(box);
+    Inspection::InspectNominalShape nominal(box, 5.0F);
+    EXPECT_EQ(triangulations(box), meshes);
+    EXPECT_FLOAT_EQ(nominal.getDistance(Base::Vector3f(0.5F, 0.5F, 2.0F)), 1.0F);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
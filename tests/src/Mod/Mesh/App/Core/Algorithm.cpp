@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Curvature.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshAdjacencyTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a wavy grid with a border, large enough to be built by several threads
+        const int size = 150;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto point = [](int i, int j) {
+            return Base::Vector3f(float(i), float(j), float((i * j) % 7) * 0.1F);
+        };
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+            }
+        }
+        kernel = facets;
+    }
+
+    template<typename Set>
+    static std::vector<MeshCore::ElementIndex> toVector(const Set& set)
+    {
+        return {set.begin(), set.end()};
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshAdjacencyTest, TestPointToFacets)
+{
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+    ASSERT_EQ(compact.CountElements(), kernel.CountPoints());
+    EXPECT_EQ(compact.CountEntries(), 3 * kernel.CountFacets());
+
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(ref[i]));
+        EXPECT_EQ(compact.GetNormal(i), ref.GetNormal(i));
+    }
+}
+
+TEST_F(MeshAdjacencyTest, TestPointToPoints)
+{
+    MeshCore::MeshRefPointToPoints ref(kernel);
+    MeshCore::MeshCompactPointToPoints compact(kernel);
+    ASSERT_EQ(compact.CountElements(), kernel.CountPoints());
+
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(ref[i]));
+    }
+}
+
+TEST_F(MeshAdjacencyTest, TestFacetToFacets)
+{
+    MeshCore::MeshRefFacetToFacets ref(kernel);
+    MeshCore::MeshCompactFacetToFacets compact(kernel);
+    ASSERT_EQ(compact.CountElements(), kernel.CountFacets());
+
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(ref[i]));
+    }
+}
+
+TEST_F(MeshAdjacencyTest, TestNeighbours)
+{
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+
+    std::vector<MeshCore::FacetIndex> facets1, facets2;
+    MeshCore::FacetCollector collect1(facets1);
+    MeshCore::FacetCollector collect2(facets2);
+    ref.Neighbours(1000, 3.0F, collect1);
+    compact.Neighbours(1000, 3.0F, collect2);
+    EXPECT_FALSE(facets2.empty());
+    EXPECT_EQ(facets1, facets2);
+}
+
+TEST_F(MeshAdjacencyTest, TestFacetCurvature)
+{
+    MeshCore::MeshRefPointToFacets ref(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+    MeshCore::FacetCurvature curvature1(kernel, ref, 3.0F, 20);
+    MeshCore::FacetCurvature curvature2(kernel, compact, 3.0F, 20);
+
+    MeshCore::CurvatureInfo info1 = curvature1.Compute(1000);
+    MeshCore::CurvatureInfo info2 = curvature2.Compute(1000);
+    EXPECT_EQ(info1.fMaxCurvature, info2.fMaxCurvature);
+    EXPECT_EQ(info1.fMinCurvature, info2.fMinCurvature);
+    EXPECT_EQ(info1.cMaxCurvDir, info2.cMaxCurvDir);
+    EXPECT_EQ(info1.cMinCurvDir, info2.cMinCurvDir);
+}
+
+TEST(MeshCompactAdjacencyTest, TestEmpty)
+{
+    MeshCore::MeshKernel kernel;
+    MeshCore::MeshCompactPointToFacets vf(kernel);
+    MeshCore::MeshCompactPointToPoints vv(kernel, vf);
+    MeshCore::MeshCompactFacetToFacets ff(kernel, vf);
+    EXPECT_EQ(vf.CountElements(), 0);
+    EXPECT_EQ(vv.CountEntries(), 0);
+    EXPECT_EQ(ff.CountEntries(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <vector>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshBlockDecimationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a smooth grid that is split into several blocks
+        const int size = 100;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+            }
+        }
+        kernel = facets;
+    }
+
+    static Base::Vector3f point(int i, int j)
+    {
+        float x = float(i) * 0.1F;
+        float y = float(j) * 0.1F;
+        return Base::Vector3f(x, y, 0.5F * std::sin(x) * std::cos(y));
+    }
+
+    static MeshCore::MeshSimplify::BlockParameters blockParameters()
+    {
+        MeshCore::MeshSimplify::BlockParameters params;
+        params.reduction = 0.8F;
+        params.blockSize = 4000;
+        params.threads = 4;
+        return params;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshBlockDecimationTest, TestReduction)
+{
+    unsigned long numFacets = kernel.CountFacets();
+    Base::BoundBox3f box = kernel.GetBoundBox();
+
+    MeshCore::MeshSimplify(kernel).simplify(blockParameters());
+    EXPECT_LT(kernel.CountFacets(), numFacets / 2);
+    EXPECT_GT(kernel.CountFacets(), 0);
+
+    // the points shared by neighbouring blocks are kept, so no gaps open at the seams
+    EXPECT_TRUE(kernel.GetBoundBox().IsInBox(box));
+    EXPECT_NEAR(kernel.GetBoundBox().LengthX(), box.LengthX(), 1e-4F);
+    EXPECT_NEAR(kernel.GetBoundBox().LengthY(), box.LengthY(), 1e-4F);
+}
+
+TEST_F(MeshBlockDecimationTest, TestThreads)
+{
+    MeshCore::MeshKernel copy = kernel;
+    auto params = blockParameters();
+    params.threads = 1;
+    MeshCore::MeshSimplify(copy).simplify(params);
+    MeshCore::MeshSimplify(kernel).simplify(blockParameters());
+
+    // the blocks are merged in the same order
+    ASSERT_EQ(copy.CountFacets(), kernel.CountFacets());
+    ASSERT_EQ(copy.CountPoints(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < copy.CountPoints(); i++) {
+        EXPECT_EQ(copy.GetPoint(i), kernel.GetPoint(i));
+    }
+}
+
+TEST_F(MeshBlockDecimationTest, TestMaxDistance)
+{
+    MeshCore::MeshKernel coarse = kernel;
+    MeshCore::MeshSimplify(coarse).simplify(blockParameters());
+
+    auto params = blockParameters();
+    params.maxDistance = 0.0005F;
+    MeshCore::MeshSimplify(kernel).simplify(params);
+
+    // the limit stops collapses before the target number of facets is reached
+    EXPECT_GT(kernel.CountFacets(), coarse.CountFacets());
+}
+
+TEST_F(MeshBlockDecimationTest, TestStream)
+{
+    std::stringstream str;
+    MeshCore::MeshKernel copy = kernel;
+    EXPECT_TRUE(MeshCore::MeshSimplify(kernel).simplify(blockParameters(), str));
+    MeshCore::MeshSimplify(copy).simplify(blockParameters());
+
+    std::string data = str.str();
+    ASSERT_EQ(data.size(), 84 + 50 * copy.CountFacets());
+
+    uint32_t numFacets {};
+    std::memcpy(&numFacets, data.data() + 80, sizeof(numFacets));
+    EXPECT_EQ(numFacets, copy.CountFacets());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
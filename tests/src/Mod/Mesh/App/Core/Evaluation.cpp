@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshEvaluationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        box = makeBox(Base::Vector3f(0.0F, 0.0F, 0.0F), 20);
+    }
+
+    // the facets of a unit cube at offset with every side split into a grid of size x size squares
+    static std::vector<MeshCore::MeshGeomFacet> makeBox(const Base::Vector3f& offset, int size)
+    {
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto addSide = [&](const Base::Vector3f& base,
+                           const Base::Vector3f& u,
+                           const Base::Vector3f& v) {
+            float step = 1.0F / float(size);
+            for (int i = 0; i < size; i++) {
+                for (int j = 0; j < size; j++) {
+                    Base::Vector3f p0 = base + u * (float(i) * step) + v * (float(j) * step);
+                    Base::Vector3f p1 = p0 + u * step;
+                    Base::Vector3f p2 = p1 + v * step;
+                    Base::Vector3f p3 = p0 + v * step;
+                    facets.emplace_back(p0, p1, p2);
+                    facets.emplace_back(p0, p2, p3);
+                }
+            }
+        };
+
+        Base::Vector3f ex(1.0F, 0.0F, 0.0F), ey(0.0F, 1.0F, 0.0F), ez(0.0F, 0.0F, 1.0F);
+        Base::Vector3f one(1.0F, 1.0F, 1.0F);
+        addSide(offset, ey, ex);
+        addSide(offset, ex, ez);
+        addSide(offset, ez, ey);
+        addSide(offset + one, -ex, -ey);
+        addSide(offset + one, -ez, -ex);
+        addSide(offset + one, -ey, -ez);
+        return facets;
+    }
+
+    std::vector<MeshCore::MeshGeomFacet> box;
+};
+
+TEST_F(MeshEvaluationTest, TestEdgeIndex)
+{
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+    MeshCore::MeshEdgeIndex edges(kernel, 4);
+    EXPECT_EQ(edges.CountFacets(), kernel.CountFacets());
+    ASSERT_EQ(edges.CountEdges(), 3 * kernel.CountFacets() / 2);
+    for (std::size_t i = 0; i < edges.CountEdges(); i++) {
+        auto edge = edges[i];
+        ASSERT_EQ(edge.size(), 2);
+        EXPECT_LT(edge[0].p0, edge[0].p1);
+        EXPECT_EQ(edge[0].p0, edge[1].p0);
+        EXPECT_EQ(edge[0].p1, edge[1].p1);
+        EXPECT_LT(edge[0].f, edge[1].f);
+    }
+
+    EXPECT_EQ(MeshCore::MeshEdgeIndex(MeshCore::MeshKernel()).CountEdges(), 0);
+}
+
+TEST_F(MeshEvaluationTest, TestTopology)
+{
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+    EXPECT_TRUE(MeshCore::MeshEvalTopology(kernel).Evaluate());
+
+    // a third facet at an edge of the cube
+    box.emplace_back(
+        Base::Vector3f(0.0F, 0.0F, 0.0F),
+        Base::Vector3f(0.0F, 0.05F, 0.0F),
+        Base::Vector3f(-1.0F, 0.0F, -1.0F)
+    );
+    kernel = box;
+    MeshCore::MeshEvalTopology eval(kernel);
+    EXPECT_FALSE(eval.Evaluate());
+    ASSERT_EQ(eval.CountManifolds(), 1);
+    EXPECT_EQ(eval.GetFacets().front().size(), 3);
+
+    std::vector<MeshCore::FacetIndex> facets;
+    eval.GetFacetManifolds(facets);
+    EXPECT_EQ(facets.size(), 3);
+}
+
+TEST_F(MeshEvaluationTest, TestNeighbourhood)
+{
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+    MeshCore::MeshEvalNeighbourhood eval(kernel);
+    EXPECT_TRUE(eval.Evaluate());
+    EXPECT_TRUE(eval.GetIndices().empty());
+
+    // without neighbours all edges are open
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::MeshFacetArray facets = kernel.GetFacets();
+    for (auto& it : facets) {
+        it.SetNeighbours(
+            MeshCore::FACET_INDEX_MAX,
+            MeshCore::FACET_INDEX_MAX,
+            MeshCore::FACET_INDEX_MAX
+        );
+    }
+    MeshCore::MeshKernel broken;
+    broken.Adopt(points, facets, false);
+    MeshCore::MeshEvalNeighbourhood eval2(broken);
+    EXPECT_FALSE(eval2.Evaluate());
+    EXPECT_EQ(eval2.GetIndices().size(), broken.CountFacets());
+}
+
+TEST_F(MeshEvaluationTest, TestSelfIntersection)
+{
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+    EXPECT_TRUE(MeshCore::MeshEvalSelfIntersection(kernel).Evaluate());
+
+    std::vector<MeshCore::MeshGeomFacet> other = makeBox(Base::Vector3f(0.55F, 0.23F, 0.31F), 20);
+    box.insert(box.end(), other.begin(), other.end());
+    kernel = box;
+
+    MeshCore::MeshEvalSelfIntersection eval1(kernel);
+    eval1.SetThreads(1);
+    EXPECT_FALSE(eval1.Evaluate());
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs1;
+    eval1.GetIntersections(pairs1);
+
+    MeshCore::MeshEvalSelfIntersection eval4(kernel);
+    eval4.SetThreads(4);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> pairs4;
+    eval4.GetIntersections(pairs4);
+
+    EXPECT_FALSE(pairs1.empty());
+    EXPECT_EQ(pairs1, pairs4);
+    for (const auto& it : pairs1) {
+        EXPECT_LT(it.first, it.second);
+    }
+}
+
+TEST_F(MeshEvaluationTest, TestPipeline)
+{
+    box.emplace_back(
+        Base::Vector3f(0.0F, 0.0F, 0.0F),
+        Base::Vector3f(0.0F, 0.05F, 0.0F),
+        Base::Vector3f(-1.0F, 0.0F, -1.0F)
+    );
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+
+    MeshCore::MeshEvalTopology topology(kernel);
+    MeshCore::MeshEvalNeighbourhood neighbourhood(kernel);
+    MeshCore::MeshEvalSelfIntersection selfIntersection(kernel);
+    MeshCore::MeshEvalPointManifolds pointManifolds(kernel);
+
+    MeshCore::MeshEvalPipeline pipeline(kernel);
+    pipeline.Add(topology);
+    pipeline.Add(neighbourhood);
+    pipeline.Add(selfIntersection);
+    pipeline.Add(pointManifolds);
+    EXPECT_FALSE(pipeline.Evaluate());
+    EXPECT_FALSE(pipeline.GetResult(0));
+    EXPECT_TRUE(pipeline.GetResult(1));
+    EXPECT_TRUE(pipeline.GetResult(2));
+    EXPECT_EQ(topology.CountManifolds(), 1);
+}
+
+TEST_F(MeshEvaluationTest, TestPipelineMeshFlags)
+{
+    // flip one facet
+    const auto& points = box[0]._aclPoints;
+    box[0] = MeshCore::MeshGeomFacet(points[0], points[2], points[1]);
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+
+    MeshCore::MeshEvalTopology topology(kernel);
+    MeshCore::MeshEvalOrientation orientation(kernel);
+    MeshCore::MeshEvalNeighbourhood neighbourhood(kernel);
+    EXPECT_FALSE(topology.UsesMeshFlags());
+    EXPECT_TRUE(orientation.UsesMeshFlags());
+
+    MeshCore::MeshEvalPipeline pipeline(kernel);
+    pipeline.SetThreads(4);
+    pipeline.Add(topology);
+    pipeline.Add(orientation);
+    pipeline.Add(neighbourhood);
+    EXPECT_FALSE(pipeline.Evaluate());
+    EXPECT_TRUE(pipeline.GetResult(0));
+    EXPECT_FALSE(pipeline.GetResult(1));
+    EXPECT_TRUE(pipeline.GetResult(2));
+    EXPECT_EQ(orientation.GetIndices(), std::vector<MeshCore::FacetIndex>{0});
+}
+
+TEST_F(MeshEvaluationTest, TestPipelineModifiedMesh)
+{
+    MeshCore::MeshKernel kernel;
+    kernel = box;
+
+    MeshCore::MeshEvalNeighbourhood neighbourhood(kernel);
+    MeshCore::MeshEvalPipeline pipeline(kernel);
+    pipeline.Add(neighbourhood);
+    EXPECT_TRUE(pipeline.Evaluate());
+
+    // move a corner of a facet to another point, this keeps the number of facets but makes the
+    // shared edge index of the pipeline out of date
+    unsigned long revision = kernel.GetRevision();
+    MeshCore::PointIndex p0 {}, p1 {}, p2 {};
+    kernel.GetFacetPoints(0, p0, p1, p2);
+    kernel.SetFacetPoints(0, p0, p1, kernel.CountPoints() - 1);
+    EXPECT_NE(kernel.GetRevision(), revision);
+    EXPECT_FALSE(neighbourhood.Evaluate());
+
+    // changing flags is no modification
+    revision = kernel.GetRevision();
+    MeshCore::MeshAlgorithm(kernel).SetFacetFlag(MeshCore::MeshFacet::VISIT);
+    EXPECT_EQ(kernel.GetRevision(), revision);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <Mod/Mesh/App/Core/Grid.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(MeshGridCellsTest, TestEmpty)
+{
+    MeshCore::MeshGridCells cells;
+    cells.Resize(8);
+    EXPECT_EQ(cells.CountCells(), 8);
+    EXPECT_EQ(cells.CountEntries(), 0);
+    EXPECT_TRUE(cells[3].empty());
+}
+
+TEST(MeshGridCellsTest, TestBuildSortedCells)
+{
+    // large enough to be built by several threads
+    const std::size_t numCells = 20;
+    const std::size_t numElements = 200000;
+    auto cellsOf = [](MeshCore::ElementIndex i, std::vector<unsigned long>& cells) {
+        cells.push_back(i % 7);
+        if (i % 3 == 0) {
+            cells.push_back(7 + (i * 5) % 13);
+        }
+    };
+
+    MeshCore::MeshGridCells cells;
+    cells.Build(numCells, numElements, cellsOf);
+    EXPECT_EQ(cells.CountCells(), numCells);
+
+    std::vector<std::vector<MeshCore::ElementIndex>> expected(numCells);
+    std::vector<unsigned long> tmp;
+    for (std::size_t i = 0; i < numElements; i++) {
+        tmp.clear();
+        cellsOf(i, tmp);
+        for (unsigned long c : tmp) {
+            expected[c].push_back(i);
+        }
+    }
+
+    for (std::size_t c = 0; c < numCells; c++) {
+        MeshCore::MeshGridCells::Cell cell = cells[c];
+        std::vector<MeshCore::ElementIndex> elements(cell.begin(), cell.end());
+        EXPECT_EQ(elements, expected[c]);
+    }
+}
+
+TEST(MeshGridTest, TestFacetGrid)
+{
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f p1 {0, 0, 0};
+    Base::Vector3f p2 {10, 0, 0};
+    Base::Vector3f p3 {0, 10, 0};
+    Base::Vector3f p4 {10, 10, 10};
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+
+    MeshCore::MeshFacetGrid grid(kernel, 4, 4, 4);
+    EXPECT_TRUE(grid.Verify());
+
+    std::vector<MeshCore::ElementIndex> elements;
+    grid.Inside(kernel.GetBoundBox(), elements);
+    EXPECT_EQ(elements, std::vector<MeshCore::ElementIndex>({0, 1}));
+
+    unsigned long count = 0;
+    MeshCore::MeshGridIterator it(grid);
+    for (it.Init(); it.More(); it.Next()) {
+        std::vector<MeshCore::ElementIndex> cell;
+        it.GetElements(cell);
+        EXPECT_TRUE(std::is_sorted(cell.begin(), cell.end()));
+        EXPECT_EQ(cell.size(), it.GetCtElements());
+        count += it.GetCtElements();
+    }
+    EXPECT_GE(count, 2);
+
+    EXPECT_EQ(grid.SearchNearestFromPoint(Base::Vector3f(1, 1, 0.1F)), 0);
+}
+
+TEST(MeshGridTest, TestPointGrid)
+{
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f p1 {0, 0, 0};
+    Base::Vector3f p2 {10, 0, 0};
+    Base::Vector3f p3 {0, 10, 0};
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+
+    MeshCore::MeshPointGrid grid(kernel, 4, 4, 4);
+    std::set<MeshCore::ElementIndex> elements;
+    grid.FindElements(p2, elements);
+    EXPECT_EQ(elements.size(), 1);
+
+    std::set<MeshCore::ElementIndex> all;
+    grid.Inside(kernel.GetBoundBox(), all);
+    EXPECT_EQ(all.size(), 3);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/PointCoordinates.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshPointCoordinatesTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // large enough to be processed by several threads
+        const int size = 200000;
+        points.reserve(size);
+        for (int i = 0; i < size; i++) {
+            points.emplace_back(
+                float(i % 97) - 40.0F,
+                float(i % 89) * 0.5F,
+                float(i % 83) * 0.25F - 10.0F
+            );
+        }
+    }
+
+    MeshCore::MeshPointArray points;
+};
+
+TEST_F(MeshPointCoordinatesTest, TestAssign)
+{
+    points[5].SetFlag(MeshCore::MeshPoint::MARKED);
+    MeshCore::MeshPointCoordinates coords(points);
+    ASSERT_EQ(coords.Size(), points.size());
+    EXPECT_EQ(coords.GetPoint(7), points[7]);
+    EXPECT_TRUE(coords.IsFlag(5, MeshCore::MeshPoint::MARKED));
+    EXPECT_FALSE(coords.IsFlag(6, MeshCore::MeshPoint::MARKED));
+
+    coords.SetPoint(7, Base::Vector3f(1.0F, 2.0F, 3.0F));
+    coords.ResetFlag(5, MeshCore::MeshPoint::MARKED);
+    coords.Apply(points);
+    EXPECT_EQ(points[7], Base::Vector3f(1.0F, 2.0F, 3.0F));
+    EXPECT_FALSE(points[5].IsFlag(MeshCore::MeshPoint::MARKED));
+}
+
+TEST_F(MeshPointCoordinatesTest, TestTransform)
+{
+    Base::Matrix4D mat;
+    mat.rotX(0.3);
+    mat.rotZ(1.1);
+    mat.move(Base::Vector3d(1.5, -2.0, 7.25));
+
+    MeshCore::MeshPointCoordinates coords(points);
+    coords.Transform(mat);
+    points.Transform(mat);
+    for (MeshCore::PointIndex i = 0; i < points.size(); i++) {
+        EXPECT_EQ(coords.GetPoint(i), points[i]);
+    }
+}
+
+TEST_F(MeshPointCoordinatesTest, TestMove)
+{
+    MeshCore::MeshPointCoordinates coords(points);
+    coords.Move(Base::Vector3f(1.0F, 2.0F, 3.0F));
+    EXPECT_EQ(coords.GetPoint(100), points[100] + Base::Vector3f(1.0F, 2.0F, 3.0F));
+}
+
+TEST_F(MeshPointCoordinatesTest, TestBoundBox)
+{
+    Base::BoundBox3f box;
+    for (const auto& it : points) {
+        box.Add(it);
+    }
+
+    MeshCore::MeshPointCoordinates coords(points);
+    Base::BoundBox3f soa = coords.GetBoundBox();
+    EXPECT_EQ(soa.MinX, box.MinX);
+    EXPECT_EQ(soa.MinY, box.MinY);
+    EXPECT_EQ(soa.MinZ, box.MinZ);
+    EXPECT_EQ(soa.MaxX, box.MaxX);
+    EXPECT_EQ(soa.MaxY, box.MaxY);
+    EXPECT_EQ(soa.MaxZ, box.MaxZ);
+
+    EXPECT_FALSE(MeshCore::MeshPointCoordinates().GetBoundBox().IsValid());
+}
+
+TEST_F(MeshPointCoordinatesTest, TestNearestPoint)
+{
+    points[150000].Set(100.0F, 100.0F, 100.0F);
+    points[170000].Set(100.0F, 100.0F, 100.5F);
+
+    MeshCore::MeshPointCoordinates coords(points);
+    float distance {};
+    EXPECT_EQ(coords.NearestPoint(Base::Vector3f(100.0F, 100.0F, 100.1F), distance), 150000);
+    EXPECT_NEAR(distance, 0.1F, 1e-4F);
+
+    // invalid points are skipped
+    coords.SetFlag(150000, MeshCore::MeshPoint::INVALID);
+    EXPECT_EQ(coords.NearestPoint(Base::Vector3f(100.0F, 100.0F, 100.1F), distance), 170000);
+    EXPECT_EQ(coords.NearestPoint(points[3], distance), 3);
+    EXPECT_FLOAT_EQ(distance, 0.0F);
+
+    EXPECT_EQ(
+        MeshCore::MeshPointCoordinates().NearestPoint(Base::Vector3f(), distance),
+        MeshCore::POINT_INDEX_MAX
+    );
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
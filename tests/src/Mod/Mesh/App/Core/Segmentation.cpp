@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Segmentation.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+namespace
+{
+// Searches the same segments with the sequential region growing
+template<typename Segment>
+class RegionGrowingSegment: public Segment
+{
+public:
+    using Segment::Segment;
+    bool IsLocal() const override
+    {
+        return false;
+    }
+};
+}  // namespace
+
+class MeshSegmentationTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const int size = 80;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto point = [](int i, int j) {
+            return Base::Vector3f(float(i), float(j), 0.0F);
+        };
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+            }
+        }
+        kernel = facets;
+
+        // curved stripes split the plane into blocks, some points are curved in two directions
+        curvature.resize(kernel.CountPoints());
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            int x = int(points[i].x);
+            int y = int(points[i].y);
+            MeshCore::CurvatureInfo& ci = curvature[i];
+            ci.fMaxCurvature = (x % 9 == 4 || y % 13 == 6) ? 1.0F : 0.0F;
+            ci.fMinCurvature = (x + y) % 17 == 0 ? 1.0F : 0.0F;
+        }
+    }
+
+    template<typename Planar, typename Freeform>
+    std::vector<MeshCore::MeshSegment> findSegments(int threads) const
+    {
+        std::vector<MeshCore::MeshSurfaceSegmentPtr> segm;
+        segm.emplace_back(std::make_shared<Planar>(curvature, 2, 0.1F));
+        segm.emplace_back(std::make_shared<Freeform>(curvature, 2, 0.1F, 0.1F, 1.0F, 0.0F));
+
+        MeshCore::MeshSegmentAlgorithm finder(kernel);
+        finder.SetThreads(threads);
+        finder.FindSegments(segm);
+
+        std::vector<MeshCore::MeshSegment> result;
+        for (const auto& it : segm) {
+            for (MeshCore::MeshSegment segment : it->GetSegments()) {
+                std::sort(segment.begin(), segment.end());
+                result.push_back(segment);
+            }
+        }
+        return result;
+    }
+
+    MeshCore::MeshKernel kernel;
+    std::vector<MeshCore::CurvatureInfo> curvature;
+};
+
+TEST_F(MeshSegmentationTest, TestCurvatureSegments)
+{
+    using Planar = MeshCore::MeshCurvaturePlanarSegment;
+    using Freeform = MeshCore::MeshCurvatureFreeformSegment;
+    std::vector<MeshCore::MeshSegment> segments = findSegments<Planar, Freeform>(1);
+    EXPECT_GT(segments.size(), 10);
+
+    EXPECT_EQ(segments, (findSegments<Planar, Freeform>(3)));
+    EXPECT_EQ(segments, (findSegments<Planar, Freeform>(0)));
+
+    // the same segments as with the region growing
+    EXPECT_EQ(
+        segments,
+        (findSegments<RegionGrowingSegment<Planar>, RegionGrowingSegment<Freeform>>(1))
+    );
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/SetOperations.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SetOperationsTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        box1 = makeBox(Base::Vector3f(0.0F, 0.0F, 0.0F), 10);
+        box2 = makeBox(Base::Vector3f(0.55F, 0.23F, 0.31F), 10);
+    }
+
+    // a unit cube at offset with every side split into a grid of size x size squares
+    static MeshCore::MeshKernel makeBox(const Base::Vector3f& offset, int size)
+    {
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto addSide = [&](const Base::Vector3f& base,
+                           const Base::Vector3f& u,
+                           const Base::Vector3f& v) {
+            float step = 1.0F / float(size);
+            for (int i = 0; i < size; i++) {
+                for (int j = 0; j < size; j++) {
+                    Base::Vector3f p0 = base + u * (float(i) * step) + v * (float(j) * step);
+                    Base::Vector3f p1 = p0 + u * step;
+                    Base::Vector3f p2 = p1 + v * step;
+                    Base::Vector3f p3 = p0 + v * step;
+                    facets.emplace_back(p0, p1, p2);
+                    facets.emplace_back(p0, p2, p3);
+                }
+            }
+        };
+
+        Base::Vector3f ex(1.0F, 0.0F, 0.0F), ey(0.0F, 1.0F, 0.0F), ez(0.0F, 0.0F, 1.0F);
+        Base::Vector3f one(1.0F, 1.0F, 1.0F);
+        addSide(offset, ey, ex);
+        addSide(offset, ex, ez);
+        addSide(offset, ez, ey);
+        addSide(offset + one, -ex, -ey);
+        addSide(offset + one, -ez, -ex);
+        addSide(offset + one, -ey, -ez);
+
+        MeshCore::MeshKernel kernel;
+        kernel = facets;
+        return kernel;
+    }
+
+    MeshCore::MeshKernel box1;
+    MeshCore::MeshKernel box2;
+};
+
+TEST_F(SetOperationsTest, TestBoxes)
+{
+    EXPECT_NEAR(box1.GetVolume(), 1.0F, 1e-4F);
+    EXPECT_FALSE(box1.HasOpenEdges());
+}
+
+TEST_F(SetOperationsTest, TestIntersect)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Intersect).Do();
+    EXPECT_NEAR(result.GetVolume(), 0.45F * 0.77F * 0.69F, 1e-3F);
+}
+
+TEST_F(SetOperationsTest, TestUnite)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Union).Do();
+    EXPECT_NEAR(result.GetVolume(), 2.0F - 0.45F * 0.77F * 0.69F, 1e-3F);
+}
+
+TEST_F(SetOperationsTest, TestDifference)
+{
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(box1, box2, result, MeshCore::SetOperations::Difference).Do();
+    EXPECT_NEAR(result.GetVolume(), 1.0F - 0.45F * 0.77F * 0.69F, 1e-3F);
+}
+
+TEST_F(SetOperationsTest, TestSmallFacets)
+{
+    // the facets are small enough that a fixed epsilon on unnormalized plane distances fails
+    MeshCore::MeshKernel fine1 = makeBox(Base::Vector3f(0.0F, 0.0F, 0.0F), 80);
+    MeshCore::MeshKernel fine2 = makeBox(Base::Vector3f(0.5537F, 0.2311F, 0.3129F), 80);
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(fine1, fine2, result, MeshCore::SetOperations::Intersect).Do();
+    EXPECT_FALSE(result.HasOpenEdges());
+    EXPECT_NEAR(result.GetVolume(), 0.4463F * 0.7689F * 0.6871F, 1e-3F);
+}
+
+TEST_F(SetOperationsTest, TestThreads)
+{
+    MeshCore::MeshKernel result1;
+    MeshCore::SetOperations setOp1(box1, box2, result1, MeshCore::SetOperations::Union);
+    setOp1.SetThreads(1);
+    setOp1.Do();
+
+    MeshCore::MeshKernel result2;
+    MeshCore::SetOperations setOp2(box1, box2, result2, MeshCore::SetOperations::Union);
+    setOp2.SetThreads(4);
+    setOp2.Do();
+
+    // the result doesn't depend on the number of threads, facet for facet
+    ASSERT_EQ(result1.CountFacets(), result2.CountFacets());
+    ASSERT_EQ(result1.CountPoints(), result2.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < result1.CountPoints(); i++) {
+        EXPECT_EQ(Base::Vector3f(result1.GetPoint(i)), Base::Vector3f(result2.GetPoint(i)));
+    }
+    const MeshCore::MeshFacetArray& facets1 = result1.GetFacets();
+    const MeshCore::MeshFacetArray& facets2 = result2.GetFacets();
+    for (MeshCore::FacetIndex i = 0; i < result1.CountFacets(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_EQ(facets1[i]._aulPoints[j], facets2[i]._aulPoints[j]);
+        }
+    }
+}
+
+TEST_F(SetOperationsTest, TestDisjoint)
+{
+    MeshCore::MeshKernel box3 = makeBox(Base::Vector3f(5.0F, 0.0F, 0.0F), 2);
+    MeshCore::MeshKernel result;
+    MeshCore::SetOperations(box1, box3, result, MeshCore::SetOperations::Intersect).Do();
+    EXPECT_EQ(result.CountFacets(), 0);
+
+    MeshCore::SetOperations(box1, box3, result, MeshCore::SetOperations::Union).Do();
+    EXPECT_EQ(result.CountFacets(), box1.CountFacets() + box3.CountFacets());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <set>
+#include <vector>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshSmoothingTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a noisy grid with a border
+        const int size = 60;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto point = [](int i, int j) {
+            return Base::Vector3f(float(i), float(j), float((i * 7 + j * 13) % 5) * 0.2F);
+        };
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                facets.emplace_back(point(i, j), point(i + 1, j), point(i + 1, j + 1));
+                facets.emplace_back(point(i, j), point(i + 1, j + 1), point(i, j + 1));
+            }
+        }
+        kernel = facets;
+    }
+
+    template<typename Smoothing>
+    std::vector<Base::Vector3f> smooth(int threads, bool selection, bool simultaneous)
+    {
+        MeshCore::MeshKernel copy(kernel);
+        Smoothing smooth(copy);
+        smooth.SetThreads(threads);
+        smooth.SetSimultaneous(simultaneous);
+        if (selection) {
+            std::vector<MeshCore::PointIndex> indices;
+            for (MeshCore::PointIndex i = 0; i < copy.CountPoints(); i += 2) {
+                indices.push_back(i);
+            }
+            smooth.SmoothPoints(5, indices);
+        }
+        else {
+            smooth.Smooth(5);
+        }
+
+        return {copy.GetPoints().begin(), copy.GetPoints().end()};
+    }
+
+    double roughness(const std::vector<Base::Vector3f>& points) const
+    {
+        double sum = 0.0;
+        for (const auto& pnt : points) {
+            sum += std::fabs(pnt.z - 0.4F);
+        }
+        return sum;
+    }
+
+    template<typename Smoothing>
+    void testSmoothing()
+    {
+        std::vector<Base::Vector3f> points(kernel.GetPoints().begin(), kernel.GetPoints().end());
+        for (bool simultaneous : {false, true}) {
+            for (bool selection : {false, true}) {
+                std::vector<Base::Vector3f> result = smooth<Smoothing>(1, selection, simultaneous);
+                EXPECT_EQ(result, smooth<Smoothing>(4, selection, simultaneous));
+                EXPECT_EQ(result, smooth<Smoothing>(0, selection, simultaneous));
+                EXPECT_LT(roughness(result), roughness(points));
+            }
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshSmoothingTest, TestPlaneFit)
+{
+    testSmoothing<MeshCore::PlaneFitSmoothing>();
+}
+
+TEST_F(MeshSmoothingTest, TestLaplace)
+{
+    testSmoothing<MeshCore::LaplaceSmoothing>();
+}
+
+TEST_F(MeshSmoothingTest, TestTaubin)
+{
+    testSmoothing<MeshCore::TaubinSmoothing>();
+}
+
+TEST_F(MeshSmoothingTest, TestMedianFilter)
+{
+    testSmoothing<MeshCore::MedianFilterSmoothing>();
+}
+
+TEST_F(MeshSmoothingTest, TestLaplaceInPlace)
+{
+    // by default every point sees the already moved positions of its predecessors
+    MeshCore::MeshKernel expected(kernel);
+    MeshCore::MeshRefPointToFacets vf(expected);
+    MeshCore::MeshRefPointToPoints vv(expected);
+    const double lambda = 0.6307;
+    for (MeshCore::PointIndex pos = 0; pos < expected.CountPoints(); pos++) {
+        const std::set<MeshCore::PointIndex>& cv = vv[pos];
+        if (cv.size() < 3 || cv.size() != vf[pos].size()) {
+            continue;
+        }
+        Base::Vector3f pnt = expected.GetPoint(pos);
+        double w = 1.0 / double(cv.size());
+        double delx = 0.0, dely = 0.0, delz = 0.0;
+        for (MeshCore::PointIndex it : cv) {
+            Base::Vector3f nb = expected.GetPoint(it);
+            delx += w * static_cast<double>(nb.x - pnt.x);
+            dely += w * static_cast<double>(nb.y - pnt.y);
+            delz += w * static_cast<double>(nb.z - pnt.z);
+        }
+        expected.SetPoint(
+            pos,
+            static_cast<float>(static_cast<double>(pnt.x) + lambda * delx),
+            static_cast<float>(static_cast<double>(pnt.y) + lambda * dely),
+            static_cast<float>(static_cast<double>(pnt.z) + lambda * delz)
+        );
+    }
+
+    MeshCore::MeshKernel copy(kernel);
+    MeshCore::LaplaceSmoothing laplace(copy);
+    laplace.Smooth(1);
+    std::vector<Base::Vector3f> points(copy.GetPoints().begin(), copy.GetPoints().end());
+    std::vector<Base::Vector3f> reference(expected.GetPoints().begin(), expected.GetPoints().end());
+    EXPECT_EQ(points, reference);
+
+    // the simultaneous mode gives a different result
+    EXPECT_NE(
+        smooth<MeshCore::LaplaceSmoothing>(1, false, false),
+        smooth<MeshCore::LaplaceSmoothing>(1, false, true)
+    );
+}
+
+namespace
+{
+class UmbrellaSmoothing: public MeshCore::LaplaceSmoothing
+{
+public:
+    using MeshCore::LaplaceSmoothing::LaplaceSmoothing;
+    using MeshCore::LaplaceSmoothing::Umbrella;
+};
+}  // namespace
+
+TEST_F(MeshSmoothingTest, TestUmbrellaTables)
+{
+    // the overloads for the MeshRef* and MeshCompact* tables give the same result
+    MeshCore::MeshKernel copy1(kernel);
+    MeshCore::MeshRefPointToFacets vf1(copy1);
+    MeshCore::MeshRefPointToPoints vv1(copy1);
+    UmbrellaSmoothing smooth1(copy1);
+    smooth1.Umbrella(vv1, vf1, 0.5);
+
+    MeshCore::MeshKernel copy2(kernel);
+    MeshCore::MeshCompactPointToFacets vf2(copy2);
+    MeshCore::MeshCompactPointToPoints vv2(copy2, vf2);
+    UmbrellaSmoothing smooth2(copy2);
+    smooth2.Umbrella(vv2, vf2, 0.5);
+
+    std::vector<Base::Vector3f> points(kernel.GetPoints().begin(), kernel.GetPoints().end());
+    std::vector<Base::Vector3f> points1(copy1.GetPoints().begin(), copy1.GetPoints().end());
+    std::vector<Base::Vector3f> points2(copy2.GetPoints().begin(), copy2.GetPoints().end());
+    EXPECT_EQ(points1, points2);
+    EXPECT_LT(roughness(points1), roughness(points));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
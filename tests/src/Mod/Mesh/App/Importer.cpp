@@ -1,9 +1,14 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
 #include <Mod/Mesh/App/Core/IO/ReaderOBJ.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -14,6 +19,28 @@ protected:
     {
         XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
     }
+
+    static bool sameMesh(const MeshCore::MeshKernel& kernel1, const MeshCore::MeshKernel& kernel2)
+    {
+        if (kernel1.GetPoints() != kernel2.GetPoints()) {
+            return false;
+        }
+        const MeshCore::MeshFacetArray& facets1 = kernel1.GetFacets();
+        const MeshCore::MeshFacetArray& facets2 = kernel2.GetFacets();
+        return std::equal(
+            facets1.begin(),
+            facets1.end(),
+            facets2.begin(),
+            facets2.end(),
+            [](const MeshCore::MeshFacet& f1, const MeshCore::MeshFacet& f2) {
+                return std::equal(
+                    std::begin(f1._aulPoints),
+                    std::end(f1._aulPoints),
+                    std::begin(f2._aulPoints)
+                );
+            }
+        );
+    }
 };
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
@@ -53,4 +80,48 @@ TEST_F(ImporterTest, TestOBJ)
     EXPECT_EQ(kernel.CountPoints(), 8);
     EXPECT_EQ(kernel.CountFacets(), 12);
 }
+
+TEST_F(ImporterTest, TestBinarySTL)
+{
+    // two triangles of a square in binary STL format
+    const float facets[2][12] = {
+        {0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0},
+        {0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 0},
+    };
+    std::string data(80, ' ');
+    uint32_t count = 2;
+    data.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& facet : facets) {
+        uint16_t attr = 0;
+        data.append(reinterpret_cast<const char*>(facet), sizeof(facet));
+        data.append(reinterpret_cast<const char*>(&attr), sizeof(attr));
+    }
+
+    // read from a stream
+    MeshCore::MeshKernel kernel1;
+    std::istringstream str(data);
+    EXPECT_TRUE(MeshCore::MeshInput(kernel1).LoadSTL(str));
+    EXPECT_EQ(kernel1.CountPoints(), 4);
+    EXPECT_EQ(kernel1.CountFacets(), 2);
+
+    // read from memory
+    MeshCore::MeshKernel kernel2;
+    EXPECT_TRUE(MeshCore::MeshInput(kernel2).LoadBinarySTL(data.data(), data.size()));
+    EXPECT_TRUE(sameMesh(kernel2, kernel1));
+
+    // read from a memory-mapped file
+    Base::FileInfo fi(Base::FileInfo::getTempFileName() + ".stl");
+    {
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out.write(data.data(), std::streamsize(data.size()));
+    }
+    MeshCore::MeshKernel kernel3;
+    EXPECT_TRUE(MeshCore::MeshInput(kernel3).LoadAny(fi.filePath().c_str()));
+    fi.deleteFile();
+    EXPECT_TRUE(sameMesh(kernel3, kernel1));
+
+    // truncated data
+    MeshCore::MeshKernel kernel4;
+    EXPECT_FALSE(MeshCore::MeshInput(kernel4).LoadBinarySTL(data.data(), data.size() - 10));
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,8 +1,14 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include "gtest/gtest.h"
+#include <memory>
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <Mod/Mesh/App/FeatureMeshDefects.h>
 #include <Mod/Mesh/App/MeshFeature.h>
+#include <Mod/Mesh/App/MeshPy.h>
 
 class MeshFeatureTest: public ::testing::Test
 {
@@ -10,6 +16,7 @@ protected:
     static void SetUpTestSuite()
     {
         tests::initApplication();
+        Base::Interpreter().runString("import Mesh");
     }
 
     void SetUp() override
@@ -39,4 +46,110 @@ TEST_F(MeshFeatureTest, getComplexElementTypes)
     EXPECT_STREQ(types[0], "Mesh");
     EXPECT_STREQ(types[1], "Segment");
 }
+
+TEST_F(MeshFeatureTest, copySharesMesh)
+{
+    Mesh::Feature mf;
+    mf.Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+
+    std::unique_ptr<App::Property> copy(mf.Mesh.Copy());
+    auto meshCopy = static_cast<Mesh::PropertyMeshKernel*>(copy.get());
+    EXPECT_EQ(meshCopy->getValuePtr(), mf.Mesh.getValuePtr());
+
+    // modifying the mesh leaves the copy untouched, the property keeps its mesh object
+    const Mesh::MeshObject* original = mf.Mesh.getValuePtr();
+    Mesh::MeshObject* mesh = mf.Mesh.startEditing();
+    mesh->deleteFacets({0});
+    mf.Mesh.finishEditing();
+    EXPECT_EQ(mf.Mesh.getValuePtr(), original);
+    EXPECT_NE(meshCopy->getValuePtr(), mf.Mesh.getValuePtr());
+    EXPECT_EQ(meshCopy->getValue().countFacets(), 12);
+    EXPECT_EQ(mf.Mesh.getValue().countFacets(), 11);
+
+    // pasting shares the mesh again
+    mf.Mesh.Paste(*copy);
+    EXPECT_EQ(meshCopy->getValuePtr(), mf.Mesh.getValuePtr());
+    EXPECT_EQ(mf.Mesh.getValue().countFacets(), 12);
+
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(1.0, 2.0, 3.0));
+    mf.Mesh.setTransform(mat);
+    EXPECT_NE(meshCopy->getValuePtr(), mf.Mesh.getValuePtr());
+    EXPECT_EQ(meshCopy->getTransform(), Base::Matrix4D());
+    EXPECT_EQ(mf.Mesh.getTransform(), mat);
+}
+
+TEST_F(MeshFeatureTest, pythonMeshFollowsUndoableEdits)
+{
+    std::string name = App::GetApplication().getUniqueDocumentName("mesh_undo");
+    App::Document* doc = App::GetApplication().newDocument(name.c_str(), "testUser");
+    auto feature = doc->addObject<Mesh::Feature>("Mesh");
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    auto normal = [feature]() {
+        return feature->Mesh.getValue().getKernel().GetFacet(0).GetNormal();
+    };
+    Base::Vector3f original = normal();
+
+    {
+        Base::PyGILStateLocker lock;
+        // keep the wrapper like 'm = obj.Mesh' does
+        Py::Object mesh(feature->Mesh.getPyObject(), true);
+        auto meshPy = static_cast<Mesh::MeshPy*>(mesh.ptr());
+
+        doc->openTransaction("Flip normals");
+        Py::Callable(mesh.getAttr("flipNormals")).apply(Py::Tuple());
+        doc->commitTransaction();
+        EXPECT_EQ(meshPy->getMeshObjectPtr(), feature->Mesh.getValuePtr());
+        EXPECT_FLOAT_EQ(normal() * original, -1.0F);
+
+        EXPECT_TRUE(doc->undo());
+        EXPECT_EQ(meshPy->getMeshObjectPtr(), feature->Mesh.getValuePtr());
+        EXPECT_FLOAT_EQ(normal() * original, 1.0F);
+
+        // the wrapper still edits the mesh of the feature
+        Py::Callable(mesh.getAttr("flipNormals")).apply(Py::Tuple());
+        EXPECT_FLOAT_EQ(normal() * original, -1.0F);
+    }
+
+    App::GetApplication().closeDocument(name.c_str());
+}
+
+TEST_F(MeshFeatureTest, fixDefectsRecomputeConcurrently)
+{
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document"
+    );
+    hGrp->SetBool("EnableParallelRecompute", true);
+    hGrp->SetInt("ParallelRecomputeThreads", 2);
+    std::string name = App::GetApplication().getUniqueDocumentName("fix_defects");
+    App::Document* doc = App::GetApplication().newDocument(name.c_str(), "testUser");
+
+    auto source = doc->addObject<Mesh::Feature>("Source");
+    source->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    auto flip = doc->addObject<Mesh::FlipNormals>("Flip");
+    flip->Source.setValue(source);
+    auto duplicates = doc->addObject<Mesh::FixDuplicatedFaces>("Duplicates");
+    duplicates->Source.setValue(source);
+    auto harmonize = doc->addObject<Mesh::HarmonizeNormals>("Harmonize");
+    harmonize->Source.setValue(flip);
+
+    EXPECT_TRUE(flip->canRecomputeConcurrently());
+    EXPECT_FALSE(source->canRecomputeConcurrently());
+    EXPECT_EQ(doc->recompute(), 4);
+
+    const MeshCore::MeshKernel& kernel = source->Mesh.getValue().getKernel();
+    const MeshCore::MeshKernel& flipped = flip->Mesh.getValue().getKernel();
+    EXPECT_EQ(flipped.CountFacets(), 12);
+    EXPECT_EQ(duplicates->Mesh.getValue().countFacets(), 12);
+    EXPECT_EQ(harmonize->Mesh.getValue().countFacets(), 12);
+    Base::Vector3f normal = kernel.GetFacet(0).GetNormal();
+    Base::Vector3f flippedNormal = flipped.GetFacet(0).GetNormal();
+    EXPECT_FLOAT_EQ(normal * flippedNormal, -1.0F);
+    EXPECT_FALSE(flip->isTouched());
+    EXPECT_FALSE(harmonize->isTouched());
+
+    App::GetApplication().closeDocument(name.c_str());
+    hGrp->RemoveBool("EnableParallelRecompute");
+    hGrp->RemoveInt("ParallelRecomputeThreads");
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
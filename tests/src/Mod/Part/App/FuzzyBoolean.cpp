@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
 
 #include "Mod/Part/App/FuzzyHelper.h"
 #include "Mod/Part/App/FeaturePartImportBrep.h"
@@ -172,3 +174,36 @@ TEST_F(FuzzyBooleanTest, testCompletelyFailsTooBigFuzzy)
     Part::FuzzyHelper::setBooleanFuzzy(oldFuzzy);
     EXPECT_EQ(failed, 1);
 }
+
+TEST_F(FuzzyBooleanTest, testWithBooleanFuzzyIsThreadLocal)
+{
+    double oldFuzzy = Part::FuzzyHelper::getBooleanFuzzy();
+    Part::FuzzyHelper::setBooleanFuzzy(10.0);
+
+    double inner = -1.0;
+    double nested = -1.0;
+    double otherThread = -1.0;
+    Part::FuzzyHelper::withBooleanFuzzy(0.0, [&]() {
+        inner = Part::FuzzyHelper::getBooleanFuzzy();
+        Part::FuzzyHelper::withBooleanFuzzy(2.0, [&]() {
+            nested = Part::FuzzyHelper::getBooleanFuzzy();
+        });
+        // a boolean running at the same time in another thread keeps the global value
+        std::thread thread([&]() { otherThread = Part::FuzzyHelper::getBooleanFuzzy(); });
+        thread.join();
+        EXPECT_DOUBLE_EQ(Part::FuzzyHelper::getBooleanFuzzy(), 0.0);
+    });
+    EXPECT_DOUBLE_EQ(inner, 0.0);
+    EXPECT_DOUBLE_EQ(nested, 2.0);
+    EXPECT_DOUBLE_EQ(otherThread, 10.0);
+    EXPECT_DOUBLE_EQ(Part::FuzzyHelper::getBooleanFuzzy(), 10.0);
+
+    // the value is restored when the function throws
+    EXPECT_THROW(
+        Part::FuzzyHelper::withBooleanFuzzy(0.0, []() { throw std::runtime_error("failed"); }),
+        std::runtime_error
+    );
+    EXPECT_DOUBLE_EQ(Part::FuzzyHelper::getBooleanFuzzy(), 10.0);
+
+    Part::FuzzyHelper::setBooleanFuzzy(oldFuzzy);
+}
@@ -1,8 +1,12 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include <gtest/gtest.h>
+#include <future>
 
 #include <BRepFilletAPI_MakeFillet.hxx>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
 #include "Mod/Part/App/FeaturePartCommon.h"
 #include "Mod/Part/App/PropertyTopoShape.h"
 #include <src/App/InitApplication.h>
@@ -101,6 +105,62 @@ EndMap
 )x";
     }
 
+    // What a restored shape property looks like
+    struct RestoredShape
+    {
+        bool pendingAfterOpen = false;
+        int changes = 0;
+        double volume = 0.0;
+        size_t elementMapSize = 0;
+        long tag = 0;
+        std::string version;
+        Base::BoundBox3d box;
+    };
+
+    // Saves the test document and closes it
+    std::string saveTestDoc()
+    {
+        std::string fileName = App::Application::getTempFileName("lazy_restore") + ".FCStd";
+        _doc->saveAs(fileName.c_str());
+        App::GetApplication().closeDocument(_docName.c_str());
+        _doc = nullptr;
+        return fileName;
+    }
+
+    static void setRestoreMode(bool lazy, bool parallel)
+    {
+        auto hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/General"
+        );
+        hGrp->SetBool("LazyShapeRestore", lazy);
+        hGrp->SetBool("ParallelShapeRestore", parallel);
+    }
+
+    static RestoredShape restoreShape(const std::string& fileName, const std::string& objName)
+    {
+        RestoredShape res;
+        auto conn = App::GetApplication().signalChangedObject.connect(
+            [&res, &objName](const App::DocumentObject& obj, const App::Property& prop) {
+                if (objName == obj.getNameInDocument() && strcmp(prop.getName(), "Shape") == 0) {
+                    res.changes++;
+                }
+            }
+        );
+        App::Document* doc = App::GetApplication().openDocument(fileName.c_str());
+        conn.disconnect();
+
+        auto feature = freecad_cast<Part::Feature*>(doc->getObject(objName.c_str()));
+        res.pendingAfterOpen = feature->Shape.isPending();
+        res.box = feature->Shape.getBoundingBox();
+        const TopoShape& shape = feature->Shape.getShape();
+        res.volume = getVolume(shape.getShape());
+        res.elementMapSize = shape.getElementMapSize();
+        res.tag = shape.Tag;
+        res.version = feature->Shape.getElementMapVersion(true);
+        App::GetApplication().closeDocument(doc->getName());
+        return res;
+    }
+
     Common* _common = nullptr;  // NOLINT Can't be private in a test framework
 };
 
@@ -269,3 +329,100 @@ TEST_F(PropertyTopoShapeTest, testRestore)
     EXPECT_TRUE(reader.isValid());
     EXPECT_TRUE(reader.isEndOfElement());
 }
+
+TEST_F(PropertyTopoShapeTest, testLazyRestoreMatchesEager)
+{
+    // Arrange
+    std::string objName = _common->getNameInDocument();
+    std::string fileName = saveTestDoc();
+
+    // Act
+    setRestoreMode(false, false);
+    auto eager = restoreShape(fileName, objName);
+    setRestoreMode(true, false);
+    auto lazy = restoreShape(fileName, objName);
+    setRestoreMode(false, true);
+    auto parallel = restoreShape(fileName, objName);
+    setRestoreMode(false, false);
+    Base::FileInfo(fileName).deleteFile();
+
+    // Assert
+    EXPECT_FALSE(eager.pendingAfterOpen);
+    EXPECT_TRUE(lazy.pendingAfterOpen);
+    EXPECT_FALSE(parallel.pendingAfterOpen);
+    EXPECT_DOUBLE_EQ(eager.volume, 3.0);
+    EXPECT_EQ(eager.elementMapSize, 26);
+    for (const auto& res : {lazy, parallel}) {
+        EXPECT_GT(res.changes, 0);
+        EXPECT_EQ(res.changes, eager.changes);
+        EXPECT_DOUBLE_EQ(res.volume, eager.volume);
+        EXPECT_EQ(res.elementMapSize, eager.elementMapSize);
+        EXPECT_EQ(res.tag, eager.tag);
+        EXPECT_EQ(res.version, eager.version);
+        EXPECT_DOUBLE_EQ(res.box.MinY, eager.box.MinY);
+        EXPECT_DOUBLE_EQ(res.box.MaxY, eager.box.MaxY);
+    }
+}
+
+TEST_F(PropertyTopoShapeTest, testLazyRestoreUsesSavedBoundBox)
+{
+    // Arrange: saved without lazy restore, opened with it
+    std::string objName = _common->getNameInDocument();
+    Base::BoundBox3d expected = _common->Shape.getBoundingBox();
+    setRestoreMode(false, false);
+    std::string fileName = saveTestDoc();
+    setRestoreMode(true, false);
+    App::Document* doc = App::GetApplication().openDocument(fileName.c_str());
+    auto feature = freecad_cast<Part::Feature*>(doc->getObject(objName.c_str()));
+    ASSERT_TRUE(feature->Shape.isPending());
+
+    // Act
+    Base::BoundBox3d box = feature->Shape.getBoundingBox();
+
+    // Assert: the box is read from the file without decoding the shape
+    EXPECT_TRUE(feature->Shape.isPending());
+    EXPECT_DOUBLE_EQ(box.MinX, expected.MinX);
+    EXPECT_DOUBLE_EQ(box.MinY, expected.MinY);
+    EXPECT_DOUBLE_EQ(box.MinZ, expected.MinZ);
+    EXPECT_DOUBLE_EQ(box.MaxX, expected.MaxX);
+    EXPECT_DOUBLE_EQ(box.MaxY, expected.MaxY);
+    EXPECT_DOUBLE_EQ(box.MaxZ, expected.MaxZ);
+
+    App::GetApplication().closeDocument(doc->getName());
+    setRestoreMode(false, false);
+    Base::FileInfo(fileName).deleteFile();
+}
+
+TEST_F(PropertyTopoShapeTest, testLazyRestoreConcurrentAccess)
+{
+    // Arrange
+    std::string objName = _common->getNameInDocument();
+    std::string fileName = saveTestDoc();
+    setRestoreMode(true, false);
+    App::Document* doc = App::GetApplication().openDocument(fileName.c_str());
+    auto feature = freecad_cast<Part::Feature*>(doc->getObject(objName.c_str()));
+    ASSERT_TRUE(feature->Shape.isPending());
+    std::unique_ptr<App::Property> copy(feature->Shape.Copy());
+    auto copyShape = static_cast<PropertyPartShape*>(copy.get());
+    EXPECT_TRUE(copyShape->isPending());
+
+    // Act: the first access decodes, all others wait for it without deadlocking
+    std::vector<std::future<TopoDS_Shape>> results;
+    for (int i = 0; i < 8; i++) {
+        auto prop = i % 2 ? copyShape : &feature->Shape;
+        results.push_back(std::async(std::launch::async, [prop]() { return prop->getValue(); }));
+    }
+
+    // Assert: the copy shares the decoded shape
+    TopoDS_Shape shape = feature->Shape.getValue();
+    for (auto& result : results) {
+        EXPECT_TRUE(result.get().IsSame(shape));
+    }
+    EXPECT_FALSE(feature->Shape.isPending());
+    EXPECT_FALSE(copyShape->isPending());
+    EXPECT_DOUBLE_EQ(getVolume(shape), 3.0);
+
+    App::GetApplication().closeDocument(doc->getName());
+    setRestoreMode(false, false);
+    Base::FileInfo(fileName).deleteFile();
+}
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+
+#include <BRepBuilderAPI_Copy.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <gp_Trsf.hxx>
+
+#include <src/App/InitApplication.h>
+#include <Mod/Part/Gui/TessellationCache.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+class TessellationCacheTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        PartGui::TessellationCache::instance().clear();
+    }
+
+    void TearDown() override
+    {
+        PartGui::TessellationCache::instance().clear();
+    }
+
+    static constexpr double deflection = 0.1;
+    static constexpr double angularDeflection = 0.5;
+
+    // Runs the cache lookup of ViewProviderPartExt::setupCoinGeometry() and
+    // returns the number of faces that were served from the cache
+    static int mesh(const TopoDS_Shape& shape)
+    {
+        auto& cache = PartGui::TessellationCache::instance();
+        BRepTools::Clean(shape);
+
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        std::vector<std::string> keys;
+        std::vector<bool> cached;
+        for (int i = 1; i <= faces.Extent(); i++) {
+            std::string key;
+            cached.push_back(cache.apply(TopoDS::Face(faces(i)), deflection, angularDeflection, key));
+            keys.push_back(key);
+        }
+
+        BRepMesh_IncrementalMesh(shape, deflection, Standard_False, angularDeflection);
+
+        int hits = 0;
+        for (int i = 1; i <= faces.Extent(); i++) {
+            if (cached[i - 1]) {
+                hits++;
+            }
+            else {
+                cache.store(keys[i - 1], TopoDS::Face(faces(i)), deflection, angularDeflection);
+            }
+        }
+        return hits;
+    }
+
+    static bool hasTriangulation(const TopoDS_Shape& shape)
+    {
+        TopTools_IndexedMapOfShape faces;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        for (int i = 1; i <= faces.Extent(); i++) {
+            TopLoc_Location loc;
+            if (BRep_Tool::Triangulation(TopoDS::Face(faces(i)), loc).IsNull()) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(TessellationCacheTest, sameShapeUsesIdentity)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+
+    EXPECT_EQ(mesh(box), 0);
+    EXPECT_EQ(cache.size(), 6);
+    EXPECT_EQ(cache.statistics().misses, 6);
+
+    // redisplaying the unchanged shape must not hash its faces
+    EXPECT_EQ(mesh(box), 6);
+    EXPECT_TRUE(hasTriangulation(box));
+    EXPECT_EQ(cache.statistics().identityHits, 6);
+    EXPECT_EQ(cache.statistics().hashHits, 0);
+}
+
+TEST_F(TessellationCacheTest, copiedShapeFallsBackToHash)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape cylinder = BRepPrimAPI_MakeCylinder(1.0, 2.0).Shape();
+    const int numFaces = 3;
+    EXPECT_EQ(mesh(cylinder), 0);
+    ASSERT_EQ(cache.size(), numFaces);
+
+    // a copy has new TShapes but the same geometry
+    TopoDS_Shape copy = BRepBuilderAPI_Copy(cylinder, Standard_True, Standard_False).Shape();
+    EXPECT_EQ(mesh(copy), numFaces);
+    EXPECT_TRUE(hasTriangulation(copy));
+    EXPECT_EQ(cache.statistics().hashHits, numFaces);
+    EXPECT_EQ(cache.size(), numFaces);
+
+    // the copy is now known by identity, too
+    EXPECT_EQ(mesh(copy), numFaces);
+    EXPECT_EQ(cache.statistics().identityHits, numFaces);
+}
+
+TEST_F(TessellationCacheTest, locationIsPartOfIdentity)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    EXPECT_EQ(mesh(box), 0);
+
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5.0, 0.0, 0.0));
+    TopoDS_Shape moved = box.Moved(TopLoc_Location(trsf));
+    EXPECT_EQ(mesh(moved), 6);
+    EXPECT_EQ(cache.statistics().identityHits, 0);
+    EXPECT_EQ(cache.statistics().hashHits, 6);
+    EXPECT_EQ(cache.size(), 6);
+}
+
+TEST_F(TessellationCacheTest, deflectionIsPartOfKey)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 1.0, 1.0).Shape();
+    EXPECT_EQ(mesh(box), 0);
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(box, TopAbs_FACE, faces);
+    std::string key;
+    EXPECT_FALSE(cache.apply(TopoDS::Face(faces(1)), deflection * 2, angularDeflection, key));
+    EXPECT_FALSE(key.empty());
+    EXPECT_EQ(cache.statistics().misses, 7);
+}
+
+TEST_F(TessellationCacheTest, saveAndRestore)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    BRepTools::Clean(box);
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(box, TopAbs_FACE, faces);
+    std::vector<std::string> keys;
+    for (int i = 1; i <= faces.Extent(); i++) {
+        std::string key;
+        cache.apply(TopoDS::Face(faces(i)), deflection, angularDeflection, key);
+        keys.push_back(key);
+    }
+    BRepMesh_IncrementalMesh(box, deflection, Standard_False, angularDeflection);
+    for (int i = 1; i <= faces.Extent(); i++) {
+        cache.store(keys[i - 1], TopoDS::Face(faces(i)), deflection, angularDeflection);
+    }
+
+    std::stringstream str(std::ios::in | std::ios::out | std::ios::binary);
+    cache.save(str, keys);
+    cache.clear();
+    cache.restore(str);
+    EXPECT_EQ(cache.size(), 6);
+
+    // restored entries have no identity yet
+    EXPECT_EQ(mesh(box), 6);
+    EXPECT_EQ(cache.statistics().hashHits, 6);
+}
+
+TEST_F(TessellationCacheTest, restoreCorruptData)
+{
+    auto& cache = PartGui::TessellationCache::instance();
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    EXPECT_EQ(mesh(box), 0);
+
+    TopTools_IndexedMapOfShape faces;
+    TopExp::MapShapes(box, TopAbs_FACE, faces);
+    std::vector<std::string> keys;
+    for (int i = 1; i <= faces.Extent(); i++) {
+        std::string key;
+        cache.apply(TopoDS::Face(faces(i)), deflection, angularDeflection, key);
+        keys.push_back(key);
+    }
+    std::stringstream out(std::ios::in | std::ios::out | std::ios::binary);
+    cache.save(out, keys);
+    const std::string data = out.str();
+
+    auto restore = [&cache](const std::string& data) {
+        cache.clear();
+        std::stringstream in(data, std::ios::in | std::ios::binary);
+        cache.restore(in);
+        return cache.size();
+    };
+    ASSERT_EQ(restore(data), 6);
+
+    // a truncated file keeps the complete entries only
+    for (std::size_t length = 0; length < data.size(); length += 7) {
+        EXPECT_LT(restore(data.substr(0, length)), 6);
+    }
+
+    // the header is followed by the key and the triangulation of the first entry
+    auto readUInt32 = [&data](std::size_t pos) {
+        uint32_t value {};
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        return value;
+    };
+    std::size_t triangulation = 3 * sizeof(uint32_t) + sizeof(uint32_t) + readUInt32(12);
+    uint32_t nbNodes = readUInt32(triangulation);
+    bool hasUV = data[triangulation + 2 * sizeof(uint32_t)] != 0;
+    std::size_t triangles = triangulation + 2 * sizeof(uint32_t) + 1 + sizeof(double)
+        + nbNodes * (hasUV ? 5 : 3) * sizeof(double);
+
+    // a node count beyond the end of the file
+    std::string corrupt = data;
+    uint32_t huge = 0x7fffffff;
+    std::memcpy(corrupt.data() + triangulation, &huge, sizeof(huge));
+    EXPECT_EQ(restore(corrupt), 0);
+
+    // a triangle referring to a node that does not exist
+    corrupt = data;
+    int32_t node = static_cast<int32_t>(nbNodes) + 1;
+    std::memcpy(corrupt.data() + triangles, &node, sizeof(node));
+    EXPECT_EQ(restore(corrupt), 0);
+
+    // the faces that were not restored are meshed again
+    EXPECT_EQ(mesh(box), 0);
+    EXPECT_EQ(cache.statistics().misses, 6);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
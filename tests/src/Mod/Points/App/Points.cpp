@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
 
@@ -240,4 +241,76 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestBinaryPLY)
+{
+    // enough points to be decoded in several blocks
+    const int numPoints = 100000;
+    std::string name = getFileName();
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex " << numPoints << "\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property double z\n"
+            << "property float intensity\n"
+            << "end_header\n";
+        Base::OutputStream str(out);
+        for (int i = 0; i < numPoints; i++) {
+            str << float(i) << float(-i) << double(i) / 2 << float(i % 10);
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_FALSE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    EXPECT_EQ(reader.getWidth(), numPoints);
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), numPoints);
+    ASSERT_EQ(reader.getIntensities().size(), numPoints);
+    for (int i = 0; i < numPoints; i += 997) {
+        EXPECT_EQ(kernel.getPoint(i), Base::Vector3d(i, -i, double(i) / 2));
+        EXPECT_FLOAT_EQ(reader.getIntensities()[i], float(i % 10));
+    }
+}
+
+TEST_F(PointsTest, TestBinaryPCD)
+{
+    const int numPoints = 100000;
+    std::string name = getFileName();
+    {
+        Base::FileInfo fi(name);
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        out << "VERSION 0.7\n"
+            << "FIELDS x y z rgb\n"
+            << "SIZE 4 4 4 4\n"
+            << "TYPE F F F U\n"
+            << "COUNT 1 1 1 1\n"
+            << "WIDTH " << numPoints << "\n"
+            << "HEIGHT 1\n"
+            << "POINTS " << numPoints << "\n"
+            << "DATA binary\n";
+        Base::OutputStream str(out);
+        for (int i = 0; i < numPoints; i++) {
+            str << float(i) << float(1) << float(2) << uint32_t(0xff00ff00);
+        }
+    }
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasColors());
+    EXPECT_FALSE(reader.hasIntensities());
+    const Points::PointKernel& kernel = reader.getPoints();
+    ASSERT_EQ(kernel.size(), numPoints);
+    ASSERT_EQ(reader.getColors().size(), numPoints);
+    EXPECT_EQ(kernel.getPoint(numPoints - 1), Base::Vector3d(numPoints - 1, 1, 2));
+    EXPECT_EQ(reader.getColors()[numPoints - 1].getPackedARGB(), 0xff00ff00);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
 #include "gtest/gtest.h"
+#include <memory>
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsPy.h>
 
 class PointsFeatureTest: public ::testing::Test
 {
@@ -10,6 +15,7 @@ protected:
     static void SetUpTestSuite()
     {
         tests::initApplication();
+        Base::Interpreter().runString("import Points");
     }
 
     void SetUp() override
@@ -35,4 +41,73 @@ TEST_F(PointsFeatureTest, getComplexElementTypes)
 
     EXPECT_EQ(types.size(), 0);
 }
+
+TEST_F(PointsFeatureTest, copySharesPoints)
+{
+    Points::Feature pf;
+    Points::PointKernel pk;
+    pk.push_back(Base::Vector3d(0.0, 0.0, 0.0));
+    pk.push_back(Base::Vector3d(1.0, 0.0, 0.0));
+    pk.push_back(Base::Vector3d(0.0, 1.0, 0.0));
+    pf.Points.setValue(pk);
+
+    std::unique_ptr<App::Property> copy(pf.Points.Copy());
+    auto pointsCopy = static_cast<Points::PropertyPointKernel*>(copy.get());
+    EXPECT_EQ(&pointsCopy->getValue(), &pf.Points.getValue());
+
+    // modifying the points leaves the copy untouched, the property keeps its kernel
+    const Points::PointKernel* original = &pf.Points.getValue();
+    pf.Points.removeIndices({1});
+    EXPECT_EQ(&pf.Points.getValue(), original);
+    EXPECT_NE(&pointsCopy->getValue(), &pf.Points.getValue());
+    EXPECT_EQ(pointsCopy->getValue().size(), 3);
+    EXPECT_EQ(pf.Points.getValue().size(), 2);
+
+    // pasting shares the points again
+    pf.Points.Paste(*copy);
+    EXPECT_EQ(&pointsCopy->getValue(), &pf.Points.getValue());
+
+    Points::PointKernel* kernel = pf.Points.startEditing();
+    kernel->push_back(Base::Vector3d(0.0, 0.0, 1.0));
+    pf.Points.finishEditing();
+    EXPECT_EQ(pointsCopy->getValue().size(), 3);
+    EXPECT_EQ(pf.Points.getValue().size(), 4);
+}
+
+TEST_F(PointsFeatureTest, pythonPointsFollowUndoableEdits)
+{
+    std::string name = App::GetApplication().getUniqueDocumentName("points_undo");
+    App::Document* doc = App::GetApplication().newDocument(name.c_str(), "testUser");
+    auto feature = doc->addObject<Points::Feature>("Points");
+    Points::PointKernel pk;
+    pk.push_back(Base::Vector3d(0.0, 0.0, 0.0));
+    pk.push_back(Base::Vector3d(1.0, 0.0, 0.0));
+    pk.push_back(Base::Vector3d(0.0, 1.0, 0.0));
+    feature->Points.setValue(pk);
+
+    {
+        Base::PyGILStateLocker lock;
+        // keep the wrapper like 'p = obj.Points' does
+        Py::Object points(feature->Points.getPyObject(), true);
+        auto pointsPy = static_cast<Points::PointsPy*>(points.ptr());
+        auto countPoints = [&points]() {
+            return static_cast<long>(Py::Long(points.getAttr("CountPoints")));
+        };
+
+        doc->openTransaction("Remove point");
+        feature->Points.removeIndices({1});
+        doc->commitTransaction();
+        EXPECT_EQ(pointsPy->getPointKernelPtr(), &feature->Points.getValue());
+        EXPECT_EQ(countPoints(), 2);
+
+        EXPECT_TRUE(doc->undo());
+        EXPECT_EQ(pointsPy->getPointKernelPtr(), &feature->Points.getValue());
+        EXPECT_EQ(countPoints(), 3);
+
+        EXPECT_TRUE(doc->redo());
+        EXPECT_EQ(countPoints(), 2);
+    }
+
+    App::GetApplication().closeDocument(name.c_str());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <Base/FileInfo.h>
+#include <Mod/Points/App/PointsOctree.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsOctreeTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < 100; i++) {
+            for (int j = 0; j < 100; j++) {
+                for (int k = 0; k < 10; k++) {
+                    points.emplace_back(float(i), float(j), 0.1F * float(k));
+                }
+            }
+        }
+        // invalid points as in structured clouds
+        for (std::size_t i = 0; i < points.size(); i += 1000) {
+            points[i].x = std::numeric_limits<float>::quiet_NaN();
+        }
+        kernel.setBasicPoints(points);
+    }
+
+    Points::PointKernel kernel;
+};
+
+TEST_F(PointsOctreeTest, TestNodes)
+{
+    Points::PointsOctree octree(kernel, 256);
+    EXPECT_EQ(octree.size(), kernel.size() - 100);
+    EXPECT_GT(octree.depth(), 0);
+
+    const auto& nodes = octree.nodes();
+    ASSERT_FALSE(nodes.empty());
+    EXPECT_EQ(nodes.front().size(), octree.size());
+
+    const Base::Vector3f* points = octree.points();
+    const Points::PointsOctree::Index* indices = octree.indices();
+    for (const auto& node : nodes) {
+        if (node.isLeaf()) {
+            EXPECT_LE(node.size(), 256);
+        }
+        else {
+            EXPECT_EQ(nodes[node.firstChild].begin, node.begin);
+            EXPECT_EQ(nodes[node.firstChild + node.numChildren - 1].end, node.end);
+        }
+        for (std::size_t i = node.begin; i < node.end; i++) {
+            EXPECT_TRUE(node.box.IsInBox(points[i]));
+            EXPECT_EQ(kernel.getBasicPoints()[indices[i]], points[i]);
+        }
+    }
+}
+
+TEST_F(PointsOctreeTest, TestSelect)
+{
+    Points::PointsOctree octree(kernel, 256);
+
+    auto coarse = octree.selectLevel(0);
+    ASSERT_EQ(coarse.size(), 1);
+    EXPECT_LE(Points::PointsOctree::count(coarse), 256);
+
+    auto ranges = octree.select(0.0F, 10000);
+    std::size_t count = Points::PointsOctree::count(ranges);
+    EXPECT_LE(count, 10000);
+    EXPECT_GT(count, 5000);
+
+    // a large spacing is satisfied by the root already
+    EXPECT_EQ(octree.select(100.0F, 10000).size(), 1);
+    // a budget below the size of the root representation thins out the root
+    EXPECT_LE(Points::PointsOctree::count(octree.select(0.0F, 100)), 100);
+    EXPECT_TRUE(octree.select(0.0F, 0).empty());
+
+    Points::PointKernel subset = octree.getKernel(ranges);
+    EXPECT_EQ(subset.size(), count);
+}
+
+TEST_F(PointsOctreeTest, TestView)
+{
+    Points::PointsOctree octree(kernel, 256);
+
+    // only the half space x >= 60 is visible
+    Points::PointsOctree::View view;
+    view.position.Set(80.0F, 50.0F, 100.0F);
+    view.pixelScale = 1000.0F;
+    view.planes.push_back({Base::Vector3f(1.0F, 0.0F, 0.0F), 60.0F});
+
+    auto ranges = octree.select(view, 0.0F, octree.size());
+    std::vector<Base::Vector3f> points;
+    std::vector<std::size_t> indices;
+    octree.getPoints(ranges, points, &indices);
+    ASSERT_EQ(points.size(), indices.size());
+
+    float leafSize = 0.0F;
+    for (const auto& node : octree.nodes()) {
+        if (node.isLeaf()) {
+            leafSize = std::max(leafSize, node.box.LengthX());
+        }
+    }
+    for (const auto& pnt : points) {
+        EXPECT_GE(pnt.x, 60.0F - leafSize);
+    }
+    EXPECT_LT(points.size(), octree.size());
+
+    // a small budget keeps the points that are close to the camera
+    auto limited = octree.select(view, 0.0F, 5000);
+    EXPECT_LE(Points::PointsOctree::count(limited), 5000);
+}
+
+TEST_F(PointsOctreeTest, TestSpill)
+{
+    Points::PointsOctree octree(kernel, 256);
+    std::vector<Base::Vector3f> points(octree.points(), octree.points() + octree.size());
+    std::vector<Points::PointsOctree::Index> indices(
+        octree.indices(),
+        octree.indices() + octree.size()
+    );
+
+    Base::FileInfo fi(Base::FileInfo::getTempFileName());
+    ASSERT_TRUE(octree.spill(fi.filePath()));
+    EXPECT_TRUE(octree.isSpilled());
+    EXPECT_TRUE(fi.exists());
+
+    EXPECT_TRUE(std::equal(points.begin(), points.end(), octree.points()));
+    EXPECT_TRUE(std::equal(indices.begin(), indices.end(), octree.indices()));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -11,6 +11,14 @@ public:
     {
         return _getNumberOfConstraints(tagID);
     }
+    size_t getDiagnosisCacheHits() const
+    {
+        return _getDiagnosisCacheHits();
+    }
+    size_t getSkippedComponents() const
+    {
+        return _getSkippedComponents();
+    }
 };
 
 class GCSTest: public ::testing::Test
@@ -50,3 +58,87 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+TEST_F(GCSTest, incrementalSolveAndDiagnosis)  // NOLINT
+{
+    // Arrange
+    // Two independent components, of which only the first one needs to be solved
+    double a = 1.0, b = 2.0, c = 5.0, d = 5.0;
+    auto setUp = [&]() {
+        System()->clear();
+        System()->addConstraintEqual(&a, &b, 1);
+        System()->addConstraintEqual(&c, &d, 2);
+        GCS::VEC_pD params {&a, &b, &c, &d};
+        System()->declareUnknowns(params);
+        // diagnoses the system
+        System()->initSolution();
+        return System()->dofsNumber();
+    };
+    System()->incremental = true;
+
+    // Act
+    int dofs = setUp();
+    int ret = System()->solve();
+    System()->applySolution();
+    size_t skipped = System()->getSkippedComponents();
+    // the solution moved a and b, so the first diagnosis must not be reused
+    int dofsSolved = setUp();
+    size_t hitsSolved = System()->getDiagnosisCacheHits();
+    int dofsAgain = setUp();
+    size_t hitsAgain = System()->getDiagnosisCacheHits();
+    int retAgain = System()->solve();
+    size_t skippedAgain = System()->getSkippedComponents();
+
+    // Assert
+    EXPECT_EQ(dofs, 2);
+    EXPECT_EQ(dofsSolved, dofs);
+    EXPECT_EQ(dofsAgain, dofs);
+    EXPECT_EQ(ret, GCS::Success);
+    EXPECT_EQ(retAgain, GCS::Success);
+    EXPECT_EQ(skipped, 1);
+    EXPECT_EQ(hitsSolved, 0);
+    EXPECT_EQ(hitsAgain, 1);
+    EXPECT_EQ(skippedAgain, 3);
+    EXPECT_DOUBLE_EQ(a, b);
+    EXPECT_EQ(c, 5.0);
+    EXPECT_EQ(d, 5.0);
+}
+
+TEST_F(GCSTest, incrementalDiagnosisDependsOnValues)  // NOLINT
+{
+    // Arrange
+    // The rank of a point on a circle of radius r through the origin changes for r = 0
+    double px = 0.0, py = 0.0, cx = 0.0, cy = 0.0, r = 1.0;
+    auto setUp = [&]() {
+        System()->clear();
+        GCS::Point p;
+        p.x = &px;
+        p.y = &py;
+        GCS::Point center;
+        center.x = &cx;
+        center.y = &cy;
+        System()->addConstraintP2PDistance(p, center, &r, 1);
+        GCS::VEC_pD params {&px, &py};
+        System()->declareUnknowns(params);
+        // diagnoses the system
+        System()->initSolution();
+        return System()->dofsNumber();
+    };
+    System()->incremental = true;
+
+    // Act
+    px = 1.0;
+    int dofsCircle = setUp();
+    px = 0.0;
+    r = 0.0;
+    int dofsDegenerate = setUp();
+    px = 1.0;
+    r = 1.0;
+    int dofsCircleAgain = setUp();
+
+    // Assert
+    EXPECT_EQ(dofsCircle, 1);
+    EXPECT_EQ(dofsCircleAgain, 1);
+    EXPECT_EQ(System()->getDiagnosisCacheHits(), 1);
+    EXPECT_NE(dofsDegenerate, dofsCircle);
+}
@@ -0,0 +1,653 @@
+# SPDX-License-Identifier: LGPL-2.1-or-later
+# ***************************************************************************
+# *                                                                         *
+# *   This file is part of FreeCAD.                                         *
+# *                                                                         *
+# *   FreeCAD is free software: you can redistribute it and/or modify it    *
+# *   under the terms of the GNU Lesser General Public License as           *
+# *   published by the Free Software Foundation, either version 2.1 of the  *
+# *   License, or (at your option) any later version.                       *
+# *                                                                         *
+# *   FreeCAD is distributed in the hope that it will be useful, but        *
+# *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+# *   Lesser General Public License for more details.                       *
+# *                                                                         *
+# *   You should have received a copy of the GNU Lesser General Public      *
+# *   License along with FreeCAD. If not, see                               *
+# *   <https://www.gnu.org/licenses/>.                                      *
+# *                                                                         *
+# ***************************************************************************
+
+"""
+Headless performance benchmarks.
+
+Every workload is generated from scratch, so the results only depend on the build that runs them.
+Each timed step reports its wall time, CPU time, the peak resident set size and, if FreeCADCmd was
+built with FREECAD_COUNT_ALLOCATIONS, the number of heap allocations.
+
+Run the suite with:
+
+    FreeCADCmd benchmark.py --pass output=results.json [scale=0.1] [repeat=3]
+                                   [filter=mesh] [work-dir=DIR] [baseline=old.json]
+
+FreeCADCmd would parse arguments starting with a dash itself, so the options after --pass are
+given as name=value. With baseline the results are compared against an earlier run and the exit
+status is 1 if a step got slower, or used more memory or allocations, by more than threshold
+(default 2.0).
+Two result files can also be compared without running anything, even with a plain Python:
+
+    python3 benchmark.py --compare old.json new.json
+
+The sizes of the workloads are multiplied by scale. At scale 1 the mesh has 10M facets and the
+point cloud 50M points which needs several GB of memory. Generated input files are kept in the
+work directory and reused by later runs.
+"""
+
+import argparse
+import contextlib
+import json
+import math
+import os
+import platform
+import re
+import shutil
+import statistics
+import struct
+import sys
+import tempfile
+import time
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+# Base sizes at scale 1
+SIZES = {
+    "partdesign_features": 40,
+    "sketch_constraints": 3000,
+    "mesh_facets": 10_000_000,
+    "points": 50_000_000,
+    "fcstd_objects": 1000,
+    "spreadsheet_cells": 5000,
+    "techdraw_holes": 200,
+}
+
+# Steps that take less than this are too noisy to report a timing regression
+MIN_COMPARED_TIME = 0.05
+
+
+# --------------------------------------------------------------------------------------------------
+# Measurement
+
+
+def _memory_statistics(reset_peak=False):
+    import FreeCAD
+
+    if hasattr(FreeCAD, "getMemoryStatistics"):
+        return FreeCAD.getMemoryStatistics(reset_peak)
+
+    # Older builds, e.g. when producing a baseline
+    import resource
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform != "darwin":
+        peak *= 1024
+    return {"ResidentSize": 0, "PeakResidentSize": peak, "Allocations": None, "PeakReset": False}
+
+
+class Recorder:
+    """Collects the measurements of the timed steps of all workloads."""
+
+    def __init__(self):
+        self.results = {}
+
+    @contextlib.contextmanager
+    def measure(self, name, **parameters):
+        before = _memory_statistics(reset_peak=True)
+        wall = time.perf_counter()
+        cpu = time.process_time()
+        yield
+        cpu = time.process_time() - cpu
+        wall = time.perf_counter() - wall
+        after = _memory_statistics()
+
+        allocations = None
+        if after["Allocations"] is not None:
+            allocations = after["Allocations"] - before["Allocations"]
+
+        result = self.results.setdefault(
+            name, {"name": name, "parameters": parameters, "runs": []}
+        )
+        result["runs"].append(
+            {
+                "wall_time": wall,
+                "cpu_time": cpu,
+                "peak_rss": after["PeakResidentSize"],
+                "peak_rss_reset": before["PeakReset"],
+                "allocations": allocations,
+            }
+        )
+        print(f"  {name}: {wall:.3f} s", flush=True)
+
+    def summary(self):
+        benchmarks = []
+        for result in self.results.values():
+            runs = result["runs"]
+            times = [run["wall_time"] for run in runs]
+            allocations = [run["allocations"] for run in runs if run["allocations"] is not None]
+            benchmarks.append(
+                {
+                    "name": result["name"],
+                    "parameters": result["parameters"],
+                    "repeat": len(runs),
+                    "wall_time": {
+                        "min": min(times),
+                        "median": statistics.median(times),
+                        "max": max(times),
+                    },
+                    "cpu_time": min(run["cpu_time"] for run in runs),
+                    "peak_rss": max(run["peak_rss"] for run in runs),
+                    "peak_rss_reset": all(run["peak_rss_reset"] for run in runs),
+                    "allocations": min(allocations) if allocations else None,
+                }
+            )
+        return benchmarks
+
+
+# --------------------------------------------------------------------------------------------------
+# Generated input files
+
+
+def _torus_point(u, v, major=50.0, minor=15.0):
+    ring = major + minor * math.cos(v)
+    return (ring * math.cos(u), ring * math.sin(u), minor * math.sin(v))
+
+
+def _write_torus_stl(path, facets):
+    """Writes a closed torus with at least the given number of facets as binary STL."""
+    columns = max(3, int(math.sqrt(facets / 8)))
+    rows = max(3, math.ceil(facets / (2 * columns)))
+    count = 2 * rows * columns
+    with open(path, "wb") as out:
+        out.write(b"FreeCAD benchmark torus".ljust(80, b"\0"))
+        out.write(struct.pack("<I", count))
+        if numpy:
+            record = numpy.dtype(
+                [("normal", "<f4", (3,)), ("points", "<f4", (3, 3)), ("attr", "<u2")]
+            )
+            # Wrap the indices so that the seams share exactly the same points
+            v = (numpy.arange(columns + 1) % columns) * (2 * math.pi / columns)
+            for first in range(0, rows, 256):
+                last = min(first + 256, rows)
+                u = (numpy.arange(first, last + 1) % rows) * (2 * math.pi / rows)
+                uu, vv = numpy.meshgrid(u, v, indexing="ij")
+                ring = 50.0 + 15.0 * numpy.cos(vv)
+                grid = numpy.stack(
+                    (ring * numpy.cos(uu), ring * numpy.sin(uu), 15.0 * numpy.sin(vv)), -1
+                )
+                p00 = grid[:-1, :-1]
+                p10 = grid[1:, :-1]
+                p11 = grid[1:, 1:]
+                p01 = grid[:-1, 1:]
+                data = numpy.zeros((last - first, columns, 2), dtype=record)
+                data["points"][:, :, 0] = numpy.stack((p00, p10, p11), -2)
+                data["points"][:, :, 1] = numpy.stack((p00, p11, p01), -2)
+                out.write(data.tobytes())
+        else:
+            facet = struct.Struct("<12fH")
+            for i in range(rows):
+                u0 = 2 * math.pi * i / rows
+                u1 = 2 * math.pi * ((i + 1) % rows) / rows
+                for j in range(columns):
+                    v0 = 2 * math.pi * j / columns
+                    v1 = 2 * math.pi * ((j + 1) % columns) / columns
+                    p00 = _torus_point(u0, v0)
+                    p10 = _torus_point(u1, v0)
+                    p11 = _torus_point(u1, v1)
+                    p01 = _torus_point(u0, v1)
+                    out.write(facet.pack(0, 0, 0, *p00, *p10, *p11, 0))
+                    out.write(facet.pack(0, 0, 0, *p00, *p11, *p01, 0))
+    return count
+
+
+def _write_points_ply(path, count):
+    """Writes points spread evenly over a torus with some deterministic noise as binary PLY."""
+    # R2 low discrepancy sequence
+    alpha1 = 0.7548776662466927
+    alpha2 = 0.5698402909980532
+    with open(path, "wb") as out:
+        out.write(
+            (
+                "ply\nformat binary_little_endian 1.0\n"
+                f"element vertex {count}\n"
+                "property float x\nproperty float y\nproperty float z\n"
+                "end_header\n"
+            ).encode("ascii")
+        )
+        chunk = 1 << 20
+        for first in range(0, count, chunk):
+            last = min(first + chunk, count)
+            if numpy:
+                k = numpy.arange(first, last, dtype=numpy.float64)
+                u = 2 * math.pi * numpy.modf(0.5 + alpha1 * k)[0]
+                v = 2 * math.pi * numpy.modf(0.5 + alpha2 * k)[0]
+                minor = 15.0 + 0.05 * numpy.sin(37.0 * u + 11.0 * v)
+                ring = 50.0 + minor * numpy.cos(v)
+                xyz = numpy.stack(
+                    (ring * numpy.cos(u), ring * numpy.sin(u), minor * numpy.sin(v)), -1
+                )
+                out.write(xyz.astype("<f4").tobytes())
+            else:
+                values = []
+                for k in range(first, last):
+                    u = 2 * math.pi * math.modf(0.5 + alpha1 * k)[0]
+                    v = 2 * math.pi * math.modf(0.5 + alpha2 * k)[0]
+                    values.extend(_torus_point(u, v, minor=15.0 + 0.05 * math.sin(37 * u + 11 * v)))
+                out.write(struct.pack(f"<{len(values)}f", *values))
+
+
+def _generated_file(work_dir, name, writer, size):
+    path = os.path.join(work_dir, name)
+    if not os.path.exists(path):
+        print(f"  generating {name}", flush=True)
+        writer(path + ".tmp", size)
+        os.replace(path + ".tmp", path)
+    return path
+
+
+# --------------------------------------------------------------------------------------------------
+# Workloads
+
+
+def _add_rectangle(sketch, x, y, width, height):
+    import FreeCAD
+    import Part
+    import Sketcher
+
+    V = FreeCAD.Vector
+    corners = [V(x, y, 0), V(x + width, y, 0), V(x + width, y + height, 0), V(x, y + height, 0)]
+    first = sketch.GeometryCount
+    sketch.addGeometry([Part.LineSegment(corners[i], corners[(i + 1) % 4]) for i in range(4)])
+    constraints = [
+        Sketcher.Constraint("Coincident", first + i, 2, first + (i + 1) % 4, 1) for i in range(4)
+    ]
+    constraints += [
+        Sketcher.Constraint("Horizontal", first),
+        Sketcher.Constraint("Horizontal", first + 2),
+        Sketcher.Constraint("Vertical", first + 1),
+        Sketcher.Constraint("Vertical", first + 3),
+    ]
+    sketch.addConstraint(constraints)
+
+
+def _new_document(name):
+    import FreeCAD
+
+    return FreeCAD.newDocument(name, hidden=True, temp=True)
+
+
+def _touch_all(doc):
+    for obj in doc.Objects:
+        obj.touch()
+
+
+def bench_partdesign(rec, scale, work_dir):
+    """A body with N pads, N pockets and a fillet on all pads."""
+    import FreeCAD
+
+    count = max(1, int(SIZES["partdesign_features"] * scale))
+    doc = _new_document("BenchPartDesign")
+    try:
+        body = doc.addObject("PartDesign::Body", "Body")
+        xy = [f for f in body.Origin.OriginFeatures if f.Role == "XY_Plane"][0]
+
+        def sketch_at(name, z):
+            sketch = body.newObject("Sketcher::SketchObject", name)
+            sketch.AttachmentSupport = [(xy, "")]
+            sketch.MapMode = "FlatFace"
+            sketch.AttachmentOffset = FreeCAD.Placement(FreeCAD.Vector(0, 0, z), FreeCAD.Rotation())
+            return sketch
+
+        with rec.measure("partdesign_build", features=2 * count + 2):
+            sketch = sketch_at("PlateSketch", 0)
+            _add_rectangle(sketch, 0, 0, 10 * count, 20)
+            plate = body.newObject("PartDesign::Pad", "Plate")
+            plate.Profile = sketch
+            plate.Length = 5
+            for i in range(count):
+                sketch = sketch_at(f"BossSketch{i}", 5)
+                _add_rectangle(sketch, 10 * i + 1, 2, 4, 4)
+                pad = body.newObject("PartDesign::Pad", f"Boss{i}")
+                pad.Profile = sketch
+                pad.Length = 3
+                sketch = sketch_at(f"PocketSketch{i}", 5)
+                _add_rectangle(sketch, 10 * i + 5, 12, 3, 3)
+                pocket = body.newObject("PartDesign::Pocket", f"Pocket{i}")
+                pocket.Profile = sketch
+                pocket.Length = 2
+            doc.recompute()
+
+            # Round the vertical edges of the bosses
+            tip = body.Tip
+            edges = [
+                f"Edge{i + 1}"
+                for i, edge in enumerate(tip.Shape.Edges)
+                if abs(edge.Vertexes[0].Z - edge.Vertexes[-1].Z) > 2.9
+                and min(edge.Vertexes[0].Z, edge.Vertexes[-1].Z) > 4.9
+            ]
+            fillet = body.newObject("PartDesign::Fillet", "Fillet")
+            fillet.Base = (tip, edges)
+            fillet.Radius = 0.5
+            doc.recompute()
+
+        _touch_all(doc)
+        with rec.measure("partdesign_recompute", features=2 * count + 2):
+            doc.recompute()
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def bench_sketch(rec, scale, work_dir):
+    """A fully constrained staircase polyline with N constraints whose dimensions are edited."""
+    import FreeCAD
+    import Part
+    import Sketcher
+
+    lines = max(2, int(SIZES["sketch_constraints"] * scale) // 3)
+    doc = _new_document("BenchSketch")
+    try:
+        sketch = doc.addObject("Sketcher::SketchObject", "Sketch")
+        with rec.measure("sketch_build", constraints=3 * lines + 1):
+            V = FreeCAD.Vector
+            geometry = []
+            x = y = 0.0
+            for i in range(lines):
+                start = V(x, y, 0)
+                if i % 2:
+                    y += 10.0
+                else:
+                    x += 10.0
+                geometry.append(Part.LineSegment(start, V(x, y, 0)))
+            sketch.addGeometry(geometry)
+
+            constraints = [
+                Sketcher.Constraint("DistanceX", 0, 1, 0.0),
+                Sketcher.Constraint("DistanceY", 0, 1, 0.0),
+            ]
+            for i in range(lines):
+                constraints.append(Sketcher.Constraint("Vertical" if i % 2 else "Horizontal", i))
+                constraints.append(Sketcher.Constraint("Distance", i, 10.0))
+                if i:
+                    constraints.append(Sketcher.Constraint("Coincident", i - 1, 2, i, 1))
+            sketch.addConstraint(constraints)
+            doc.recompute()
+
+        datums = [
+            index
+            for index, constraint in enumerate(sketch.Constraints)
+            if constraint.Type == "Distance"
+        ][:20]
+        with rec.measure("sketch_edit_dimensions", constraints=3 * lines + 1, edits=len(datums)):
+            for index in datums:
+                sketch.setDatum(index, FreeCAD.Units.Quantity("12 mm"))
+                doc.recompute()
+
+        with rec.measure("sketch_solve", constraints=3 * lines + 1):
+            sketch.solve()
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def bench_mesh(rec, scale, work_dir):
+    """Reads, analyses, smooths and writes a closed mesh with N facets."""
+    import Mesh
+
+    facets = max(100, int(SIZES["mesh_facets"] * scale))
+    path = _generated_file(work_dir, f"torus_{facets}.stl", _write_torus_stl, facets)
+    params = {"facets": facets}
+
+    mesh = Mesh.Mesh()
+    with rec.measure("mesh_read_stl", **params):
+        mesh.read(path)
+    with rec.measure("mesh_evaluate", **params):
+        mesh.hasNonManifolds()
+        mesh.isSolid()
+        mesh.countComponents()
+    with rec.measure("mesh_curvature", **params):
+        mesh.getCurvaturePerVertex()
+    with rec.measure("mesh_smooth", **params):
+        mesh.smooth(Method="Laplace", Iteration=3)
+    output = os.path.join(work_dir, "torus_out.stl")
+    with rec.measure("mesh_write_stl", **params):
+        mesh.write(output)
+    os.remove(output)
+
+
+def bench_points(rec, scale, work_dir):
+    """Reads and writes a point cloud with N points."""
+    import FreeCAD
+    import Points
+
+    count = max(100, int(SIZES["points"] * scale))
+    path = _generated_file(work_dir, f"points_{count}.ply", _write_points_ply, count)
+    params = {"points": count}
+
+    doc = _new_document("BenchPoints")
+    try:
+        with rec.measure("points_read_ply", **params):
+            Points.insert(path, doc.Name)
+        output = os.path.join(work_dir, "points_out.ply")
+        with rec.measure("points_write_ply", **params):
+            Points.export(doc.Objects, output)
+        os.remove(output)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def bench_fcstd(rec, scale, work_dir):
+    """Saves, opens and recomputes a document with N Part features."""
+    import FreeCAD
+
+    count = max(10, int(SIZES["fcstd_objects"] * scale))
+    params = {"objects": count}
+    path = os.path.join(work_dir, "roundtrip.FCStd")
+    doc = _new_document("BenchRoundTrip")
+    try:
+        for i in range(count):
+            x, y = 12.0 * (i % 50), 12.0 * (i // 50)
+            if i % 10 == 9:
+                box = doc.addObject("Part::Box", f"Block{i}")
+                box.Placement.Base = FreeCAD.Vector(x, y, 0)
+                cylinder = doc.addObject("Part::Cylinder", f"Hole{i}")
+                cylinder.Radius = 2
+                cylinder.Placement.Base = FreeCAD.Vector(x + 5, y + 5, 0)
+                cut = doc.addObject("Part::Cut", f"Cut{i}")
+                cut.Base = box
+                cut.Tool = cylinder
+            else:
+                sphere = doc.addObject("Part::Sphere", f"Sphere{i}")
+                sphere.Radius = 5
+                sphere.Placement.Base = FreeCAD.Vector(x + 5, y + 5, 5)
+        doc.recompute()
+        with rec.measure("fcstd_save", **params):
+            doc.saveAs(path)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    with rec.measure("fcstd_open", **params):
+        doc = FreeCAD.openDocument(path, hidden=True)
+    try:
+        _touch_all(doc)
+        with rec.measure("fcstd_recompute", **params):
+            doc.recompute()
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+    os.remove(path)
+
+
+def bench_spreadsheet(rec, scale, work_dir):
+    """A chain of N cells where every cell depends on the previous one."""
+    import FreeCAD
+
+    count = max(10, int(SIZES["spreadsheet_cells"] * scale))
+    params = {"cells": count}
+    doc = _new_document("BenchSpreadsheet")
+    try:
+        sheet = doc.addObject("Spreadsheet::Sheet", "Sheet")
+        with rec.measure("spreadsheet_build", **params):
+            sheet.set("A1", "1")
+            for row in range(2, count + 1):
+                sheet.set(f"A{row}", f"=A{row - 1} + 1")
+            doc.recompute()
+        with rec.measure("spreadsheet_recompute", **params):
+            sheet.set("A1", "2")
+            doc.recompute()
+        if sheet.get(f"A{count}") != count + 1:
+            raise RuntimeError("Unexpected spreadsheet result")
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def bench_techdraw(rec, scale, work_dir):
+    """Hidden line removal of a plate with N holes."""
+    import FreeCAD
+    import Part
+    import TechDraw
+
+    holes = max(1, int(SIZES["techdraw_holes"] * scale))
+    columns = max(1, int(math.sqrt(holes)))
+    rows = math.ceil(holes / columns)
+    shape = Part.makeBox(10 * columns, 10 * rows, 5)
+    cylinders = [
+        Part.makeCylinder(3, 5, FreeCAD.Vector(10 * (i % columns) + 5, 10 * (i // columns) + 5, 0))
+        for i in range(holes)
+    ]
+    shape = shape.cut(Part.makeCompound(cylinders))
+    params = {"holes": holes}
+
+    direction = FreeCAD.Vector(1, -1, 1)
+    with rec.measure("techdraw_project", **params):
+        TechDraw.projectEx(shape, direction)
+    with rec.measure("techdraw_svg", **params):
+        TechDraw.projectToSVG(shape, direction)
+
+
+WORKLOADS = {
+    "partdesign": bench_partdesign,
+    "sketch": bench_sketch,
+    "mesh": bench_mesh,
+    "points": bench_points,
+    "fcstd": bench_fcstd,
+    "spreadsheet": bench_spreadsheet,
+    "techdraw": bench_techdraw,
+}
+
+
+# --------------------------------------------------------------------------------------------------
+# Comparison
+
+
+def compare(baseline, current, threshold):
+    """Returns a list of the steps that got worse by more than threshold."""
+    previous = {b["name"]: b for b in baseline["benchmarks"]}
+    regressions = []
+    for bench in current["benchmarks"]:
+        old = previous.get(bench["name"])
+        if not old or old["parameters"] != bench["parameters"]:
+            continue
+
+        checks = []
+        if bench["wall_time"]["min"] >= MIN_COMPARED_TIME:
+            checks.append(("wall time", old["wall_time"]["min"], bench["wall_time"]["min"]))
+        if old["peak_rss_reset"] and bench["peak_rss_reset"]:
+            checks.append(("peak RSS", old["peak_rss"], bench["peak_rss"]))
+        if old["allocations"] and bench["allocations"] is not None:
+            checks.append(("allocations", old["allocations"], bench["allocations"]))
+
+        for metric, before, after in checks:
+            ratio = after / before if before else 0.0
+            print(f"{bench['name']:32} {metric:12} {before:>16.6g} {after:>16.6g} {ratio:8.2f}x")
+            if before and ratio > threshold:
+                regressions.append((bench["name"], metric, ratio))
+    return regressions
+
+
+def _report_regressions(regressions, threshold):
+    for name, metric, ratio in regressions:
+        print(f"REGRESSION: {name} {metric} is {ratio:.2f}x the baseline (limit {threshold}x)")
+    return 1 if regressions else 0
+
+
+# --------------------------------------------------------------------------------------------------
+
+
+def _arguments():
+    argv = sys.argv[1:]
+    if "--pass" in argv:
+        argv = argv[argv.index("--pass") + 1 :]
+        argv = [f"--{arg}" if "=" in arg and not arg.startswith("-") else arg for arg in argv]
+
+    parser = argparse.ArgumentParser(prog="benchmark.py", description=__doc__.split("\n\n")[0])
+    parser.add_argument("--output", help="file to write the JSON results to")
+    parser.add_argument("--scale", type=float, default=1.0, help="workload size factor")
+    parser.add_argument("--repeat", type=int, default=3, help="runs of every workload")
+    parser.add_argument("--filter", default="", help="regular expression selecting workloads")
+    parser.add_argument("--work-dir", help="directory for generated files, kept between runs")
+    parser.add_argument("--baseline", help="earlier results to compare against")
+    parser.add_argument("--threshold", type=float, default=2.0, help="allowed slowdown factor")
+    parser.add_argument("--compare", nargs=2, metavar=("BASELINE", "CURRENT"))
+    return parser.parse_args(argv)
+
+
+def main():
+    args = _arguments()
+    if args.compare:
+        with open(args.compare[0], encoding="utf-8") as baseline:
+            with open(args.compare[1], encoding="utf-8") as current:
+                regressions = compare(json.load(baseline), json.load(current), args.threshold)
+        return _report_regressions(regressions, args.threshold)
+
+    import FreeCAD
+
+    work_dir = args.work_dir or tempfile.mkdtemp(prefix="FreeCADBenchmark")
+    os.makedirs(work_dir, exist_ok=True)
+    pattern = re.compile(args.filter)
+    recorder = Recorder()
+    try:
+        for name, workload in WORKLOADS.items():
+            if not pattern.search(name):
+                continue
+            for run in range(args.repeat):
+                print(f"{name} ({run + 1}/{args.repeat})", flush=True)
+                workload(recorder, args.scale, work_dir)
+    finally:
+        if not args.work_dir:
+            shutil.rmtree(work_dir, ignore_errors=True)
+
+    results = {
+        "version": ".".join(FreeCAD.Version()[:3]),
+        "revision": FreeCAD.Version()[3] if len(FreeCAD.Version()) > 3 else "",
+        "platform": platform.platform(),
+        "cpu_count": os.cpu_count(),
+        "scale": args.scale,
+        "benchmarks": recorder.summary(),
+    }
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as output:
+            json.dump(results, output, indent=2)
+    else:
+        json.dump(results, sys.stdout, indent=2)
+        print()
+
+    if args.baseline:
+        with open(args.baseline, encoding="utf-8") as baseline:
+            regressions = compare(json.load(baseline), results, args.threshold)
+        return _report_regressions(regressions, args.threshold)
+    return 0
+
+
+# FreeCADCmd imports a script given on the command line as module
+if __name__ in ("__main__", "benchmark"):
+    sys.exit(main())